@@ -175,8 +175,8 @@ static void archive_view_add_item(ArchiveApp* archive, FileInfo* file_info, cons
 static bool archive_is_favorite(ArchiveApp* archive, ArchiveFile_t* selected) {
     furi_assert(selected);
     string_t path;
-    string_t buffer;
-    string_init(buffer);
+    char* line;
+    size_t line_length;
     bool found = false;
 
     string_init_printf(
@@ -186,21 +186,17 @@ static bool archive_is_favorite(ArchiveApp* archive, ArchiveFile_t* selected) {
         file_worker_open(archive->file_worker, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_ALWAYS);
 
     if(load_result) {
-        while(1) {
-            if(!file_worker_read_until(archive->file_worker, buffer, '\n')) {
+        while(file_worker_read_line(archive->file_worker, &line, &line_length, '\n')) {
+            if(!line_length) {
                 break;
             }
-            if(!string_size(buffer)) {
-                break;
-            }
-            if(!string_search(buffer, path)) {
+            if(!strncmp(line, string_get_cstr(path), string_size(path))) {
                 found = true;
                 break;
             }
         }
     }
 
-    string_clear(buffer);
     string_clear(path);
     file_worker_close(archive->file_worker);
 
@@ -208,27 +204,22 @@ static bool archive_is_favorite(ArchiveApp* archive, ArchiveFile_t* selected) {
 }
 
 static bool archive_favorites_read(ArchiveApp* archive) {
-    string_t buffer;
     FileInfo file_info;
-    string_init(buffer);
+    char* line;
+    size_t line_length;
 
     bool load_result =
         file_worker_open(archive->file_worker, ARCHIVE_FAV_PATH, FSAM_READ, FSOM_OPEN_EXISTING);
 
     if(load_result) {
-        while(1) {
-            if(!file_worker_read_until(archive->file_worker, buffer, '\n')) {
-                break;
-            }
-            if(!string_size(buffer)) {
+        while(file_worker_read_line(archive->file_worker, &line, &line_length, '\n')) {
+            if(!line_length) {
                 break;
             }
 
-            archive_view_add_item(archive, &file_info, string_get_cstr(buffer));
-            string_clean(buffer);
+            archive_view_add_item(archive, &file_info, line);
         }
     }
-    string_clear(buffer);
     file_worker_close(archive->file_worker);
 
     return load_result;
@@ -781,6 +772,8 @@ ArchiveApp* archive_alloc() {
     archive->text_input = text_input_alloc();
     archive->view_archive_main = view_alloc();
     archive->file_worker = file_worker_alloc(true);
+    /* favorites are read line by line in place, line is a full path */
+    file_worker_set_read_buffer_size(archive->file_worker, ARCHIVE_FAV_LINE_MAX);
 
     furi_check(archive->event_queue);
 
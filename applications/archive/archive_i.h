@@ -20,6 +20,7 @@
 #define MAX_FILE_SIZE 128
 #define ARCHIVE_FAV_PATH "/any/favorites.txt"
 #define ARCHIVE_FAV_TEMP_PATH "/any/favorites.tmp"
+#define ARCHIVE_FAV_LINE_MAX 512
 
 typedef enum {
     ArchiveViewMain,
@@ -54,6 +54,10 @@ size_t cli_read(Cli* cli, uint8_t* buffer, size_t size) {
     return furi_hal_vcp_rx(buffer, size);
 }
 
+size_t cli_read_timeout(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout) {
+    return furi_hal_vcp_rx_with_timeout(buffer, size, timeout);
+}
+
 bool cli_cmd_interrupt_received(Cli* cli) {
     char c = '\0';
     if(furi_hal_vcp_rx_with_timeout((uint8_t*)&c, 1, 0) == 1) {
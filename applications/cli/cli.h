@@ -76,6 +76,16 @@ void cli_delete_command(Cli* cli, const char* name);
  */
 size_t cli_read(Cli* cli, uint8_t* buffer, size_t size);
 
+/* Read from terminal, waiting for data not longer than timeout
+ * Do it only from inside of cli call.
+ * @param cli - Cli instance
+ * @param buffer - pointer to buffer
+ * @param size - size of buffer in bytes
+ * @param timeout - timeout in ms
+ * @return bytes written, 0 on timeout
+ */
+size_t cli_read_timeout(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout);
+
 /* Not blocking check for interrupt command received
  * @param cli - Cli instance
  */
@@ -193,10 +193,19 @@ void cli_command_date(Cli* cli, string_t args, void* context) {
     }
 }
 
+static void cli_command_log_write(const uint8_t* data, size_t size) {
+    fwrite(data, 1, size, stdout);
+    fflush(stdout);
+}
+
+/* 'log binary' streams binary frames, decode them with scripts/log_decode.py */
 void cli_command_log(Cli* cli, string_t args, void* context) {
+    bool binary = !string_cmp_str(args, "binary");
     furi_stdglue_set_global_stdout_callback(cli_stdout_callback);
+    if(binary) furi_log_set_binary(cli_command_log_write);
     printf("Press any key to stop...\r\n");
     cli_getc(cli);
+    if(binary) furi_log_set_binary(NULL);
     furi_stdglue_set_global_stdout_callback(NULL);
 }
 
@@ -380,12 +389,62 @@ void cli_command_free(Cli* cli, string_t args, void* context) {
     printf("Free heap size: %d\r\n", memmgr_get_free_heap());
     printf("Minimum heap size: %d\r\n", memmgr_get_minimum_free_heap());
     printf("Maximum heap block: %d\r\n", memmgr_heap_get_max_free_block());
+
+    MemmgrHeapSlabStats stats[8];
+    size_t count = memmgr_heap_get_slab_stats(stats, COUNT_OF(stats));
+    printf("%-6s %-6s %-8s %-8s %-8s %s\r\n", "Slab", "Pages", "Used", "Free", "Peak", "Allocs");
+    for(size_t i = 0; i < count; i++) {
+        printf(
+            "%-6u %-6u %-8u %-8u %-8u %u\r\n",
+            stats[i].size,
+            stats[i].pages,
+            stats[i].used,
+            stats[i].free,
+            stats[i].peak,
+            stats[i].allocs);
+    }
 }
 
 void cli_command_free_blocks(Cli* cli, string_t args, void* context) {
     memmgr_heap_printf_free_blocks();
 }
 
+/* Addresses are return addresses of malloc() callers, use addr2line on firmware elf */
+static void cli_command_heap_trace_callers(MemmgrHeapTraceCaller* callers, size_t count) {
+    printf("%-12s %-8s %s\r\n", "Caller", "Bytes", "Blocks");
+    for(size_t i = 0; i < MIN(count, 16U); i++) {
+        printf(
+            "0x%08lx   %-8u %u\r\n",
+            (uint32_t)callers[i].caller,
+            callers[i].size,
+            callers[i].count);
+    }
+}
+
+void cli_command_heap_trace(Cli* cli, string_t args, void* context) {
+    MemmgrHeapTraceStats stats;
+    memmgr_heap_get_trace_stats(&stats);
+    printf(
+        "Traced threads: %u, finished with leftovers: %u\r\n"
+        "Allocations: %u of %u, leftovers: %u, dropped: %u\r\n",
+        stats.threads,
+        stats.finished_threads,
+        stats.entries,
+        stats.capacity,
+        stats.leftovers,
+        stats.dropped);
+
+    const size_t callers_count = 64;
+    MemmgrHeapTraceCaller* callers = furi_alloc(sizeof(MemmgrHeapTraceCaller) * callers_count);
+    printf("Leftovers of finished threads:\r\n");
+    cli_command_heap_trace_callers(
+        callers, memmgr_heap_get_trace_callers(callers, callers_count, true));
+    printf("Running threads:\r\n");
+    cli_command_heap_trace_callers(
+        callers, memmgr_heap_get_trace_callers(callers, callers_count, false));
+    free(callers);
+}
+
 void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "!", CliCommandFlagParallelSafe, cli_command_device_info, NULL);
     cli_add_command(cli, "device_info", CliCommandFlagParallelSafe, cli_command_device_info, NULL);
@@ -398,6 +457,7 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "ps", CliCommandFlagParallelSafe, cli_command_ps, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(cli, "heap_trace", CliCommandFlagParallelSafe, cli_command_heap_trace, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
@@ -1,10 +1,7 @@
 #include "irda-app-brute-force.h"
-#include "irda/irda-app-file-parser.h"
 
 #include <memory>
-#include <m-string.h>
 #include <furi.h>
-#include <file-worker-cpp.h>
 
 void IrdaAppBruteForce::add_record(int index, const char* name) {
     records[name].index = index;
@@ -12,60 +9,67 @@ void IrdaAppBruteForce::add_record(int index, const char* name) {
 }
 
 bool IrdaAppBruteForce::calculate_messages() {
-    bool fs_res = false;
-    furi_assert(!file_parser);
-
-    file_parser = std::make_unique<IrdaAppFileParser>();
-    fs_res = file_parser->open_irda_file_read(universal_db_filename);
-    if(!fs_res) {
-        file_parser.reset();
+    if(!universal_index.open()) {
         return false;
     }
 
-    while(1) {
-        auto file_signal = file_parser->read_signal();
-        if(!file_signal) break;
-
-        auto element = records.find(file_signal->name);
-        if(element != records.cend()) {
-            ++element->second.amount;
-        }
+    for(auto& it : records) {
+        it.second.amount = universal_index.get_signals_count(it.first.c_str());
     }
 
-    file_parser->close();
-    file_parser.reset();
-
     return true;
 }
 
+void IrdaAppBruteForce::signal_sent_callback(void* context) {
+    IrdaAppBruteForce* brute_force = static_cast<IrdaAppBruteForce*>(context);
+    brute_force->sent_count = brute_force->sent_count + 1;
+}
+
 void IrdaAppBruteForce::stop_bruteforce() {
     furi_assert((current_record.size()));
 
     if(current_record.size()) {
-        furi_assert(file_parser);
         current_record.clear();
-        file_parser->close();
-        file_parser.reset();
+        universal_index.stop();
+        irda_worker_tx_stop(irda_worker);
+        irda_worker = nullptr;
     }
 }
 
-bool IrdaAppBruteForce::send_next_bruteforce(void) {
-    furi_assert(current_record.size());
-    furi_assert(file_parser);
+/* Next signals are read while worker sends previous ones, queue holds
+ * more airtime than tick period, so transmission never waits for us */
+void IrdaAppBruteForce::fill_queue() {
+    while(!all_queued && irda_worker_tx_queue_get_space(irda_worker)) {
+        IrdaAppSignal signal;
+        bool queued = false;
+        if(universal_index.read_signal(signal)) {
+            if(signal.is_raw()) {
+                queued = irda_worker_tx_queue_raw_signal(irda_worker, signal.get_raw_signal(), 0);
+            } else {
+                queued = irda_worker_tx_queue_decoded_signal(irda_worker, &signal.get_message(), 0);
+            }
+        }
 
-    std::unique_ptr<IrdaAppFileParser::IrdaFileSignal> file_signal;
+        if(queued) {
+            ++queued_count;
+        } else {
+            all_queued = true;
+            if(queued_count) {
+                bool finished = irda_worker_tx_queue_finish(irda_worker, 0);
+                furi_check(finished);
+            }
+        }
+    }
+}
 
-    do {
-        file_signal = file_parser->read_signal();
-    } while(file_signal && current_record.compare(file_signal->name));
+bool IrdaAppBruteForce::send_next_bruteforce(void) {
+    furi_assert(current_record.size());
 
-    if(file_signal) {
-        file_signal->signal.transmit();
-    }
-    return !!file_signal;
+    fill_queue();
+    return !all_queued || (sent_count < queued_count);
 }
 
-bool IrdaAppBruteForce::start_bruteforce(int index, int& record_amount) {
+bool IrdaAppBruteForce::start_bruteforce(int index, int& record_amount, IrdaWorker* worker) {
     bool result = false;
     record_amount = 0;
 
@@ -80,11 +84,27 @@ bool IrdaAppBruteForce::start_bruteforce(int index, int& record_amount) {
     }
 
     if(record_amount) {
-        file_parser = std::make_unique<IrdaAppFileParser>();
-        result = file_parser->open_irda_file_read(universal_db_filename);
-        if(!result) {
-            file_parser.reset();
-        }
+        result = universal_index.start(current_record.c_str());
+    }
+
+    if(result) {
+        irda_worker = worker;
+        all_queued = false;
+        queued_count = 0;
+        sent_count = 0;
+        fill_queue();
+        result = (queued_count > 0);
+    }
+
+    if(result) {
+        irda_worker_tx_set_get_signal_callback(
+            irda_worker, irda_worker_tx_get_signal_queue_callback, this);
+        irda_worker_tx_set_signal_sent_callback(irda_worker, signal_sent_callback, this);
+        irda_worker_tx_start(irda_worker);
+    } else {
+        universal_index.stop();
+        current_record.clear();
+        irda_worker = nullptr;
     }
 
     return result;
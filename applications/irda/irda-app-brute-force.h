@@ -1,14 +1,19 @@
 #pragma once
 
-#include "irda-app-file-parser.h"
+#include "irda-app-universal-index.h"
 
+#include <irda_worker.h>
 #include <unordered_map>
 #include <memory>
 
 class IrdaAppBruteForce {
-    const char* universal_db_filename;
+    IrdaAppUniversalIndex universal_index;
     std::string current_record;
-    std::unique_ptr<IrdaAppFileParser> file_parser;
+    IrdaWorker* irda_worker = nullptr;
+    bool all_queued = false;
+    uint32_t queued_count = 0;
+    /* incremented by worker thread */
+    volatile uint32_t sent_count = 0;
 
     typedef struct {
         int index;
@@ -22,15 +27,22 @@ class IrdaAppBruteForce {
     // more critical to have faster search by record name.
     std::unordered_map<std::string, Record> records;
 
+    static void signal_sent_callback(void* context);
+    void fill_queue();
+
 public:
     bool calculate_messages();
     void stop_bruteforce();
+    /* keeps worker TX queue filled, false when all signals are sent */
     bool send_next_bruteforce();
-    bool start_bruteforce(int index, int& record_amount);
+    bool start_bruteforce(int index, int& record_amount, IrdaWorker* worker);
+    uint32_t get_sent_count() const {
+        return sent_count;
+    }
     void add_record(int index, const char* name);
 
     IrdaAppBruteForce(const char* filename)
-        : universal_db_filename(filename) {
+        : universal_index(filename) {
     }
     ~IrdaAppBruteForce() {
     }
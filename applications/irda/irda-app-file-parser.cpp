@@ -10,6 +10,7 @@
 #include <furi.h>
 #include <furi-hal-irda.h>
 #include <file-worker-cpp.h>
+#include <toolbox/hex.h>
 
 bool IrdaAppFileParser::open_irda_file_read(const char* name) {
     std::string full_filename;
@@ -58,7 +59,7 @@ size_t IrdaAppFileParser::stringify_message(
     return written;
 }
 
-size_t IrdaAppFileParser::stringify_raw_signal(
+size_t IrdaAppFileParser::stringify_raw_signal_plain(
     const IrdaAppSignal& signal,
     const char* name,
     char* buf,
@@ -73,13 +74,64 @@ size_t IrdaAppFileParser::stringify_raw_signal(
         IRDA_COMMON_CARRIER_FREQUENCY,
         duty_cycle);
 
-    auto& raw_signal = signal.get_raw_signal();
-    for(size_t i = 0; i < raw_signal.timings_cnt; ++i) {
-        written += sniprintf(&buf[written], buf_size - written, " %ld", raw_signal.timings[i]);
-        if(written > buf_size) {
-            return false;
+    IrdaRawSignalIterator iterator;
+    uint32_t duration;
+    irda_raw_signal_iterator_init(&iterator, signal.get_raw_signal());
+    while(irda_raw_signal_iterator_next(&iterator, &duration)) {
+        written += sniprintf(&buf[written], buf_size - written, " %lu", duration);
+        if(written >= buf_size) {
+            return 0;
+        }
+    }
+    written += snprintf(&buf[written], buf_size - written, "\n");
+
+    furi_assert(written < buf_size);
+    if(written >= buf_size) {
+        written = 0;
+    }
+
+    return written;
+}
+
+/* New raw signals are saved compact, ones read from plain RAW lines stay
+ * plain, so files of older firmware are written back in the same format */
+size_t IrdaAppFileParser::stringify_raw_signal(
+    const IrdaAppSignal& signal,
+    const char* name,
+    char* buf,
+    size_t buf_size) {
+    if(signal.is_raw_plain_format()) {
+        return stringify_raw_signal_plain(signal, name, buf, buf_size);
+    }
+
+    size_t written = 0;
+    int duty_cycle = 100 * IRDA_COMMON_DUTY_CYCLE;
+    written += sniprintf(
+        &buf[written],
+        max_line_length - written,
+        "%.31s RAWC F:%d DC:%d D:",
+        name,
+        IRDA_COMMON_CARRIER_FREQUENCY,
+        duty_cycle);
+
+    size_t dictionary_cnt;
+    size_t stream_size;
+    auto dictionary = irda_raw_signal_get_dictionary(signal.get_raw_signal(), &dictionary_cnt);
+    auto stream = irda_raw_signal_get_stream(signal.get_raw_signal(), &stream_size);
+    for(size_t i = 0; i < dictionary_cnt; ++i) {
+        written +=
+            sniprintf(&buf[written], buf_size - written, i ? ",%u" : "%u", dictionary[i]);
+        if(written >= buf_size) {
+            return 0;
         }
     }
+    written += sniprintf(&buf[written], buf_size - written, " S:");
+    for(size_t i = 0; i < stream_size; ++i) {
+        if(written >= buf_size) {
+            return 0;
+        }
+        written += sniprintf(&buf[written], buf_size - written, "%02X", stream[i]);
+    }
     written += snprintf(&buf[written], buf_size - written, "\n");
 
     furi_assert(written < buf_size);
@@ -108,37 +160,42 @@ bool IrdaAppFileParser::save_signal(const IrdaAppSignal& signal, const char* nam
     return write_result;
 }
 
+IrdaAppFileParser::IrdaAppFileParser() {
+    /* whole line is parsed in place in file worker read buffer */
+    file_worker.set_read_buffer_size(max_line_length);
+}
+
 std::unique_ptr<IrdaAppFileParser::IrdaFileSignal> IrdaAppFileParser::read_signal(void) {
-    string_t line;
-    string_init(line);
-    string_reserve(line, max_line_length);
     std::unique_ptr<IrdaAppFileParser::IrdaFileSignal> file_signal;
+    char* line;
+    size_t line_length;
 
-    while(!file_signal &&
-          file_worker.read_until_buffered(line, file_buf, &file_buf_cnt, sizeof(file_buf))) {
-        if(string_empty_p(line)) {
+    while(!file_signal && file_worker.read_line(&line, &line_length)) {
+        if(!line_length) {
             continue;
         }
-        auto c_str = string_get_cstr(line);
-        file_signal = parse_signal(c_str);
+        std::string_view str(line, line_length);
+        file_signal = parse_signal(str);
         if(!file_signal) {
-            file_signal = parse_signal_raw(c_str);
+            file_signal = parse_signal_raw_compact(str);
+        }
+        if(!file_signal) {
+            file_signal = parse_signal_raw(str);
         }
     }
-    string_clear(line);
 
     return file_signal;
 }
 
 std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
-    IrdaAppFileParser::parse_signal(const std::string& str) const {
+    IrdaAppFileParser::parse_signal(std::string_view str) const {
     char protocol_name[32];
     uint32_t address;
     uint32_t command;
     auto irda_file_signal = std::make_unique<IrdaFileSignal>();
 
     int parsed = std::sscanf(
-        str.c_str(),
+        str.data(),
         "%31s %31s A:%lX C:%lX",
         irda_file_signal->name,
         protocol_name,
@@ -157,7 +214,7 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
             "IrdaFileParser",
             "Unknown protocol(\'%.*s...\'): \'%s\'",
             end_of_str,
-            str.c_str(),
+            str.data(),
             protocol_name);
         return nullptr;
     }
@@ -170,7 +227,7 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
             "IrdaFileParser",
             "Signal(\'%.*s...\'): address is too long (mask for this protocol is 0x%08X): 0x%X",
             end_of_str,
-            str.c_str(),
+            str.data(),
             address_mask,
             address);
         return nullptr;
@@ -184,7 +241,7 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
             "IrdaFileParser",
             "Signal(\'%.*s...\'): command is too long (mask for this protocol is 0x%08X): 0x%X",
             end_of_str,
-            str.c_str(),
+            str.data(),
             command_mask,
             command);
         return nullptr;
@@ -239,31 +296,18 @@ static int remove_args32(std::string_view& str, size_t num) {
     return removed_length;
 }
 
-std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
-    IrdaAppFileParser::parse_signal_raw(const std::string& string) const {
-    uint32_t frequency;
-    uint32_t duty_cycle;
-    std::string_view str(string.c_str());
-    auto irda_file_signal = std::make_unique<IrdaFileSignal>();
-
-    int parsed = std::sscanf(
-        str.data(), "%31s RAW F:%ld DC:%ld", irda_file_signal->name, &frequency, &duty_cycle);
-
-    if(parsed != 3) {
-        return nullptr;
-    }
-
+static bool check_raw_carrier(std::string_view string, uint32_t frequency, uint32_t duty_cycle) {
     if((frequency < IRDA_MIN_FREQUENCY) || (frequency > IRDA_MAX_FREQUENCY)) {
         size_t end_of_str = MIN(string.find_last_not_of(" \t\r\n") + 1, (size_t)30);
         FURI_LOG_E(
             "IrdaFileParser",
             "RAW signal(\'%.*s...\'): frequency is out of bounds (%ld-%ld): %ld",
             end_of_str,
-            string.c_str(),
+            string.data(),
             IRDA_MIN_FREQUENCY,
             IRDA_MAX_FREQUENCY,
             frequency);
-        return nullptr;
+        return false;
     }
 
     if((duty_cycle == 0) || (duty_cycle > 100)) {
@@ -272,8 +316,112 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
             "IrdaFileParser",
             "RAW signal(\'%.*s...\'): duty cycle is out of bounds (0-100): %ld",
             end_of_str,
-            string.c_str(),
+            string.data(),
             duty_cycle);
+        return false;
+    }
+
+    return true;
+}
+
+/* Compact raw signal: dictionary of repeated durations and hex stream,
+ * see irda_raw.h */
+std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
+    IrdaAppFileParser::parse_signal_raw_compact(std::string_view string) const {
+    uint32_t frequency;
+    uint32_t duty_cycle;
+    int header_len = 0;
+    auto irda_file_signal = std::make_unique<IrdaFileSignal>();
+
+    int parsed = std::sscanf(
+        string.data(),
+        "%31s RAWC F:%ld DC:%ld D:%n",
+        irda_file_signal->name,
+        &frequency,
+        &duty_cycle,
+        &header_len);
+
+    if((parsed != 3) || !header_len) {
+        return nullptr;
+    }
+
+    if(!check_raw_carrier(string, frequency, duty_cycle)) {
+        return nullptr;
+    }
+
+    const char* str = string.data() + header_len;
+    uint16_t dictionary[IRDA_RAW_DICTIONARY_SIZE];
+    size_t dictionary_cnt = 0;
+    while((*str >= '0') && (*str <= '9')) {
+        char* end;
+        unsigned long value = strtoul(str, &end, 10);
+        if(!value || (value > UINT16_MAX) || (dictionary_cnt >= COUNT_OF(dictionary))) {
+            FURI_LOG_E(
+                "IrdaFileParser",
+                "RAW signal(\'%.*s...\'): wrong dictionary",
+                header_len,
+                string.data());
+            return nullptr;
+        }
+        dictionary[dictionary_cnt++] = value;
+        str = (*end == ',') ? end + 1 : end;
+    }
+
+    if(strncmp(str, " S:", 3)) {
+        FURI_LOG_E(
+            "IrdaFileParser", "RAW signal(\'%.*s...\'): no stream", header_len, string.data());
+        return nullptr;
+    }
+    str += 3;
+
+    /* every timing takes at most 4 bytes */
+    auto stream = std::make_unique<uint8_t[]>(max_raw_timings_in_signal * 4);
+    size_t stream_size = 0;
+    uint8_t high, low;
+    while(hex_char_to_hex_nibble(str[0], &high) && hex_char_to_hex_nibble(str[1], &low)) {
+        if(stream_size >= max_raw_timings_in_signal * 4) {
+            break;
+        }
+        stream[stream_size++] = (high << 4) | low;
+        str += 2;
+    }
+
+    IrdaRawSignal* raw = nullptr;
+    if(!*str || strchr(" \t\r\n", *str)) {
+        raw = irda_raw_signal_load(dictionary, dictionary_cnt, stream.get(), stream_size);
+    }
+    if(raw && (irda_raw_signal_get_timings_count(raw) > max_raw_timings_in_signal)) {
+        irda_raw_signal_free(raw);
+        raw = nullptr;
+    }
+    if(!raw) {
+        FURI_LOG_E(
+            "IrdaFileParser",
+            "RAW signal(\'%.*s...\'): malformed stream",
+            header_len,
+            string.data());
+        return nullptr;
+    }
+
+    irda_file_signal->signal.set_raw_signal(raw);
+    return irda_file_signal;
+}
+
+std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
+    IrdaAppFileParser::parse_signal_raw(std::string_view string) const {
+    uint32_t frequency;
+    uint32_t duty_cycle;
+    std::string_view str(string);
+    auto irda_file_signal = std::make_unique<IrdaFileSignal>();
+
+    int parsed = std::sscanf(
+        str.data(), "%31s RAW F:%ld DC:%ld", irda_file_signal->name, &frequency, &duty_cycle);
+
+    if(parsed != 3) {
+        return nullptr;
+    }
+
+    if(!check_raw_carrier(string, frequency, duty_cycle)) {
         return nullptr;
     }
 
@@ -284,13 +432,14 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
         str.remove_suffix(str.size() - last_valid_ch - 1);
     } else {
         FURI_LOG_E(
-            "IrdaFileParser", "RAW signal(\'%.*s\'): no timings", header_len, string.c_str());
+            "IrdaFileParser", "RAW signal(\'%.*s\'): no timings", header_len, string.data());
         return nullptr;
     }
 
-    /* move allocated timings into raw signal object */
-    IrdaAppSignal::RawSignal raw_signal = {
-        .timings_cnt = 0, .timings = new uint32_t[max_raw_timings_in_signal]};
+    struct {
+        size_t timings_cnt;
+        uint32_t* timings;
+    } raw_signal = {.timings_cnt = 0, .timings = new uint32_t[max_raw_timings_in_signal]};
     bool result = false;
 
     while(!str.empty()) {
@@ -306,7 +455,7 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
                 "IrdaFileParser",
                 "RAW signal(\'%.*s...\'): failed on timing[%ld] \'%*s\'",
                 header_len,
-                string.c_str(),
+                string.data(),
                 raw_signal.timings_cnt,
                 str.size(),
                 str.data());
@@ -321,7 +470,7 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
                 "IrdaFileParser",
                 "RAW signal(\'%.*s...\'): failed on timing[%ld] \'%s\'",
                 header_len,
-                string.c_str(),
+                string.data(),
                 raw_signal.timings_cnt,
                 buf);
             result = false;
@@ -333,7 +482,7 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
                 "IrdaFileParser",
                 "RAW signal(\'%.*s...\'): too much timings (max %ld)",
                 header_len,
-                string.c_str(),
+                string.data(),
                 max_raw_timings_in_signal);
             result = false;
             break;
@@ -344,8 +493,10 @@ std::unique_ptr<IrdaAppFileParser::IrdaFileSignal>
     }
 
     if(result) {
-        /* copy timings instead of moving them to occupy less than max_raw_timings_in_signal */
+        /* legacy plain timings, stored in memory as compact raw signal,
+         * saved back as plain timings */
         irda_file_signal->signal.copy_raw_signal(raw_signal.timings, raw_signal.timings_cnt);
+        irda_file_signal->signal.set_raw_plain_format(true);
     } else {
         irda_file_signal.reset();
     }
@@ -388,6 +539,10 @@ bool IrdaAppFileParser::check_errors() {
     return file_worker.check_errors();
 }
 
+bool IrdaAppFileParser::get_file_size(uint64_t* size) {
+    return file_worker.size(size);
+}
+
 std::string IrdaAppFileParser::file_select(const char* selected) {
     auto filename_ts = std::make_unique<TextStore>(IrdaAppRemoteManager::max_remote_name_length);
     bool result;
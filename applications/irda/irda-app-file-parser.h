@@ -6,6 +6,7 @@
 #include <file-worker-cpp.h>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <cstdint>
 
 class IrdaAppFileParser {
@@ -15,6 +16,8 @@ public:
         IrdaAppSignal signal;
     } IrdaFileSignal;
 
+    IrdaAppFileParser();
+
     bool open_irda_file_read(const char* filename);
     bool open_irda_file_write(const char* filename);
     bool is_irda_file_exist(const char* filename, bool* exist);
@@ -22,6 +25,7 @@ public:
     bool remove_irda_file(const char* name);
     bool close();
     bool check_errors();
+    bool get_file_size(uint64_t* size);
 
     std::unique_ptr<IrdaAppFileParser::IrdaFileSignal> read_signal();
     bool save_signal(const IrdaAppSignal& signal, const char* name);
@@ -40,8 +44,14 @@ private:
         const char* name,
         char* content,
         size_t content_len);
-    std::unique_ptr<IrdaFileSignal> parse_signal(const std::string& str) const;
-    std::unique_ptr<IrdaFileSignal> parse_signal_raw(const std::string& str) const;
+    size_t stringify_raw_signal_plain(
+        const IrdaAppSignal& signal,
+        const char* name,
+        char* content,
+        size_t content_len);
+    std::unique_ptr<IrdaFileSignal> parse_signal(std::string_view str) const;
+    std::unique_ptr<IrdaFileSignal> parse_signal_raw(std::string_view str) const;
+    std::unique_ptr<IrdaFileSignal> parse_signal_raw_compact(std::string_view str) const;
     std::string make_full_name(const std::string& name) const;
 
     static inline const char* const irda_directory = "/any/irda";
@@ -51,6 +61,4 @@ private:
         (9 + 1) * IrdaAppFileParser::max_raw_timings_in_signal + 100;
 
     FileWorkerCpp file_worker;
-    char file_buf[128];
-    size_t file_buf_cnt = 0;
 };
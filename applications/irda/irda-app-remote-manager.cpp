@@ -5,12 +5,127 @@
 
 #include <irda.h>
 #include <cstdio>
+#include <cstring>
 #include <furi.h>
 #include <gui/modules/button_menu.h>
 #include <storage/storage.h>
 
 static const std::string default_remote_name = "remote";
 
+IrdaAppRemote::IrdaAppRemote(const std::string& name, size_t arena_size)
+    : name(name)
+    , arena_size(arena_size) {
+    if(arena_size) {
+        arena = static_cast<uint8_t*>(furi_alloc(arena_size));
+    }
+}
+
+IrdaAppRemote::~IrdaAppRemote() {
+    free(arena);
+}
+
+/* Raw signal goes first as it has to be aligned, then name. Only size is
+ * calculated if arena is null */
+size_t IrdaAppRemote::pack_button(
+    uint8_t* arena,
+    size_t offset,
+    IrdaAppRemoteButton& button,
+    const char* name,
+    const IrdaAppSignal& signal) {
+    button.decoded = !signal.is_raw();
+    button.raw_plain_format = signal.is_raw_plain_format();
+    if(button.decoded) {
+        button.payload.message = signal.get_message();
+    } else {
+        size_t raw_size = irda_raw_signal_get_size(signal.get_raw_signal());
+        offset = (offset + alignof(uint32_t) - 1) & ~(alignof(uint32_t) - 1);
+        if(arena) memcpy(&arena[offset], signal.get_raw_signal(), raw_size);
+        button.payload.raw = offset;
+        offset += raw_size;
+    }
+
+    size_t name_size = strlen(name) + 1;
+    if(arena) memcpy(&arena[offset], name, name_size);
+    button.name = offset;
+    offset += name_size;
+
+    return offset;
+}
+
+void IrdaAppRemote::add_button(const char* name, const IrdaAppSignal& signal) {
+    IrdaAppRemoteButton button;
+    size_t required = pack_button(nullptr, arena_used, button, name, signal);
+    if(required > arena_size) {
+        uint8_t* new_arena = static_cast<uint8_t*>(furi_alloc(required));
+        if(arena_used) memcpy(new_arena, arena, arena_used);
+        free(arena);
+        arena = new_arena;
+        arena_size = required;
+    }
+    arena_used = pack_button(arena, arena_used, button, name, signal);
+    buttons.push_back(button);
+}
+
+/* Move all buttons to new arena of exact size, leaving behind deleted ones */
+void IrdaAppRemote::repack(size_t renamed_index, const char* new_name) {
+    IrdaAppRemoteButton button;
+    size_t size = 0;
+    for(size_t i = 0; i < buttons.size(); ++i) {
+        const char* name = (i == renamed_index) ? new_name : get_button_name(i);
+        size = pack_button(nullptr, size, button, name, get_button_signal(i));
+    }
+
+    uint8_t* new_arena = size ? static_cast<uint8_t*>(furi_alloc(size)) : nullptr;
+    size_t used = 0;
+    for(size_t i = 0; i < buttons.size(); ++i) {
+        const char* name = (i == renamed_index) ? new_name : get_button_name(i);
+        used = pack_button(new_arena, used, buttons[i], name, get_button_signal(i));
+    }
+
+    free(arena);
+    arena = new_arena;
+    arena_size = size;
+    arena_used = used;
+}
+
+void IrdaAppRemote::delete_button(size_t index) {
+    furi_check(index < buttons.size());
+    buttons.erase(buttons.begin() + index);
+    repack();
+}
+
+void IrdaAppRemote::rename_button(size_t index, const char* name) {
+    furi_check(index < buttons.size());
+    repack(index, name);
+}
+
+void IrdaAppRemote::shrink() {
+    if(arena_used < arena_size) {
+        arena = static_cast<uint8_t*>(realloc(arena, arena_used));
+        arena_size = arena_used;
+    }
+    buttons.shrink_to_fit();
+}
+
+const char* IrdaAppRemote::get_button_name(size_t index) const {
+    furi_check(index < buttons.size());
+    return reinterpret_cast<const char*>(&arena[buttons[index].name]);
+}
+
+IrdaAppSignal IrdaAppRemote::get_button_signal(size_t index) const {
+    furi_check(index < buttons.size());
+    const auto& button = buttons[index];
+    IrdaAppSignal signal;
+    if(button.decoded) {
+        signal.set_message(&button.payload.message);
+    } else {
+        signal.set_raw_signal_view(
+            reinterpret_cast<const IrdaRawSignal*>(&arena[button.payload.raw]));
+        signal.set_raw_plain_format(button.raw_plain_format);
+    }
+    return signal;
+}
+
 std::string IrdaAppRemoteManager::find_vacant_remote_name(const std::string& name) {
     IrdaAppFileParser file_parser;
     bool exist = true;
@@ -30,7 +145,7 @@ std::string IrdaAppRemoteManager::find_vacant_remote_name(const std::string& nam
 }
 
 bool IrdaAppRemoteManager::add_button(const char* button_name, const IrdaAppSignal& signal) {
-    remote->buttons.emplace_back(button_name, signal);
+    remote->add_button(button_name, signal);
     return store();
 }
 
@@ -48,24 +163,9 @@ bool IrdaAppRemoteManager::add_remote_with_button(
     return add_button(button_name, signal);
 }
 
-std::vector<std::string> IrdaAppRemoteManager::get_button_list(void) const {
-    std::vector<std::string> name_vector;
-    name_vector.reserve(remote->buttons.size());
-
-    for(const auto& it : remote->buttons) {
-        name_vector.emplace_back(it.name);
-    }
-
-    // copy elision
-    return name_vector;
-}
-
-const IrdaAppSignal& IrdaAppRemoteManager::get_button_data(size_t index) const {
+IrdaAppSignal IrdaAppRemoteManager::get_button_data(size_t index) const {
     furi_check(remote.get() != nullptr);
-    auto& buttons = remote->buttons;
-    furi_check(index < buttons.size());
-
-    return buttons.at(index).signal;
+    return remote->get_button_signal(index);
 }
 
 bool IrdaAppRemoteManager::delete_remote() {
@@ -83,18 +183,13 @@ void IrdaAppRemoteManager::reset_remote() {
 
 bool IrdaAppRemoteManager::delete_button(uint32_t index) {
     furi_check(remote.get() != nullptr);
-    auto& buttons = remote->buttons;
-    furi_check(index < buttons.size());
-
-    buttons.erase(buttons.begin() + index);
+    remote->delete_button(index);
     return store();
 }
 
-std::string IrdaAppRemoteManager::get_button_name(uint32_t index) {
+const char* IrdaAppRemoteManager::get_button_name(uint32_t index) const {
     furi_check(remote.get() != nullptr);
-    auto& buttons = remote->buttons;
-    furi_check(index < buttons.size());
-    return buttons[index].name.c_str();
+    return remote->get_button_name(index);
 }
 
 std::string IrdaAppRemoteManager::get_remote_name() {
@@ -135,16 +230,13 @@ bool IrdaAppRemoteManager::rename_remote(const char* str) {
 
 bool IrdaAppRemoteManager::rename_button(uint32_t index, const char* str) {
     furi_check(remote.get() != nullptr);
-    auto& buttons = remote->buttons;
-    furi_check(index < buttons.size());
-
-    buttons[index].name = str;
+    remote->rename_button(index, str);
     return store();
 }
 
 size_t IrdaAppRemoteManager::get_number_of_buttons() {
     furi_check(remote.get() != nullptr);
-    return remote->buttons.size();
+    return remote->get_number_of_buttons();
 }
 
 bool IrdaAppRemoteManager::store(void) {
@@ -155,8 +247,9 @@ bool IrdaAppRemoteManager::store(void) {
         return false;
     }
 
-    for(const auto& button : remote->buttons) {
-        bool result = file_parser.save_signal(button.signal, button.name.c_str());
+    for(size_t i = 0; i < remote->get_number_of_buttons(); ++i) {
+        bool result =
+            file_parser.save_signal(remote->get_button_signal(i), remote->get_button_name(i));
         if(!result) {
             result = false;
             break;
@@ -177,16 +270,20 @@ bool IrdaAppRemoteManager::load(const std::string& name) {
         return false;
     }
 
-    remote = std::make_unique<IrdaAppRemote>(name);
+    /* text line is never shorter than name and raw signal packed in arena */
+    uint64_t file_size = 0;
+    file_parser.get_file_size(&file_size);
+    remote = std::make_unique<IrdaAppRemote>(name, file_size);
 
     while(1) {
         auto file_signal = file_parser.read_signal();
         if(!file_signal) {
             break;
         }
-        remote->buttons.emplace_back(file_signal->name, file_signal->signal);
+        remote->add_button(file_signal->name, file_signal->signal);
     }
     file_parser.close();
+    remote->shrink();
 
     return true;
 }
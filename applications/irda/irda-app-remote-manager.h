@@ -11,34 +11,56 @@
 #include <vector>
 
 class IrdaAppRemoteButton {
-    friend class IrdaAppRemoteManager;
-    std::string name;
-    IrdaAppSignal signal;
-
-public:
-    IrdaAppRemoteButton(const char* name, const IrdaAppSignal& signal)
-        : name(name)
-        , signal(signal) {
-    }
-    ~IrdaAppRemoteButton() {
-    }
+    friend class IrdaAppRemote;
+    /* offsets in remote arena */
+    uint32_t name;
+    bool decoded;
+    bool raw_plain_format;
+    union {
+        IrdaMessage message;
+        uint32_t raw;
+    } payload;
 };
 
+/**
+ * All names and raw signals of remote buttons are packed one after
+ * another in one arena, so remote takes the same couple of allocations
+ * regardless of amount of buttons. Button names and signals are views into
+ * arena and stay valid until remote is modified.
+ */
 class IrdaAppRemote {
     friend class IrdaAppRemoteManager;
     std::vector<IrdaAppRemoteButton> buttons;
     std::string name;
+    uint8_t* arena = nullptr;
+    size_t arena_size = 0;
+    size_t arena_used = 0;
+
+    static size_t pack_button(
+        uint8_t* arena,
+        size_t offset,
+        IrdaAppRemoteButton& button,
+        const char* name,
+        const IrdaAppSignal& signal);
+    void repack(size_t renamed_index = SIZE_MAX, const char* new_name = nullptr);
 
 public:
-    IrdaAppRemote(const std::string& name)
-        : name(name) {
-    }
+    IrdaAppRemote(const std::string& name, size_t arena_size = 0);
+    ~IrdaAppRemote();
+    IrdaAppRemote(const IrdaAppRemote&) = delete;
+    IrdaAppRemote& operator=(const IrdaAppRemote&) = delete;
+
+    void add_button(const char* name, const IrdaAppSignal& signal);
+    void delete_button(size_t index);
+    void rename_button(size_t index, const char* name);
+    /* release arena space reserved in advance */
+    void shrink();
 
-    IrdaAppRemote& operator=(std::string& new_name) noexcept {
-        name = new_name;
-        buttons.clear();
-        return *this;
+    size_t get_number_of_buttons() const {
+        return buttons.size();
     }
+    const char* get_button_name(size_t index) const;
+    IrdaAppSignal get_button_signal(size_t index) const;
 };
 
 class IrdaAppRemoteManager {
@@ -57,11 +79,12 @@ public:
     bool rename_remote(const char* str);
     std::string find_vacant_remote_name(const std::string& name);
 
-    std::vector<std::string> get_button_list() const;
-    std::string get_button_name(uint32_t index);
+    /* valid until remote is modified */
+    const char* get_button_name(uint32_t index) const;
     std::string get_remote_name();
     size_t get_number_of_buttons();
-    const IrdaAppSignal& get_button_data(size_t index) const;
+    /* signal is a view into remote, valid until remote is modified */
+    IrdaAppSignal get_button_data(size_t index) const;
     bool delete_button(uint32_t index);
     bool delete_remote();
     void reset_remote();
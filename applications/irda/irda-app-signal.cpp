@@ -1,28 +1,20 @@
 #include "irda-app-signal.h"
 #include <irda_transmit.h>
 
-void IrdaAppSignal::copy_timings(const uint32_t* timings, size_t size) {
-    furi_assert(size);
-    furi_assert(timings);
-
-    payload.raw.timings_cnt = size;
-    if(size) {
-        payload.raw.timings = new uint32_t[size];
-        memcpy(payload.raw.timings, timings, size * sizeof(uint32_t));
-    }
-}
-
 void IrdaAppSignal::clear_timings() {
-    if(!decoded) {
-        delete[] payload.raw.timings;
-        payload.raw.timings_cnt = 0;
-        payload.raw.timings = nullptr;
+    if(!decoded && raw_owned) {
+        irda_raw_signal_free(const_cast<IrdaRawSignal*>(payload.raw));
     }
+    raw_owned = false;
+    raw_plain_format = false;
 }
 
+/* Raw signals are encoded losslessly: they are saved to file, and timings
+ * read from old file have to be written back as they were */
 IrdaAppSignal::IrdaAppSignal(const uint32_t* timings, size_t timings_cnt) {
     decoded = false;
-    copy_timings(timings, timings_cnt);
+    raw_owned = true;
+    payload.raw = irda_raw_signal_encode(timings, timings_cnt, 0);
 }
 
 IrdaAppSignal::IrdaAppSignal(const IrdaMessage* irda_message) {
@@ -30,41 +22,25 @@ IrdaAppSignal::IrdaAppSignal(const IrdaMessage* irda_message) {
     payload.message = *irda_message;
 }
 
-IrdaAppSignal& IrdaAppSignal::operator=(const IrdaAppSignal& other) {
-    clear_timings();
+IrdaAppSignal::IrdaAppSignal(IrdaAppSignal&& other) {
     decoded = other.decoded;
-    if(decoded) {
-        payload.message = other.payload.message;
-    } else {
-        copy_timings(other.payload.raw.timings, other.payload.raw.timings_cnt);
-    }
-
-    return *this;
+    raw_owned = other.raw_owned;
+    raw_plain_format = other.raw_plain_format;
+    payload = other.payload;
+    other.raw_owned = false;
 }
 
-IrdaAppSignal::IrdaAppSignal(const IrdaAppSignal& other) {
-    decoded = other.decoded;
-    if(decoded) {
-        payload.message = other.payload.message;
-    } else {
-        copy_timings(other.payload.raw.timings, other.payload.raw.timings_cnt);
-    }
-}
+IrdaAppSignal& IrdaAppSignal::operator=(IrdaAppSignal&& other) {
+    if(this == &other) return *this;
 
-IrdaAppSignal::IrdaAppSignal(IrdaAppSignal&& other) {
     clear_timings();
-
     decoded = other.decoded;
-    if(decoded) {
-        payload.message = other.payload.message;
-    } else {
-        furi_assert(other.payload.raw.timings_cnt > 0);
+    raw_owned = other.raw_owned;
+    raw_plain_format = other.raw_plain_format;
+    payload = other.payload;
+    other.raw_owned = false;
 
-        payload.raw.timings = other.payload.raw.timings;
-        payload.raw.timings_cnt = other.payload.raw.timings_cnt;
-        other.payload.raw.timings = nullptr;
-        other.payload.raw.timings_cnt = 0;
-    }
+    return *this;
 }
 
 void IrdaAppSignal::set_message(const IrdaMessage* irda_message) {
@@ -73,23 +49,32 @@ void IrdaAppSignal::set_message(const IrdaMessage* irda_message) {
     payload.message = *irda_message;
 }
 
-void IrdaAppSignal::set_raw_signal(uint32_t* timings, size_t timings_cnt) {
+void IrdaAppSignal::set_raw_signal(IrdaRawSignal* raw) {
+    furi_assert(raw);
+    clear_timings();
+    decoded = false;
+    raw_owned = true;
+    payload.raw = raw;
+}
+
+void IrdaAppSignal::set_raw_signal_view(const IrdaRawSignal* raw) {
+    furi_assert(raw);
     clear_timings();
     decoded = false;
-    payload.raw.timings = timings;
-    payload.raw.timings_cnt = timings_cnt;
+    payload.raw = raw;
 }
 
-void IrdaAppSignal::copy_raw_signal(uint32_t* timings, size_t timings_cnt) {
+void IrdaAppSignal::copy_raw_signal(const uint32_t* timings, size_t timings_cnt) {
     clear_timings();
     decoded = false;
-    copy_timings(timings, timings_cnt);
+    raw_owned = true;
+    payload.raw = irda_raw_signal_encode(timings, timings_cnt, 0);
 }
 
 void IrdaAppSignal::transmit() const {
     if(decoded) {
         irda_send(&payload.message, 1);
     } else {
-        irda_send_raw(payload.raw.timings, payload.raw.timings_cnt, true);
+        irda_send_raw_compact(payload.raw, true);
     }
 }
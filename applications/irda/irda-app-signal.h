@@ -1,24 +1,24 @@
 #pragma once
 #include <irda_worker.h>
+#include <irda_raw.h>
 #include <stdint.h>
 #include <string>
 #include <irda.h>
 
 class IrdaAppSignal {
-public:
-    typedef struct {
-        size_t timings_cnt;
-        uint32_t* timings;
-    } RawSignal;
-
 private:
     bool decoded;
+    /* raw signal is freed with signal, otherwise it's a view into storage
+     * of somebody else (i.e. remote arena) */
+    bool raw_owned = false;
+    /* raw signal read from plain RAW line is saved the same way, so file
+     * stays readable by firmware which doesn't know compact RAWC lines */
+    bool raw_plain_format = false;
     union {
         IrdaMessage message;
-        RawSignal raw;
+        const IrdaRawSignal* raw;
     } payload;
 
-    void copy_timings(const uint32_t* timings, size_t size);
     void clear_timings();
 
 public:
@@ -34,14 +34,26 @@ public:
     IrdaAppSignal(const uint32_t* timings, size_t timings_cnt);
     IrdaAppSignal(const IrdaMessage* irda_message);
 
-    IrdaAppSignal(const IrdaAppSignal& other);
+    /* move-only: copying raw signal means allocation */
+    IrdaAppSignal(const IrdaAppSignal& other) = delete;
+    IrdaAppSignal& operator=(const IrdaAppSignal& other) = delete;
     IrdaAppSignal(IrdaAppSignal&& other);
-
-    IrdaAppSignal& operator=(const IrdaAppSignal& signal);
+    IrdaAppSignal& operator=(IrdaAppSignal&& other);
 
     void set_message(const IrdaMessage* irda_message);
-    void set_raw_signal(uint32_t* timings, size_t timings_cnt);
-    void copy_raw_signal(uint32_t* timings, size_t timings_cnt);
+    /* takes ownership of raw signal */
+    void set_raw_signal(IrdaRawSignal* raw);
+    /* raw signal is not copied and has to outlive this signal */
+    void set_raw_signal_view(const IrdaRawSignal* raw);
+    void copy_raw_signal(const uint32_t* timings, size_t timings_cnt);
+    void set_raw_plain_format(bool plain) {
+        furi_assert(!decoded);
+        raw_plain_format = plain;
+    }
+
+    bool is_raw_plain_format(void) const {
+        return !decoded && raw_plain_format;
+    }
 
     void transmit() const;
 
@@ -54,8 +66,12 @@ public:
         return payload.message;
     }
 
-    const RawSignal& get_raw_signal(void) const {
+    const IrdaRawSignal* get_raw_signal(void) const {
         furi_assert(!decoded);
         return payload.raw;
     }
+
+    size_t get_raw_timings_count(void) const {
+        return irda_raw_signal_get_timings_count(get_raw_signal());
+    }
 };
@@ -0,0 +1,240 @@
+#include "irda-app-universal-index.h"
+#include "irda-app-file-parser.h"
+
+#include <cstring>
+#include <memory>
+#include <furi.h>
+#include <irda.h>
+#include <lib/toolbox/md5.h>
+
+IrdaAppUniversalIndex::IrdaAppUniversalIndex(const char* database_filename)
+    : database_filename(database_filename)
+    , index_filename(std::string(database_filename) + ".idx")
+    , file_worker(true) {
+}
+
+bool IrdaAppUniversalIndex::hash_database(uint32_t* size, uint8_t md5[16]) {
+    const uint16_t block_size = 512;
+    uint64_t file_size = 0;
+
+    if(!file_worker.open(database_filename, FSAM_READ, FSOM_OPEN_EXISTING)) return false;
+    bool result = file_worker.size(&file_size) && (file_size <= UINT32_MAX);
+    if(result) {
+        auto block = std::make_unique<uint8_t[]>(block_size);
+        md5_context* md5_ctx = static_cast<md5_context*>(furi_alloc(sizeof(md5_context)));
+        md5_starts(md5_ctx);
+        for(uint64_t left = file_size; result && left;) {
+            uint16_t block_read = MIN(left, block_size);
+            result = file_worker.read(block.get(), block_read);
+            md5_update(md5_ctx, block.get(), block_read);
+            left -= block_read;
+        }
+        md5_finish(md5_ctx, md5);
+        free(md5_ctx);
+        *size = file_size;
+    }
+    file_worker.close();
+
+    return result;
+}
+
+bool IrdaAppUniversalIndex::load_names(uint32_t size, const uint8_t md5[16]) {
+    Header header;
+
+    if(!file_worker.open(index_filename.c_str(), FSAM_READ, FSOM_OPEN_EXISTING)) return false;
+    bool result = file_worker.read(&header, sizeof(header)) && (header.magic == magic) &&
+                  (header.version == version) && (header.source_size == size) &&
+                  !memcmp(header.source_md5, md5, sizeof(header.source_md5));
+    if(result) {
+        names.resize(header.names_cnt);
+        result = file_worker.seek(header.names_offset, true) &&
+                 (!names.size() || file_worker.read(names.data(), names.size() * sizeof(Name)));
+    }
+    file_worker.close();
+
+    if(!result) names.clear();
+    return result;
+}
+
+/* Parse database once and store every signal as entry, remembering
+ * offsets of entries of every button name */
+bool IrdaAppUniversalIndex::build(uint32_t size, const uint8_t md5[16]) {
+    IrdaAppFileParser file_parser;
+    std::vector<Name> build_names;
+    std::vector<std::vector<uint32_t>> build_offsets;
+
+    if(!file_parser.open_irda_file_read(database_filename)) return false;
+    if(!file_worker.open(index_filename.c_str(), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        file_parser.close();
+        return false;
+    }
+
+    Header header = {
+        .magic = magic,
+        .version = version,
+        .names_cnt = 0,
+        .names_offset = 0,
+        .source_size = size,
+        .source_md5 = {0},
+    };
+    /* md5 goes to header once index is complete, so broken index never matches */
+    bool result = file_worker.write(&header, sizeof(header));
+    uint32_t offset = sizeof(header);
+
+    while(result) {
+        auto file_signal = file_parser.read_signal();
+        if(!file_signal) break;
+
+        size_t name_index = 0;
+        while((name_index < build_names.size()) &&
+              strcmp(build_names[name_index].name, file_signal->name)) {
+            ++name_index;
+        }
+        if(name_index == build_names.size()) {
+            Name name = {.name = {0}, .first = 0, .count = 0};
+            strncpy(name.name, file_signal->name, sizeof(name.name) - 1);
+            build_names.push_back(name);
+            build_offsets.emplace_back();
+        }
+        build_offsets[name_index].push_back(offset);
+
+        const auto& signal = file_signal->signal;
+        Entry entry = {.decoded = !signal.is_raw()};
+        if(entry.decoded) {
+            entry.protocol = signal.get_message().protocol;
+            entry.address = signal.get_message().address;
+            entry.command = signal.get_message().command;
+            result = file_worker.write(&entry, sizeof(entry));
+            offset += sizeof(entry);
+        } else {
+            size_t dictionary_cnt;
+            size_t stream_size;
+            auto dictionary =
+                irda_raw_signal_get_dictionary(signal.get_raw_signal(), &dictionary_cnt);
+            auto stream = irda_raw_signal_get_stream(signal.get_raw_signal(), &stream_size);
+            entry.dictionary_cnt = dictionary_cnt;
+            entry.stream_size = stream_size;
+            result = file_worker.write(&entry, sizeof(entry)) &&
+                     (!dictionary_cnt ||
+                      file_worker.write(dictionary, dictionary_cnt * sizeof(uint16_t))) &&
+                     file_worker.write(stream, stream_size);
+            offset += sizeof(entry) + dictionary_cnt * sizeof(uint16_t) + stream_size;
+        }
+    }
+    file_parser.close();
+
+    header.names_cnt = build_names.size();
+    header.names_offset = offset;
+    uint32_t first = 0;
+    for(auto& name : build_names) {
+        name.first = first;
+        name.count = build_offsets[&name - build_names.data()].size();
+        first += name.count;
+    }
+    if(result && build_names.size()) {
+        result = file_worker.write(build_names.data(), build_names.size() * sizeof(Name));
+    }
+    for(const auto& name_offsets : build_offsets) {
+        if(!result) break;
+        result = file_worker.write(name_offsets.data(), name_offsets.size() * sizeof(uint32_t));
+    }
+    if(result) {
+        memcpy(header.source_md5, md5, sizeof(header.source_md5));
+        result = file_worker.seek(0, true) && file_worker.write(&header, sizeof(header));
+    }
+    file_worker.close();
+
+    return result;
+}
+
+bool IrdaAppUniversalIndex::open() {
+    uint32_t size = 0;
+    uint8_t md5[16];
+
+    if(!hash_database(&size, md5)) return false;
+    if(load_names(size, md5)) return true;
+
+    FURI_LOG_I("IrdaUniversalIndex", "Rebuilding %s", index_filename.c_str());
+    return build(size, md5) && load_names(size, md5);
+}
+
+uint32_t IrdaAppUniversalIndex::get_signals_count(const char* name) const {
+    for(const auto& it : names) {
+        if(!strcmp(it.name, name)) return it.count;
+    }
+    return 0;
+}
+
+bool IrdaAppUniversalIndex::start(const char* name) {
+    const Name* found = nullptr;
+    for(const auto& it : names) {
+        if(!strcmp(it.name, name)) {
+            found = &it;
+            break;
+        }
+    }
+    if(!found || !found->count) return false;
+
+    Header header;
+    offsets.resize(found->count);
+    offsets_index = 0;
+    bool result = file_worker.open(index_filename.c_str(), FSAM_READ, FSOM_OPEN_EXISTING) &&
+                  file_worker.read(&header, sizeof(header)) &&
+                  file_worker.seek(
+                      header.names_offset + header.names_cnt * sizeof(Name) +
+                          found->first * sizeof(uint32_t),
+                      true) &&
+                  file_worker.read(offsets.data(), offsets.size() * sizeof(uint32_t));
+    if(!result) {
+        stop();
+    }
+
+    return result;
+}
+
+bool IrdaAppUniversalIndex::read_signal(IrdaAppSignal& signal) {
+    Entry entry;
+
+    if(offsets_index >= offsets.size()) return false;
+    if(!file_worker.seek(offsets[offsets_index++], true) ||
+       !file_worker.read(&entry, sizeof(entry))) {
+        return false;
+    }
+
+    if(entry.decoded) {
+        IrdaMessage message = {
+            .protocol = static_cast<IrdaProtocol>(entry.protocol),
+            .address = entry.address,
+            .command = entry.command,
+            .repeat = false,
+        };
+        if(!irda_is_protocol_valid(message.protocol)) return false;
+        signal.set_message(&message);
+        return true;
+    }
+
+    size_t dictionary_size = entry.dictionary_cnt * sizeof(uint16_t);
+    raw_buffer.resize(dictionary_size + entry.stream_size);
+    if(!entry.stream_size || !file_worker.read(raw_buffer.data(), raw_buffer.size())) {
+        return false;
+    }
+
+    uint16_t dictionary[IRDA_RAW_DICTIONARY_SIZE];
+    if(entry.dictionary_cnt > COUNT_OF(dictionary)) return false;
+    memcpy(dictionary, raw_buffer.data(), dictionary_size);
+    IrdaRawSignal* raw = irda_raw_signal_load(
+        dictionary, entry.dictionary_cnt, &raw_buffer[dictionary_size], entry.stream_size);
+    if(!raw) return false;
+
+    signal.set_raw_signal(raw);
+    return true;
+}
+
+void IrdaAppUniversalIndex::stop() {
+    file_worker.close();
+    offsets.clear();
+    offsets.shrink_to_fit();
+    raw_buffer.clear();
+    raw_buffer.shrink_to_fit();
+    offsets_index = 0;
+}
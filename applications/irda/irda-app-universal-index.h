@@ -0,0 +1,76 @@
+#pragma once
+
+#include "irda-app-signal.h"
+
+#include <file-worker-cpp.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Binary index of universal remote database: signals are pre-parsed and
+ * grouped by button name, so brute force reads only signals of pressed
+ * button and does no text parsing between transmissions.
+ *
+ * Index is stored next to database ("<database>.idx") and is rebuilt when
+ * size or md5 of database doesn't match the one index was built from.
+ *
+ * Layout: header, entries in database order, names table, then offsets of
+ * entries of every name, referenced by names table.
+ */
+class IrdaAppUniversalIndex {
+public:
+    typedef struct {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t names_cnt;
+        uint32_t names_offset;
+        uint32_t source_size;
+        uint8_t source_md5[16];
+    } Header;
+
+    typedef struct {
+        char name[32];
+        uint32_t first;
+        uint32_t count;
+    } Name;
+
+    /* raw signal entry is followed by dictionary and stream */
+    typedef struct {
+        uint8_t decoded;
+        uint8_t dictionary_cnt;
+        uint16_t stream_size;
+        uint32_t protocol;
+        uint32_t address;
+        uint32_t command;
+    } Entry;
+
+    static inline const uint32_t magic = 0x58445249; /* "IRDX" */
+    static inline const uint16_t version = 1;
+
+    IrdaAppUniversalIndex(const char* database_filename);
+
+    /* Check index against database, rebuild it if needed, load names */
+    bool open();
+    /* amount of signals of button, 0 if there are none */
+    uint32_t get_signals_count(const char* name) const;
+
+    /* Start reading signals of button */
+    bool start(const char* name);
+    /* Next signal of button, false if there are no more */
+    bool read_signal(IrdaAppSignal& signal);
+    void stop();
+
+private:
+    bool hash_database(uint32_t* size, uint8_t md5[16]);
+    bool load_names(uint32_t size, const uint8_t md5[16]);
+    bool build(uint32_t size, const uint8_t md5[16]);
+
+    const char* database_filename;
+    std::string index_filename;
+    FileWorkerCpp file_worker;
+    std::vector<Name> names;
+    std::vector<uint32_t> offsets;
+    size_t offsets_index = 0;
+    std::vector<uint8_t> raw_buffer;
+};
@@ -281,6 +281,6 @@ const IrdaAppSignal& IrdaApp::get_received_signal() const {
     return received_signal;
 }
 
-void IrdaApp::set_received_signal(const IrdaAppSignal& signal) {
-    received_signal = signal;
+void IrdaApp::set_received_signal(IrdaAppSignal&& signal) {
+    received_signal = std::move(signal);
 }
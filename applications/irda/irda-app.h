@@ -56,7 +56,7 @@ public:
 
     IrdaWorker* get_irda_worker();
     const IrdaAppSignal& get_received_signal() const;
-    void set_received_signal(const IrdaAppSignal& signal);
+    void set_received_signal(IrdaAppSignal&& signal);
 
     void search_and_switch_to_previous_scene(const std::initializer_list<Scene>& scenes_list);
 
@@ -27,7 +27,7 @@ void IrdaAppSceneEditDelete::on_enter(IrdaApp* app) {
             app->set_text_store(
                 0,
                 "%s\n%s\nA=0x%0*lX C=0x%0*lX",
-                remote_manager->get_button_name(app->get_current_button()).c_str(),
+                remote_manager->get_button_name(app->get_current_button()),
                 irda_get_protocol_name(message->protocol),
                 ROUND_UP_TO(irda_get_protocol_address_length(message->protocol), 4),
                 message->address,
@@ -37,8 +37,8 @@ void IrdaAppSceneEditDelete::on_enter(IrdaApp* app) {
             app->set_text_store(
                 0,
                 "%s\nRAW\n%ld samples",
-                remote_manager->get_button_name(app->get_current_button()).c_str(),
-                signal.get_raw_signal().timings_cnt);
+                remote_manager->get_button_name(app->get_current_button()),
+                signal.get_raw_timings_count());
         }
     } else {
         dialog_ex_set_header(dialog_ex, "Delete remote?", 64, 6, AlignCenter, AlignCenter);
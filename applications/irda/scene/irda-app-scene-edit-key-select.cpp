@@ -21,9 +21,9 @@ void IrdaAppSceneEditKeySelect::on_enter(IrdaApp* app) {
     submenu_set_header(submenu, header);
 
     auto remote_manager = app->get_remote_manager();
-    buttons_names = remote_manager->get_button_list();
-    for(const auto& it : buttons_names) {
-        submenu_add_item(submenu, it.c_str(), item_number++, submenu_callback, app);
+    for(size_t i = 0; i < remote_manager->get_number_of_buttons(); ++i) {
+        submenu_add_item(
+            submenu, remote_manager->get_button_name(i), item_number++, submenu_callback, app);
     }
     if((item_number > 0) && (app->get_current_button() != IrdaApp::ButtonNA)) {
         submenu_set_selected_item(submenu, app->get_current_button());
@@ -11,7 +11,7 @@ void IrdaAppSceneEditRename::on_enter(IrdaApp* app) {
         auto button_name = remote_manager->get_button_name(app->get_current_button());
         char* buffer_str = app->get_text_store(0);
         size_t max_len = IrdaAppRemoteManager::max_button_name_length;
-        strncpy(buffer_str, button_name.c_str(), max_len);
+        strncpy(buffer_str, button_name, max_len);
         buffer_str[max_len + 1] = 0;
         enter_name_length = max_len;
         text_input_set_header_text(text_input, "Name the key");
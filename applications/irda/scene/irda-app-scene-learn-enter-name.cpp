@@ -5,7 +5,7 @@ void IrdaAppSceneLearnEnterName::on_enter(IrdaApp* app) {
     IrdaAppViewManager* view_manager = app->get_view_manager();
     TextInput* text_input = view_manager->get_text_input();
 
-    auto signal = app->get_received_signal();
+    const auto& signal = app->get_received_signal();
 
     if(!signal.is_raw()) {
         auto message = &signal.get_message();
@@ -16,8 +16,7 @@ void IrdaAppSceneLearnEnterName::on_enter(IrdaApp* app) {
             ROUND_UP_TO(irda_get_protocol_command_length(message->protocol), 4),
             message->command);
     } else {
-        auto raw_signal = signal.get_raw_signal();
-        app->set_text_store(0, "RAW_%d", raw_signal.timings_cnt);
+        app->set_text_store(0, "RAW_%d", signal.get_raw_timings_count());
     }
 
     text_input_set_header_text(text_input, "Name the key");
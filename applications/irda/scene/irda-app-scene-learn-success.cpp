@@ -19,7 +19,7 @@ void IrdaAppSceneLearnSuccess::on_enter(IrdaApp* app) {
 
     app->notify_green_on();
 
-    auto signal = app->get_received_signal();
+    const auto& signal = app->get_received_signal();
 
     if(!signal.is_raw()) {
         auto message = &signal.get_message();
@@ -35,7 +35,7 @@ void IrdaAppSceneLearnSuccess::on_enter(IrdaApp* app) {
         dialog_ex_set_text(dialog_ex, app->get_text_store(1), 75, 23, AlignLeft, AlignTop);
     } else {
         dialog_ex_set_header(dialog_ex, "Unknown", 95, 10, AlignCenter, AlignCenter);
-        app->set_text_store(0, "%d samples", signal.get_raw_signal().timings_cnt);
+        app->set_text_store(0, "%d samples", signal.get_raw_timings_count());
         dialog_ex_set_text(dialog_ex, app->get_text_store(0), 75, 23, AlignLeft, AlignTop);
     }
 
@@ -63,7 +63,7 @@ bool IrdaAppSceneLearnSuccess::on_event(IrdaApp* app, IrdaAppEvent* event) {
             break;
         case DialogExResultCenter: {
             app->notify_space_blink();
-            auto signal = app->get_received_signal();
+            const auto& signal = app->get_received_signal();
             signal.transmit();
             break;
         }
@@ -10,13 +10,13 @@ static void signal_received_callback(void* context, IrdaWorkerSignal* received_s
 
     if(irda_worker_signal_is_decoded(received_signal)) {
         IrdaAppSignal signal(irda_worker_get_decoded_signal(received_signal));
-        app->set_received_signal(signal);
+        app->set_received_signal(std::move(signal));
     } else {
         const uint32_t* timings;
         size_t timings_cnt;
         irda_worker_get_raw_signal(received_signal, &timings, &timings_cnt);
         IrdaAppSignal signal(timings, timings_cnt);
-        app->set_received_signal(signal);
+        app->set_received_signal(std::move(signal));
     }
 
     irda_worker_rx_set_received_signal_callback(app->get_irda_worker(), NULL, NULL);
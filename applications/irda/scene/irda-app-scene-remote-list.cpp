@@ -1,5 +1,6 @@
 #include "../irda-app.h"
 #include "irda/irda-app-event.h"
+#include "../irda-app-file-parser.h"
 
 void IrdaAppSceneRemoteList::on_enter(IrdaApp* app) {
     IrdaAppFileParser file_parser;
@@ -37,19 +37,22 @@ void IrdaAppSceneRemote::on_enter(IrdaApp* app) {
     IrdaAppViewManager* view_manager = app->get_view_manager();
     ButtonMenu* button_menu = view_manager->get_button_menu();
     auto remote_manager = app->get_remote_manager();
-    int i = 0;
     button_pressed = false;
 
     irda_worker_tx_set_get_signal_callback(
         app->get_irda_worker(), irda_worker_tx_get_signal_steady_callback, app);
     irda_worker_tx_set_signal_sent_callback(
         app->get_irda_worker(), irda_app_message_sent_callback, app);
-    buttons_names = remote_manager->get_button_list();
 
-    i = 0;
-    for(auto& name : buttons_names) {
+    /* names live in remote, which is not modified while menu is shown */
+    for(size_t i = 0; i < remote_manager->get_number_of_buttons(); ++i) {
         button_menu_add_item(
-            button_menu, name.c_str(), i++, button_menu_callback, ButtonMenuItemTypeCommon, app);
+            button_menu,
+            remote_manager->get_button_name(i),
+            i,
+            button_menu_callback,
+            ButtonMenuItemTypeCommon,
+            app);
     }
 
     button_menu_add_item(
@@ -97,10 +100,8 @@ bool IrdaAppSceneRemote::on_event(IrdaApp* app, IrdaAppEvent* event) {
                 auto button_signal =
                     app->get_remote_manager()->get_button_data(event->payload.menu_index);
                 if(button_signal.is_raw()) {
-                    irda_worker_set_raw_signal(
-                        app->get_irda_worker(),
-                        button_signal.get_raw_signal().timings,
-                        button_signal.get_raw_signal().timings_cnt);
+                    irda_worker_set_raw_signal_compact(
+                        app->get_irda_worker(), button_signal.get_raw_signal());
                 } else {
                     irda_worker_set_decoded_signal(
                         app->get_irda_worker(), &button_signal.get_message());
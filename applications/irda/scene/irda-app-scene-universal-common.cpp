@@ -49,11 +49,10 @@ void IrdaAppSceneUniversalCommon::show_popup(IrdaApp* app, int record_amount) {
     button_panel_set_popup_input_callback(button_panel, irda_popup_brut_input_callback, app);
 }
 
-bool IrdaAppSceneUniversalCommon::progress_popup(IrdaApp* app) {
-    bool result = popup_brut_increase_progress(app->get_view_manager()->get_popup_brut());
+void IrdaAppSceneUniversalCommon::progress_popup(IrdaApp* app, uint16_t progress) {
+    popup_brut_set_progress(app->get_view_manager()->get_popup_brut(), progress);
     auto button_panel = app->get_view_manager()->get_button_panel();
     with_view_model_cpp(button_panel_get_view(button_panel), void*, model, { return true; });
-    return result;
 }
 
 bool IrdaAppSceneUniversalCommon::on_event(IrdaApp* app, IrdaAppEvent* event) {
@@ -61,13 +60,9 @@ bool IrdaAppSceneUniversalCommon::on_event(IrdaApp* app, IrdaAppEvent* event) {
 
     if(brute_force_started) {
         if(event->type == IrdaAppEvent::Type::Tick) {
-            auto view_manager = app->get_view_manager();
-            IrdaAppEvent tick_event = {.type = IrdaAppEvent::Type::Tick};
-            view_manager->send_event(&tick_event);
+            /* worker sends in background, tick only tops up its queue */
             bool result = brute_force.send_next_bruteforce();
-            if(result) {
-                result = progress_popup(app);
-            }
+            progress_popup(app, brute_force.get_sent_count());
             if(!result) {
                 brute_force.stop_bruteforce();
                 brute_force_started = false;
@@ -83,7 +78,8 @@ bool IrdaAppSceneUniversalCommon::on_event(IrdaApp* app, IrdaAppEvent* event) {
     } else {
         if(event->type == IrdaAppEvent::Type::ButtonPanelPressed) {
             int record_amount = 0;
-            if(brute_force.start_bruteforce(event->payload.menu_index, record_amount)) {
+            if(brute_force.start_bruteforce(
+                   event->payload.menu_index, record_amount, app->get_irda_worker())) {
                 brute_force_started = true;
                 show_popup(app, record_amount);
             } else {
@@ -73,7 +73,6 @@ public:
     void on_exit(IrdaApp* app) final;
 
 private:
-    std::vector<std::string> buttons_names;
     uint32_t buttonmenu_item_selected = 0;
     bool button_pressed = false;
 };
@@ -104,9 +103,6 @@ public:
     void on_enter(IrdaApp* app) final;
     bool on_event(IrdaApp* app, IrdaAppEvent* event) final;
     void on_exit(IrdaApp* app) final;
-
-private:
-    std::vector<std::string> buttons_names;
 };
 
 class IrdaAppSceneEditRename : public IrdaAppScene {
@@ -146,7 +142,7 @@ protected:
     IrdaAppBruteForce brute_force;
     void remove_popup(IrdaApp* app);
     void show_popup(IrdaApp* app, int record_amount);
-    bool progress_popup(IrdaApp* app);
+    void progress_popup(IrdaApp* app, uint16_t progress);
     static void irda_app_item_callback(void* context, uint32_t index);
     IrdaAppSceneUniversalCommon(const char* filename)
         : brute_force(filename) {
@@ -26,6 +26,11 @@ bool popup_brut_increase_progress(IrdaAppPopupBrut* popup_brut) {
     return popup_brut->progress < popup_brut->progress_max;
 }
 
+void popup_brut_set_progress(IrdaAppPopupBrut* popup_brut, uint16_t progress) {
+    furi_assert(popup_brut);
+    popup_brut->progress = MIN(progress, popup_brut->progress_max);
+}
+
 void popup_brut_draw_callback(Canvas* canvas, void* context) {
     furi_assert(canvas);
     furi_assert(context);
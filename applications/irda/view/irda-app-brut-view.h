@@ -8,6 +8,7 @@ extern "C" {
 typedef struct IrdaAppPopupBrut IrdaAppPopupBrut;
 
 bool popup_brut_increase_progress(IrdaAppPopupBrut* popup_brut);
+void popup_brut_set_progress(IrdaAppPopupBrut* popup_brut, uint16_t progress);
 IrdaAppPopupBrut* popup_brut_alloc();
 void popup_brut_free(IrdaAppPopupBrut* popup_brut);
 void popup_brut_draw_callback(Canvas* canvas, void* model);
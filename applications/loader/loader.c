@@ -117,14 +117,14 @@ static void loader_thread_state_callback(FuriThreadState thread_state, void* con
         instance->free_heap_size = xPortGetFreeHeapSize();
     } else if(thread_state == FuriThreadStateStopped) {
         /*
-         * Current Leak Sanitizer assumes that memory is allocated and freed
-         * inside one thread. Timers are allocated in one task, but freed in
-         * Timer-Task thread, and xTimerDelete() just put command to queue.
-         * To avoid some bad cases there are few fixes:
+         * Leak Sanitizer forgets allocation whatever thread frees it, but
+         * timers are freed by Timer-Task thread and xTimerDelete() just puts
+         * command to queue. To avoid some bad cases there are few fixes:
          * 1) delay for Timer to process commands
          * 2) there are 'heap diff' which shows difference in heap before task
          * started and after task completed. In process of leakage monitoring
-         * both values should be taken into account.
+         * both values should be taken into account. 'heap_trace' CLI command
+         * shows where leftovers were allocated until they are freed.
          */
         delay(20);
         int heap_diff = instance->free_heap_size - xPortGetFreeHeapSize();
@@ -133,6 +133,13 @@ static void loader_thread_state_callback(FuriThreadState thread_state, void* con
             "Application thread stopped. Heap allocation balance: %d. Thread allocation balance: %d.",
             heap_diff,
             furi_thread_get_heap_size(instance->thread));
+        size_t heap_dropped = furi_thread_get_heap_dropped(instance->thread);
+        if(heap_dropped) {
+            FURI_LOG_W(
+                LOADER_LOG_TAG,
+                "Heap trace was full, %u allocations are missing from thread balance",
+                heap_dropped);
+        }
         furi_hal_power_insomnia_exit();
         loader_unlock(instance);
     }
@@ -48,6 +48,18 @@ typedef struct {
     uint64_t size; /**< file size */
 } FileInfo;
 
+/**  Buffer of vectored read */
+typedef struct {
+    void* buff; /**< pointer to data */
+    size_t size; /**< data size */
+} FileIoVec;
+
+/**  Buffer of vectored write, data is not changed */
+typedef struct {
+    const void* buff; /**< pointer to data */
+    size_t size; /**< data size */
+} FileIoConstVec;
+
 /** Gets the error text from FS_Error
  * @param error_id error id
  * @return const char* error text
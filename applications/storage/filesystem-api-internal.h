@@ -12,6 +12,7 @@ struct File {
     FS_Error error_id; /**< Standart API error from FS_Error enum */
     int32_t internal_error_id; /**< Internal API error value */
     void* storage;
+    void* storage_data; /**< StorageData file is opened on, NULL if closed */
 };
 
 /** File api structure
@@ -73,6 +74,20 @@ struct File {
  *      @brief Checks that the r/w pointer is at the end of the file
  *      @param file pointer to file object
  *      @return end of file flag
+ * 
+ *  @var FS_File_Api::read_v
+ *      @brief Read bytes from file to buffers, one buffer after another
+ *      @param file pointer to file object
+ *      @param iov array of buffers
+ *      @param iov_count buffers count
+ *      @return how many bytes actually has been readed
+ * 
+ *  @var FS_File_Api::write_v
+ *      @brief Write bytes from buffers to file, one buffer after another
+ *      @param file pointer to file object
+ *      @param iov array of buffers
+ *      @param iov_count buffers count
+ *      @return how many bytes actually has been writed
  */
 typedef struct {
     bool (*open)(
@@ -90,6 +105,8 @@ typedef struct {
     uint64_t (*size)(void* context, File* file);
     bool (*sync)(void* context, File* file);
     bool (*eof)(void* context, File* file);
+    size_t (*read_v)(void* context, File* file, const FileIoVec* iov, size_t iov_count);
+    size_t (*write_v)(void* context, File* file, const FileIoConstVec* iov, size_t iov_count);
 } FS_File_Api;
 
 /** Dir api structure
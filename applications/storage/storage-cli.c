@@ -2,12 +2,35 @@
 #include <cli/cli.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/md5.h>
+#include <lib/toolbox/crc32.h>
 #include <storage/storage.h>
 #include <storage/storage-sd-api.h>
 #include <furi-hal-version.h>
 
 #define MAX_NAME_LENGTH 255
 
+/* Binary stream transfer, used by scripts/flipper/storage.py.
+ * Packet is StorageCliStreamHeader, header.length bytes of payload and CRC-32
+ * of header and payload. Packet without payload ends stream. Receiver answers
+ * every packet with {ACK or NAK, seq}, sender keeps up to window packets
+ * without answer. NAK aborts transfer. */
+#define STORAGE_CLI_STREAM_MAGIC 0xA5
+#define STORAGE_CLI_STREAM_ACK 0x06
+#define STORAGE_CLI_STREAM_NAK 0x15
+#define STORAGE_CLI_STREAM_PAYLOAD_SIZE 512
+#define STORAGE_CLI_STREAM_WINDOW 4
+#define STORAGE_CLI_STREAM_TIMEOUT 2000
+#define STORAGE_CLI_STREAM_DRAIN_TIMEOUT 100
+
+typedef struct {
+    uint8_t magic;
+    uint8_t seq;
+    uint16_t length;
+} __attribute__((packed)) StorageCliStreamHeader;
+
+#define STORAGE_CLI_STREAM_PACKET_SIZE \
+    (sizeof(StorageCliStreamHeader) + STORAGE_CLI_STREAM_PAYLOAD_SIZE + sizeof(uint32_t))
+
 void storage_cli(Cli* cli, string_t args, void* context);
 
 // app cli function
@@ -32,6 +55,8 @@ void storage_cli_print_usage() {
     printf("\twrite\t - read text from cli and append it to file, stops by ctrl+c\r\n");
     printf(
         "\twrite_chunk\t - read data from cli and append it to file, <args> should contain how many bytes you want to write\r\n");
+    printf("\tread_stream\t - send file to cli by binary packets, for scripts\r\n");
+    printf("\twrite_stream\t - receive file from cli by binary packets, for scripts\r\n");
     printf("\tcopy\t - copy file to new file, <args> must contain new path\r\n");
     printf("\trename\t - move file to new file, <args> must contain new path\r\n");
     printf("\tmkdir\t - creates a new directory\r\n");
@@ -301,6 +326,148 @@ void storage_cli_write_chunk(Cli* cli, string_t path, string_t args) {
     furi_record_close("storage");
 }
 
+static bool storage_cli_stream_receive(Cli* cli, uint8_t* buffer, size_t size) {
+    while(size > 0) {
+        size_t received = cli_read_timeout(cli, buffer, size, STORAGE_CLI_STREAM_TIMEOUT);
+        if(received == 0) return false;
+        buffer += received;
+        size -= received;
+    }
+
+    return true;
+}
+
+static void storage_cli_stream_answer(Cli* cli, uint8_t answer, uint8_t seq) {
+    uint8_t data[2] = {answer, seq};
+    cli_write(cli, data, sizeof(data));
+}
+
+// skip packets sent before transfer was aborted, so cli doesn't take them for commands
+static void storage_cli_stream_drain(Cli* cli) {
+    uint8_t data[64];
+    while(cli_read_timeout(cli, data, sizeof(data), STORAGE_CLI_STREAM_DRAIN_TIMEOUT) > 0) {
+    }
+}
+
+void storage_cli_read_stream(Cli* cli, string_t path) {
+    Storage* api = furi_record_open("storage");
+    File* file = storage_file_alloc(api);
+
+    if(storage_file_open(file, string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+        uint8_t* packet = furi_alloc(STORAGE_CLI_STREAM_PACKET_SIZE);
+        StorageCliStreamHeader* header = (StorageCliStreamHeader*)packet;
+        uint8_t* payload = packet + sizeof(StorageCliStreamHeader);
+        uint8_t seq = 0;
+        uint8_t unanswered = 0;
+        bool result = true;
+
+        printf("Size: %lu\r\n", (uint32_t)storage_file_size(file));
+
+        do {
+            header->magic = STORAGE_CLI_STREAM_MAGIC;
+            header->seq = seq++;
+            header->length = storage_file_read(file, payload, STORAGE_CLI_STREAM_PAYLOAD_SIZE);
+            uint32_t crc =
+                crc32_calc_buffer(0, packet, sizeof(StorageCliStreamHeader) + header->length);
+            memcpy(payload + header->length, &crc, sizeof(crc));
+            cli_write(cli, packet, sizeof(StorageCliStreamHeader) + header->length + sizeof(crc));
+            unanswered++;
+
+            // wait for answer when window is full, and for all of them at the end
+            while(result && ((unanswered == STORAGE_CLI_STREAM_WINDOW) ||
+                             (header->length == 0 && unanswered > 0))) {
+                uint8_t answer[2];
+                result = storage_cli_stream_receive(cli, answer, sizeof(answer)) &&
+                         (answer[0] == STORAGE_CLI_STREAM_ACK) &&
+                         (answer[1] == (uint8_t)(seq - unanswered));
+                unanswered--;
+            }
+        } while(result && header->length > 0);
+
+        if(!result) {
+            storage_cli_stream_drain(cli);
+        } else if(storage_file_get_error(file) != FSE_OK) {
+            storage_cli_print_error(storage_file_get_error(file));
+        }
+
+        free(packet);
+    } else {
+        storage_cli_print_error(storage_file_get_error(file));
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    furi_record_close("storage");
+}
+
+void storage_cli_write_stream(Cli* cli, string_t path) {
+    Storage* api = furi_record_open("storage");
+    File* file = storage_file_alloc(api);
+
+    if(storage_file_open(file, string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        uint8_t* packet = furi_alloc(STORAGE_CLI_STREAM_PACKET_SIZE);
+        StorageCliStreamHeader* header = (StorageCliStreamHeader*)packet;
+        uint8_t* payload = packet + sizeof(StorageCliStreamHeader);
+        uint8_t seq = 0;
+        const char* error = NULL;
+
+        printf("Ready: %u %u\r\n", STORAGE_CLI_STREAM_PAYLOAD_SIZE, STORAGE_CLI_STREAM_WINDOW);
+
+        while(true) {
+            uint32_t crc;
+            if(!storage_cli_stream_receive(cli, packet, sizeof(StorageCliStreamHeader)) ||
+               (header->magic != STORAGE_CLI_STREAM_MAGIC) ||
+               (header->length > STORAGE_CLI_STREAM_PAYLOAD_SIZE) ||
+               !storage_cli_stream_receive(cli, payload, header->length + sizeof(crc))) {
+                error = "broken packet";
+                break;
+            }
+
+            memcpy(&crc, payload + header->length, sizeof(crc));
+            if((header->seq != seq) ||
+               (crc != crc32_calc_buffer(
+                           0, packet, sizeof(StorageCliStreamHeader) + header->length))) {
+                error = "packet CRC or sequence mismatch";
+                break;
+            }
+
+            if(header->length == 0) {
+                storage_cli_stream_answer(cli, STORAGE_CLI_STREAM_ACK, seq);
+                break;
+            }
+
+            if(storage_file_write(file, payload, header->length) != header->length) {
+                // short write without error means no space left
+                if(storage_file_get_error(file) == FSE_OK) error = "short write, storage is full";
+                break;
+            }
+
+            storage_cli_stream_answer(cli, STORAGE_CLI_STREAM_ACK, seq);
+            seq++;
+        }
+
+        if(error || storage_file_get_error(file) != FSE_OK) {
+            storage_cli_stream_answer(cli, STORAGE_CLI_STREAM_NAK, seq);
+            storage_cli_stream_drain(cli);
+            if(error) {
+                printf("Stream error: %s\r\n", error);
+            } else {
+                storage_cli_print_error(storage_file_get_error(file));
+            }
+        }
+
+        free(packet);
+    } else {
+        storage_cli_print_error(storage_file_get_error(file));
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+
+    furi_record_close("storage");
+}
+
 void storage_cli_stat(Cli* cli, string_t path) {
     Storage* api = furi_record_open("storage");
 
@@ -491,6 +658,16 @@ void storage_cli(Cli* cli, string_t args, void* context) {
             break;
         }
 
+        if(string_cmp_str(cmd, "read_stream") == 0) {
+            storage_cli_read_stream(cli, path);
+            break;
+        }
+
+        if(string_cmp_str(cmd, "write_stream") == 0) {
+            storage_cli_write_stream(cli, path);
+            break;
+        }
+
         if(string_cmp_str(cmd, "copy") == 0) {
             storage_cli_copy(cli, path, args);
             break;
@@ -1,6 +1,7 @@
 #include "storage.h"
 #include "storage-i.h"
 #include "storage-message.h"
+#include "storage-processing.h"
 
 #define S_API_PROLOGUE                                      \
     osSemaphoreId_t semaphore = osSemaphoreNew(1, 0, NULL); \
@@ -46,6 +47,8 @@
 #define FILE_CLOSED 0
 
 /****************** FILE ******************/
+/* Open, close and sync go through storage service, other functions of opened
+ * file are called directly, under lock of storage file belongs to. */
 
 bool storage_file_open(
     File* file,
@@ -86,77 +89,42 @@ bool storage_file_close(File* file) {
 
 uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
-
-    SAData data = {
-        .fread = {
-            .file = file,
-            .buff = buff,
-            .bytes_to_read = bytes_to_read,
-        }};
-
-    S_API_MESSAGE(StorageCommandFileRead);
-    S_API_EPILOGUE;
-    return S_RETURN_UINT16;
+    return storage_process_file_read(storage, file, buff, bytes_to_read);
 }
 
 uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
+    return storage_process_file_write(storage, file, buff, bytes_to_write);
+}
 
-    SAData data = {
-        .fwrite = {
-            .file = file,
-            .buff = buff,
-            .bytes_to_write = bytes_to_write,
-        }};
+size_t storage_file_read_v(File* file, const FileIoVec* iov, size_t iov_count) {
+    S_FILE_API_PROLOGUE;
+    return storage_process_file_read_v(storage, file, iov, iov_count);
+}
 
-    S_API_MESSAGE(StorageCommandFileWrite);
-    S_API_EPILOGUE;
-    return S_RETURN_UINT16;
+size_t storage_file_write_v(File* file, const FileIoConstVec* iov, size_t iov_count) {
+    S_FILE_API_PROLOGUE;
+    return storage_process_file_write_v(storage, file, iov, iov_count);
 }
 
 bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
-
-    SAData data = {
-        .fseek = {
-            .file = file,
-            .offset = offset,
-            .from_start = from_start,
-        }};
-
-    S_API_MESSAGE(StorageCommandFileSeek);
-    S_API_EPILOGUE;
-    return S_RETURN_BOOL;
+    return storage_process_file_seek(storage, file, offset, from_start);
 }
 
 uint64_t storage_file_tell(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
-    S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileTell);
-    S_API_EPILOGUE;
-    return S_RETURN_UINT64;
+    return storage_process_file_tell(storage, file);
 }
 
 bool storage_file_truncate(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
-    S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileTruncate);
-    S_API_EPILOGUE;
-    return S_RETURN_BOOL;
+    return storage_process_file_truncate(storage, file);
 }
 
 uint64_t storage_file_size(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
-    S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileSize);
-    S_API_EPILOGUE;
-    return S_RETURN_UINT64;
+    return storage_process_file_size(storage, file);
 }
 
 bool storage_file_sync(File* file) {
@@ -170,11 +138,7 @@ bool storage_file_sync(File* file) {
 
 bool storage_file_eof(File* file) {
     S_FILE_API_PROLOGUE;
-    S_API_PROLOGUE;
-    S_API_DATA_FILE;
-    S_API_MESSAGE(StorageCommandFileEof);
-    S_API_EPILOGUE;
-    return S_RETURN_BOOL;
+    return storage_process_file_eof(storage, file);
 }
 
 /****************** DIR ******************/
@@ -187,6 +187,7 @@ void storage_push_storage_file(
     furi_check(storage_file != NULL);
 
     file->file_id = (uint32_t)storage_file;
+    file->storage_data = storage;
     storage_file->file = file;
     storage_file->type = type;
     string_set(storage_file->path, path);
@@ -206,6 +207,7 @@ bool storage_pop_storage_file(File* file, StorageData* storage) {
 
     if(result) {
         StorageFileList_remove(storage->files, it);
+        file->storage_data = NULL;
     }
 
     return result;
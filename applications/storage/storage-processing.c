@@ -5,6 +5,11 @@
     ret = _storage->fs_api._fn;  \
     storage_data_unlock(_storage);
 
+/* Call on storage locked by storage_lock_storage_by_file() */
+#define FS_CALL_LOCKED(_storage, _fn) \
+    ret = _storage->fs_api._fn;       \
+    storage_data_unlock(_storage);
+
 #define ST_CALL(_storage, _fn)   \
     storage_data_lock(_storage); \
     ret = _storage->api._fn;     \
@@ -30,16 +35,21 @@ static bool storage_type_is_not_valid(StorageType type) {
     return type >= ST_ERROR;
 }
 
-static StorageData* get_storage_by_file(File* file, StorageData* storages) {
-    StorageData* storage_data = NULL;
-
-    for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
-        if(storage_has_file(file, &storages[i])) {
-            storage_data = &storages[i];
-        }
+/* File handle functions are also called directly from other threads, so
+ * storage file list is changed and searched only under storage lock. Only
+ * storage file is opened on is locked, operations on other storage go on.
+ * Returns locked storage of file, NULL if file is not opened. */
+static StorageData* storage_lock_storage_by_file(File* file) {
+    StorageData* storage = file->storage_data;
+    if(storage == NULL) return NULL;
+
+    storage_data_lock(storage);
+    if(!storage_has_file(file, storage)) {
+        storage_data_unlock(storage);
+        return NULL;
     }
 
-    return storage_data;
+    return storage;
 }
 
 const char* remove_vfs(const char* path) {
@@ -58,17 +68,21 @@ bool storage_process_file_open(
     StorageType type = storage_get_type_by_path(path);
     StorageData* storage;
     file->error_id = FSE_OK;
+    file->storage_data = NULL;
 
     if(storage_type_is_not_valid(type)) {
         file->error_id = FSE_INVALID_NAME;
     } else {
         storage = storage_get_storage_by_type(app, type);
+        storage_data_lock(storage);
         if(storage_path_already_open(path, storage->files)) {
             file->error_id = FSE_ALREADY_OPEN;
         } else {
             storage_push_storage_file(file, path, type, storage);
-            FS_CALL(storage, file.open(storage, file, remove_vfs(path), access_mode, open_mode));
+            ret = storage->fs_api.file.open(
+                storage, file, remove_vfs(path), access_mode, open_mode);
         }
+        storage_data_unlock(storage);
     }
 
     return ret;
@@ -76,87 +90,122 @@ bool storage_process_file_open(
 
 bool storage_process_file_close(Storage* app, File* file) {
     bool ret = false;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.close(storage, file));
+        ret = storage->fs_api.file.close(storage, file);
         storage_pop_storage_file(file, storage);
+        storage_data_unlock(storage);
     }
 
     return ret;
 }
 
-static uint16_t
+uint16_t
     storage_process_file_read(Storage* app, File* file, void* buff, uint16_t const bytes_to_read) {
     uint16_t ret = 0;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.read(storage, file, buff, bytes_to_read));
+        FS_CALL_LOCKED(storage, file.read(storage, file, buff, bytes_to_read));
     }
 
     return ret;
 }
 
-static uint16_t storage_process_file_write(
+uint16_t storage_process_file_write(
     Storage* app,
     File* file,
     const void* buff,
     uint16_t const bytes_to_write) {
     uint16_t ret = 0;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.write(storage, file, buff, bytes_to_write));
+        FS_CALL_LOCKED(storage, file.write(storage, file, buff, bytes_to_write));
     }
 
     return ret;
 }
 
-static bool storage_process_file_seek(
+size_t storage_process_file_read_v(
+    Storage* app,
+    File* file,
+    const FileIoVec* iov,
+    size_t iov_count) {
+    size_t ret = 0;
+    StorageData* storage = storage_lock_storage_by_file(file);
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else {
+        FS_CALL_LOCKED(storage, file.read_v(storage, file, iov, iov_count));
+    }
+
+    return ret;
+}
+
+size_t storage_process_file_write_v(
+    Storage* app,
+    File* file,
+    const FileIoConstVec* iov,
+    size_t iov_count) {
+    size_t ret = 0;
+    StorageData* storage = storage_lock_storage_by_file(file);
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else {
+        FS_CALL_LOCKED(storage, file.write_v(storage, file, iov, iov_count));
+    }
+
+    return ret;
+}
+
+bool storage_process_file_seek(
     Storage* app,
     File* file,
     const uint32_t offset,
     const bool from_start) {
     bool ret = false;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.seek(storage, file, offset, from_start));
+        FS_CALL_LOCKED(storage, file.seek(storage, file, offset, from_start));
     }
 
     return ret;
 }
 
-static uint64_t storage_process_file_tell(Storage* app, File* file) {
+uint64_t storage_process_file_tell(Storage* app, File* file) {
     uint64_t ret = 0;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.tell(storage, file));
+        FS_CALL_LOCKED(storage, file.tell(storage, file));
     }
 
     return ret;
 }
 
-static bool storage_process_file_truncate(Storage* app, File* file) {
+bool storage_process_file_truncate(Storage* app, File* file) {
     bool ret = false;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.truncate(storage, file));
+        FS_CALL_LOCKED(storage, file.truncate(storage, file));
     }
 
     return ret;
@@ -164,38 +213,38 @@ static bool storage_process_file_truncate(Storage* app, File* file) {
 
 static bool storage_process_file_sync(Storage* app, File* file) {
     bool ret = false;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.sync(storage, file));
+        FS_CALL_LOCKED(storage, file.sync(storage, file));
     }
 
     return ret;
 }
 
-static uint64_t storage_process_file_size(Storage* app, File* file) {
+uint64_t storage_process_file_size(Storage* app, File* file) {
     uint64_t ret = 0;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.size(storage, file));
+        FS_CALL_LOCKED(storage, file.size(storage, file));
     }
 
     return ret;
 }
 
-static bool storage_process_file_eof(Storage* app, File* file) {
+bool storage_process_file_eof(Storage* app, File* file) {
     bool ret = false;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, file.eof(storage, file));
+        FS_CALL_LOCKED(storage, file.eof(storage, file));
     }
 
     return ret;
@@ -208,17 +257,20 @@ bool storage_process_dir_open(Storage* app, File* file, const char* path) {
     StorageType type = storage_get_type_by_path(path);
     StorageData* storage;
     file->error_id = FSE_OK;
+    file->storage_data = NULL;
 
     if(storage_type_is_not_valid(type)) {
         file->error_id = FSE_INVALID_NAME;
     } else {
         storage = storage_get_storage_by_type(app, type);
+        storage_data_lock(storage);
         if(storage_path_already_open(path, storage->files)) {
             file->error_id = FSE_ALREADY_OPEN;
         } else {
             storage_push_storage_file(file, path, type, storage);
-            FS_CALL(storage, dir.open(storage, file, remove_vfs(path)));
+            ret = storage->fs_api.dir.open(storage, file, remove_vfs(path));
         }
+        storage_data_unlock(storage);
     }
 
     return ret;
@@ -226,44 +278,45 @@ bool storage_process_dir_open(Storage* app, File* file, const char* path) {
 
 bool storage_process_dir_close(Storage* app, File* file) {
     bool ret = false;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, dir.close(storage, file));
+        ret = storage->fs_api.dir.close(storage, file);
         storage_pop_storage_file(file, storage);
+        storage_data_unlock(storage);
     }
 
     return ret;
 }
 
-bool storage_process_dir_read(
+static bool storage_process_dir_read(
     Storage* app,
     File* file,
     FileInfo* fileinfo,
     char* name,
     const uint16_t name_length) {
     bool ret = false;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, dir.read(storage, file, fileinfo, name, name_length));
+        FS_CALL_LOCKED(storage, dir.read(storage, file, fileinfo, name, name_length));
     }
 
     return ret;
 }
 
-bool storage_process_dir_rewind(Storage* app, File* file) {
+static bool storage_process_dir_rewind(Storage* app, File* file) {
     bool ret = false;
-    StorageData* storage = get_storage_by_file(file, app->storage);
+    StorageData* storage = storage_lock_storage_by_file(file);
 
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, dir.rewind(storage, file));
+        FS_CALL_LOCKED(storage, dir.rewind(storage, file));
     }
 
     return ret;
@@ -321,51 +374,273 @@ static FS_Error storage_process_common_mkdir(Storage* app, const char* path) {
     return ret;
 }
 
-static FS_Error storage_process_common_copy(Storage* app, const char* old, const char* new) {
+/* Copy is done by blocks of few SD sectors, which is also a part of
+ * internal flash page. Between different storages file data is
+ * double buffered: writer thread writes one block while next one is read. */
+#define STORAGE_COPY_BLOCK_SIZE 2048
+#define STORAGE_COPY_BLOCKS 2
+#define STORAGE_COPY_PIPELINE_MIN_SIZE (STORAGE_COPY_BLOCK_SIZE * 8)
+#define STORAGE_COPY_WRITER_STACK_SIZE 2048
+#define STORAGE_COPY_NAME_LENGTH 256
+#define STORAGE_COPY_DEPTH_MAX 16
+
+typedef struct {
+    uint8_t* data;
+    uint16_t size;
+} StorageCopyBlock;
+
+typedef struct {
+    Storage* app;
+    File* file;
+    osMessageQueueId_t filled;
+    osMessageQueueId_t free;
+    volatile FS_Error error;
+} StorageCopyWriter;
+
+static FS_Error storage_process_copy_data(Storage* app, File* file_old, File* file_new) {
+    FS_Error ret = FSE_OK;
+    uint8_t* buffer = malloc(STORAGE_COPY_BLOCK_SIZE);
+
+    while(true) {
+        uint16_t read_size =
+            storage_process_file_read(app, file_old, buffer, STORAGE_COPY_BLOCK_SIZE);
+        ret = storage_file_get_error(file_old);
+        if(ret != FSE_OK || read_size == 0) break;
+
+        uint16_t write_size = storage_process_file_write(app, file_new, buffer, read_size);
+        ret = storage_file_get_error(file_new);
+        if(write_size < read_size) {
+            if(ret == FSE_OK) ret = FSE_INTERNAL;
+            break;
+        }
+    }
+
+    free(buffer);
+    return ret;
+}
+
+/* Writes filled blocks until empty one, after error just returns them */
+static int32_t storage_process_copy_writer(void* context) {
+    StorageCopyWriter* writer = context;
+    StorageCopyBlock block;
+
+    while(true) {
+        furi_check(osMessageQueueGet(writer->filled, &block, NULL, osWaitForever) == osOK);
+        if(block.size == 0) break;
+
+        if(writer->error == FSE_OK) {
+            uint16_t write_size =
+                storage_process_file_write(writer->app, writer->file, block.data, block.size);
+            FS_Error error = storage_file_get_error(writer->file);
+            if(error == FSE_OK && write_size < block.size) error = FSE_INTERNAL;
+            writer->error = error;
+        }
+        furi_check(osMessageQueuePut(writer->free, &block, 0, osWaitForever) == osOK);
+    }
+
+    return 0;
+}
+
+static FS_Error storage_process_copy_data_pipelined(Storage* app, File* file_old, File* file_new) {
+    FS_Error ret = FSE_OK;
+    uint8_t* buffer = malloc(STORAGE_COPY_BLOCK_SIZE * STORAGE_COPY_BLOCKS);
+    StorageCopyWriter writer = {
+        .app = app,
+        .file = file_new,
+        .filled = osMessageQueueNew(STORAGE_COPY_BLOCKS + 1, sizeof(StorageCopyBlock), NULL),
+        .free = osMessageQueueNew(STORAGE_COPY_BLOCKS, sizeof(StorageCopyBlock), NULL),
+        .error = FSE_OK,
+    };
+    StorageCopyBlock block;
+
+    for(uint8_t i = 0; i < STORAGE_COPY_BLOCKS; i++) {
+        block.data = buffer + i * STORAGE_COPY_BLOCK_SIZE;
+        block.size = 0;
+        furi_check(osMessageQueuePut(writer.free, &block, 0, 0) == osOK);
+    }
+
+    FuriThread* thread = furi_thread_alloc();
+    furi_thread_set_name(thread, "StorageCopy");
+    furi_thread_set_stack_size(thread, STORAGE_COPY_WRITER_STACK_SIZE);
+    furi_thread_set_context(thread, &writer);
+    furi_thread_set_callback(thread, storage_process_copy_writer);
+    furi_thread_start(thread);
+
+    while(writer.error == FSE_OK) {
+        furi_check(osMessageQueueGet(writer.free, &block, NULL, osWaitForever) == osOK);
+        block.size = storage_process_file_read(app, file_old, block.data, STORAGE_COPY_BLOCK_SIZE);
+        ret = storage_file_get_error(file_old);
+        if(ret != FSE_OK || block.size == 0) break;
+
+        furi_check(osMessageQueuePut(writer.filled, &block, 0, osWaitForever) == osOK);
+    }
+
+    // empty block stops writer
+    block.size = 0;
+    furi_check(osMessageQueuePut(writer.filled, &block, 0, osWaitForever) == osOK);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    if(ret == FSE_OK) ret = writer.error;
+
+    osMessageQueueDelete(writer.filled);
+    osMessageQueueDelete(writer.free);
+    free(buffer);
+    return ret;
+}
+
+static FS_Error
+    storage_process_copy_file(Storage* app, const char* old, const char* new, uint64_t size) {
     FS_Error ret = FSE_INTERNAL;
     File file_old;
     File file_new;
 
+    do {
+        if(!storage_process_file_open(app, &file_old, old, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            ret = storage_file_get_error(&file_old);
+            storage_process_file_close(app, &file_old);
+            break;
+        }
+
+        if(!storage_process_file_open(app, &file_new, new, FSAM_WRITE, FSOM_CREATE_NEW)) {
+            ret = storage_file_get_error(&file_new);
+            storage_process_file_close(app, &file_new);
+            storage_process_file_close(app, &file_old);
+            break;
+        }
+
+        // same storage can't read and write at once
+        if(storage_get_type_by_path(old) != storage_get_type_by_path(new) &&
+           size >= STORAGE_COPY_PIPELINE_MIN_SIZE) {
+            ret = storage_process_copy_data_pipelined(app, &file_old, &file_new);
+        } else {
+            ret = storage_process_copy_data(app, &file_old, &file_new);
+        }
+
+        storage_process_file_close(app, &file_old);
+        storage_process_file_close(app, &file_new);
+    } while(false);
+
+    return ret;
+}
+
+/* old and new are restored before return, name is scratch buffer shared by all levels */
+static FS_Error
+    storage_process_copy_dir(Storage* app, string_t old, string_t new, char* name, uint8_t depth) {
+    FS_Error ret = storage_process_common_mkdir(app, string_get_cstr(new));
+    if(ret != FSE_OK) return ret;
+    if(depth >= STORAGE_COPY_DEPTH_MAX) return FSE_INTERNAL;
+
+    File dir;
+    if(!storage_process_dir_open(app, &dir, string_get_cstr(old))) {
+        ret = storage_file_get_error(&dir);
+        storage_process_dir_close(app, &dir);
+        return ret;
+    }
+
+    size_t old_length = string_size(old);
+    size_t new_length = string_size(new);
     FileInfo fileinfo;
-    ret = storage_process_common_stat(app, old, &fileinfo);
 
-    if(ret == FSE_OK) {
+    while(ret == FSE_OK &&
+          storage_process_dir_read(app, &dir, &fileinfo, name, STORAGE_COPY_NAME_LENGTH)) {
+        string_cat_printf(old, "/%s", name);
+        string_cat_printf(new, "/%s", name);
+
         if(fileinfo.flags & FSF_DIRECTORY) {
-            ret = storage_process_common_mkdir(app, new);
+            ret = storage_process_copy_dir(app, old, new, name, depth + 1);
         } else {
-            do {
-                if(!storage_process_file_open(app, &file_old, old, FSAM_READ, FSOM_OPEN_EXISTING)) {
-                    ret = storage_file_get_error(&file_old);
-                    storage_process_file_close(app, &file_old);
-                    break;
-                }
+            ret = storage_process_copy_file(
+                app, string_get_cstr(old), string_get_cstr(new), fileinfo.size);
+        }
 
-                if(!storage_process_file_open(app, &file_new, new, FSAM_WRITE, FSOM_CREATE_NEW)) {
-                    ret = storage_file_get_error(&file_new);
-                    storage_process_file_close(app, &file_new);
-                    storage_process_file_close(app, &file_old);
-                    break;
-                }
+        string_left(old, old_length);
+        string_left(new, new_length);
+    }
+
+    // end of directory is reported as FSE_NOT_EXIST
+    if(ret == FSE_OK && storage_file_get_error(&dir) != FSE_NOT_EXIST) {
+        ret = storage_file_get_error(&dir);
+    }
+    storage_process_dir_close(app, &dir);
+
+    return ret;
+}
 
-                const uint16_t buffer_size = 64;
-                uint8_t* buffer = malloc(buffer_size);
-                uint16_t readed_size = 0;
-                uint16_t writed_size = 0;
+/* Remove directory with its content, used when directory is moved between storages */
+static FS_Error
+    storage_process_remove_dir(Storage* app, string_t path, char* name, uint8_t depth) {
+    FS_Error ret = FSE_OK;
+    if(depth >= STORAGE_COPY_DEPTH_MAX) return FSE_INTERNAL;
 
-                while(true) {
-                    readed_size = storage_process_file_read(app, &file_old, buffer, buffer_size);
-                    ret = storage_file_get_error(&file_old);
-                    if(readed_size == 0) break;
+    File dir;
+    if(!storage_process_dir_open(app, &dir, string_get_cstr(path))) {
+        ret = storage_file_get_error(&dir);
+        storage_process_dir_close(app, &dir);
+        return ret;
+    }
 
-                    writed_size = storage_process_file_write(app, &file_new, buffer, readed_size);
-                    ret = storage_file_get_error(&file_new);
-                    if(writed_size < readed_size) break;
-                }
+    size_t path_length = string_size(path);
+    FileInfo fileinfo;
+
+    // directory is read from start after every removal, entries shift
+    while(ret == FSE_OK &&
+          storage_process_dir_read(app, &dir, &fileinfo, name, STORAGE_COPY_NAME_LENGTH)) {
+        string_cat_printf(path, "/%s", name);
 
-                free(buffer);
-                storage_process_file_close(app, &file_old);
-                storage_process_file_close(app, &file_new);
-            } while(false);
+        if(fileinfo.flags & FSF_DIRECTORY) {
+            ret = storage_process_remove_dir(app, path, name, depth + 1);
+        } else {
+            ret = storage_process_common_remove(app, string_get_cstr(path));
+        }
+
+        string_left(path, path_length);
+        if(ret == FSE_OK) storage_process_dir_rewind(app, &dir);
+    }
+
+    if(ret == FSE_OK && storage_file_get_error(&dir) != FSE_NOT_EXIST) {
+        ret = storage_file_get_error(&dir);
+    }
+    storage_process_dir_close(app, &dir);
+
+    if(ret == FSE_OK) {
+        ret = storage_process_common_remove(app, string_get_cstr(path));
+    }
+
+    return ret;
+}
+
+static bool storage_process_path_is_inside(const char* path, const char* dir) {
+    size_t dir_length = strlen(dir);
+    return (strncmp(path, dir, dir_length) == 0) &&
+           (path[dir_length] == '/' || path[dir_length] == '\0');
+}
+
+static FS_Error storage_process_common_copy(Storage* app, const char* old, const char* new) {
+    FS_Error ret = FSE_INTERNAL;
+
+    FileInfo fileinfo;
+    ret = storage_process_common_stat(app, old, &fileinfo);
+
+    if(ret == FSE_OK) {
+        if(fileinfo.flags & FSF_DIRECTORY) {
+            if(storage_process_path_is_inside(new, old)) {
+                ret = FSE_INVALID_PARAMETER;
+            } else {
+                string_t old_path;
+                string_t new_path;
+                string_init_set_str(old_path, old);
+                string_init_set_str(new_path, new);
+                char* name = malloc(STORAGE_COPY_NAME_LENGTH);
+
+                ret = storage_process_copy_dir(app, old_path, new_path, name, 0);
+
+                free(name);
+                string_clear(old_path);
+                string_clear(new_path);
+            }
+        } else {
+            ret = storage_process_copy_file(app, old, new, fileinfo.size);
         }
     }
 
@@ -381,9 +656,22 @@ static FS_Error storage_process_common_rename(Storage* app, const char* old, con
         ret = FSE_INVALID_NAME;
     } else {
         if(type_old != type_new) {
-            ret = storage_process_common_copy(app, old, new);
+            FileInfo fileinfo;
+            ret = storage_process_common_stat(app, old, &fileinfo);
             if(ret == FSE_OK) {
-                ret = storage_process_common_remove(app, old);
+                ret = storage_process_common_copy(app, old, new);
+            }
+            if(ret == FSE_OK) {
+                if(fileinfo.flags & FSF_DIRECTORY) {
+                    string_t path;
+                    string_init_set_str(path, old);
+                    char* name = malloc(STORAGE_COPY_NAME_LENGTH);
+                    ret = storage_process_remove_dir(app, path, name, 0);
+                    free(name);
+                    string_clear(path);
+                } else {
+                    ret = storage_process_common_remove(app, old);
+                }
             }
         } else {
             StorageData* storage = storage_get_storage_by_type(app, type_old);
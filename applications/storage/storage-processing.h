@@ -11,6 +11,37 @@ extern "C" {
 
 void storage_process_message(Storage* app, StorageMessage* message);
 
+/* Opened file functions. Storage of file is locked for the call, so they are
+ * called directly in thread of file owner, not only by storage service. Only
+ * ones with shallow stack are here: dir read and rewind put FatFs LFN buffer
+ * on stack, littlefs sync may compact directory, they stay in service. */
+uint16_t
+    storage_process_file_read(Storage* app, File* file, void* buff, uint16_t const bytes_to_read);
+uint16_t storage_process_file_write(
+    Storage* app,
+    File* file,
+    const void* buff,
+    uint16_t const bytes_to_write);
+size_t storage_process_file_read_v(
+    Storage* app,
+    File* file,
+    const FileIoVec* iov,
+    size_t iov_count);
+size_t storage_process_file_write_v(
+    Storage* app,
+    File* file,
+    const FileIoConstVec* iov,
+    size_t iov_count);
+bool storage_process_file_seek(
+    Storage* app,
+    File* file,
+    const uint32_t offset,
+    const bool from_start);
+uint64_t storage_process_file_tell(Storage* app, File* file);
+bool storage_process_file_truncate(Storage* app, File* file);
+uint64_t storage_process_file_size(Storage* app, File* file);
+bool storage_process_file_eof(Storage* app, File* file);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
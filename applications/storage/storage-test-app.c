@@ -1,6 +1,8 @@
 #include <furi.h>
 #include <furi-hal.h>
 #include <storage/storage.h>
+#include "storage-i.h"
+#include "storage-message.h"
 
 #define TAG "storage-test"
 #define BYTES_COUNT 16
@@ -8,6 +10,7 @@
 #define SEEK_OFFSET_FROM_START 10
 #define SEEK_OFFSET_INCREASE 12
 #define SEEK_OFFSET_SUM (SEEK_OFFSET_FROM_START + SEEK_OFFSET_INCREASE)
+#define BENCH_READ_COUNT 1000
 
 static void do_file_test(Storage* api, const char* path) {
     File* file = storage_file_alloc(api);
@@ -223,6 +226,71 @@ static void do_dir_test(Storage* api, const char* path) {
     free(filename);
 }
 
+typedef uint16_t (*BenchReadFn)(Storage* api, File* file, void* buff, uint16_t bytes_to_read);
+
+// read through storage service, as storage_file_read() did before direct calls
+static uint16_t
+    bench_read_by_message(Storage* api, File* file, void* buff, uint16_t bytes_to_read) {
+    osSemaphoreId_t semaphore = osSemaphoreNew(1, 0, NULL);
+    furi_check(semaphore != NULL);
+
+    SAData data = {
+        .fread = {
+            .file = file,
+            .buff = buff,
+            .bytes_to_read = bytes_to_read,
+        }};
+    SAReturn return_data;
+    StorageMessage message = {
+        .semaphore = semaphore,
+        .command = StorageCommandFileRead,
+        .data = &data,
+        .return_data = &return_data,
+    };
+
+    furi_check(osMessageQueuePut(api->message_queue, &message, 0, osWaitForever) == osOK);
+    osSemaphoreAcquire(semaphore, osWaitForever);
+    osSemaphoreDelete(semaphore);
+
+    return return_data.uint16_value;
+}
+
+static uint16_t bench_read_direct(Storage* api, File* file, void* buff, uint16_t bytes_to_read) {
+    return storage_file_read(file, buff, bytes_to_read);
+}
+
+static void do_bench_read(Storage* api, File* file, const char* name, BenchReadFn read) {
+    uint8_t byte;
+    storage_file_seek(file, 0, true);
+
+    uint32_t start = osKernelGetTickCount();
+    for(uint32_t i = 0; i < BENCH_READ_COUNT; i++) {
+        if(read(api, file, &byte, 1) != 1) {
+            storage_file_seek(file, 0, true);
+        }
+    }
+    uint32_t ticks = MAX(osKernelGetTickCount() - start, 1);
+
+    FURI_LOG_I(
+        TAG, "%s: %lu byte reads/s", name, BENCH_READ_COUNT * osKernelGetTickFreq() / ticks);
+}
+
+static void do_bench_test(Storage* api, const char* path) {
+    File* file = storage_file_alloc(api);
+
+    FURI_LOG_I(TAG, "--------- BENCH \"%s\" ---------", path);
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        do_bench_read(api, file, "message", bench_read_by_message);
+        do_bench_read(api, file, "direct", bench_read_direct);
+    } else {
+        FURI_LOG_E(TAG, "open, %s", storage_file_get_error_desc(file));
+    }
+
+    storage_file_close(file);
+    storage_file_free(file);
+}
+
 static void do_test_start(Storage* api, const char* path) {
     string_t str_path;
     string_init_printf(str_path, "%s/test-folder", path);
@@ -329,6 +397,9 @@ int32_t storage_test_app(void* p) {
     do_dir_test(api, "/any");
     do_dir_test(api, "/ext");
 
+    do_bench_test(api, "/int/test.txt");
+    do_bench_test(api, "/ext/test.txt");
+
     do_test_end(api, "/int");
     do_test_end(api, "/any");
     do_test_end(api, "/ext");
@@ -20,6 +20,11 @@ void storage_file_free(File* file);
 
 /******************* File Functions *******************/
 
+/* Open, close, sync and directory functions are done by storage service.
+ * Read, write, seek and other functions of opened file run in caller thread,
+ * under storage lock, so file system driver runs on caller thread stack for
+ * them. They do not go through FatFs LFN buffer or littlefs commit. */
+
 /** Opens an existing file or create a new one.
  * @param file pointer to file object.
  * @param path path to file 
@@ -61,6 +66,25 @@ uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read);
  */
 uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write);
 
+/** Reads bytes from a file into buffers, fills one buffer after another.
+ * Sizes are not limited to 64k, large buffer is read by whole sectors/blocks
+ * at once, so prefer it to many storage_file_read() calls.
+ * @param file pointer to file object.
+ * @param iov array of buffers
+ * @param iov_count how many buffers are in array
+ * @return size_t how many bytes were actually readed, less than total size at end of file or on error
+ */
+size_t storage_file_read_v(File* file, const FileIoVec* iov, size_t iov_count);
+
+/** Writes bytes from buffers to a file, one buffer after another.
+ * Sizes are not limited to 64k, large buffer is written by whole sectors/blocks at once.
+ * @param file pointer to file object.
+ * @param iov array of buffers, data is not changed
+ * @param iov_count how many buffers are in array
+ * @return size_t how many bytes were actually written
+ */
+size_t storage_file_write_v(File* file, const FileIoConstVec* iov, size_t iov_count);
+
 /** Moves the r/w pointer 
  * @param file pointer to file object.
  * @param offset offset to move the r/w pointer
@@ -155,7 +179,8 @@ FS_Error storage_common_remove(Storage* storage, const char* path);
  */
 FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path);
 
-/** Copy file, file must not be open
+/** Copy file or directory with its content, file/directory must not be open.
+ * Renaming between storages copies directory the same way, then removes it.
  * @param app pointer to the api
  * @param old_path old path
  * @param new_path new path
@@ -302,7 +302,7 @@ static uint16_t
     storage_ext_file_read(void* ctx, File* file, void* buff, uint16_t const bytes_to_read) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    uint16_t bytes_readed = 0;
+    UINT bytes_readed = 0;
     file->internal_error_id = f_read(file_data, buff, bytes_to_read, &bytes_readed);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_readed;
@@ -312,12 +312,50 @@ static uint16_t
     storage_ext_file_write(void* ctx, File* file, const void* buff, uint16_t const bytes_to_write) {
     StorageData* storage = ctx;
     SDFile* file_data = storage_get_storage_file_data(file, storage);
-    uint16_t bytes_written = 0;
+    UINT bytes_written = 0;
     file->internal_error_id = f_write(file_data, buff, bytes_to_write, &bytes_written);
     file->error_id = storage_ext_parse_error(file->internal_error_id);
     return bytes_written;
 }
 
+/* Every buffer goes to FatFs at once, so whole sectors of it are
+ * transferred by single disk_read()/disk_write() */
+static size_t
+    storage_ext_file_read_v(void* ctx, File* file, const FileIoVec* iov, size_t iov_count) {
+    StorageData* storage = ctx;
+    SDFile* file_data = storage_get_storage_file_data(file, storage);
+    size_t bytes_readed = 0;
+
+    file->internal_error_id = FR_OK;
+    for(size_t i = 0; i < iov_count; i++) {
+        UINT buffer_readed = 0;
+        file->internal_error_id = f_read(file_data, iov[i].buff, iov[i].size, &buffer_readed);
+        bytes_readed += buffer_readed;
+        if(file->internal_error_id != FR_OK || buffer_readed < iov[i].size) break;
+    }
+
+    file->error_id = storage_ext_parse_error(file->internal_error_id);
+    return bytes_readed;
+}
+
+static size_t
+    storage_ext_file_write_v(void* ctx, File* file, const FileIoConstVec* iov, size_t iov_count) {
+    StorageData* storage = ctx;
+    SDFile* file_data = storage_get_storage_file_data(file, storage);
+    size_t bytes_written = 0;
+
+    file->internal_error_id = FR_OK;
+    for(size_t i = 0; i < iov_count; i++) {
+        UINT buffer_written = 0;
+        file->internal_error_id = f_write(file_data, iov[i].buff, iov[i].size, &buffer_written);
+        bytes_written += buffer_written;
+        if(file->internal_error_id != FR_OK || buffer_written < iov[i].size) break;
+    }
+
+    file->error_id = storage_ext_parse_error(file->internal_error_id);
+    return bytes_written;
+}
+
 static bool
     storage_ext_file_seek(void* ctx, File* file, const uint32_t offset, const bool from_start) {
     StorageData* storage = ctx;
@@ -528,6 +566,8 @@ void storage_ext_init(StorageData* storage) {
     storage->fs_api.file.size = storage_ext_file_size;
     storage->fs_api.file.sync = storage_ext_file_sync;
     storage->fs_api.file.eof = storage_ext_file_eof;
+    storage->fs_api.file.read_v = storage_ext_file_read_v;
+    storage->fs_api.file.write_v = storage_ext_file_write_v;
 
     storage->fs_api.dir.open = storage_ext_dir_open;
     storage->fs_api.dir.close = storage_ext_dir_close;
@@ -368,6 +368,62 @@ static uint16_t
     return bytes_written;
 }
 
+/* littlefs reads and programs whole blocks of large buffer directly,
+ * without copying through file cache */
+static size_t
+    storage_int_file_read_v(void* ctx, File* file, const FileIoVec* iov, size_t iov_count) {
+    StorageData* storage = ctx;
+    lfs_t* lfs = lfs_get_from_storage(storage);
+    LFSHandle* handle = storage_get_storage_file_data(file, storage);
+    size_t bytes_readed = 0;
+
+    file->internal_error_id = 0;
+    if(lfs_handle_is_open(handle)) {
+        for(size_t i = 0; i < iov_count; i++) {
+            lfs_ssize_t result =
+                lfs_file_read(lfs, lfs_handle_get_file(handle), iov[i].buff, iov[i].size);
+            if(result < 0) {
+                file->internal_error_id = result;
+                break;
+            }
+            bytes_readed += result;
+            if((size_t)result < iov[i].size) break;
+        }
+    } else {
+        file->internal_error_id = LFS_ERR_BADF;
+    }
+
+    file->error_id = storage_int_parse_error(file->internal_error_id);
+    return bytes_readed;
+}
+
+static size_t
+    storage_int_file_write_v(void* ctx, File* file, const FileIoConstVec* iov, size_t iov_count) {
+    StorageData* storage = ctx;
+    lfs_t* lfs = lfs_get_from_storage(storage);
+    LFSHandle* handle = storage_get_storage_file_data(file, storage);
+    size_t bytes_written = 0;
+
+    file->internal_error_id = 0;
+    if(lfs_handle_is_open(handle)) {
+        for(size_t i = 0; i < iov_count; i++) {
+            lfs_ssize_t result =
+                lfs_file_write(lfs, lfs_handle_get_file(handle), iov[i].buff, iov[i].size);
+            if(result < 0) {
+                file->internal_error_id = result;
+                break;
+            }
+            bytes_written += result;
+            if((size_t)result < iov[i].size) break;
+        }
+    } else {
+        file->internal_error_id = LFS_ERR_BADF;
+    }
+
+    file->error_id = storage_int_parse_error(file->internal_error_id);
+    return bytes_written;
+}
+
 static bool
     storage_int_file_seek(void* ctx, File* file, const uint32_t offset, const bool from_start) {
     StorageData* storage = ctx;
@@ -676,6 +732,8 @@ void storage_int_init(StorageData* storage) {
     storage->fs_api.file.size = storage_int_file_size;
     storage->fs_api.file.sync = storage_int_file_sync;
     storage->fs_api.file.eof = storage_int_file_eof;
+    storage->fs_api.file.read_v = storage_int_file_read_v;
+    storage->fs_api.file.write_v = storage_int_file_write_v;
 
     storage->fs_api.dir.open = storage_int_dir_open;
     storage->fs_api.dir.close = storage_int_dir_close;
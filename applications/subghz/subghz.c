@@ -163,15 +163,16 @@ SubGhz* subghz_alloc() {
     subghz->txrx->protocol = subghz_protocol_alloc();
     subghz_worker_set_overrun_callback(
         subghz->txrx->worker, (SubGhzWorkerOverrunCallback)subghz_protocol_reset);
-    subghz_worker_set_pair_callback(
-        subghz->txrx->worker, (SubGhzWorkerPairCallback)subghz_protocol_parse);
+    subghz_worker_set_pairs_callback(
+        subghz->txrx->worker, (SubGhzWorkerPairsCallback)subghz_protocol_parse_pairs);
     subghz_worker_set_context(subghz->txrx->worker, subghz->txrx->protocol);
 
     //Init Error_str
     string_init(subghz->error_str);
 
     subghz_protocol_load_keeloq_file(subghz->txrx->protocol, "/ext/subghz/keeloq_mfcodes");
-    subghz_protocol_load_nice_flor_s_file(subghz->txrx->protocol, "/ext/subghz/nice_floor_s_rx");
+    subghz_protocol_load_nice_flor_s_file(
+        subghz->txrx->protocol, "/ext/subghz/nice_floor_s_rx", false);
 
     //subghz_protocol_enable_dump_text(subghz->protocol, subghz_text_callback, subghz);
 
@@ -2,7 +2,7 @@
 
 #include <furi.h>
 #include <furi-hal.h>
-#include <stream_buffer.h>
+#include <lib/subghz/subghz_worker.h>
 #include <lib/subghz/protocols/subghz_protocol.h>
 #include <lib/subghz/protocols/subghz_protocol_common.h>
 #include <lib/subghz/protocols/subghz_protocol_princeton.h>
@@ -10,6 +10,9 @@
 #define SUBGHZ_FREQUENCY_RANGE_STR \
     "299999755...348000000 or 386999938...464000000 or 778999847...928000000"
 
+#define SUBGHZ_CLI_RX_POLL_MS 250
+#define SUBGHZ_CLI_RX_STATS_MS 5000
+
 void subghz_cli_init() {
     Cli* cli = furi_record_open("cli");
 
@@ -156,32 +159,27 @@ void subghz_cli_command_tx(Cli* cli, string_t args, void* context) {
 }
 
 typedef struct {
-    volatile bool overrun;
-    StreamBufferHandle_t stream;
     size_t packet_count;
 } SubGhzCliCommandRx;
 
-static void subghz_cli_command_rx_callback(bool level, uint32_t duration, void* context) {
-    SubGhzCliCommandRx* instance = context;
-
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    LevelDuration level_duration = level_duration_make(level, duration);
-    if(instance->overrun) {
-        instance->overrun = false;
-        level_duration = level_duration_reset();
-    }
-    size_t ret = xStreamBufferSendFromISR(
-        instance->stream, &level_duration, sizeof(LevelDuration), &xHigherPriorityTaskWoken);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-}
-
 static void subghz_cli_command_rx_text_callback(string_t text, void* context) {
     SubGhzCliCommandRx* instance = context;
     instance->packet_count++;
     printf(string_get_cstr(text));
 }
 
+static void subghz_cli_print_worker_stats(SubGhzWorker* worker) {
+    SubGhzWorkerStats stats;
+    subghz_worker_get_stats(worker, &stats);
+    printf(
+        "Edges received %lu, dropped %lu, overruns %lu, max stream fill %lu/%u\r\n",
+        stats.edges_received,
+        stats.edges_dropped,
+        stats.overrun_count,
+        stats.stream_fill_max,
+        subghz_worker_get_stream_size(worker));
+}
+
 void subghz_cli_command_rx(Cli* cli, string_t args, void* context) {
     uint32_t frequency = 433920000;
 
@@ -202,14 +200,18 @@ void subghz_cli_command_rx(Cli* cli, string_t args, void* context) {
 
     // Allocate context and buffers
     SubGhzCliCommandRx* instance = furi_alloc(sizeof(SubGhzCliCommandRx));
-    instance->stream = xStreamBufferCreate(sizeof(LevelDuration) * 1024, sizeof(LevelDuration));
-    furi_check(instance->stream);
 
     SubGhzProtocol* protocol = subghz_protocol_alloc();
     subghz_protocol_load_keeloq_file(protocol, "/ext/subghz/keeloq_mfcodes");
-    subghz_protocol_load_nice_flor_s_file(protocol, "/ext/subghz/nice_floor_s_rx");
+    subghz_protocol_load_nice_flor_s_file(protocol, "/ext/subghz/nice_floor_s_rx", false);
     subghz_protocol_enable_dump_text(protocol, subghz_cli_command_rx_text_callback, instance);
 
+    SubGhzWorker* worker = subghz_worker_alloc();
+    subghz_worker_set_overrun_callback(worker, (SubGhzWorkerOverrunCallback)subghz_protocol_reset);
+    subghz_worker_set_pairs_callback(
+        worker, (SubGhzWorkerPairsCallback)subghz_protocol_parse_pairs);
+    subghz_worker_set_context(worker, protocol);
+
     // Configure radio
     furi_hal_subghz_reset();
     furi_hal_subghz_load_preset(FuriHalSubGhzPresetOok650Async);
@@ -217,34 +219,32 @@ void subghz_cli_command_rx(Cli* cli, string_t args, void* context) {
     hal_gpio_init(&gpio_cc1101_g0, GpioModeInput, GpioPullNo, GpioSpeedLow);
 
     // Prepare and start RX
-    furi_hal_subghz_start_async_rx(subghz_cli_command_rx_callback, instance);
+    furi_hal_subghz_start_async_rx(subghz_worker_rx_callback, worker);
+    subghz_worker_start(worker);
 
     // Wait for packets to arrive
     printf("Listening at %lu. Press CTRL+C to stop\r\n", frequency);
-    LevelDuration level_duration;
+    uint32_t stats_ms = 0;
     while(!cli_cmd_interrupt_received(cli)) {
-        int ret =
-            xStreamBufferReceive(instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                printf(".");
-                subghz_protocol_reset(protocol);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-                subghz_protocol_parse(protocol, level, duration);
-            }
+        osDelay(SUBGHZ_CLI_RX_POLL_MS);
+        // Drops and overruns are seen while they happen, not only at exit
+        stats_ms += SUBGHZ_CLI_RX_POLL_MS;
+        if(stats_ms >= SUBGHZ_CLI_RX_STATS_MS) {
+            stats_ms = 0;
+            subghz_cli_print_worker_stats(worker);
         }
     }
 
     // Shutdown radio
+    subghz_worker_stop(worker);
     furi_hal_subghz_stop_async_rx();
     furi_hal_subghz_sleep();
 
     printf("\r\nPackets recieved %u\r\n", instance->packet_count);
+    subghz_cli_print_worker_stats(worker);
 
     // Cleanup
+    subghz_worker_free(worker);
     subghz_protocol_free(protocol);
-    vStreamBufferDelete(instance->stream);
     free(instance);
 }
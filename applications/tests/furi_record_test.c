@@ -12,3 +12,20 @@ void test_furi_create_open() {
     void* record = furi_record_open("test/holding");
     mu_assert_pointers_eq(record, &test_data);
 }
+
+void test_furi_record_id() {
+    // Well-known records have fixed ids
+    mu_assert_int_eq(FuriRecordIdStorage, furi_record_get_id("storage"));
+
+    // Other names get an id, same every time
+    uint8_t test_data = 0;
+    furi_record_create("test/id", (void*)&test_data);
+    FuriRecordId id = furi_record_get_id("test/id");
+    mu_assert_int_eq(id, furi_record_get_id("test/id"));
+
+    // Open by id is the same record as open by name
+    mu_assert_pointers_eq(furi_record_open_id(id), furi_record_open("test/id"));
+    furi_record_close_id(id);
+    furi_record_close("test/id");
+    mu_check(furi_record_destroy("test/id"));
+}
@@ -1,6 +1,7 @@
 #include <furi.h>
 #include "../minunit.h"
 #include "irda.h"
+#include "irda_raw.h"
 #include "common/irda_common_i.h"
 #include "test_data/irda_nec_test_data.srcdata"
 #include "test_data/irda_necext_test_data.srcdata"
@@ -17,6 +18,12 @@
 
 #define RUN_ENCODER_DECODER(data) run_encoder_decoder((data), COUNT_OF(data))
 
+#define RUN_DECODER_BATCH(data, expected) \
+    run_decoder_batch((data), COUNT_OF(data), (expected), COUNT_OF(expected))
+
+#define RUN_RAW_SIGNAL(data, expected) \
+    run_raw_signal((data), COUNT_OF(data), (expected), COUNT_OF(expected))
+
 static IrdaDecoderHandler* decoder_handler;
 static IrdaEncoderHandler* encoder_handler;
 
@@ -204,6 +211,108 @@ static void run_decoder(
     mu_assert(message_counter == message_expected_len, "decoded less than expected");
 }
 
+typedef struct {
+    const IrdaMessage* message_expected;
+    uint32_t message_expected_len;
+    uint32_t message_counter;
+    size_t last_index;
+} DecoderBatchContext;
+
+static void run_decoder_batch_callback(void* context, const IrdaMessage* message, size_t index) {
+    DecoderBatchContext* batch = context;
+
+    mu_assert(batch->message_counter < batch->message_expected_len, "decoded more than expected");
+    mu_assert(!batch->message_counter || (index > batch->last_index), "wrong timing index");
+    compare_message_results(message, &batch->message_expected[batch->message_counter]);
+    batch->last_index = index;
+    ++batch->message_counter;
+}
+
+/* same as run_decoder(), but all timings at once, for protocols with no irda_check_decoder_ready() */
+static void run_decoder_batch(
+    const uint32_t* input_delays,
+    uint32_t input_delays_len,
+    const IrdaMessage* message_expected,
+    uint32_t message_expected_len) {
+    DecoderBatchContext batch = {
+        .message_expected = message_expected,
+        .message_expected_len = message_expected_len,
+    };
+    LevelDuration* timings = furi_alloc(sizeof(LevelDuration) * input_delays_len);
+    bool level = 0;
+
+    for(uint32_t i = 0; i < input_delays_len; ++i) {
+        timings[i] = level_duration_make(level, input_delays[i]);
+        level = !level;
+    }
+
+    size_t decoded = irda_decode_batch(
+        decoder_handler, timings, input_delays_len, run_decoder_batch_callback, &batch);
+    free(timings);
+
+    mu_assert(decoded == batch.message_counter, "wrong amount of decoded messages returned");
+    mu_assert(batch.message_counter == message_expected_len, "decoded less than expected");
+}
+
+static void run_raw_signal(
+    const uint32_t* input_delays,
+    uint32_t input_delays_len,
+    const IrdaMessage* message_expected,
+    uint32_t message_expected_len) {
+    uint32_t* timings = malloc(sizeof(uint32_t) * input_delays_len);
+    uint32_t* restored = malloc(sizeof(uint32_t) * input_delays_len);
+
+    IrdaRawSignal* signal = irda_raw_signal_encode(input_delays, input_delays_len, 0);
+    mu_assert(irda_raw_signal_get_timings_count(signal) == input_delays_len, "wrong timings count");
+    irda_raw_signal_decode(signal, timings);
+    mu_assert(
+        !memcmp(timings, input_delays, sizeof(uint32_t) * input_delays_len),
+        "lossless raw signal differs");
+    irda_raw_signal_free(signal);
+
+    signal = irda_raw_signal_encode(input_delays, input_delays_len, IRDA_RAW_QUANTIZATION_US);
+    mu_assert(
+        irda_raw_signal_get_size(signal) < sizeof(uint32_t) * input_delays_len / 2,
+        "raw signal is not compact");
+    irda_raw_signal_decode(signal, timings);
+    for(uint32_t i = 0; i < input_delays_len; ++i) {
+        uint32_t delta = (timings[i] > input_delays[i]) ? timings[i] - input_delays[i] :
+                                                          input_delays[i] - timings[i];
+        mu_assert(delta <= IRDA_RAW_QUANTIZATION_US, "timing moved more than quantization");
+    }
+
+    /* dictionary and stream are what goes to file */
+    size_t dictionary_cnt;
+    size_t stream_size;
+    const uint16_t* dictionary = irda_raw_signal_get_dictionary(signal, &dictionary_cnt);
+    const uint8_t* stream = irda_raw_signal_get_stream(signal, &stream_size);
+    IrdaRawSignal* loaded = irda_raw_signal_load(dictionary, dictionary_cnt, stream, stream_size);
+    mu_assert(loaded, "failed to load raw signal");
+    irda_raw_signal_decode(loaded, restored);
+    mu_assert(
+        !memcmp(timings, restored, sizeof(uint32_t) * input_delays_len),
+        "loaded raw signal differs");
+    mu_assert(
+        !irda_raw_signal_load(dictionary, dictionary_cnt, stream, stream_size - 1) ||
+            (stream[stream_size - 1] < 0x40),
+        "truncated raw signal is loaded");
+    irda_raw_signal_free(loaded);
+    irda_raw_signal_free(signal);
+
+    run_decoder(timings, input_delays_len, message_expected, message_expected_len);
+
+    free(restored);
+    free(timings);
+}
+
+MU_TEST(test_decoder_batch) {
+    RUN_DECODER_BATCH(test_decoder_nec_input2, test_decoder_nec_expected2);
+    RUN_DECODER_BATCH(test_decoder_necext_input1, test_decoder_necext_expected1);
+    RUN_DECODER_BATCH(test_decoder_samsung32_input1, test_decoder_samsung32_expected1);
+    RUN_DECODER_BATCH(test_decoder_rc6_input1, test_decoder_rc6_expected1);
+    RUN_DECODER_BATCH(test_decoder_rc5_input_all_repeats, test_decoder_rc5_expected_all_repeats);
+}
+
 MU_TEST(test_decoder_samsung32) {
     RUN_DECODER(test_decoder_samsung32_input1, test_decoder_samsung32_expected1);
 }
@@ -292,6 +401,21 @@ MU_TEST(test_encoder_rc6) {
     RUN_ENCODER(test_encoder_rc6_input1, test_encoder_rc6_expected1);
 }
 
+MU_TEST(test_raw_signal) {
+    RUN_RAW_SIGNAL(test_decoder_nec_input2, test_decoder_nec_expected2);
+    RUN_RAW_SIGNAL(test_decoder_necext_input1, test_decoder_necext_expected1);
+    RUN_RAW_SIGNAL(test_decoder_samsung32_input1, test_decoder_samsung32_expected1);
+    RUN_RAW_SIGNAL(test_decoder_rc6_input1, test_decoder_rc6_expected1);
+    RUN_RAW_SIGNAL(test_decoder_rc5_input_all_repeats, test_decoder_rc5_expected_all_repeats);
+    RUN_RAW_SIGNAL(test_decoder_sirc_input1, test_decoder_sirc_expected1);
+
+    /* dictionary index out of dictionary */
+    const uint16_t dictionary[] = {560, 1690};
+    const uint8_t stream[] = {0x00, 0x01, 0x02};
+    mu_check(!irda_raw_signal_load(dictionary, COUNT_OF(dictionary), stream, sizeof(stream)));
+    mu_check(!irda_raw_signal_load(dictionary, COUNT_OF(dictionary), stream, 0));
+}
+
 MU_TEST(test_encoder_decoder_all) {
     RUN_ENCODER_DECODER(test_nec);
     RUN_ENCODER_DECODER(test_necext);
@@ -317,6 +441,8 @@ MU_TEST_SUITE(test_irda_decoder_encoder) {
     MU_RUN_TEST(test_decoder_samsung32);
     MU_RUN_TEST(test_decoder_necext1);
     MU_RUN_TEST(test_mix);
+    MU_RUN_TEST(test_decoder_batch);
+    MU_RUN_TEST(test_raw_signal);
     MU_RUN_TEST(test_encoder_decoder_all);
 }
 
@@ -4,6 +4,7 @@
 
 // v2 tests
 void test_furi_create_open();
+void test_furi_record_id();
 void test_furi_valuemutex();
 void test_furi_concurrent_access();
 void test_furi_pubsub();
@@ -29,6 +30,10 @@ MU_TEST(mu_test_furi_create_open) {
     test_furi_create_open();
 }
 
+MU_TEST(mu_test_furi_record_id) {
+    test_furi_record_id();
+}
+
 MU_TEST(mu_test_furi_valuemutex) {
     test_furi_valuemutex();
 }
@@ -54,6 +59,7 @@ MU_TEST_SUITE(test_suite) {
 
     // v2 tests
     MU_RUN_TEST(mu_test_furi_create_open);
+    MU_RUN_TEST(mu_test_furi_record_id);
     MU_RUN_TEST(mu_test_furi_valuemutex);
     MU_RUN_TEST(mu_test_furi_concurrent_access);
     MU_RUN_TEST(mu_test_furi_pubsub);
@@ -2,38 +2,339 @@
 #include <stm32wbxx_hal.h>
 #include "check.h"
 #include <cmsis_os2.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Messages are formatted by caller into ring buffer and printed by FuriLog
+ * thread of low priority, so caller never waits for console. Buffer is
+ * multi-producer: place is reserved by compare-and-swap of head, record is
+ * written and marked ready, thread takes ready records from tail. Reservation
+ * never blocks, but text is formatted by vsnprintf() on caller stack, so from
+ * ISR only integer, character and string formats may be used. When there is
+ * no place message is dropped and counted. Record never wraps, end of buffer
+ * is padded instead. Thread zeroes every record it took before giving place
+ * back, so ready of a new record is clear wherever it lands. Record reserved
+ * and not ready for FURI_LOG_COMMIT_TIMEOUT ticks is dropped: writing takes
+ * microseconds, so its producer is gone, e.g. thread was terminated inside
+ * furi_log_print(). If it was gone before size was stored, record can't be
+ * skipped alone, everything reserved up to that moment is dropped instead.
+ * Until kernel is running messages are printed right away. */
+#define FURI_LOG_THREAD_FLAG 1U
+#define FURI_LOG_COMMIT_TIMEOUT 100U
+#define FURI_LOG_BUFFER_MASK (FURI_LOG_BUFFER_SIZE - 1)
+#define FURI_LOG_FRAME_START 0x1E
+
+_Static_assert(
+    (FURI_LOG_BUFFER_SIZE & FURI_LOG_BUFFER_MASK) == 0,
+    "FURI_LOG_BUFFER_SIZE must be power of 2");
+_Static_assert(FURI_LOG_LINE_SIZE <= 248, "binary frame length is one byte");
+
+typedef enum {
+    FuriLogRecordPadding,
+    FuriLogRecordText,
+    FuriLogRecordBinary,
+} FuriLogRecordType;
+
+/* Record is aligned to 4, size includes header */
+typedef struct {
+    uint16_t size;
+    uint8_t type;
+    volatile uint8_t ready;
+    uint32_t timestamp;
+} FuriLogRecord;
 
 typedef struct {
     FuriLogLevel log_level;
     FuriLogPrint print;
     FuriLogVPrint vprint;
+    FuriLogWrite write;
     FuriLogTimestamp timetamp;
-    osMutexId_t mutex;
+    osThreadId_t thread;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;
+    uint8_t buffer[FURI_LOG_BUFFER_SIZE] __attribute__((aligned(4)));
 } FuriLogParams;
 
 static FuriLogParams furi_log;
 
+static void furi_log_thread(void* context);
+
 void furi_log_init() {
     // Set default logging parameters
     furi_log.log_level = FURI_LOG_LEVEL;
     furi_log.print = printf;
     furi_log.vprint = vprintf;
+    furi_log.write = NULL;
     furi_log.timetamp = HAL_GetTick;
-    furi_log.mutex = osMutexNew(NULL);
+
+    const osThreadAttr_t attr = {
+        .name = "FuriLog",
+        .stack_size = 2048,
+        .priority = osPriorityLow,
+    };
+    furi_log.thread = osThreadNew(furi_log_thread, NULL, &attr);
+    furi_check(furi_log.thread);
+}
+
+static FuriLogRecord* furi_log_record_at(uint32_t position) {
+    return (FuriLogRecord*)&furi_log.buffer[position & FURI_LOG_BUFFER_MASK];
+}
+
+/* FuriLog thread reports drops once buffer is empty */
+static void furi_log_drop() {
+    __atomic_fetch_add(&furi_log.dropped, 1, __ATOMIC_RELAXED);
+    osThreadFlagsSet(furi_log.thread, FURI_LOG_THREAD_FLAG);
+}
+
+/* Reserve place for record of given size, NULL if buffer is full */
+static FuriLogRecord* furi_log_reserve(size_t size) {
+    size = (sizeof(FuriLogRecord) + size + 3) & ~3U;
+    uint32_t head = __atomic_load_n(&furi_log.head, __ATOMIC_RELAXED);
+    uint32_t padding;
+
+    do {
+        uint32_t left = FURI_LOG_BUFFER_SIZE - (head & FURI_LOG_BUFFER_MASK);
+        padding = (left < size) ? left : 0;
+        uint32_t tail = __atomic_load_n(&furi_log.tail, __ATOMIC_ACQUIRE);
+        if(head + padding + size - tail > FURI_LOG_BUFFER_SIZE) {
+            furi_log_drop();
+            return NULL;
+        }
+    } while(!__atomic_compare_exchange_n(
+        &furi_log.head, &head, head + padding + size, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    if(padding) {
+        FuriLogRecord* record = furi_log_record_at(head);
+        record->size = padding;
+        record->type = FuriLogRecordPadding;
+        __atomic_store_n(&record->ready, 1, __ATOMIC_RELEASE);
+    }
+
+    FuriLogRecord* record = furi_log_record_at(head + padding);
+    record->size = size;
+    return record;
+}
+
+static void furi_log_commit(FuriLogRecord* record, FuriLogRecordType type) {
+    record->type = type;
+    record->timestamp = furi_log.timetamp();
+    __atomic_store_n(&record->ready, 1, __ATOMIC_RELEASE);
+    osThreadFlagsSet(furi_log.thread, FURI_LOG_THREAD_FLAG);
+}
+
+static inline void furi_log_put(uint8_t** out, const uint8_t* end, const void* data, size_t size) {
+    if(*out + size <= end) {
+        memcpy(*out, data, size);
+        *out += size;
+    } else {
+        *out = (uint8_t*)end + 1;
+    }
+}
+
+/* Binary record: format address and arguments as they are, 64 bit for ll, j
+ * and floating point, NUL terminated string for %s, 32 bit for the rest.
+ * Returns encoded size or 0 if arguments don't fit. */
+static size_t furi_log_encode(uint8_t* data, size_t size, const char* format, va_list args) {
+    uint8_t* out = data;
+    const uint8_t* end = data + size;
+    uint32_t value;
+    uint64_t value64;
+
+    value = (uintptr_t)format;
+    furi_log_put(&out, end, &value, sizeof(value));
+
+    for(const char* p = format; *p && out <= end; p++) {
+        if(*p != '%') continue;
+        p++;
+        while(*p && strchr("-+ #0", *p)) p++;
+        for(int field = 0; field < 2; field++) {
+            if(*p == '*') {
+                value = va_arg(args, int);
+                furi_log_put(&out, end, &value, sizeof(value));
+                p++;
+            } else {
+                while(*p >= '0' && *p <= '9') p++;
+            }
+            if(*p != '.') break;
+            p++;
+        }
+
+        /* 'q' stands for ll, hh is same as h */
+        char length = 0;
+        if(p[0] == 'l' && p[1] == 'l') {
+            length = 'q';
+            p += 2;
+        } else if(p[0] == 'h' && p[1] == 'h') {
+            length = 'h';
+            p += 2;
+        } else if(*p && strchr("hlzjtL", *p)) {
+            length = *p++;
+        }
+
+        if(*p && strchr("diouxXc", *p)) {
+            if(length == 'q' || length == 'j') {
+                value64 = (length == 'q') ? va_arg(args, long long) : va_arg(args, intmax_t);
+                furi_log_put(&out, end, &value64, sizeof(value64));
+                continue;
+            }
+            if(length == 'l') {
+                value = va_arg(args, long);
+            } else if(length == 'z') {
+                value = va_arg(args, size_t);
+            } else if(length == 't') {
+                value = va_arg(args, ptrdiff_t);
+            } else {
+                value = va_arg(args, int);
+            }
+            furi_log_put(&out, end, &value, sizeof(value));
+        } else if(*p && strchr("feEgGaA", *p)) {
+            double number = (length == 'L') ? va_arg(args, long double) : va_arg(args, double);
+            furi_log_put(&out, end, &number, sizeof(number));
+        } else if(*p == 's') {
+            const char* string = va_arg(args, const char*);
+            if(string == NULL) string = "(null)";
+            /* long string is cut, rest of arguments may still fit */
+            size_t length = strlen(string);
+            if((out < end) && (out + length + 1 > end)) length = end - out - 1;
+            furi_log_put(&out, end, string, length);
+            furi_log_put(&out, end, "", 1);
+        } else if(*p == 'p') {
+            value = (uintptr_t)va_arg(args, void*);
+            furi_log_put(&out, end, &value, sizeof(value));
+        } else if(*p == 'n') {
+            (void)va_arg(args, void*);
+        } else if(*p == '\0') {
+            break;
+        }
+    }
+
+    return (out <= end) ? (size_t)(out - data) : 0;
 }
 
 void furi_log_print(FuriLogLevel level, const char* format, ...) {
     va_list args;
     va_start(args, format);
     if(level <= furi_log.log_level) {
-        osMutexAcquire(furi_log.mutex, osWaitForever);
-        furi_log.print("%lu ", furi_log.timetamp());
-        furi_log.vprint(format, args);
-        osMutexRelease(furi_log.mutex);
+        if(osKernelGetState() != osKernelRunning) {
+            furi_log.print("%lu ", furi_log.timetamp());
+            furi_log.vprint(format, args);
+        } else if(furi_log.write) {
+            uint8_t data[FURI_LOG_LINE_SIZE];
+            size_t size = furi_log_encode(data, sizeof(data), format, args);
+            FuriLogRecord* record = size ? furi_log_reserve(size) : NULL;
+            if(record) {
+                memcpy(&record[1], data, size);
+                furi_log_commit(record, FuriLogRecordBinary);
+            } else if(!size) {
+                furi_log_drop();
+            }
+        } else {
+            char line[FURI_LOG_LINE_SIZE];
+            int length = vsnprintf(line, sizeof(line), format, args);
+            if(length >= (int)sizeof(line)) {
+                length = sizeof(line) - 1;
+                line[length - 2] = '\r';
+                line[length - 1] = '\n';
+            }
+            if(length >= 0) {
+                FuriLogRecord* record = furi_log_reserve(length + 1);
+                if(record) {
+                    memcpy(&record[1], line, length + 1);
+                    furi_log_commit(record, FuriLogRecordText);
+                }
+            }
+        }
     }
     va_end(args);
 }
 
+/* Frame: start byte, payload length, payload (timestamp, format address,
+ * arguments), sum of payload bytes */
+static void furi_log_write_frame(const FuriLogRecord* record) {
+    uint8_t frame[2 + sizeof(uint32_t) + FURI_LOG_LINE_SIZE + 1];
+    size_t payload = sizeof(uint32_t) + record->size - sizeof(FuriLogRecord);
+
+    /* record size is rounded up, trailing bytes are decoded as nothing */
+    frame[0] = FURI_LOG_FRAME_START;
+    frame[1] = payload;
+    memcpy(&frame[2], &record->timestamp, sizeof(uint32_t));
+    memcpy(&frame[2 + sizeof(uint32_t)], &record[1], record->size - sizeof(FuriLogRecord));
+    uint8_t sum = 0;
+    for(size_t i = 0; i < payload; i++) sum += frame[2 + i];
+    frame[2 + payload] = sum;
+
+    FuriLogWrite write = furi_log.write;
+    if(write) write(frame, 2 + payload + 1);
+}
+
+/* Zero span of buffer, it may wrap */
+static void furi_log_clear(uint32_t from, uint32_t to) {
+    while(from != to) {
+        uint32_t offset = from & FURI_LOG_BUFFER_MASK;
+        uint32_t size = FURI_LOG_BUFFER_SIZE - offset;
+        if(size > to - from) size = to - from;
+        memset(&furi_log.buffer[offset], 0, size);
+        from += size;
+    }
+}
+
+static void furi_log_thread(void* context) {
+    uint32_t dropped = 0;
+    uint32_t waited = 0;
+
+    while(true) {
+        osThreadFlagsWait(FURI_LOG_THREAD_FLAG, osFlagsWaitAny, osWaitForever);
+
+        uint32_t tail = furi_log.tail;
+        uint32_t head;
+        while(tail != (head = __atomic_load_n(&furi_log.head, __ATOMIC_ACQUIRE))) {
+            FuriLogRecord* record = furi_log_record_at(tail);
+            uint32_t size = record->size;
+            if(!__atomic_load_n(&record->ready, __ATOMIC_ACQUIRE)) {
+                /* reserved, but not written yet. Size is set right after
+                 * reservation, without it record can't be skipped. */
+                bool size_valid = (size >= sizeof(FuriLogRecord)) && !(size & 3U) &&
+                                  (size <= head - tail);
+                if(waited < FURI_LOG_COMMIT_TIMEOUT) {
+                    waited++;
+                    osDelay(1);
+                    continue;
+                }
+                __atomic_fetch_add(&furi_log.dropped, 1, __ATOMIC_RELAXED);
+                if(!size_valid) {
+                    /* records after it can't be found, they go too and
+                     * are counted as one */
+                    waited = 0;
+                    furi_log_clear(tail, head);
+                    tail = head;
+                    __atomic_store_n(&furi_log.tail, tail, __ATOMIC_RELEASE);
+                    continue;
+                }
+            } else if(record->type == FuriLogRecordText) {
+                furi_log.print("%lu %s", record->timestamp, (const char*)&record[1]);
+            } else if(record->type == FuriLogRecordBinary) {
+                furi_log_write_frame(record);
+            }
+
+            waited = 0;
+            tail += size;
+            memset(record, 0, size);
+            __atomic_store_n(&furi_log.tail, tail, __ATOMIC_RELEASE);
+        }
+
+        uint32_t dropped_now = __atomic_load_n(&furi_log.dropped, __ATOMIC_RELAXED);
+        if(dropped_now != dropped) {
+            furi_log.print(
+                "%lu " FURI_LOG_FORMAT(W, "FuriLog", "%lu messages dropped"),
+                furi_log.timetamp(),
+                dropped_now - dropped);
+            dropped = dropped_now;
+        }
+    }
+}
+
 void furi_log_set_level(FuriLogLevel level) {
     furi_log.log_level = level;
 }
@@ -50,6 +351,14 @@ void furi_log_set_print(FuriLogPrint print, FuriLogVPrint vprint) {
     furi_log.vprint = vprint;
 }
 
+void furi_log_set_binary(FuriLogWrite write) {
+    furi_log.write = write;
+}
+
+uint32_t furi_log_get_dropped(void) {
+    return __atomic_load_n(&furi_log.dropped, __ATOMIC_RELAXED);
+}
+
 void furi_log_set_timestamp(FuriLogTimestamp timestamp) {
     furi_assert(timestamp);
 
@@ -14,6 +14,16 @@ extern "C" {
 #define FURI_LOG_LEVEL FURI_LOG_LEVEL_DEFAULT
 #endif
 
+/* Messages wait for FuriLog thread in buffer of this size, power of 2 */
+#ifndef FURI_LOG_BUFFER_SIZE
+#define FURI_LOG_BUFFER_SIZE 2048
+#endif
+
+/* Longer messages are truncated */
+#ifndef FURI_LOG_LINE_SIZE
+#define FURI_LOG_LINE_SIZE 128
+#endif
+
 #define FURI_LOG_CLR(clr) "\033[0;" clr "m"
 #define FURI_LOG_CLR_RESET "\033[0m"
 
@@ -33,6 +43,7 @@ extern "C" {
 typedef int (*FuriLogPrint)(const char*, ...);
 typedef int (*FuriLogVPrint)(const char*, va_list);
 typedef uint32_t (*FuriLogTimestamp)(void);
+typedef void (*FuriLogWrite)(const uint8_t* data, size_t size);
 
 typedef enum {
     FURI_LOG_NONE = 0,
@@ -50,6 +61,18 @@ FuriLogLevel furi_log_get_level();
 void furi_log_set_print(FuriLogPrint print, FuriLogVPrint vprint);
 void furi_log_set_timestamp(FuriLogTimestamp timestamp);
 
+/** Send messages in binary frames instead of text: format string address
+ * and arguments, as passed. Caller doesn't format anything, messages are
+ * decoded on host with scripts/log_decode.py and firmware elf.
+ * @param write - frame sink, called from FuriLog thread, NULL for text
+ */
+void furi_log_set_binary(FuriLogWrite write);
+
+/** Get amount of messages dropped because log buffer was full
+ * @return dropped messages since start
+ */
+uint32_t furi_log_get_dropped(void);
+
 #define FURI_LOG_FORMAT(log_letter, tag, format) \
     FURI_LOG_CLR_##log_letter "[" #log_letter "][" tag "]: " FURI_LOG_CLR_RESET format "\r\n"
 #define FURI_LOG_SHOW(tag, format, log_level, log_letter, ...) \
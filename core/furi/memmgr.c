@@ -1,13 +1,14 @@
 #include "memmgr.h"
 #include <string.h>
 
-extern void* pvPortMalloc(size_t xSize);
+extern void* memmgr_heap_malloc(size_t size, void* caller);
+extern void* memmgr_heap_realloc(void* pointer, size_t size, void* caller);
 extern void vPortFree(void* pv);
 extern size_t xPortGetFreeHeapSize(void);
 extern size_t xPortGetMinimumEverFreeHeapSize(void);
 
 void* malloc(size_t size) {
-    return pvPortMalloc(size);
+    return memmgr_heap_malloc(size, __builtin_return_address(0));
 }
 
 void free(void* ptr) {
@@ -15,26 +16,11 @@ void free(void* ptr) {
 }
 
 void* realloc(void* ptr, size_t size) {
-    if(size == 0) {
-        vPortFree(ptr);
-        return NULL;
-    }
-
-    void* p;
-    p = pvPortMalloc(size);
-    if(p) {
-        // TODO implement secure realloc
-        // insecure, but will do job in our case
-        if(ptr != NULL) {
-            memcpy(p, ptr, size);
-            vPortFree(ptr);
-        }
-    }
-    return p;
+    return memmgr_heap_realloc(ptr, size, __builtin_return_address(0));
 }
 
 void* calloc(size_t count, size_t size) {
-    void* ptr = pvPortMalloc(count * size);
+    void* ptr = memmgr_heap_malloc(count * size, __builtin_return_address(0));
     if(ptr) {
         // zero the memory
         memset(ptr, 0, count * size);
@@ -49,7 +35,7 @@ char* strdup(const char* s) {
     }
 
     size_t siz = strlen(s) + 1;
-    char* y = malloc(siz);
+    char* y = memmgr_heap_malloc(siz, __builtin_return_address(0));
 
     if(y != NULL) {
         memcpy(y, s, siz);
@@ -69,7 +55,7 @@ size_t memmgr_get_minimum_free_heap(void) {
 }
 
 void* __wrap__malloc_r(struct _reent* r, size_t size) {
-    void* pointer = malloc(size);
+    void* pointer = memmgr_heap_malloc(size, __builtin_return_address(0));
     return pointer;
 }
 
@@ -78,11 +64,14 @@ void __wrap__free_r(struct _reent* r, void* ptr) {
 }
 
 void* __wrap__calloc_r(struct _reent* r, size_t count, size_t size) {
-    void* pointer = calloc(count, size);
+    void* pointer = memmgr_heap_malloc(count * size, __builtin_return_address(0));
+    if(pointer) {
+        memset(pointer, 0, count * size);
+    }
     return pointer;
 }
 
 void* __wrap__realloc_r(struct _reent* r, void* ptr, size_t size) {
-    void* pointer = realloc(ptr, size);
+    void* pointer = memmgr_heap_realloc(ptr, size, __builtin_return_address(0));
     return pointer;
 }
\ No newline at end of file
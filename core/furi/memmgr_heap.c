@@ -36,7 +36,11 @@
 
 #include "memmgr_heap.h"
 #include "check.h"
+#include "common_defines.h"
+#include <stdbool.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
 #include <cmsis_os2.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
@@ -87,6 +91,19 @@ static void prvInsertBlockIntoFreeList(BlockLink_t* pxBlockToInsert);
  */
 static void prvHeapInit(void);
 
+/*
+ * Takes block of xWantedSize bytes from the list of free blocks, without
+ * tracing.  Must be called with scheduler suspended.
+ */
+static void* prvHeapAllocate(size_t xWantedSize);
+
+/*
+ * Resizes allocated block in place: grows it into the free block right after
+ * it or gives its tail back to the list of free blocks.  Returns pdFALSE if
+ * the block can't be grown.  Must be called with scheduler suspended.
+ */
+static BaseType_t prvHeapResize(BlockLink_t* pxLink, size_t xWantedSize);
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -109,36 +126,191 @@ space. */
 static size_t xBlockAllocatedBit = 0;
 
 /* Furi heap extension */
-#include <m-dict.h>
-
-/* Allocation tracking types */
-DICT_DEF2(MemmgrHeapAllocDict, uint32_t, uint32_t)
-DICT_DEF2(
-    MemmgrHeapThreadDict,
-    uint32_t,
-    M_DEFAULT_OPLIST,
-    MemmgrHeapAllocDict_t,
-    DICT_OPLIST(MemmgrHeapAllocDict))
-
-/* Thread allocation tracing storage */
-static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
-static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
-
-/* Initialize tracing storage on start */
+
+/* Allocations of traced threads are kept in fixed open addressing table,
+ * linear probing, backward shift on removal. Tracing takes no allocations and
+ * costs a few probes per call, so it stays on in release builds. When table
+ * is 3/4 full, new allocations are not recorded and counted as dropped.
+ * Entries of finished thread stay as its leftovers until blocks are freed,
+ * same thread id is traced again or slot of finished thread is needed. */
+#define MEMMGR_HEAP_TRACE_LIMIT (MEMMGR_HEAP_TRACE_SIZE / 4 * 3)
+#define MEMMGR_HEAP_TRACE_THREADS 8
+
+typedef struct {
+    uintptr_t pointer; /* 0 for empty entry */
+    uintptr_t caller;
+    uint32_t size : 24;
+    uint32_t thread : 8; /* index in memmgr_heap_trace_threads */
+} MemmgrHeapTraceEntry;
+
+typedef struct {
+    osThreadId_t thread_id; /* NULL for free slot */
+    size_t entries;
+    size_t dropped;
+    bool finished;
+} MemmgrHeapTraceThread;
+
+static MemmgrHeapTraceEntry memmgr_heap_trace_table[MEMMGR_HEAP_TRACE_SIZE];
+static MemmgrHeapTraceThread memmgr_heap_trace_threads[MEMMGR_HEAP_TRACE_THREADS];
+/* Threads traced right now, finished ones are not counted */
+static size_t memmgr_heap_trace_threads_count = 0;
+static size_t memmgr_heap_trace_count = 0;
+static size_t memmgr_heap_trace_dropped = 0;
+
+/* Small allocations are served by size class slabs: page taken from heap is
+ * cut to slots of one size. Slot has BlockLink_t header like heap block, with
+ * allocated bit in xBlockSize, but pxNextFreeBlock of allocated slot points
+ * to its page, that's how vPortFree() tells slots from blocks. Freed slots of
+ * page are linked by pxNextFreeBlock, slots never taken are handed out in
+ * order, so new page costs no more than heap block. Empty page goes back to
+ * heap at once: pages kept for later fragment heap. */
+#define MEMMGR_HEAP_SLAB_PAGE_SIZE 1024
+
+typedef struct MemmgrHeapSlabPage {
+    struct MemmgrHeapSlabPage* next;
+    struct MemmgrHeapSlabPage* prev;
+    BlockLink_t* free_slots;
+    uint16_t used;
+    /* Slots at the end of page never taken */
+    uint16_t fresh;
+    uint16_t class_index;
+} MemmgrHeapSlabPage;
+
+typedef struct {
+    /* Pages with free slots, full pages are not linked anywhere */
+    MemmgrHeapSlabPage* partial;
+    size_t slot_size;
+    size_t page_size;
+    uint16_t slots_per_page;
+    size_t pages;
+    size_t used;
+    size_t peak;
+    size_t allocs;
+} MemmgrHeapSlabClass;
+
+/* Largest allocation of every class, must be ascending */
+static const size_t memmgr_heap_slab_sizes[] = {16, 32, 48, 64, 96, 128, 192, 256};
+#define MEMMGR_HEAP_SLAB_CLASS_COUNT COUNT_OF(memmgr_heap_slab_sizes)
+#define MEMMGR_HEAP_SLAB_SIZE_MAX 256
+
+static MemmgrHeapSlabClass memmgr_heap_slab_classes[MEMMGR_HEAP_SLAB_CLASS_COUNT];
+static size_t memmgr_heap_slab_page_header_size = 0;
+/* Bytes of free slots of slab pages, counted as free heap. Page headers and
+ * page tails too short for a slot can't be allocated, so they are not. */
+static size_t memmgr_heap_slab_free_bytes = 0;
+
+static void memmgr_heap_slab_init() {
+    memmgr_heap_slab_page_header_size = (sizeof(MemmgrHeapSlabPage) + portBYTE_ALIGNMENT_MASK) &
+                                        ~((size_t)portBYTE_ALIGNMENT_MASK);
+    for(size_t i = 0; i < MEMMGR_HEAP_SLAB_CLASS_COUNT; i++) {
+        MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[i];
+        slab_class->slot_size = xHeapStructSize + memmgr_heap_slab_sizes[i];
+        slab_class->slots_per_page =
+            (MEMMGR_HEAP_SLAB_PAGE_SIZE - memmgr_heap_slab_page_header_size) /
+            slab_class->slot_size;
+        slab_class->page_size = memmgr_heap_slab_page_header_size +
+                                slab_class->slots_per_page * slab_class->slot_size;
+    }
+}
+
+/* Initialize slabs on start */
 void memmgr_heap_init() {
-    MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
+    memmgr_heap_slab_init();
+}
+
+static inline size_t memmgr_heap_trace_hash(uintptr_t pointer) {
+    return ((uint32_t)(pointer >> 3) * 2654435761UL) % MEMMGR_HEAP_TRACE_SIZE;
+}
+
+/* NULL finds free slot, finished threads are found too */
+static inline int memmgr_heap_trace_find_thread(osThreadId_t thread_id) {
+    for(size_t i = 0; i < MEMMGR_HEAP_TRACE_THREADS; i++) {
+        if(memmgr_heap_trace_threads[i].thread_id == thread_id) return i;
+    }
+    return -1;
+}
+
+/* Slot of finished thread is free once its last leftover is gone */
+static void memmgr_heap_trace_thread_put_entry(size_t thread) {
+    MemmgrHeapTraceThread* trace_thread = &memmgr_heap_trace_threads[thread];
+    trace_thread->entries--;
+    if(trace_thread->finished && !trace_thread->entries) {
+        trace_thread->thread_id = NULL;
+    }
+}
+
+static size_t memmgr_heap_trace_find(uintptr_t pointer) {
+    size_t index = memmgr_heap_trace_hash(pointer);
+    while(memmgr_heap_trace_table[index].pointer &&
+          memmgr_heap_trace_table[index].pointer != pointer) {
+        index = (index + 1) % MEMMGR_HEAP_TRACE_SIZE;
+    }
+    return index;
+}
+
+/* Move following entries of the same probe run into the hole */
+static void memmgr_heap_trace_remove_at(size_t hole) {
+    memmgr_heap_trace_thread_put_entry(memmgr_heap_trace_table[hole].thread);
+
+    size_t index = hole;
+    while(true) {
+        index = (index + 1) % MEMMGR_HEAP_TRACE_SIZE;
+        MemmgrHeapTraceEntry* entry = &memmgr_heap_trace_table[index];
+        if(!entry->pointer) break;
+        size_t home = memmgr_heap_trace_hash(entry->pointer);
+        /* entry can be moved if its home is not in (hole, index] */
+        bool movable = (hole <= index) ? ((home <= hole) || (home > index)) :
+                                         ((home <= hole) && (home > index));
+        if(movable) {
+            memmgr_heap_trace_table[hole] = *entry;
+            hole = index;
+        }
+    }
+    memmgr_heap_trace_table[hole].pointer = 0;
+    memmgr_heap_trace_count--;
+}
+
+/* Forget leftovers of finished thread, its slot becomes free */
+static void memmgr_heap_trace_forget_thread(size_t thread) {
+    furi_check(memmgr_heap_trace_threads[thread].finished);
+    for(size_t i = 0; memmgr_heap_trace_threads[thread].entries && (i < MEMMGR_HEAP_TRACE_SIZE);) {
+        MemmgrHeapTraceEntry* entry = &memmgr_heap_trace_table[i];
+        if(entry->pointer && entry->thread == thread) {
+            /* something else may be moved here, check it again */
+            memmgr_heap_trace_remove_at(i);
+        } else {
+            i++;
+        }
+    }
+    memmgr_heap_trace_threads[thread].thread_id = NULL;
 }
 
 void memmgr_heap_enable_thread_trace(osThreadId_t thread_id) {
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) == NULL);
-        MemmgrHeapAllocDict_t alloc_dict;
-        MemmgrHeapAllocDict_init(alloc_dict);
-        MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
-        MemmgrHeapAllocDict_clear(alloc_dict);
-        memmgr_heap_thread_trace_depth--;
+        furi_check(thread_id);
+        /* same id traced again: leftovers of previous run are not told apart */
+        int thread = memmgr_heap_trace_find_thread(thread_id);
+        if(thread != -1) {
+            memmgr_heap_trace_forget_thread(thread);
+        } else {
+            thread = memmgr_heap_trace_find_thread(NULL);
+        }
+        /* all slots taken: leftovers of some finished thread go */
+        for(size_t i = 0; (thread == -1) && (i < MEMMGR_HEAP_TRACE_THREADS); i++) {
+            if(memmgr_heap_trace_threads[i].finished) {
+                memmgr_heap_trace_forget_thread(i);
+                thread = i;
+            }
+        }
+        furi_check(thread != -1);
+
+        MemmgrHeapTraceThread* trace_thread = &memmgr_heap_trace_threads[thread];
+        trace_thread->thread_id = thread_id;
+        trace_thread->entries = 0;
+        trace_thread->dropped = 0;
+        trace_thread->finished = false;
+        memmgr_heap_trace_threads_count++;
     }
     (void)xTaskResumeAll();
 }
@@ -146,61 +318,265 @@ void memmgr_heap_enable_thread_trace(osThreadId_t thread_id) {
 void memmgr_heap_disable_thread_trace(osThreadId_t thread_id) {
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) != NULL);
-        MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        memmgr_heap_thread_trace_depth--;
+        int thread = memmgr_heap_trace_find_thread(thread_id);
+        furi_check(thread != -1);
+        MemmgrHeapTraceThread* trace_thread = &memmgr_heap_trace_threads[thread];
+        furi_check(!trace_thread->finished);
+        trace_thread->finished = true;
+        if(!trace_thread->entries) {
+            trace_thread->thread_id = NULL;
+        }
+        memmgr_heap_trace_threads_count--;
+    }
+    (void)xTaskResumeAll();
+}
+
+size_t memmgr_heap_get_thread_dropped(osThreadId_t thread_id) {
+    size_t dropped;
+    vTaskSuspendAll();
+    {
+        int thread = memmgr_heap_trace_find_thread(thread_id);
+        furi_check(thread != -1);
+        dropped = memmgr_heap_trace_threads[thread].dropped;
     }
     (void)xTaskResumeAll();
+    return dropped;
 }
 
 size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id) {
     size_t leftovers = 0;
     vTaskSuspendAll();
     {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        furi_check(alloc_dict);
-        MemmgrHeapAllocDict_it_t alloc_dict_it;
-        for(MemmgrHeapAllocDict_it(alloc_dict_it, *alloc_dict);
-            !MemmgrHeapAllocDict_end_p(alloc_dict_it);
-            MemmgrHeapAllocDict_next(alloc_dict_it)) {
-            MemmgrHeapAllocDict_itref_t* data = MemmgrHeapAllocDict_ref(alloc_dict_it);
-            leftovers += data->value;
+        int thread = memmgr_heap_trace_find_thread(thread_id);
+        furi_check(thread != -1);
+        for(size_t i = 0; i < MEMMGR_HEAP_TRACE_SIZE; i++) {
+            const MemmgrHeapTraceEntry* entry = &memmgr_heap_trace_table[i];
+            if(entry->pointer && entry->thread == thread) {
+                leftovers += entry->size;
+            }
         }
-        memmgr_heap_thread_trace_depth--;
     }
     (void)xTaskResumeAll();
     return leftovers;
 }
 
+size_t
+    memmgr_heap_get_trace_callers(MemmgrHeapTraceCaller* callers, size_t count, bool finished) {
+    size_t used = 0;
+    vTaskSuspendAll();
+    {
+        for(size_t i = 0; i < MEMMGR_HEAP_TRACE_SIZE; i++) {
+            const MemmgrHeapTraceEntry* entry = &memmgr_heap_trace_table[i];
+            if(!entry->pointer) continue;
+            if(memmgr_heap_trace_threads[entry->thread].finished != finished) continue;
+
+            size_t j = 0;
+            while((j < used) && (callers[j].caller != (void*)entry->caller)) j++;
+            if(j == used) {
+                if(used == count) continue;
+                callers[used].caller = (void*)entry->caller;
+                callers[used].size = 0;
+                callers[used].count = 0;
+                used++;
+            }
+            callers[j].size += entry->size;
+            callers[j].count++;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    /* by bytes, few dozens of callers */
+    for(size_t i = 1; i < used; i++) {
+        MemmgrHeapTraceCaller caller = callers[i];
+        size_t j = i;
+        for(; (j > 0) && (callers[j - 1].size < caller.size); j--) {
+            callers[j] = callers[j - 1];
+        }
+        callers[j] = caller;
+    }
+
+    return used;
+}
+
+void memmgr_heap_get_trace_stats(MemmgrHeapTraceStats* stats) {
+    vTaskSuspendAll();
+    {
+        stats->threads = memmgr_heap_trace_threads_count;
+        stats->finished_threads = 0;
+        stats->leftovers = 0;
+        for(size_t i = 0; i < MEMMGR_HEAP_TRACE_THREADS; i++) {
+            const MemmgrHeapTraceThread* trace_thread = &memmgr_heap_trace_threads[i];
+            if(trace_thread->thread_id && trace_thread->finished) {
+                stats->finished_threads++;
+                stats->leftovers += trace_thread->entries;
+            }
+        }
+        stats->entries = memmgr_heap_trace_count;
+        stats->capacity = MEMMGR_HEAP_TRACE_LIMIT;
+        stats->dropped = memmgr_heap_trace_dropped;
+    }
+    (void)xTaskResumeAll();
+}
+
 #undef traceMALLOC
-static inline void traceMALLOC(void* pointer, size_t size) {
+static inline void traceMALLOC(void* pointer, size_t size, void* caller) {
+    if(memmgr_heap_trace_threads_count == 0) return;
     osThreadId_t thread_id = osThreadGetId();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
+    if(thread_id == NULL) return;
+    int thread = memmgr_heap_trace_find_thread(thread_id);
+    if(thread == -1 || memmgr_heap_trace_threads[thread].finished) return;
+
+    /* realloc in place updates existing entry */
+    size_t index = memmgr_heap_trace_find((uintptr_t)pointer);
+    MemmgrHeapTraceEntry* entry = &memmgr_heap_trace_table[index];
+    if(!entry->pointer) {
+        if(memmgr_heap_trace_count >= MEMMGR_HEAP_TRACE_LIMIT) {
+            memmgr_heap_trace_dropped++;
+            memmgr_heap_trace_threads[thread].dropped++;
+            return;
         }
-        memmgr_heap_thread_trace_depth--;
+        memmgr_heap_trace_count++;
+        memmgr_heap_trace_threads[thread].entries++;
+    } else if(entry->thread != thread) {
+        memmgr_heap_trace_thread_put_entry(entry->thread);
+        memmgr_heap_trace_threads[thread].entries++;
     }
+    entry->pointer = (uintptr_t)pointer;
+    entry->caller = (uintptr_t)caller;
+    entry->size = size;
+    entry->thread = thread;
 }
 
 #undef traceFREE
+/* Entry is removed whatever thread frees it */
 static inline void traceFREE(void* pointer, size_t size) {
-    osThreadId_t thread_id = osThreadGetId();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
+    if(memmgr_heap_trace_count == 0) return;
+
+    size_t index = memmgr_heap_trace_find((uintptr_t)pointer);
+    if(memmgr_heap_trace_table[index].pointer) {
+        memmgr_heap_trace_remove_at(index);
+    }
+}
+
+/* Size of heap block or slot, header included */
+static inline size_t memmgr_heap_get_block_size(void* pointer) {
+    BlockLink_t* link = (void*)((uint8_t*)pointer - xHeapStructSize);
+    return link->xBlockSize & ~xBlockAllocatedBit;
+}
+
+static inline MemmgrHeapSlabClass* memmgr_heap_slab_get_class(size_t size) {
+    size_t i = 0;
+    while(memmgr_heap_slab_sizes[i] < size) i++;
+    return &memmgr_heap_slab_classes[i];
+}
+
+static void memmgr_heap_slab_page_link(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    page->prev = NULL;
+    page->next = slab_class->partial;
+    if(page->next) page->next->prev = page;
+    slab_class->partial = page;
+}
+
+static void
+    memmgr_heap_slab_page_unlink(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    if(page->prev) {
+        page->prev->next = page->next;
+    } else {
+        slab_class->partial = page->next;
+    }
+    if(page->next) page->next->prev = page->prev;
+}
+
+static MemmgrHeapSlabPage* memmgr_heap_slab_page_alloc(MemmgrHeapSlabClass* slab_class) {
+    MemmgrHeapSlabPage* page = prvHeapAllocate(slab_class->page_size);
+    if(page == NULL) return NULL;
+
+    page->free_slots = NULL;
+    page->used = 0;
+    page->fresh = slab_class->slots_per_page;
+    page->class_index = slab_class - memmgr_heap_slab_classes;
+
+    memmgr_heap_slab_page_link(slab_class, page);
+    slab_class->pages++;
+    memmgr_heap_slab_free_bytes += slab_class->slots_per_page * slab_class->slot_size;
+    return page;
+}
+
+static void memmgr_heap_slab_page_free(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    BlockLink_t* link = (void*)((uint8_t*)page - xHeapStructSize);
+
+    memmgr_heap_slab_page_unlink(slab_class, page);
+    slab_class->pages--;
+    memmgr_heap_slab_free_bytes -= slab_class->slots_per_page * slab_class->slot_size;
+
+    link->xBlockSize &= ~xBlockAllocatedBit;
+    xFreeBytesRemaining += link->xBlockSize;
+    prvInsertBlockIntoFreeList(link);
+}
+
+static void* memmgr_heap_slab_alloc(MemmgrHeapSlabClass* slab_class) {
+    MemmgrHeapSlabPage* page = slab_class->partial;
+    if(page == NULL) {
+        page = memmgr_heap_slab_page_alloc(slab_class);
+        if(page == NULL) return NULL;
+    }
+
+    BlockLink_t* slot = page->free_slots;
+    if(slot != NULL) {
+        page->free_slots = slot->pxNextFreeBlock;
+    } else {
+        page->fresh--;
+        slot = (void*)((uint8_t*)page + memmgr_heap_slab_page_header_size +
+                       (slab_class->slots_per_page - page->fresh - 1) * slab_class->slot_size);
+    }
+    page->used++;
+    if((page->free_slots == NULL) && (page->fresh == 0)) {
+        memmgr_heap_slab_page_unlink(slab_class, page);
+    }
+
+    slot->xBlockSize = slab_class->slot_size | xBlockAllocatedBit;
+    slot->pxNextFreeBlock = (void*)page;
+
+    slab_class->allocs++;
+    if(++slab_class->used > slab_class->peak) slab_class->peak = slab_class->used;
+    memmgr_heap_slab_free_bytes -= slab_class->slot_size;
+    return (uint8_t*)slot + xHeapStructSize;
+}
+
+static void memmgr_heap_slab_free(BlockLink_t* slot) {
+    MemmgrHeapSlabPage* page = (void*)slot->pxNextFreeBlock;
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[page->class_index];
+
+    if((page->free_slots == NULL) && (page->fresh == 0)) {
+        memmgr_heap_slab_page_link(slab_class, page);
+    }
+    slot->xBlockSize &= ~xBlockAllocatedBit;
+    slot->pxNextFreeBlock = page->free_slots;
+    page->free_slots = slot;
+
+    slab_class->used--;
+    memmgr_heap_slab_free_bytes += slab_class->slot_size;
+    if(--page->used == 0) {
+        memmgr_heap_slab_page_free(slab_class, page);
+    }
+}
+
+size_t memmgr_heap_get_slab_stats(MemmgrHeapSlabStats* stats, size_t count) {
+    count = MIN(count, MEMMGR_HEAP_SLAB_CLASS_COUNT);
+    vTaskSuspendAll();
+    {
+        for(size_t i = 0; i < count; i++) {
+            const MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab_classes[i];
+            stats[i].size = memmgr_heap_slab_sizes[i];
+            stats[i].pages = slab_class->pages;
+            stats[i].used = slab_class->used;
+            stats[i].free = slab_class->pages * slab_class->slots_per_page - slab_class->used;
+            stats[i].peak = slab_class->peak;
+            stats[i].allocs = slab_class->allocs;
         }
-        memmgr_heap_thread_trace_depth--;
     }
+    (void)xTaskResumeAll();
+    return count;
 }
 
 size_t memmgr_heap_get_max_free_block() {
@@ -236,7 +612,11 @@ void memmgr_heap_printf_free_blocks() {
 /*-----------------------------------------------------------*/
 
 void* pvPortMalloc(size_t xWantedSize) {
-    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+    return memmgr_heap_malloc(xWantedSize, __builtin_return_address(0));
+}
+/*-----------------------------------------------------------*/
+
+void* memmgr_heap_malloc(size_t xWantedSize, void* pvCaller) {
     void* pvReturn = NULL;
 
     vTaskSuspendAll();
@@ -250,110 +630,247 @@ void* pvPortMalloc(size_t xWantedSize) {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Check the requested block size is not so large that the top bit is
-        set.  The top bit of the block size member of the BlockLink_t structure
-        is used to determine who owns the block - the application or the
-        kernel, so it must be free. */
-        if((xWantedSize & xBlockAllocatedBit) == 0) {
-            /* The wanted size is increased so it can contain a BlockLink_t
-            structure in addition to the requested amount of bytes. */
-            if(xWantedSize > 0) {
-                xWantedSize += xHeapStructSize;
-
-                /* Ensure that blocks are always aligned to the required number
-                of bytes. */
-                if((xWantedSize & portBYTE_ALIGNMENT_MASK) != 0x00) {
-                    /* Byte alignment required. */
-                    xWantedSize += (portBYTE_ALIGNMENT - (xWantedSize & portBYTE_ALIGNMENT_MASK));
-                    configASSERT((xWantedSize & portBYTE_ALIGNMENT_MASK) == 0);
-                } else {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+        if((xWantedSize > 0) && (xWantedSize <= MEMMGR_HEAP_SLAB_SIZE_MAX)) {
+            pvReturn = memmgr_heap_slab_alloc(memmgr_heap_slab_get_class(xWantedSize));
+        }
+        /* No place for a new page still may leave a block big enough */
+        if(pvReturn == NULL) {
+            pvReturn = prvHeapAllocate(xWantedSize);
+        }
+
+        if(pvReturn != NULL) {
+            size_t xFreeHeapSize = xPortGetFreeHeapSize();
+            if(xFreeHeapSize < xMinimumEverFreeBytesRemaining) {
+                xMinimumEverFreeBytesRemaining = xFreeHeapSize;
             } else {
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
-                /* Traverse the list from the start (lowest address) block until
-                one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = xStart.pxNextFreeBlock;
-                while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = pxBlock->pxNextFreeBlock;
-                }
+            traceMALLOC(pvReturn, memmgr_heap_get_block_size(pvReturn), pvCaller);
+        }
+    }
+    (void)xTaskResumeAll();
+
+#if(configUSE_MALLOC_FAILED_HOOK == 1)
+    {
+        if(pvReturn == NULL) {
+            extern void vApplicationMallocFailedHook(void);
+            vApplicationMallocFailedHook();
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+#endif
+
+    configASSERT((((size_t)pvReturn) & (size_t)portBYTE_ALIGNMENT_MASK) == 0);
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
 
-                /* If the end marker was reached then a block of adequate size
-                was not found. */
-                if(pxBlock != pxEnd) {
-                    /* Return the memory space pointed to - jumping over the
-                    BlockLink_t structure at its start. */
-                    pvReturn =
-                        (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
-
-                    /* This block is being returned for use so must be taken out
-                    of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                    two. */
-                    if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
-                        /* This block is to be split into two.  Create a new
-                        block following the number of bytes requested. The void
-                        cast is used to prevent byte alignment warnings from the
-                        compiler. */
-                        pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
-                        configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
-
-                        /* Calculate the sizes of two blocks split from the
-                        single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        prvInsertBlockIntoFreeList(pxNewBlockLink);
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
-
-                    if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* The block is being returned - it is allocated and owned
-                    by the application and has no "next" block. */
-                    pxBlock->xBlockSize |= xBlockAllocatedBit;
-                    pxBlock->pxNextFreeBlock = NULL;
+static void* prvHeapAllocate(size_t xWantedSize) {
+    BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+    void* pvReturn = NULL;
+
+    /* Check the requested block size is not so large that the top bit is
+    set.  The top bit of the block size member of the BlockLink_t structure
+    is used to determine who owns the block - the application or the
+    kernel, so it must be free. */
+    if((xWantedSize & xBlockAllocatedBit) == 0) {
+        /* The wanted size is increased so it can contain a BlockLink_t
+        structure in addition to the requested amount of bytes. */
+        if(xWantedSize > 0) {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned to the required number
+            of bytes. */
+            if((xWantedSize & portBYTE_ALIGNMENT_MASK) != 0x00) {
+                /* Byte alignment required. */
+                xWantedSize += (portBYTE_ALIGNMENT - (xWantedSize & portBYTE_ALIGNMENT_MASK));
+                configASSERT((xWantedSize & portBYTE_ALIGNMENT_MASK) == 0);
+            } else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
+            /* Traverse the list from the start (lowest address) block until
+            one of adequate size is found. */
+            pxPreviousBlock = &xStart;
+            pxBlock = xStart.pxNextFreeBlock;
+            while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
+                pxPreviousBlock = pxBlock;
+                pxBlock = pxBlock->pxNextFreeBlock;
+            }
+
+            /* If the end marker was reached then a block of adequate size
+            was not found. */
+            if(pxBlock != pxEnd) {
+                /* Return the memory space pointed to - jumping over the
+                BlockLink_t structure at its start. */
+                pvReturn =
+                    (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
+
+                /* This block is being returned for use so must be taken out
+                of the list of free blocks. */
+                pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+                /* If the block is larger than required it can be split into
+                two. */
+                if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+                    /* This block is to be split into two.  Create a new
+                    block following the number of bytes requested. The void
+                    cast is used to prevent byte alignment warnings from the
+                    compiler. */
+                    pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
+                    configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
+
+                    /* Calculate the sizes of two blocks split from the
+                    single block. */
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* Insert the new block into the list of free blocks. */
+                    prvInsertBlockIntoFreeList(pxNewBlockLink);
                 } else {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                /* The block is being returned - it is allocated and owned
+                by the application and has no "next" block. */
+                pxBlock->xBlockSize |= xBlockAllocatedBit;
+                pxBlock->pxNextFreeBlock = NULL;
             } else {
                 mtCOVERAGE_TEST_MARKER();
             }
         } else {
             mtCOVERAGE_TEST_MARKER();
         }
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-        traceMALLOC(pvReturn, xWantedSize);
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvHeapResize(BlockLink_t* pxLink, size_t xWantedSize) {
+    BlockLink_t *pxIterator, *pxNextBlock, *pxNewBlockLink;
+    size_t xBlockSize = pxLink->xBlockSize & ~xBlockAllocatedBit;
+
+    if((xWantedSize & xBlockAllocatedBit) != 0) {
+        return pdFALSE;
     }
-    (void)xTaskResumeAll();
 
-#if(configUSE_MALLOC_FAILED_HOOK == 1)
+    /* Same size adjustment as in prvHeapAllocate(). */
+    xWantedSize += xHeapStructSize;
+    if((xWantedSize & portBYTE_ALIGNMENT_MASK) != 0x00) {
+        xWantedSize += (portBYTE_ALIGNMENT - (xWantedSize & portBYTE_ALIGNMENT_MASK));
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if(xWantedSize > xBlockSize) {
+        /* Find the free block right after this one, the list is sorted by
+        address.  pxEnd is a marker, not a block. */
+        pxNextBlock = (void*)(((uint8_t*)pxLink) + xBlockSize);
+        for(pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxNextBlock;
+            pxIterator = pxIterator->pxNextFreeBlock) {
+            /* Nothing to do here, just iterate to the right position. */
+        }
+
+        if((pxIterator->pxNextFreeBlock != pxNextBlock) || (pxNextBlock == pxEnd) ||
+           (xBlockSize + pxNextBlock->xBlockSize < xWantedSize)) {
+            return pdFALSE;
+        }
+
+        /* Take the whole free block, the rest is split below. */
+        pxIterator->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+        xFreeBytesRemaining -= pxNextBlock->xBlockSize;
+        xBlockSize += pxNextBlock->xBlockSize;
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Give the tail back if it is large enough to be a block. */
+    if((xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+        pxNewBlockLink = (void*)(((uint8_t*)pxLink) + xWantedSize);
+        pxNewBlockLink->xBlockSize = xBlockSize - xWantedSize;
+        xBlockSize = xWantedSize;
+        xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+        prvInsertBlockIntoFreeList(pxNewBlockLink);
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxLink->xBlockSize = xBlockSize | xBlockAllocatedBit;
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void* pvPortRealloc(void* pv, size_t xWantedSize) {
+    return memmgr_heap_realloc(pv, xWantedSize, __builtin_return_address(0));
+}
+/*-----------------------------------------------------------*/
+
+void* memmgr_heap_realloc(void* pv, size_t xWantedSize, void* pvCaller) {
+    BlockLink_t* pxLink;
+    void* pvReturn = NULL;
+    size_t xCopySize = 0;
+
+    if(pv == NULL) {
+        return memmgr_heap_malloc(xWantedSize, pvCaller);
+    }
+
+    if(xWantedSize == 0) {
+        vPortFree(pv);
+        return NULL;
+    }
+
+    pxLink = (void*)(((uint8_t*)pv) - xHeapStructSize);
+    configASSERT((pxLink->xBlockSize & xBlockAllocatedBit) != 0);
+
+    vTaskSuspendAll();
     {
-        if(pvReturn == NULL) {
-            extern void vApplicationMallocFailedHook(void);
-            vApplicationMallocFailedHook();
+        if(pxLink->pxNextFreeBlock != NULL) {
+            /* Slab slot, stays while new size fits its class */
+            MemmgrHeapSlabPage* page = (void*)pxLink->pxNextFreeBlock;
+            if(xWantedSize <= memmgr_heap_slab_sizes[page->class_index]) {
+                pvReturn = pv;
+            }
+        } else if(prvHeapResize(pxLink, xWantedSize) == pdTRUE) {
+            pvReturn = pv;
+
+            size_t xFreeHeapSize = xPortGetFreeHeapSize();
+            if(xFreeHeapSize < xMinimumEverFreeBytesRemaining) {
+                xMinimumEverFreeBytesRemaining = xFreeHeapSize;
+            } else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceMALLOC(pv, memmgr_heap_get_block_size(pv), pvCaller);
         } else {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        if(pvReturn == NULL) {
+            xCopySize = memmgr_heap_get_block_size(pv) - xHeapStructSize;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    /* Move, only old block content is copied */
+    if(pvReturn == NULL) {
+        pvReturn = memmgr_heap_malloc(xWantedSize, pvCaller);
+        if(pvReturn != NULL) {
+            memcpy(pvReturn, pv, MIN(xCopySize, xWantedSize));
+            vPortFree(pv);
+        }
     }
-#endif
 
-    configASSERT((((size_t)pvReturn) & (size_t)portBYTE_ALIGNMENT_MASK) == 0);
     return pvReturn;
 }
 /*-----------------------------------------------------------*/
@@ -372,7 +889,6 @@ void vPortFree(void* pv) {
 
         /* Check the block is actually allocated. */
         configASSERT((pxLink->xBlockSize & xBlockAllocatedBit) != 0);
-        configASSERT(pxLink->pxNextFreeBlock == NULL);
 
         if((pxLink->xBlockSize & xBlockAllocatedBit) != 0) {
             if(pxLink->pxNextFreeBlock == NULL) {
@@ -389,7 +905,13 @@ void vPortFree(void* pv) {
                 }
                 (void)xTaskResumeAll();
             } else {
-                mtCOVERAGE_TEST_MARKER();
+                /* Slab slot, pxNextFreeBlock points to its page */
+                vTaskSuspendAll();
+                {
+                    traceFREE(pv, pxLink->xBlockSize & ~xBlockAllocatedBit);
+                    memmgr_heap_slab_free(pxLink);
+                }
+                (void)xTaskResumeAll();
             }
         } else {
             mtCOVERAGE_TEST_MARKER();
@@ -399,7 +921,8 @@ void vPortFree(void* pv) {
 /*-----------------------------------------------------------*/
 
 size_t xPortGetFreeHeapSize(void) {
-    return xFreeBytesRemaining;
+    /* Free slots of slab pages are reusable, so they are free heap */
+    return xFreeBytesRemaining + memmgr_heap_slab_free_bytes;
 }
 /*-----------------------------------------------------------*/
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <cmsis_os2.h>
 
@@ -7,12 +8,18 @@
 extern "C" {
 #endif
 
+/* Entries of heap tracing table, 12 bytes each, 3/4 of them are used */
+#ifndef MEMMGR_HEAP_TRACE_SIZE
+#define MEMMGR_HEAP_TRACE_SIZE 512
+#endif
+
 /** Memmgr heap enable thread allocation tracking
  * @param thread_id - thread id to track
  */
 void memmgr_heap_enable_thread_trace(osThreadId_t thread_id);
 
-/** Memmgr heap disable thread allocation tracking
+/** Memmgr heap disable thread allocation tracking, allocations left are
+ * kept as leftovers of finished thread until freed or thread id is traced again
  * @param thread_id - thread id to track
  */
 void memmgr_heap_disable_thread_trace(osThreadId_t thread_id);
@@ -23,6 +30,59 @@ void memmgr_heap_disable_thread_trace(osThreadId_t thread_id);
  */
 size_t memmgr_heap_get_thread_memory(osThreadId_t thread_id);
 
+/** Memmgr heap get thread allocations not recorded because table was full,
+ * they are missing from memmgr_heap_get_thread_memory()
+ * @param thread_id - thread id to track
+ * @return allocations not recorded
+ */
+size_t memmgr_heap_get_thread_dropped(osThreadId_t thread_id);
+
+/** Live allocations of traced threads made from one place */
+typedef struct {
+    void* caller; /**< return address of malloc() and friends */
+    size_t size; /**< bytes, heap block headers included */
+    size_t count; /**< allocations */
+} MemmgrHeapTraceCaller;
+
+/** Heap tracing table usage */
+typedef struct {
+    size_t threads; /**< traced threads */
+    size_t finished_threads; /**< finished threads with leftovers */
+    size_t entries; /**< recorded allocations */
+    size_t leftovers; /**< recorded allocations of finished threads */
+    size_t capacity; /**< recorded allocations limit */
+    size_t dropped; /**< allocations not recorded because table was full */
+} MemmgrHeapTraceStats;
+
+/** Memmgr heap get live allocations of traced threads grouped by caller
+ * @param callers - array to fill, sorted by bytes, largest first
+ * @param count - size of array, callers which don't fit are skipped
+ * @param finished - leftovers of finished threads instead of running ones
+ * @return amount of filled callers
+ */
+size_t
+    memmgr_heap_get_trace_callers(MemmgrHeapTraceCaller* callers, size_t count, bool finished);
+
+/** Memmgr heap get tracing table usage
+ * @param stats - stats to fill
+ */
+void memmgr_heap_get_trace_stats(MemmgrHeapTraceStats* stats);
+
+/** Allocate memory like pvPortMalloc(), with caller for heap tracing
+ * @param size - bytes to allocate
+ * @param caller - address allocation is recorded from
+ * @return pointer to memory or NULL
+ */
+void* memmgr_heap_malloc(size_t size, void* caller);
+
+/** Resize memory like realloc(), with caller for heap tracing
+ * @param pointer - memory to resize, NULL to allocate
+ * @param size - new size, 0 to free
+ * @param caller - address allocation is recorded from
+ * @return pointer to memory or NULL
+ */
+void* memmgr_heap_realloc(void* pointer, size_t size, void* caller);
+
 /** Memmgr heap get the max contiguous block size on the heap
  * @return size_t max contiguous block size
  */
@@ -33,6 +93,25 @@ size_t memmgr_heap_get_max_free_block();
  */
 void memmgr_heap_printf_free_blocks();
 
+/** Statistics of slab size class, allocations not larger than size are
+ * served from pages of size class instead of heap free list
+ */
+typedef struct {
+    size_t size; /**< largest allocation of class */
+    size_t pages; /**< pages taken from heap */
+    size_t used; /**< allocated slots */
+    size_t free; /**< free slots in pages */
+    size_t peak; /**< maximum of allocated slots */
+    size_t allocs; /**< allocations served since start */
+} MemmgrHeapSlabStats;
+
+/** Memmgr heap get statistics of slab size classes
+ * @param stats - array to fill, from smallest class
+ * @param count - size of array
+ * @return amount of filled classes
+ */
+size_t memmgr_heap_get_slab_stats(MemmgrHeapSlabStats* stats, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
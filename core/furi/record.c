@@ -3,130 +3,219 @@
 #include "memmgr.h"
 
 #include <cmsis_os2.h>
-#include <m-string.h>
-#include <m-dict.h>
+#include <string.h>
 
 #define FURI_RECORD_FLAG_UPDATED 0x00000001U
 
-DICT_SET_DEF(osThreadIdSet, uint32_t)
-
+/* Records are table indexed by FuriRecordId. Well-known names take first
+ * slots, others are interned on first use and keep their slot, so open and
+ * close by id are table access under mutex, without allocations. Name lookup
+ * compares hashes, then pointers, identical literals are merged by linker,
+ * and only then strings. Holders are counted per open, so every open needs
+ * its close before record can be destroyed. Threads waiting for record
+ * creation are linked through entries on their own stacks, any number of
+ * them, and are woken up by create. */
 typedef struct {
+    const char* name;
+    uint32_t hash;
     void* data;
     osThreadId_t owner;
-    osThreadIdSet_t holders;
+    uint16_t holders;
+    bool created;
 } FuriRecord;
 
-DICT_DEF2(FuriRecordDict, string_t, STRING_OPLIST, FuriRecord, M_POD_OPLIST)
+typedef struct FuriRecordWaiter {
+    osThreadId_t thread;
+    FuriRecordId id;
+    struct FuriRecordWaiter* next;
+} FuriRecordWaiter;
 
 typedef struct {
     osMutexId_t records_mutex;
-    FuriRecordDict_t records;
+    FuriRecord records[FURI_RECORD_MAX];
+    size_t records_count;
+    FuriRecordWaiter* waiters;
 } FuriRecordData;
 
+#define ADD_RECORD(id, name) [FuriRecordId##id] = name,
+static const char* const furi_record_fixed_names[FuriRecordIdFixedCount] = {
+#include "record_config.h"
+};
+#undef ADD_RECORD
+
 static FuriRecordData* furi_record_data = NULL;
 
+/* FNV-1a */
+static uint32_t furi_record_hash(const char* name) {
+    uint32_t hash = 2166136261U;
+    while(*name) hash = (hash ^ (uint8_t)*name++) * 16777619U;
+    return hash;
+}
+
 void furi_record_init() {
     furi_record_data = furi_alloc(sizeof(FuriRecordData));
     furi_record_data->records_mutex = osMutexNew(NULL);
     furi_check(furi_record_data->records_mutex);
-    FuriRecordDict_init(furi_record_data->records);
+    for(size_t i = 0; i < FuriRecordIdFixedCount; i++) {
+        furi_record_data->records[i].name = furi_record_fixed_names[i];
+        furi_record_data->records[i].hash = furi_record_hash(furi_record_fixed_names[i]);
+    }
+    furi_record_data->records_count = FuriRecordIdFixedCount;
 }
 
-FuriRecord* furi_record_get_or_create(string_t name_str) {
-    furi_assert(furi_record_data);
-    FuriRecord* record = FuriRecordDict_get(furi_record_data->records, name_str);
-    if(!record) {
-        FuriRecord new_record;
-        new_record.data = NULL;
-        new_record.owner = NULL;
-        osThreadIdSet_init(new_record.holders);
-        FuriRecordDict_set_at(furi_record_data->records, name_str, new_record);
-        record = FuriRecordDict_get(furi_record_data->records, name_str);
+static inline void furi_record_lock() {
+    furi_check(osMutexAcquire(furi_record_data->records_mutex, osWaitForever) == osOK);
+}
+
+static inline void furi_record_unlock() {
+    furi_check(osMutexRelease(furi_record_data->records_mutex) == osOK);
+}
+
+/* Returns FURI_RECORD_MAX if name is not interned */
+static size_t furi_record_find(const char* name) {
+    const FuriRecord* records = furi_record_data->records;
+    size_t count = furi_record_data->records_count;
+
+    uint32_t hash = furi_record_hash(name);
+    for(size_t i = 0; i < count; i++) {
+        if(records[i].hash != hash) continue;
+        if(records[i].name == name || !strcmp(records[i].name, name)) return i;
     }
-    return record;
+    return FURI_RECORD_MAX;
+}
+
+static FuriRecordId furi_record_intern(const char* name) {
+    size_t id = furi_record_find(name);
+    if(id == FURI_RECORD_MAX) {
+        furi_check(furi_record_data->records_count < FURI_RECORD_MAX);
+        id = furi_record_data->records_count;
+        FuriRecord* record = &furi_record_data->records[id];
+        record->name = strdup(name);
+        furi_check(record->name);
+        record->hash = furi_record_hash(name);
+        furi_record_data->records_count++;
+    }
+    return id;
+}
+
+/* Unlocks mutex while waiting */
+static void furi_record_wait(FuriRecordId id) {
+    FuriRecordWaiter waiter = {
+        .thread = osThreadGetId(),
+        .id = id,
+        .next = furi_record_data->waiters,
+    };
+    furi_record_data->waiters = &waiter;
+
+    furi_record_unlock();
+    osThreadFlagsWait(FURI_RECORD_FLAG_UPDATED, osFlagsWaitAny, osWaitForever);
+    furi_record_lock();
+
+    FuriRecordWaiter** link = &furi_record_data->waiters;
+    while(*link != &waiter) link = &(*link)->next;
+    *link = waiter.next;
+}
+
+static void* furi_record_hold(FuriRecordId id) {
+    FuriRecord* record = &furi_record_data->records[id];
+    record->holders++;
+    while(!record->created) {
+        furi_record_wait(id);
+    }
+    return record->data;
+}
+
+FuriRecordId furi_record_get_id(const char* name) {
+    furi_assert(furi_record_data);
+    furi_assert(name);
+
+    furi_record_lock();
+    FuriRecordId id = furi_record_intern(name);
+    furi_record_unlock();
+
+    return id;
 }
 
 void furi_record_create(const char* name, void* data) {
     furi_assert(furi_record_data);
     osThreadId_t thread_id = osThreadGetId();
 
-    string_t name_str;
-    string_init_set_str(name_str, name);
-
-    // Acquire mutex
-    furi_check(osMutexAcquire(furi_record_data->records_mutex, osWaitForever) == osOK);
-    FuriRecord* record = furi_record_get_or_create(name_str);
+    furi_record_lock();
+    FuriRecordId id = furi_record_intern(name);
+    FuriRecord* record = &furi_record_data->records[id];
     record->data = data;
     record->owner = thread_id;
+    record->created = true;
 
-    // For each holder set event flag
-    osThreadIdSet_it_t it;
-    for(osThreadIdSet_it(it, record->holders); !osThreadIdSet_end_p(it); osThreadIdSet_next(it)) {
-        osThreadFlagsSet((osThreadId_t)*osThreadIdSet_ref(it), FURI_RECORD_FLAG_UPDATED);
+    // Wake up threads waiting for this record
+    for(const FuriRecordWaiter* waiter = furi_record_data->waiters; waiter;
+        waiter = waiter->next) {
+        if(waiter->id == id) {
+            osThreadFlagsSet(waiter->thread, FURI_RECORD_FLAG_UPDATED);
+        }
     }
-    // Release mutex
-    furi_check(osMutexRelease(furi_record_data->records_mutex) == osOK);
-
-    string_clear(name_str);
+    furi_record_unlock();
 }
 
 bool furi_record_destroy(const char* name) {
     furi_assert(furi_record_data);
     osThreadId_t thread_id = osThreadGetId();
 
-    string_t name_str;
-    string_init_set_str(name_str, name);
-
     bool destroyed = false;
-    furi_check(osMutexAcquire(furi_record_data->records_mutex, osWaitForever) == osOK);
-    FuriRecord* record = FuriRecordDict_get(furi_record_data->records, name_str);
-    if(record && record->owner == thread_id && osThreadIdSet_size(record->holders) == 0) {
-        osThreadIdSet_clear(record->holders);
-        FuriRecordDict_erase(furi_record_data->records, name_str);
-        destroyed = true;
+    furi_record_lock();
+    size_t id = furi_record_find(name);
+    if(id != FURI_RECORD_MAX) {
+        FuriRecord* record = &furi_record_data->records[id];
+        if(record->created && record->owner == thread_id && record->holders == 0) {
+            record->data = NULL;
+            record->owner = NULL;
+            record->created = false;
+            destroyed = true;
+        }
     }
-    furi_check(osMutexRelease(furi_record_data->records_mutex) == osOK);
+    furi_record_unlock();
 
-    string_clear(name_str);
     return destroyed;
 }
 
 void* furi_record_open(const char* name) {
     furi_assert(furi_record_data);
-    osThreadId_t thread_id = osThreadGetId();
 
-    string_t name_str;
-    string_init_set_str(name_str, name);
-
-    FuriRecord* record = NULL;
-    while(1) {
-        furi_check(osMutexAcquire(furi_record_data->records_mutex, osWaitForever) == osOK);
-        record = furi_record_get_or_create(name_str);
-        osThreadIdSet_push(record->holders, (uint32_t)thread_id);
-        furi_check(osMutexRelease(furi_record_data->records_mutex) == osOK);
-        // Check if owner is already arrived
-        if(record->owner) {
-            break;
-        }
-        // Wait for thread flag to appear
-        osThreadFlagsWait(FURI_RECORD_FLAG_UPDATED, osFlagsWaitAny, osWaitForever);
-    }
+    furi_record_lock();
+    void* data = furi_record_hold(furi_record_intern(name));
+    furi_record_unlock();
 
-    string_clear(name_str);
-    return record->data;
+    return data;
+}
+
+void* furi_record_open_id(FuriRecordId id) {
+    furi_assert(furi_record_data);
+    furi_assert(id < furi_record_data->records_count);
+
+    furi_record_lock();
+    void* data = furi_record_hold(id);
+    furi_record_unlock();
+
+    return data;
 }
 
 void furi_record_close(const char* name) {
     furi_assert(furi_record_data);
-    osThreadId_t thread_id = osThreadGetId();
 
-    string_t name_str;
-    string_init_set_str(name_str, name);
+    furi_record_lock();
+    size_t id = furi_record_find(name);
+    furi_check(id != FURI_RECORD_MAX);
+    furi_check(furi_record_data->records[id].holders > 0);
+    furi_record_data->records[id].holders--;
+    furi_record_unlock();
+}
 
-    furi_check(osMutexAcquire(furi_record_data->records_mutex, osWaitForever) == osOK);
-    FuriRecord* record = FuriRecordDict_get(furi_record_data->records, name_str);
-    osThreadIdSet_erase(record->holders, (uint32_t)thread_id);
-    furi_check(osMutexRelease(furi_record_data->records_mutex) == osOK);
+void furi_record_close_id(FuriRecordId id) {
+    furi_assert(furi_record_data);
+    furi_assert(id < furi_record_data->records_count);
 
-    string_clear(name_str);
+    furi_record_lock();
+    furi_check(furi_record_data->records[id].holders > 0);
+    furi_record_data->records[id].holders--;
+    furi_record_unlock();
 }
@@ -6,12 +6,35 @@
 extern "C" {
 #endif
 
+/** Maximum amount of record names, well-known ones included */
+#define FURI_RECORD_MAX 32
+
+/**
+ * Record id: interned record name
+ * Ids of well-known records from record_config.h are known at compile time,
+ * other names get id from furi_record_get_id().
+ */
+#define ADD_RECORD(id, name) FuriRecordId##id,
+typedef enum {
+#include "record_config.h"
+    FuriRecordIdFixedCount,
+} FuriRecordId;
+#undef ADD_RECORD
+
 /**
  * Initialize record storage
  * For internal use only.
  */
 void furi_record_init();
 
+/**
+ * Get record id, name is interned on first use
+ * @param name - record name
+ * @return record id, same for the same name until reboot
+ * @note Thread safe.
+ */
+FuriRecordId furi_record_get_id(const char* name);
+
 /**
  * Create record
  * @param name - record name
@@ -37,6 +60,14 @@ bool furi_record_destroy(const char* name);
  */
 void* furi_record_open(const char* name);
 
+/**
+ * Open record by id, without name lookup
+ * @param id - record id
+ * @return pointer to the record
+ * @note Thread safe. Suspends caller thread till record appear
+ */
+void* furi_record_open_id(FuriRecordId id);
+
 /**
  * Close record
  * @param name - record name
@@ -44,6 +75,13 @@ void* furi_record_open(const char* name);
  */
 void furi_record_close(const char* name);
 
+/**
+ * Close record by id, without name lookup
+ * @param id - record id
+ * @note Thread safe.
+ */
+void furi_record_close_id(FuriRecordId id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,11 @@
+ADD_RECORD(Storage, "storage")
+ADD_RECORD(Notification, "notification")
+ADD_RECORD(Gui, "gui")
+ADD_RECORD(Cli, "cli")
+ADD_RECORD(Dialogs, "dialogs")
+ADD_RECORD(Menu, "menu")
+ADD_RECORD(Loader, "loader")
+ADD_RECORD(InputEvents, "input_events")
+ADD_RECORD(Bt, "bt")
+ADD_RECORD(Power, "power")
+ADD_RECORD(Dolphin, "dolphin")
@@ -20,6 +20,7 @@ struct FuriThread {
 
     bool heap_trace_enabled;
     size_t heap_size;
+    size_t heap_dropped;
 };
 
 void furi_thread_set_state(FuriThread* thread, FuriThreadState state) {
@@ -46,6 +47,8 @@ void furi_thread_body(void* context) {
 
     if(thread->heap_trace_enabled == true) {
         thread->heap_size = memmgr_heap_get_thread_memory(thread_id);
+        thread->heap_dropped = memmgr_heap_get_thread_dropped(thread_id);
+        /* leftovers stay in heap trace until freed */
         memmgr_heap_disable_thread_trace(thread_id);
     }
 
@@ -167,3 +170,9 @@ size_t furi_thread_get_heap_size(FuriThread* thread) {
     furi_assert(thread->heap_trace_enabled == true);
     return thread->heap_size;
 }
+
+size_t furi_thread_get_heap_dropped(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->heap_trace_enabled == true);
+    return thread->heap_dropped;
+}
@@ -124,6 +124,11 @@ void furi_thread_disable_heap_trace(FuriThread* thread);
  */
 size_t furi_thread_get_heap_size(FuriThread* thread);
 
+/** Get thread allocations heap trace had no room for, heap size misses them
+ * @param thread - FuriThread instance
+ */
+size_t furi_thread_get_heap_dropped(FuriThread* thread);
+
 #ifdef __cplusplus
 }
 #endif
@@ -166,7 +166,7 @@ typedef enum {
 #define SD_TOKEN_START_DATA_SINGLE_BLOCK_WRITE \
     0xFE /* Data token start byte, Start Single Block Write */
 #define SD_TOKEN_START_DATA_MULTIPLE_BLOCK_WRITE \
-    0xFD /* Data token start byte, Start Multiple Block Write */
+    0xFC /* Data token start byte, Start Multiple Block Write */
 #define SD_TOKEN_STOP_DATA_MULTIPLE_BLOCK_WRITE \
     0xFD /* Data toke stop byte, Stop Multiple Block Write */
 
@@ -383,6 +383,7 @@ uint8_t BSP_SD_GetCardInfo(SD_CardInfo* pCardInfo) {
 
 /**
   * @brief  Reads block(s) from a specified address in the SD card, in polling mode. 
+  *         More than one block is read by single CMD18 (SD_CMD_READ_MULT_BLOCK).
   * @param  pData: Pointer to the buffer that will contain the data to transmit
   * @param  ReadAddr: Address from where data is to be read. The address is counted 
   *                   in blocks of 512bytes
@@ -417,34 +418,64 @@ BSP_SD_ReadBlocks(uint32_t* pData, uint32_t ReadAddr, uint32_t NumOfBlocks, uint
     /* Initialize the address */
     addr = (ReadAddr * ((flag_SDHC == 1) ? 1 : BlockSize));
 
-    /* Data transfer */
-    while(NumOfBlocks--) {
-        /* Send CMD17 (SD_CMD_READ_SINGLE_BLOCK) to read one block */
+    if(NumOfBlocks > 1) {
+        /* Send CMD18 (SD_CMD_READ_MULT_BLOCK) to read all blocks with one command */
         /* Check if the SD acknowledged the read block command: R1 response (0x00: no errors) */
-        response = SD_SendCmd(SD_CMD_READ_SINGLE_BLOCK, addr, 0xFF, SD_ANSWER_R1_EXPECTED);
+        response = SD_SendCmd(SD_CMD_READ_MULT_BLOCK, addr, 0xFF, SD_ANSWER_R1_EXPECTED);
         if(response.r1 != SD_R1_NO_ERROR) {
             goto error;
         }
 
-        /* Now look for the data token to signify the start of the data */
-        if(SD_WaitData(SD_TOKEN_START_DATA_SINGLE_BLOCK_READ) == BSP_SD_OK) {
-            /* Read the SD block data : read NumByteToRead data */
+        /* Card sends blocks one after another, each one with its own data token */
+        uint32_t block = 0;
+        for(; block < NumOfBlocks; block++) {
+            if(SD_WaitData(SD_TOKEN_START_DATA_MULTIPLE_BLOCK_READ) != BSP_SD_OK) {
+                break;
+            }
             SD_IO_WriteReadData(ptr, (uint8_t*)pData + offset, BlockSize);
-
-            /* Set next read address*/
             offset += BlockSize;
-            addr = ((flag_SDHC == 1) ? (addr + 1) : (addr + BlockSize));
 
             /* get CRC bytes (not really needed by us, but required by SD) */
             SD_IO_WriteByte(SD_DUMMY_BYTE);
             SD_IO_WriteByte(SD_DUMMY_BYTE);
-        } else {
+        }
+
+        /* Send CMD12 (SD_CMD_STOP_TRANSMISSION) to stop reading, on error too */
+        response = SD_SendCmd(SD_CMD_STOP_TRANSMISSION, 0, 0xFF, SD_ANSWER_R1B_EXPECTED);
+        if(block < NumOfBlocks || response.r1 != SD_R1_NO_ERROR) {
             goto error;
         }
+    } else {
+        /* Data transfer */
+        while(NumOfBlocks--) {
+            /* Send CMD17 (SD_CMD_READ_SINGLE_BLOCK) to read one block */
+            /* Check if the SD acknowledged the read block command:
+             R1 response (0x00: no errors) */
+            response = SD_SendCmd(SD_CMD_READ_SINGLE_BLOCK, addr, 0xFF, SD_ANSWER_R1_EXPECTED);
+            if(response.r1 != SD_R1_NO_ERROR) {
+                goto error;
+            }
 
-        /* End the command data read cycle */
-        SD_IO_CSState(1);
-        SD_IO_WriteByte(SD_DUMMY_BYTE);
+            /* Now look for the data token to signify the start of the data */
+            if(SD_WaitData(SD_TOKEN_START_DATA_SINGLE_BLOCK_READ) == BSP_SD_OK) {
+                /* Read the SD block data : read NumByteToRead data */
+                SD_IO_WriteReadData(ptr, (uint8_t*)pData + offset, BlockSize);
+
+                /* Set next read address*/
+                offset += BlockSize;
+                addr = ((flag_SDHC == 1) ? (addr + 1) : (addr + BlockSize));
+
+                /* get CRC bytes (not really needed by us, but required by SD) */
+                SD_IO_WriteByte(SD_DUMMY_BYTE);
+                SD_IO_WriteByte(SD_DUMMY_BYTE);
+            } else {
+                goto error;
+            }
+
+            /* End the command data read cycle */
+            SD_IO_CSState(1);
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
+        }
     }
 
     retr = BSP_SD_OK;
@@ -461,6 +492,7 @@ error:
 
 /**
   * @brief  Writes block(s) to a specified address in the SD card, in polling mode. 
+  *         More than one block is written by single CMD25 (SD_CMD_WRITE_MULT_BLOCK).
   * @param  pData: Pointer to the buffer that will contain the data to transmit
   * @param  WriteAddr: Address from where data is to be written. The address is counted 
   *                   in blocks of 512bytes
@@ -494,41 +526,83 @@ BSP_SD_WriteBlocks(uint32_t* pData, uint32_t WriteAddr, uint32_t NumOfBlocks, ui
     /* Initialize the address */
     addr = (WriteAddr * ((flag_SDHC == 1) ? 1 : BlockSize));
 
-    /* Data transfer */
-    while(NumOfBlocks--) {
-        /* Send CMD24 (SD_CMD_WRITE_SINGLE_BLOCK) to write blocks  and
+    if(NumOfBlocks > 1) {
+        /* Send CMD25 (SD_CMD_WRITE_MULT_BLOCK) to write all blocks with one command and
        Check if the SD acknowledged the write block command: R1 response (0x00: no errors) */
-        response = SD_SendCmd(SD_CMD_WRITE_SINGLE_BLOCK, addr, 0xFF, SD_ANSWER_R1_EXPECTED);
+        response = SD_SendCmd(SD_CMD_WRITE_MULT_BLOCK, addr, 0xFF, SD_ANSWER_R1_EXPECTED);
         if(response.r1 != SD_R1_NO_ERROR) {
             goto error;
         }
 
-        /* Send dummy byte for NWR timing : one byte between CMDWRITE and TOKEN */
-        SD_IO_WriteByte(SD_DUMMY_BYTE);
-        SD_IO_WriteByte(SD_DUMMY_BYTE);
+        uint32_t block = 0;
+        for(; block < NumOfBlocks; block++) {
+            /* Send dummy byte for NWR timing : one byte between blocks and TOKEN */
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
 
-        /* Send the data token to signify the start of the data */
-        SD_IO_WriteByte(SD_TOKEN_START_DATA_SINGLE_BLOCK_WRITE);
+            /* Send the data token to signify the start of the next block */
+            SD_IO_WriteByte(SD_TOKEN_START_DATA_MULTIPLE_BLOCK_WRITE);
+            SD_IO_WriteReadData((uint8_t*)pData + offset, ptr, BlockSize);
+            offset += BlockSize;
 
-        /* Write the block data to SD */
-        SD_IO_WriteReadData((uint8_t*)pData + offset, ptr, BlockSize);
+            /* Put CRC bytes (not really needed by us, but required by SD) */
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
 
-        /* Set next write address */
-        offset += BlockSize;
-        addr = ((flag_SDHC == 1) ? (addr + 1) : (addr + BlockSize));
-        
-        /* Put CRC bytes (not really needed by us, but required by SD) */
-        SD_IO_WriteByte(SD_DUMMY_BYTE);
-        SD_IO_WriteByte(SD_DUMMY_BYTE);
+            /* Read data response, waits while card is busy with the block */
+            if(SD_GetDataResponse() != SD_DATA_OK) {
+                break;
+            }
+        }
 
-        /* Read data response */
-        if(SD_GetDataResponse() != SD_DATA_OK) {
-            /* Set response value to failure */
+        if(block < NumOfBlocks) {
+            /* Rejected block: card expects CMD12 (SD_CMD_STOP_TRANSMISSION) */
+            SD_SendCmd(SD_CMD_STOP_TRANSMISSION, 0, 0xFF, SD_ANSWER_R1B_EXPECTED);
             goto error;
         }
 
-        SD_IO_CSState(1);
+        /* Send stop token and wait while card is busy with the last block */
+        SD_IO_WriteByte(SD_TOKEN_STOP_DATA_MULTIPLE_BLOCK_WRITE);
         SD_IO_WriteByte(SD_DUMMY_BYTE);
+        while(SD_IO_WriteByte(SD_DUMMY_BYTE) != 0xFF)
+            ;
+    } else {
+        /* Data transfer */
+        while(NumOfBlocks--) {
+            /* Send CMD24 (SD_CMD_WRITE_SINGLE_BLOCK) to write blocks  and
+           Check if the SD acknowledged the write block command: R1 response (0x00: no errors) */
+            response = SD_SendCmd(SD_CMD_WRITE_SINGLE_BLOCK, addr, 0xFF, SD_ANSWER_R1_EXPECTED);
+            if(response.r1 != SD_R1_NO_ERROR) {
+                goto error;
+            }
+
+            /* Send dummy byte for NWR timing : one byte between CMDWRITE and TOKEN */
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
+
+            /* Send the data token to signify the start of the data */
+            SD_IO_WriteByte(SD_TOKEN_START_DATA_SINGLE_BLOCK_WRITE);
+
+            /* Write the block data to SD */
+            SD_IO_WriteReadData((uint8_t*)pData + offset, ptr, BlockSize);
+
+            /* Set next write address */
+            offset += BlockSize;
+            addr = ((flag_SDHC == 1) ? (addr + 1) : (addr + BlockSize));
+        
+            /* Put CRC bytes (not really needed by us, but required by SD) */
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
+
+            /* Read data response */
+            if(SD_GetDataResponse() != SD_DATA_OK) {
+                /* Set response value to failure */
+                goto error;
+            }
+
+            SD_IO_CSState(1);
+            SD_IO_WriteByte(SD_DUMMY_BYTE);
+        }
     }
     retr = BSP_SD_OK;
 
@@ -828,6 +902,11 @@ SD_CmdAnswer_typedef SD_SendCmd(uint8_t Cmd, uint32_t Arg, uint8_t Crc, uint8_t
     SD_IO_CSState(0);
     SD_IO_WriteReadData(frame, frameout, SD_CMD_LENGTH); /* Send the Cmd bytes */
 
+    /* Byte after CMD12 is a stuff one: it may be data of read being stopped */
+    if(Cmd == SD_CMD_STOP_TRANSMISSION) {
+        SD_IO_WriteByte(SD_DUMMY_BYTE);
+    }
+
     switch(Answer) {
     case SD_ANSWER_R1_EXPECTED:
         retr.r1 = SD_ReadData();
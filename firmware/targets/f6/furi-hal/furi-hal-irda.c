@@ -16,6 +16,7 @@
 #include <math.h>
 #include <main.h>
 #include <furi-hal-pwm.h>
+#include <toolbox/level_duration_pingpong.h>
 
 #define IRDA_TX_DEBUG 0
 
@@ -26,6 +27,8 @@ const GpioPin gpio_irda_tx_debug = {.port = GPIOA, .pin = GPIO_PIN_7};
 
 #define IRDA_TIM_TX_DMA_BUFFER_SIZE         200
 #define IRDA_POLARITY_SHIFT                 1
+/* silence to hand over partially filled rx buffer, longer than any space inside of a frame */
+#define IRDA_RX_BUFFER_FLUSH_US             10000
 
 #define IRDA_TX_CCMR_HIGH    (TIM_CCMR2_OC3PE | LL_TIM_OCMODE_PWM2)              /* Mark time - enable PWM2 mode */
 #define IRDA_TX_CCMR_LOW     (TIM_CCMR2_OC3PE | LL_TIM_OCMODE_FORCED_INACTIVE)   /* Space time - force low */
@@ -35,6 +38,8 @@ typedef struct{
     void *capture_context;
     FuriHalIrdaRxTimeoutCallback timeout_callback;
     void *timeout_context;
+    bool buffered;
+    LevelDurationPingPong pingpong;
 } IrdaTimRx;
 
 typedef struct{
@@ -81,9 +86,26 @@ static uint8_t furi_hal_irda_get_current_dma_tx_buffer(void);
 static void furi_hal_irda_tx_dma_polarity_isr();
 static void furi_hal_irda_tx_dma_isr();
 
+static void furi_hal_irda_rx_capture(bool level, uint32_t duration) {
+    if(irda_tim_rx.buffered) {
+        level_duration_pingpong_put(&irda_tim_rx.pingpong, level_duration_make(level, duration));
+    } else if (irda_tim_rx.capture_callback) {
+        irda_tim_rx.capture_callback(irda_tim_rx.capture_context, level, duration);
+    }
+}
+
 static void furi_hal_irda_tim_rx_isr() {
     static uint32_t previous_captured_ch2 = 0;
 
+    /* Short silence, hand over what is captured */
+    if(LL_TIM_IsActiveFlag_CC4(TIM2)) {
+        LL_TIM_ClearFlag_CC4(TIM2);
+        furi_assert(furi_hal_irda_state == IrdaStateAsyncRx);
+
+        if (irda_tim_rx.buffered)
+            level_duration_pingpong_flush(&irda_tim_rx.pingpong);
+    }
+
     /* Timeout */
     if(LL_TIM_IsActiveFlag_CC3(TIM2)) {
         LL_TIM_ClearFlag_CC3(TIM2);
@@ -96,6 +118,8 @@ static void furi_hal_irda_tim_rx_isr() {
          * receiving new signal few microseconds ago, because CNT register
          * is reseted once per period, not per sample. */
         if (LL_GPIO_IsInputPinSet(gpio_irda_rx.port, gpio_irda_rx.pin) != 0) {
+            if (irda_tim_rx.buffered)
+                level_duration_pingpong_flush(&irda_tim_rx.pingpong);
             if (irda_tim_rx.timeout_callback)
                 irda_tim_rx.timeout_callback(irda_tim_rx.timeout_context);
         }
@@ -109,8 +133,7 @@ static void furi_hal_irda_tim_rx_isr() {
         if(READ_BIT(TIM2->CCMR1, TIM_CCMR1_CC1S)) {
             /* Low pin level is a Mark state of IRDA signal. Invert level for further processing. */
             uint32_t duration = LL_TIM_IC_GetCaptureCH1(TIM2) - previous_captured_ch2;
-            if (irda_tim_rx.capture_callback)
-                irda_tim_rx.capture_callback(irda_tim_rx.capture_context, 1, duration);
+            furi_hal_irda_rx_capture(1, duration);
         } else {
             furi_assert(0);
         }
@@ -125,8 +148,7 @@ static void furi_hal_irda_tim_rx_isr() {
             /* High pin level is a Space state of IRDA signal. Invert level for further processing. */
             uint32_t duration = LL_TIM_IC_GetCaptureCH2(TIM2);
             previous_captured_ch2 = duration;
-            if (irda_tim_rx.capture_callback)
-                irda_tim_rx.capture_callback(irda_tim_rx.capture_context, 0, duration);
+            furi_hal_irda_rx_capture(0, duration);
         } else {
             furi_assert(0);
         }
@@ -174,6 +196,13 @@ void furi_hal_irda_async_rx_start(void) {
     LL_TIM_CC_EnableChannel(TIM2, LL_TIM_CHANNEL_CH1);
     LL_TIM_CC_EnableChannel(TIM2, LL_TIM_CHANNEL_CH2);
 
+    if(irda_tim_rx.buffered) {
+        LL_TIM_OC_SetCompareCH4(TIM2, IRDA_RX_BUFFER_FLUSH_US);
+        LL_TIM_OC_SetMode(TIM2, LL_TIM_CHANNEL_CH4, LL_TIM_OCMODE_ACTIVE);
+        LL_TIM_CC_EnableChannel(TIM2, LL_TIM_CHANNEL_CH4);
+        LL_TIM_EnableIT_CC4(TIM2);
+    }
+
     LL_TIM_SetCounter(TIM2, 0);
     LL_TIM_EnableCounter(TIM2);
 
@@ -212,6 +241,20 @@ void furi_hal_irda_async_rx_set_timeout_isr_callback(FuriHalIrdaRxTimeoutCallbac
     irda_tim_rx.timeout_context = ctx;
 }
 
+void furi_hal_irda_async_rx_set_buffer_isr_callback(LevelDuration* buffer, size_t size, FuriHalIrdaRxBufferCallback callback, void *ctx) {
+    furi_assert(furi_hal_irda_state == IrdaStateIdle);
+
+    if (callback) {
+        level_duration_pingpong_init(&irda_tim_rx.pingpong, buffer, size, callback, ctx);
+    }
+    irda_tim_rx.buffered = (callback != NULL);
+}
+
+void furi_hal_irda_async_rx_release_buffer(const LevelDuration* buffer) {
+    furi_assert(irda_tim_rx.buffered);
+    level_duration_pingpong_release(&irda_tim_rx.pingpong, buffer);
+}
+
 static void furi_hal_irda_tx_dma_terminate(void) {
     LL_DMA_DisableIT_TC(DMA1, LL_DMA_CHANNEL_1);
     LL_DMA_DisableIT_HT(DMA1, LL_DMA_CHANNEL_2);
@@ -35,9 +35,13 @@ void furi_hal_vcp_init() {
 }
 
 size_t furi_hal_vcp_rx(uint8_t* buffer, size_t size) {
+    return furi_hal_vcp_rx_with_timeout(buffer, size, portMAX_DELAY);
+}
+
+size_t furi_hal_vcp_rx_with_timeout(uint8_t* buffer, size_t size, uint32_t timeout) {
     furi_assert(furi_hal_vcp);
 
-    size_t received = xStreamBufferReceive(furi_hal_vcp->rx_stream, buffer, size, portMAX_DELAY);
+    size_t received = xStreamBufferReceive(furi_hal_vcp->rx_stream, buffer, size, timeout);
 
     if(furi_hal_vcp->rx_stream_full
         &&xStreamBufferSpacesAvailable(furi_hal_vcp->rx_stream) >= APP_RX_DATA_SIZE) {
@@ -49,11 +53,6 @@ size_t furi_hal_vcp_rx(uint8_t* buffer, size_t size) {
     return received;
 }
 
-size_t furi_hal_vcp_rx_with_timeout(uint8_t* buffer, size_t size, uint32_t timeout) {
-    furi_assert(furi_hal_vcp);
-    return xStreamBufferReceive(furi_hal_vcp->rx_stream, buffer, size, timeout);
-}
-
 void furi_hal_vcp_tx(const uint8_t* buffer, size_t size) {
     furi_assert(furi_hal_vcp);
 
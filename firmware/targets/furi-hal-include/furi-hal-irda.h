@@ -2,6 +2,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -42,6 +43,18 @@ typedef void (*FuriHalIrdaRxCaptureCallback)(void* ctx, bool level, uint32_t dur
  */
 typedef void (*FuriHalIrdaRxTimeoutCallback)(void* ctx);
 
+/**
+ * Signature of callback function for receiving buffered IRDA rx signal.
+ * Buffer belongs to receiver until it is returned with
+ * 'furi_hal_irda_async_rx_release_buffer()'.
+ *
+ * @param   ctx[in] - context to pass to callback
+ * @param   buffer[in] - captured timings
+ * @param   size[in] - amount of captured timings
+ * @param   overrun[in] - timings were lost right before this buffer
+ */
+typedef void (*FuriHalIrdaRxBufferCallback)(void* ctx, const LevelDuration* buffer, size_t size, bool overrun);
+
 /**
  * Initialize IRDA RX timer to receive interrupts.
  * It provides interrupts for every RX-signal edge changing
@@ -78,6 +91,28 @@ void furi_hal_irda_async_rx_set_capture_isr_callback(FuriHalIrdaRxCaptureCallbac
  */
 void furi_hal_irda_async_rx_set_timeout_isr_callback(FuriHalIrdaRxTimeoutCallback callback, void *ctx);
 
+/**
+ * Setup buffered capture for IRDA RX. Has to be called before
+ * 'furi_hal_irda_async_rx_start()'. Instead of calling capture callback
+ * on every edge, hal stores timings into 2 buffers in turn and hands
+ * buffer over to callback when it is full or when there is no edge for
+ * a few milliseconds. Edges are dropped while both buffers are not released.
+ * Pass NULL callback to return to capture callback mode.
+ *
+ * @param[in]   buffer - memory for both buffers, 2 * size timings
+ * @param[in]   size - size of one buffer in timings
+ * @param[in]   callback - callback for filled buffer
+ * @param[in]   ctx - context to pass to callback
+ */
+void furi_hal_irda_async_rx_set_buffer_isr_callback(LevelDuration* buffer, size_t size, FuriHalIrdaRxBufferCallback callback, void *ctx);
+
+/**
+ * Return buffer received in buffer callback back to hal.
+ *
+ * @param[in]   buffer - buffer to release
+ */
+void furi_hal_irda_async_rx_release_buffer(const LevelDuration* buffer);
+
 /**
  * Check if IRDA is in use now.
  * @return  true - IRDA is busy, false otherwise.
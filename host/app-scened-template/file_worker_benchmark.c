@@ -0,0 +1,243 @@
+#include <furi.h>
+#include <furi-stub.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <m-string.h>
+#include <storage/storage.h>
+#include <file-worker.h>
+
+/*
+ * Line by line reading of text file through FileWorker over furi-stub
+ * storage: previous file_worker_read_until(), which read 32 bytes and
+ * rewound file with tell and seek after separator, against buffered
+ * file_worker_read_until() and file_worker_read_line() in place.
+ * Storage calls are counted by furi-stub, on target every call is a
+ * message round trip to storage service, so lines/s bound by round
+ * trips is printed for given call cost.
+ */
+
+#define BENCHMARK_PATH "/file_worker_benchmark.txt"
+#define BENCHMARK_RUNS 5
+
+typedef size_t (*BenchmarkReader)(FileWorker* file_worker, File* file, uint16_t buffer_size);
+
+static uint32_t benchmark_random_state = 0x2545F491;
+
+static uint32_t benchmark_random(void) {
+    benchmark_random_state ^= benchmark_random_state << 13;
+    benchmark_random_state ^= benchmark_random_state >> 17;
+    benchmark_random_state ^= benchmark_random_state << 5;
+    return benchmark_random_state;
+}
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* .ir like lines of different length */
+static void benchmark_write(const char* host_path, size_t lines) {
+    FILE* file = fopen(host_path, "w");
+    furi_check(file);
+
+    for(size_t i = 0; i < lines; ++i) {
+        if(benchmark_random() % 4) {
+            fprintf(
+                file,
+                "Button_%zu NEC A:%02lX C:%02lX\n",
+                i,
+                (unsigned long)(benchmark_random() & 0xFF),
+                (unsigned long)(benchmark_random() & 0xFF));
+        } else {
+            fprintf(file, "Button_%zu RAW F:38000 DC:33", i);
+            size_t timings = 8 + benchmark_random() % 24;
+            for(size_t j = 0; j < timings; ++j) {
+                fprintf(file, " %lu", (unsigned long)(200 + benchmark_random() % 2000));
+            }
+            fprintf(file, "\n");
+        }
+    }
+    fclose(file);
+}
+
+/* Reference: file_worker_read_until() before read buffer */
+static bool benchmark_reference_read_until(File* file, string_t str_result, char separator) {
+    string_clean(str_result);
+    const uint8_t buffer_size = 32;
+    uint8_t buffer[buffer_size];
+
+    do {
+        uint16_t read_count = storage_file_read(file, buffer, buffer_size);
+        if(storage_file_get_error(file) != FSE_OK) {
+            return false;
+        }
+
+        bool result = false;
+        for(uint16_t i = 0; i < read_count; i++) {
+            if(buffer[i] == separator) {
+                uint64_t position = storage_file_tell(file);
+                if(storage_file_get_error(file) != FSE_OK) {
+                    return false;
+                }
+
+                position = position - read_count + i + 1;
+
+                storage_file_seek(file, position, true);
+                if(storage_file_get_error(file) != FSE_OK) {
+                    return false;
+                }
+
+                result = true;
+                break;
+            } else {
+                string_push_back(str_result, buffer[i]);
+            }
+        }
+
+        if(result || read_count == 0) {
+            break;
+        }
+    } while(true);
+
+    return true;
+}
+
+static size_t benchmark_reference(FileWorker* file_worker, File* file, uint16_t buffer_size) {
+    size_t lines = 0;
+    string_t line;
+    string_init(line);
+
+    if(storage_file_open(file, BENCHMARK_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(benchmark_reference_read_until(file, line, '\n') && string_size(line)) {
+            ++lines;
+        }
+    }
+    storage_file_close(file);
+
+    string_clear(line);
+    return lines;
+}
+
+static size_t benchmark_read_until(FileWorker* file_worker, File* file, uint16_t buffer_size) {
+    size_t lines = 0;
+    string_t line;
+    string_init(line);
+
+    file_worker_set_read_buffer_size(file_worker, buffer_size);
+    if(file_worker_open(file_worker, BENCHMARK_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(file_worker_read_until(file_worker, line, '\n') && string_size(line)) {
+            ++lines;
+        }
+    }
+    file_worker_close(file_worker);
+
+    string_clear(line);
+    return lines;
+}
+
+static size_t benchmark_read_line(FileWorker* file_worker, File* file, uint16_t buffer_size) {
+    size_t lines = 0;
+    char* line;
+    size_t line_length;
+
+    file_worker_set_read_buffer_size(file_worker, buffer_size);
+    if(file_worker_open(file_worker, BENCHMARK_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        while(file_worker_read_line(file_worker, &line, &line_length, '\n')) {
+            ++lines;
+        }
+    }
+    file_worker_close(file_worker);
+
+    return lines;
+}
+
+static void benchmark_print(
+    const char* name,
+    BenchmarkReader reader,
+    uint16_t buffer_size,
+    double call_us) {
+    FileWorker* file_worker = file_worker_alloc(true);
+    File* file = storage_file_alloc(furi_record_open("storage"));
+    size_t lines = 0;
+    size_t calls = 0;
+    double best_ns = 0;
+
+    for(size_t run = 0; run < BENCHMARK_RUNS; ++run) {
+        size_t calls_before = furi_stub_storage_get_call_count();
+        uint64_t start = benchmark_time_ns();
+        lines = reader(file_worker, file, buffer_size);
+        double run_ns = benchmark_time_ns() - start;
+        calls = furi_stub_storage_get_call_count() - calls_before;
+        if(!run || (run_ns < best_ns)) best_ns = run_ns;
+    }
+
+    double calls_per_line = (double)calls / lines;
+    printf(
+        "%-24s %6u %8zu %12.0f %10.2f %12.0f\r\n",
+        name,
+        buffer_size,
+        lines,
+        lines / (best_ns / 1e9),
+        calls_per_line,
+        1e6 / (calls_per_line * call_us));
+
+    storage_file_free(file);
+    furi_record_close("storage");
+    file_worker_free(file_worker);
+}
+
+int main(int argc, char* argv[]) {
+    size_t lines = 10000;
+    uint16_t buffer_size = 1024;
+    double call_us = 20;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:b:c:")) != -1) {
+        switch(opt) {
+        case 'n':
+            lines = atoi(optarg);
+            break;
+        case 'b':
+            buffer_size = atoi(optarg);
+            break;
+        case 'c':
+            call_us = atof(optarg);
+            break;
+        default:
+            printf("Usage: %s [-n lines] [-b buffer size] [-c storage call us]\r\n", argv[0]);
+            return 1;
+        }
+    }
+    furi_check(lines > 0);
+    furi_check(buffer_size > 0);
+
+    char root[] = "/tmp/file_worker_benchmarkXXXXXX";
+    furi_check(mkdtemp(root));
+    setenv("FURI_STUB_STORAGE_ROOT", root, 1);
+    char host_path[sizeof(root) + sizeof(BENCHMARK_PATH)];
+    snprintf(host_path, sizeof(host_path), "%s%s", root, BENCHMARK_PATH);
+    benchmark_write(host_path, lines);
+
+    printf("%zu lines, storage call %.0f us\r\n", lines, call_us);
+    printf(
+        "%-24s %6s %8s %12s %10s %12s\r\n",
+        "reader",
+        "buffer",
+        "lines",
+        "lines/s",
+        "calls/line",
+        "call bound");
+    benchmark_print("read_until, previous", benchmark_reference, 32, call_us);
+    benchmark_print("read_until", benchmark_read_until, 256, call_us);
+    benchmark_print("read_line", benchmark_read_line, 256, call_us);
+    benchmark_print("read_line", benchmark_read_line, buffer_size, call_us);
+
+    unlink(host_path);
+    rmdir(root);
+    return 0;
+}
@@ -0,0 +1,378 @@
+#include <furi.h>
+#include <furi-hal-spi.h>
+#include <furi-hal-resources.h>
+#include <furi-hal-power.h>
+#include <furi-hal-sd.h>
+#include <string.h>
+#include "stm32_adafruit_sd.h"
+#include "minunit_vars.h"
+#include "minunit.h"
+
+/*
+ * firmware/targets/f6/Src/fatfs/stm32_adafruit_sd.c against SDHC card
+ * emulated at SD_IO_* link level, which is spi_sd_hal.c on target. Every byte
+ * sent by driver gets card answer: command responses after one byte of NCR,
+ * data blocks after data token, data response and busy after written block.
+ * Card does not reset its state on chip select, same as real one, and sends
+ * garbage stuff byte after CMD12. Commands are counted by index, so test
+ * checks that multi-block transfers are done with one command.
+ */
+
+#define TEST_SD_BLOCKS 64
+#define TEST_SD_BLOCK_SIZE 512
+#define TEST_SD_CRC_SIZE 2
+#define TEST_SD_COMMAND_SIZE 6
+#define TEST_SD_OUT_SIZE (TEST_SD_BLOCK_SIZE + 16)
+#define TEST_SD_COMMANDS 64
+#define TEST_SD_TRANSFER_BLOCKS 8
+
+#define TEST_SD_CMD_STOP_TRANSMISSION 12
+#define TEST_SD_CMD_READ_SINGLE_BLOCK 17
+#define TEST_SD_CMD_READ_MULT_BLOCK 18
+#define TEST_SD_CMD_WRITE_SINGLE_BLOCK 24
+#define TEST_SD_CMD_WRITE_MULT_BLOCK 25
+
+typedef enum {
+    TestSdIdle,
+    TestSdReadMultiple,
+    TestSdWriteSingle,
+    TestSdWriteMultiple,
+    TestSdWriteData,
+} TestSdState;
+
+typedef struct {
+    uint8_t blocks[TEST_SD_BLOCKS][TEST_SD_BLOCK_SIZE];
+    bool selected;
+    bool ready;
+    bool app_command;
+    TestSdState state;
+    bool write_multiple;
+    uint32_t block;
+
+    uint8_t command[TEST_SD_COMMAND_SIZE];
+    size_t command_size;
+    uint8_t data[TEST_SD_BLOCK_SIZE + TEST_SD_CRC_SIZE];
+    size_t data_size;
+    uint8_t out[TEST_SD_OUT_SIZE];
+    size_t out_size;
+    size_t out_pos;
+
+    uint32_t commands[TEST_SD_COMMANDS];
+} TestSd;
+
+extern uint16_t flag_SDHC;
+
+static TestSd test_sd;
+static const FuriHalSpiDevice test_sd_spi_device = {.chip_select = &gpio_sdcard_cs};
+
+const GpioPin gpio_sdcard_cs = {.pin = 0};
+const GpioPin gpio_spi_d_miso = {.pin = 1};
+const GpioPin gpio_spi_d_mosi = {.pin = 2};
+const GpioPin gpio_spi_d_sck = {.pin = 3};
+
+static void test_sd_push(const uint8_t* data, size_t size) {
+    furi_check(test_sd.out_size + size <= TEST_SD_OUT_SIZE);
+    memcpy(&test_sd.out[test_sd.out_size], data, size);
+    test_sd.out_size += size;
+}
+
+static void test_sd_push_byte(uint8_t byte) {
+    test_sd_push(&byte, 1);
+}
+
+static void test_sd_push_block(uint32_t block) {
+    /* access time, data token, data and CRC */
+    test_sd_push_byte(0xFF);
+    test_sd_push_byte(0xFF);
+    test_sd_push_byte(0xFE);
+    test_sd_push(test_sd.blocks[block], TEST_SD_BLOCK_SIZE);
+    test_sd_push_byte(0x00);
+    test_sd_push_byte(0x00);
+}
+
+static void test_sd_respond(uint8_t r1) {
+    test_sd.out_size = 0;
+    test_sd.out_pos = 0;
+    /* NCR */
+    test_sd_push_byte(0xFF);
+    test_sd_push_byte(r1);
+}
+
+static uint8_t test_sd_address_r1(uint32_t block) {
+    return block < TEST_SD_BLOCKS ? 0x00 : 0x40;
+}
+
+static void test_sd_command(uint8_t index, uint32_t arg) {
+    bool app_command = test_sd.app_command;
+    test_sd.app_command = false;
+    if(index < TEST_SD_COMMANDS) test_sd.commands[index]++;
+
+    if(index == 0) {
+        test_sd.ready = false;
+        test_sd.state = TestSdIdle;
+        test_sd_respond(0x01);
+    } else if(index == 8) {
+        /* R7: voltage accepted, check pattern */
+        test_sd_respond(0x01);
+        const uint8_t r7[] = {0x00, 0x00, 0x01, 0xAA};
+        test_sd_push(r7, sizeof(r7));
+    } else if(index == 55) {
+        test_sd.app_command = true;
+        test_sd_respond(test_sd.ready ? 0x00 : 0x01);
+    } else if(index == 41 && app_command) {
+        test_sd.ready = true;
+        test_sd_respond(0x00);
+    } else if(index == 58) {
+        /* R3: OCR with CCS, SDHC */
+        test_sd_respond(0x00);
+        const uint8_t ocr[] = {0xC0, 0xFF, 0x80, 0x00};
+        test_sd_push(ocr, sizeof(ocr));
+    } else if(index == 16) {
+        test_sd_respond(arg == TEST_SD_BLOCK_SIZE ? 0x00 : 0x40);
+    } else if(index == TEST_SD_CMD_READ_SINGLE_BLOCK) {
+        test_sd_respond(test_sd_address_r1(arg));
+        if(arg < TEST_SD_BLOCKS) test_sd_push_block(arg);
+    } else if(index == TEST_SD_CMD_READ_MULT_BLOCK) {
+        test_sd_respond(test_sd_address_r1(arg));
+        if(arg < TEST_SD_BLOCKS) {
+            test_sd.state = TestSdReadMultiple;
+            test_sd.block = arg;
+        }
+    } else if(index == TEST_SD_CMD_STOP_TRANSMISSION) {
+        /* stuff byte is not 0xFF, then R1 and busy */
+        test_sd_respond(0x00);
+        test_sd.out[0] = 0x5A;
+        test_sd_push_byte(0x00);
+        test_sd_push_byte(0x00);
+        test_sd.state = TestSdIdle;
+    } else if(
+        index == TEST_SD_CMD_WRITE_SINGLE_BLOCK || index == TEST_SD_CMD_WRITE_MULT_BLOCK) {
+        test_sd_respond(test_sd_address_r1(arg));
+        if(arg < TEST_SD_BLOCKS) {
+            test_sd.write_multiple = index == TEST_SD_CMD_WRITE_MULT_BLOCK;
+            test_sd.state = test_sd.write_multiple ? TestSdWriteMultiple : TestSdWriteSingle;
+            test_sd.block = arg;
+        }
+    } else {
+        /* illegal command */
+        test_sd_respond(0x04);
+    }
+}
+
+static void test_sd_receive(uint8_t byte) {
+    if(test_sd.state == TestSdWriteData) {
+        test_sd.data[test_sd.data_size++] = byte;
+        if(test_sd.data_size == sizeof(test_sd.data)) {
+            /* data accepted, busy while block is programmed */
+            bool accepted = test_sd.block < TEST_SD_BLOCKS;
+            if(accepted) {
+                memcpy(test_sd.blocks[test_sd.block], test_sd.data, TEST_SD_BLOCK_SIZE);
+                test_sd.block++;
+            }
+            test_sd_push_byte(accepted ? 0x05 : 0x0D);
+            test_sd_push_byte(0x00);
+            test_sd_push_byte(0x00);
+            test_sd.state = test_sd.write_multiple ? TestSdWriteMultiple : TestSdIdle;
+        }
+    } else if(
+        (test_sd.state == TestSdWriteSingle && byte == 0xFE) ||
+        (test_sd.state == TestSdWriteMultiple && byte == 0xFC)) {
+        test_sd.state = TestSdWriteData;
+        test_sd.data_size = 0;
+    } else if(test_sd.state == TestSdWriteMultiple && byte == 0xFD) {
+        /* stop token: one byte, then busy with last block */
+        test_sd_push_byte(0xFF);
+        test_sd_push_byte(0x00);
+        test_sd_push_byte(0x00);
+        test_sd.state = TestSdIdle;
+    } else if(test_sd.command_size || (byte & 0xC0) == 0x40) {
+        test_sd.command[test_sd.command_size++] = byte;
+        if(test_sd.command_size == TEST_SD_COMMAND_SIZE) {
+            test_sd.command_size = 0;
+            uint32_t arg = (uint32_t)test_sd.command[1] << 24 |
+                           (uint32_t)test_sd.command[2] << 16 |
+                           (uint32_t)test_sd.command[3] << 8 | test_sd.command[4];
+            test_sd_command(test_sd.command[0] & 0x3F, arg);
+        }
+    }
+}
+
+static uint8_t test_sd_exchange(uint8_t byte) {
+    if(!test_sd.selected) return 0xFF;
+
+    if(test_sd.out_pos == test_sd.out_size) {
+        test_sd.out_size = 0;
+        test_sd.out_pos = 0;
+        /* card keeps sending blocks until CMD12 */
+        if(test_sd.state == TestSdReadMultiple && test_sd.block < TEST_SD_BLOCKS) {
+            test_sd_push_block(test_sd.block++);
+        }
+    }
+    uint8_t answer = test_sd.out_pos < test_sd.out_size ? test_sd.out[test_sd.out_pos++] : 0xFF;
+
+    test_sd_receive(byte);
+    return answer;
+}
+
+static void test_sd_reset_commands(void) {
+    memset(test_sd.commands, 0, sizeof(test_sd.commands));
+}
+
+/* SD_IO_* link of spi_sd_hal.c */
+void SD_IO_Init(void) {
+    test_sd.selected = false;
+}
+
+void SD_IO_CSState(uint8_t val) {
+    test_sd.selected = !val;
+}
+
+void SD_IO_WriteReadData(const uint8_t* DataIn, uint8_t* DataOut, uint16_t DataLength) {
+    for(uint16_t i = 0; i < DataLength; i++) {
+        DataOut[i] = test_sd_exchange(DataIn[i]);
+    }
+}
+
+uint8_t SD_IO_WriteByte(uint8_t Data) {
+    return test_sd_exchange(Data);
+}
+
+void HAL_Delay(__IO uint32_t Delay) {
+}
+
+/* bus, pins and power are not touched without card reset */
+const FuriHalSpiDevice* furi_hal_spi_device_get(FuriHalSpiDeviceId device_id) {
+    return &test_sd_spi_device;
+}
+
+void furi_hal_spi_device_return(const FuriHalSpiDevice* device) {
+}
+
+void hal_gpio_init_ex(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed,
+    const GpioAltFn alt_fn) {
+}
+
+void hal_gpio_write(const GpioPin* gpio, const bool state) {
+}
+
+void furi_hal_power_enable_external_3_3v() {
+}
+
+void furi_hal_power_disable_external_3_3v() {
+}
+
+void hal_sd_detect_init(void) {
+}
+
+void hal_sd_detect_set_low(void) {
+}
+
+static void test_sd_fill(uint8_t* data, size_t size, uint8_t seed) {
+    for(size_t i = 0; i < size; i++) {
+        data[i] = (uint8_t)(i * 7 + seed);
+    }
+}
+
+static void test_sd_setup(void) {
+    memset(&test_sd, 0, sizeof(test_sd));
+    for(size_t i = 0; i < TEST_SD_BLOCKS; i++) {
+        test_sd_fill(test_sd.blocks[i], TEST_SD_BLOCK_SIZE, i);
+    }
+    furi_check(BSP_SD_Init(false) == BSP_SD_OK);
+    test_sd_reset_commands();
+}
+
+MU_TEST(sd_spi_init_test) {
+    mu_assert_int_eq(1, flag_SDHC);
+    mu_check(test_sd.ready);
+}
+
+MU_TEST(sd_spi_read_multiple_test) {
+    static uint32_t buffer[TEST_SD_TRANSFER_BLOCKS * TEST_SD_BLOCK_SIZE / 4];
+    const uint32_t first = 3;
+
+    mu_assert_int_eq(
+        BSP_SD_OK, BSP_SD_ReadBlocks(buffer, first, TEST_SD_TRANSFER_BLOCKS, 0));
+    for(size_t i = 0; i < TEST_SD_TRANSFER_BLOCKS; i++) {
+        mu_check(!memcmp(
+            (uint8_t*)buffer + i * TEST_SD_BLOCK_SIZE,
+            test_sd.blocks[first + i],
+            TEST_SD_BLOCK_SIZE));
+    }
+    mu_assert_int_eq(1, test_sd.commands[TEST_SD_CMD_READ_MULT_BLOCK]);
+    mu_assert_int_eq(1, test_sd.commands[TEST_SD_CMD_STOP_TRANSMISSION]);
+    mu_assert_int_eq(0, test_sd.commands[TEST_SD_CMD_READ_SINGLE_BLOCK]);
+    mu_assert_int_eq(TestSdIdle, test_sd.state);
+}
+
+MU_TEST(sd_spi_write_multiple_test) {
+    static uint32_t buffer[TEST_SD_TRANSFER_BLOCKS * TEST_SD_BLOCK_SIZE / 4];
+    const uint32_t first = 20;
+
+    test_sd_fill((uint8_t*)buffer, sizeof(buffer), 0xA5);
+    mu_assert_int_eq(
+        BSP_SD_OK, BSP_SD_WriteBlocks(buffer, first, TEST_SD_TRANSFER_BLOCKS, 0));
+    for(size_t i = 0; i < TEST_SD_TRANSFER_BLOCKS; i++) {
+        mu_check(!memcmp(
+            test_sd.blocks[first + i],
+            (uint8_t*)buffer + i * TEST_SD_BLOCK_SIZE,
+            TEST_SD_BLOCK_SIZE));
+    }
+    mu_assert_int_eq(1, test_sd.commands[TEST_SD_CMD_WRITE_MULT_BLOCK]);
+    mu_assert_int_eq(0, test_sd.commands[TEST_SD_CMD_WRITE_SINGLE_BLOCK]);
+    mu_assert_int_eq(0, test_sd.commands[TEST_SD_CMD_STOP_TRANSMISSION]);
+    mu_assert_int_eq(TestSdIdle, test_sd.state);
+
+    /* data written is read back by the next command */
+    static uint32_t check[TEST_SD_BLOCK_SIZE / 4];
+    mu_assert_int_eq(BSP_SD_OK, BSP_SD_ReadBlocks(check, first + 1, 1, 0));
+    mu_check(!memcmp(check, (uint8_t*)buffer + TEST_SD_BLOCK_SIZE, TEST_SD_BLOCK_SIZE));
+}
+
+MU_TEST(sd_spi_single_block_test) {
+    static uint32_t buffer[TEST_SD_BLOCK_SIZE / 4];
+
+    mu_assert_int_eq(BSP_SD_OK, BSP_SD_ReadBlocks(buffer, 7, 1, 0));
+    mu_check(!memcmp(buffer, test_sd.blocks[7], TEST_SD_BLOCK_SIZE));
+    test_sd_fill((uint8_t*)buffer, sizeof(buffer), 0x3C);
+    mu_assert_int_eq(BSP_SD_OK, BSP_SD_WriteBlocks(buffer, 9, 1, 0));
+    mu_check(!memcmp(test_sd.blocks[9], buffer, TEST_SD_BLOCK_SIZE));
+
+    mu_assert_int_eq(1, test_sd.commands[TEST_SD_CMD_READ_SINGLE_BLOCK]);
+    mu_assert_int_eq(1, test_sd.commands[TEST_SD_CMD_WRITE_SINGLE_BLOCK]);
+    mu_assert_int_eq(0, test_sd.commands[TEST_SD_CMD_READ_MULT_BLOCK]);
+    mu_assert_int_eq(0, test_sd.commands[TEST_SD_CMD_WRITE_MULT_BLOCK]);
+}
+
+MU_TEST(sd_spi_read_out_of_range_test) {
+    static uint32_t buffer[TEST_SD_TRANSFER_BLOCKS * TEST_SD_BLOCK_SIZE / 4];
+
+    /* card stops sending at its end, read fails, card is usable after it */
+    mu_assert_int_eq(
+        BSP_SD_ERROR,
+        BSP_SD_ReadBlocks(buffer, TEST_SD_BLOCKS - 2, TEST_SD_TRANSFER_BLOCKS, 0));
+    mu_assert_int_eq(1, test_sd.commands[TEST_SD_CMD_STOP_TRANSMISSION]);
+    mu_assert_int_eq(TestSdIdle, test_sd.state);
+    mu_assert_int_eq(BSP_SD_OK, BSP_SD_ReadBlocks(buffer, 0, 2, 0));
+    mu_check(!memcmp(buffer, test_sd.blocks[0], TEST_SD_BLOCK_SIZE));
+}
+
+MU_TEST_SUITE(test_sd_spi) {
+    MU_SUITE_CONFIGURE(&test_sd_setup, NULL);
+    MU_RUN_TEST(sd_spi_init_test);
+    MU_RUN_TEST(sd_spi_read_multiple_test);
+    MU_RUN_TEST(sd_spi_write_multiple_test);
+    MU_RUN_TEST(sd_spi_single_block_test);
+    MU_RUN_TEST(sd_spi_read_out_of_range_test);
+}
+
+int main(void) {
+    MU_RUN_SUITE(test_sd_spi);
+    MU_REPORT();
+
+    return minunit_fail;
+}
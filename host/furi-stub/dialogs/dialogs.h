@@ -0,0 +1,69 @@
+#pragma once
+
+/* Host stand-in for applications/dialogs/dialogs.h.
+ * There is no screen on host: messages are printed, file select fails. */
+
+#include <furi.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    AlignLeft,
+    AlignRight,
+    AlignTop,
+    AlignBottom,
+    AlignCenter,
+} Align;
+
+typedef struct Icon Icon;
+
+extern const Icon I_SDQuestion_35x43;
+
+typedef struct DialogsApp DialogsApp;
+
+bool dialog_file_select_show(
+    DialogsApp* context,
+    const char* path,
+    const char* extension,
+    char* result,
+    uint8_t result_size,
+    const char* preselected_filename);
+
+typedef enum {
+    DialogMessageButtonBack,
+    DialogMessageButtonLeft,
+    DialogMessageButtonCenter,
+    DialogMessageButtonRight,
+} DialogMessageButton;
+
+typedef struct DialogMessage DialogMessage;
+
+DialogMessage* dialog_message_alloc();
+
+void dialog_message_free(DialogMessage* message);
+
+void dialog_message_set_text(
+    DialogMessage* message,
+    const char* text,
+    uint8_t x,
+    uint8_t y,
+    Align horizontal,
+    Align vertical);
+
+void dialog_message_set_icon(DialogMessage* message, const Icon* icon, uint8_t x, uint8_t y);
+
+void dialog_message_set_buttons(
+    DialogMessage* message,
+    const char* left,
+    const char* center,
+    const char* right);
+
+DialogMessageButton dialog_message_show(DialogsApp* context, const DialogMessage* message);
+
+#ifdef __cplusplus
+}
+#endif
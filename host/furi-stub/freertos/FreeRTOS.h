@@ -0,0 +1,31 @@
+#pragma once
+
+/* Host stand-in for FreeRTOS.h, enough to build core/furi/memmgr_heap.c.
+ * Single thread: scheduler suspension is a no-op. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <furi/check.h>
+
+typedef long BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+
+#define portBYTE_ALIGNMENT 8
+#define portBYTE_ALIGNMENT_MASK (0x0007)
+
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define configASSERT(x) furi_check(x)
+#define mtCOVERAGE_TEST_MARKER()
+
+void* pvPortMalloc(size_t xSize);
+void vPortFree(void* pv);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
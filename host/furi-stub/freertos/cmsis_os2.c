@@ -0,0 +1,287 @@
+#include "cmsis_os2.h"
+#include <furi/check.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Thread flags are pthread condition, timeout is ignored: nothing on host
+ * waits with timeout. Threads run until process ends. */
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t flags;
+    osThreadFunc_t func;
+    void* argument;
+} HostThread;
+
+static __thread HostThread* host_thread_current = NULL;
+
+static void* host_thread_body(void* context) {
+    HostThread* thread = context;
+    host_thread_current = thread;
+    thread->func(thread->argument);
+    return NULL;
+}
+
+osKernelState_t osKernelGetState(void) {
+    return osKernelRunning;
+}
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void* argument, const osThreadAttr_t* attr) {
+    HostThread* thread = calloc(1, sizeof(HostThread));
+    furi_check(thread);
+    pthread_mutex_init(&thread->mutex, NULL);
+    pthread_cond_init(&thread->cond, NULL);
+    thread->func = func;
+    thread->argument = argument;
+    furi_check(pthread_create(&thread->thread, NULL, host_thread_body, thread) == 0);
+    pthread_detach(thread->thread);
+    return thread;
+}
+
+#ifdef FURI_STUB_THREADS
+osThreadId_t osThreadGetId(void) {
+    return host_thread_current;
+}
+#endif
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags) {
+    HostThread* thread = thread_id;
+    pthread_mutex_lock(&thread->mutex);
+    thread->flags |= flags;
+    flags = thread->flags;
+    pthread_cond_signal(&thread->cond);
+    pthread_mutex_unlock(&thread->mutex);
+    return flags;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout) {
+    HostThread* thread = host_thread_current;
+    furi_check(thread);
+    pthread_mutex_lock(&thread->mutex);
+    while(!(thread->flags & flags)) {
+        pthread_cond_wait(&thread->cond, &thread->mutex);
+    }
+    uint32_t result = thread->flags;
+    thread->flags &= ~flags;
+    pthread_mutex_unlock(&thread->mutex);
+    return result;
+}
+
+/* Mutex is not recursive, timeout is ignored as for thread flags */
+osMutexId_t osMutexNew(const osMutexAttr_t* attr) {
+    pthread_mutex_t* mutex = calloc(1, sizeof(pthread_mutex_t));
+    furi_check(mutex);
+    pthread_mutex_init(mutex, NULL);
+    return mutex;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout) {
+    return pthread_mutex_lock(mutex_id) ? osError : osOK;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id) {
+    return pthread_mutex_unlock(mutex_id) ? osError : osOK;
+}
+
+osStatus_t osDelay(uint32_t ticks) {
+    usleep(ticks * 1000);
+    return osOK;
+}
+
+/* Event flags and message queues honor timeout, in ms */
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t flags;
+} HostEventFlags;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t head;
+    uint32_t count;
+    uint8_t* data;
+} HostMessageQueue;
+
+static void host_cond_init(pthread_cond_t* cond) {
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/* false on timeout */
+static bool host_cond_wait(
+    pthread_cond_t* cond,
+    pthread_mutex_t* mutex,
+    const struct timespec* deadline,
+    uint32_t timeout) {
+    if(timeout == osWaitForever) {
+        pthread_cond_wait(cond, mutex);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, mutex, deadline) == 0;
+}
+
+static void host_deadline(struct timespec* deadline, uint32_t timeout) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    if(timeout == osWaitForever) return;
+    deadline->tv_sec += timeout / 1000;
+    deadline->tv_nsec += (timeout % 1000) * 1000000L;
+    if(deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t* attr) {
+    HostEventFlags* event_flags = calloc(1, sizeof(HostEventFlags));
+    furi_check(event_flags);
+    pthread_mutex_init(&event_flags->mutex, NULL);
+    host_cond_init(&event_flags->cond);
+    return event_flags;
+}
+
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags) {
+    HostEventFlags* event_flags = ef_id;
+    pthread_mutex_lock(&event_flags->mutex);
+    event_flags->flags |= flags;
+    flags = event_flags->flags;
+    pthread_cond_broadcast(&event_flags->cond);
+    pthread_mutex_unlock(&event_flags->mutex);
+    return flags;
+}
+
+uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags) {
+    HostEventFlags* event_flags = ef_id;
+    pthread_mutex_lock(&event_flags->mutex);
+    uint32_t result = event_flags->flags;
+    event_flags->flags &= ~flags;
+    pthread_mutex_unlock(&event_flags->mutex);
+    return result;
+}
+
+uint32_t osEventFlagsGet(osEventFlagsId_t ef_id) {
+    HostEventFlags* event_flags = ef_id;
+    pthread_mutex_lock(&event_flags->mutex);
+    uint32_t result = event_flags->flags;
+    pthread_mutex_unlock(&event_flags->mutex);
+    return result;
+}
+
+uint32_t
+    osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout) {
+    HostEventFlags* event_flags = ef_id;
+    struct timespec deadline;
+    host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&event_flags->mutex);
+    while(true) {
+        uint32_t set = event_flags->flags & flags;
+        if((options & osFlagsWaitAll) ? (set == flags) : (set != 0)) break;
+        if(!timeout ||
+           !host_cond_wait(&event_flags->cond, &event_flags->mutex, &deadline, timeout)) {
+            pthread_mutex_unlock(&event_flags->mutex);
+            return osFlagsErrorTimeout;
+        }
+    }
+    uint32_t result = event_flags->flags;
+    if(!(options & osFlagsNoClear)) event_flags->flags &= ~flags;
+    pthread_mutex_unlock(&event_flags->mutex);
+    return result;
+}
+
+osStatus_t osEventFlagsDelete(osEventFlagsId_t ef_id) {
+    HostEventFlags* event_flags = ef_id;
+    pthread_cond_destroy(&event_flags->cond);
+    pthread_mutex_destroy(&event_flags->mutex);
+    free(event_flags);
+    return osOK;
+}
+
+osMessageQueueId_t
+    osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t* attr) {
+    HostMessageQueue* queue = calloc(1, sizeof(HostMessageQueue));
+    furi_check(queue);
+    queue->data = calloc(msg_count, msg_size);
+    furi_check(queue->data);
+    queue->msg_count = msg_count;
+    queue->msg_size = msg_size;
+    pthread_mutex_init(&queue->mutex, NULL);
+    host_cond_init(&queue->cond);
+    return queue;
+}
+
+osStatus_t osMessageQueuePut(
+    osMessageQueueId_t mq_id,
+    const void* msg_ptr,
+    uint8_t msg_prio,
+    uint32_t timeout) {
+    HostMessageQueue* queue = mq_id;
+    struct timespec deadline;
+    host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&queue->mutex);
+    while(queue->count == queue->msg_count) {
+        if(!timeout || !host_cond_wait(&queue->cond, &queue->mutex, &deadline, timeout)) {
+            pthread_mutex_unlock(&queue->mutex);
+            return timeout ? osErrorTimeout : osErrorResource;
+        }
+    }
+    uint32_t tail = (queue->head + queue->count) % queue->msg_count;
+    memcpy(&queue->data[tail * queue->msg_size], msg_ptr, queue->msg_size);
+    queue->count++;
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+    return osOK;
+}
+
+osStatus_t osMessageQueueGet(
+    osMessageQueueId_t mq_id,
+    void* msg_ptr,
+    uint8_t* msg_prio,
+    uint32_t timeout) {
+    HostMessageQueue* queue = mq_id;
+    struct timespec deadline;
+    host_deadline(&deadline, timeout);
+
+    pthread_mutex_lock(&queue->mutex);
+    while(queue->count == 0) {
+        if(!timeout || !host_cond_wait(&queue->cond, &queue->mutex, &deadline, timeout)) {
+            pthread_mutex_unlock(&queue->mutex);
+            return timeout ? osErrorTimeout : osErrorResource;
+        }
+    }
+    memcpy(msg_ptr, &queue->data[queue->head * queue->msg_size], queue->msg_size);
+    queue->head = (queue->head + 1) % queue->msg_count;
+    queue->count--;
+    if(msg_prio) *msg_prio = 0;
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->mutex);
+    return osOK;
+}
+
+uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    pthread_mutex_lock(&queue->mutex);
+    uint32_t space = queue->msg_count - queue->count;
+    pthread_mutex_unlock(&queue->mutex);
+    return space;
+}
+
+osStatus_t osMessageQueueDelete(osMessageQueueId_t mq_id) {
+    HostMessageQueue* queue = mq_id;
+    pthread_cond_destroy(&queue->cond);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue->data);
+    free(queue);
+    return osOK;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+/* Host stand-in for cmsis_os2.h. Heap has no threads: osThreadGetId() is NULL,
+ * so heap thread tracing never records anything, unless FURI_STUB_THREAD_ID is
+ * defined: then it is furi_stub_thread_id, which heap checks switch by hand.
+ * With FURI_STUB_THREADS it is thread of osThreadNew(). Threads and thread flags for
+ * core/furi/log.c, mutexes for core/furi/record.c, event flags and message
+ * queues for irda_worker are pthreads, in cmsis_os2.c. Ticks are ms. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define osWaitForever 0xFFFFFFFFU
+#define osFlagsWaitAny 0x00000000U
+#define osFlagsWaitAll 0x00000001U
+#define osFlagsNoClear 0x00000002U
+#define osFlagsError 0x80000000U
+#define osFlagsErrorTimeout 0xFFFFFFFEU
+
+typedef void* osThreadId_t;
+typedef void* osMutexId_t;
+typedef void* osEventFlagsId_t;
+typedef void* osMessageQueueId_t;
+typedef void (*osThreadFunc_t)(void* argument);
+
+typedef enum {
+    osOK = 0,
+    osError = -1,
+    osErrorTimeout = -2,
+    osErrorResource = -3,
+} osStatus_t;
+
+typedef enum {
+    osKernelInactive = 0,
+    osKernelReady = 1,
+    osKernelRunning = 2,
+} osKernelState_t;
+
+typedef enum {
+    osPriorityNone = 0,
+    osPriorityIdle = 1,
+    osPriorityLow = 8,
+    osPriorityNormal = 24,
+} osPriority_t;
+
+typedef struct {
+    const char* name;
+    uint32_t stack_size;
+    osPriority_t priority;
+} osThreadAttr_t;
+
+typedef struct {
+    const char* name;
+} osMutexAttr_t;
+
+typedef struct {
+    const char* name;
+} osEventFlagsAttr_t;
+
+typedef struct {
+    const char* name;
+} osMessageQueueAttr_t;
+
+#ifdef FURI_STUB_THREAD_ID
+extern osThreadId_t furi_stub_thread_id;
+
+static inline osThreadId_t osThreadGetId(void) {
+    return furi_stub_thread_id;
+}
+#elif defined(FURI_STUB_THREADS)
+/* NULL for threads not started by osThreadNew() */
+osThreadId_t osThreadGetId(void);
+#else
+static inline osThreadId_t osThreadGetId(void) {
+    return NULL;
+}
+#endif
+
+static inline int32_t osKernelLock(void) {
+    return 0;
+}
+
+static inline int32_t osKernelUnlock(void) {
+    return 0;
+}
+
+osKernelState_t osKernelGetState(void);
+osThreadId_t osThreadNew(osThreadFunc_t func, void* argument, const osThreadAttr_t* attr);
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+osStatus_t osDelay(uint32_t ticks);
+osMutexId_t osMutexNew(const osMutexAttr_t* attr);
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout);
+osStatus_t osMutexRelease(osMutexId_t mutex_id);
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t* attr);
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags);
+uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags);
+uint32_t osEventFlagsGet(osEventFlagsId_t ef_id);
+uint32_t
+    osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout);
+osStatus_t osEventFlagsDelete(osEventFlagsId_t ef_id);
+osMessageQueueId_t
+    osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t* attr);
+osStatus_t osMessageQueuePut(
+    osMessageQueueId_t mq_id,
+    const void* msg_ptr,
+    uint8_t msg_prio,
+    uint32_t timeout);
+osStatus_t osMessageQueueGet(
+    osMessageQueueId_t mq_id,
+    void* msg_ptr,
+    uint8_t* msg_prio,
+    uint32_t timeout);
+uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id);
+osStatus_t osMessageQueueDelete(osMessageQueueId_t mq_id);
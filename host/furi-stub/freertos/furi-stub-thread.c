@@ -0,0 +1,109 @@
+#include <furi.h>
+#include <pthread.h>
+#include <string.h>
+
+/* FuriThread over joinable pthread, stack size is only remembered. State
+ * callback is called from thread itself, as on target. */
+struct FuriThread {
+    FuriThreadState state;
+    int32_t ret;
+
+    FuriThreadCallback callback;
+    void* context;
+
+    FuriThreadStateCallback state_callback;
+    void* state_context;
+
+    char* name;
+    size_t stack_size;
+    pthread_t thread;
+    bool joinable;
+};
+
+static void furi_thread_set_state(FuriThread* thread, FuriThreadState state) {
+    __atomic_store_n(&thread->state, state, __ATOMIC_RELEASE);
+    if(thread->state_callback) {
+        thread->state_callback(state, thread->state_context);
+    }
+}
+
+static void* furi_thread_body(void* context) {
+    FuriThread* thread = context;
+
+    furi_thread_set_state(thread, FuriThreadStateRunning);
+    thread->ret = thread->callback(thread->context);
+    furi_thread_set_state(thread, FuriThreadStateStopped);
+
+    return NULL;
+}
+
+FuriThread* furi_thread_alloc() {
+    return furi_alloc(sizeof(FuriThread));
+}
+
+void furi_thread_free(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+
+    furi_thread_join(thread);
+    free(thread->name);
+    free(thread);
+}
+
+void furi_thread_set_name(FuriThread* thread, const char* name) {
+    furi_assert(thread);
+    free(thread->name);
+    thread->name = strdup(name);
+}
+
+void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
+    furi_assert(thread);
+    thread->stack_size = stack_size;
+}
+
+void furi_thread_set_callback(FuriThread* thread, FuriThreadCallback callback) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->callback = callback;
+}
+
+void furi_thread_set_context(FuriThread* thread, void* context) {
+    furi_assert(thread);
+    furi_assert(thread->state == FuriThreadStateStopped);
+    thread->context = context;
+}
+
+void furi_thread_set_state_callback(FuriThread* thread, FuriThreadStateCallback callback) {
+    furi_assert(thread);
+    thread->state_callback = callback;
+}
+
+void furi_thread_set_state_context(FuriThread* thread, void* context) {
+    furi_assert(thread);
+    thread->state_context = context;
+}
+
+FuriThreadState furi_thread_get_state(FuriThread* thread) {
+    furi_assert(thread);
+    return __atomic_load_n(&thread->state, __ATOMIC_ACQUIRE);
+}
+
+bool furi_thread_start(FuriThread* thread) {
+    furi_assert(thread);
+    furi_assert(thread->callback);
+    furi_assert(thread->state == FuriThreadStateStopped);
+
+    furi_thread_set_state(thread, FuriThreadStateStarting);
+    furi_check(pthread_create(&thread->thread, NULL, furi_thread_body, thread) == 0);
+    thread->joinable = true;
+    return true;
+}
+
+osStatus_t furi_thread_join(FuriThread* thread) {
+    furi_assert(thread);
+    if(thread->joinable) {
+        pthread_join(thread->thread, NULL);
+        thread->joinable = false;
+    }
+    return osOK;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+/* Host stand-in for stm32wbxx_hal.h: millisecond tick only */
+
+#include <stdint.h>
+#include <time.h>
+
+static inline uint32_t HAL_GetTick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
@@ -0,0 +1,108 @@
+#include "stream_buffer.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct HostStreamBuffer {
+    pthread_mutex_t mutex;
+    size_t size;
+    size_t head;
+    size_t count;
+    uint8_t data[];
+};
+
+StreamBufferHandle_t xStreamBufferCreate(size_t xBufferSizeBytes, size_t xTriggerLevelBytes) {
+    StreamBufferHandle_t stream = calloc(1, sizeof(struct HostStreamBuffer) + xBufferSizeBytes);
+    furi_check(stream);
+    pthread_mutex_init(&stream->mutex, NULL);
+    stream->size = xBufferSizeBytes;
+    return stream;
+}
+
+void vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer) {
+    pthread_mutex_destroy(&xStreamBuffer->mutex);
+    free(xStreamBuffer);
+}
+
+size_t xStreamBufferSend(
+    StreamBufferHandle_t xStreamBuffer,
+    const void* pvTxData,
+    size_t xDataLengthBytes,
+    TickType_t xTicksToWait) {
+    const uint8_t* data = pvTxData;
+
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    size_t space = xStreamBuffer->size - xStreamBuffer->count;
+    size_t size = (xDataLengthBytes < space) ? xDataLengthBytes : space;
+    for(size_t i = 0; i < size; i++) {
+        size_t tail = (xStreamBuffer->head + xStreamBuffer->count) % xStreamBuffer->size;
+        xStreamBuffer->data[tail] = data[i];
+        xStreamBuffer->count++;
+    }
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+    return size;
+}
+
+size_t xStreamBufferSendFromISR(
+    StreamBufferHandle_t xStreamBuffer,
+    const void* pvTxData,
+    size_t xDataLengthBytes,
+    BaseType_t* const pxHigherPriorityTaskWoken) {
+    if(pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+    return xStreamBufferSend(xStreamBuffer, pvTxData, xDataLengthBytes, 0);
+}
+
+size_t xStreamBufferReceive(
+    StreamBufferHandle_t xStreamBuffer,
+    void* pvRxData,
+    size_t xBufferLengthBytes,
+    TickType_t xTicksToWait) {
+    uint8_t* data = pvRxData;
+
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    size_t size =
+        (xBufferLengthBytes < xStreamBuffer->count) ? xBufferLengthBytes : xStreamBuffer->count;
+    for(size_t i = 0; i < size; i++) {
+        data[i] = xStreamBuffer->data[xStreamBuffer->head];
+        xStreamBuffer->head = (xStreamBuffer->head + 1) % xStreamBuffer->size;
+        xStreamBuffer->count--;
+    }
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+    return size;
+}
+
+size_t xStreamBufferReceiveFromISR(
+    StreamBufferHandle_t xStreamBuffer,
+    void* pvRxData,
+    size_t xBufferLengthBytes,
+    BaseType_t* const pxHigherPriorityTaskWoken) {
+    if(pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+    return xStreamBufferReceive(xStreamBuffer, pvRxData, xBufferLengthBytes, 0);
+}
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer) {
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    size_t space = xStreamBuffer->size - xStreamBuffer->count;
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+    return space;
+}
+
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer) {
+    return xStreamBufferSpacesAvailable(xStreamBuffer) == 0;
+}
+
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer) {
+    return xStreamBufferSpacesAvailable(xStreamBuffer) == xStreamBuffer->size;
+}
+
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer) {
+    pthread_mutex_lock(&xStreamBuffer->mutex);
+    xStreamBuffer->head = 0;
+    xStreamBuffer->count = 0;
+    pthread_mutex_unlock(&xStreamBuffer->mutex);
+    return pdPASS;
+}
+
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel) {
+    return xTriggerLevel <= xStreamBuffer->size;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "FreeRTOS.h"
+#include <time.h>
+
+static inline void vTaskSuspendAll(void) {
+}
+
+static inline BaseType_t xTaskResumeAll(void) {
+    return pdFALSE;
+}
+
+/* 1 kHz tick */
+static inline TickType_t xTaskGetTickCount(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
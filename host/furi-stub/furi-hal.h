@@ -0,0 +1,21 @@
+#pragma once
+
+/* Host stand-in for furi-hal.h: there is no hardware on host, only
+ * the types hal headers bring to libraries and delays are provided. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <toolbox/level_duration.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void delay(float milliseconds);
+
+void delay_us(float microseconds);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+#include <dialogs/dialogs.h>
+#include <stdio.h>
+
+struct Icon {
+    uint8_t dummy;
+};
+
+struct DialogMessage {
+    const char* text;
+};
+
+const Icon I_SDQuestion_35x43;
+
+bool dialog_file_select_show(
+    DialogsApp* context,
+    const char* path,
+    const char* extension,
+    char* result,
+    uint8_t result_size,
+    const char* preselected_filename) {
+    (void)context;
+    (void)path;
+    (void)extension;
+    (void)result;
+    (void)result_size;
+    (void)preselected_filename;
+    return false;
+}
+
+DialogMessage* dialog_message_alloc() {
+    return furi_alloc(sizeof(DialogMessage));
+}
+
+void dialog_message_free(DialogMessage* message) {
+    free(message);
+}
+
+void dialog_message_set_text(
+    DialogMessage* message,
+    const char* text,
+    uint8_t x,
+    uint8_t y,
+    Align horizontal,
+    Align vertical) {
+    (void)x;
+    (void)y;
+    (void)horizontal;
+    (void)vertical;
+    message->text = text;
+}
+
+void dialog_message_set_icon(DialogMessage* message, const Icon* icon, uint8_t x, uint8_t y) {
+    (void)message;
+    (void)icon;
+    (void)x;
+    (void)y;
+}
+
+void dialog_message_set_buttons(
+    DialogMessage* message,
+    const char* left,
+    const char* center,
+    const char* right) {
+    (void)message;
+    (void)left;
+    (void)center;
+    (void)right;
+}
+
+DialogMessageButton dialog_message_show(DialogsApp* context, const DialogMessage* message) {
+    (void)context;
+    if(message->text) fprintf(stderr, "dialog: %s\r\n", message->text);
+    return DialogMessageButtonBack;
+}
@@ -0,0 +1,73 @@
+#include "furi-stub.h"
+#include <furi/memmgr.h>
+#include <malloc.h>
+#include <string.h>
+
+static FuriStubHeapStats furi_stub_heap_stats;
+static size_t furi_stub_heap_size = 256 * 1024 * 1024;
+
+void* __real_malloc(size_t size);
+void __real_free(void* ptr);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+static void furi_stub_heap_account_alloc(void* ptr) {
+    if(!ptr) return;
+    size_t size = malloc_usable_size(ptr);
+    furi_stub_heap_stats.alloc_count++;
+    furi_stub_heap_stats.alloc_bytes += size;
+    furi_stub_heap_stats.used_bytes += size;
+}
+
+static void furi_stub_heap_account_free(void* ptr) {
+    if(!ptr) return;
+    furi_stub_heap_stats.free_count++;
+    furi_stub_heap_stats.used_bytes -= malloc_usable_size(ptr);
+}
+
+void* __wrap_malloc(size_t size) {
+    void* ptr = __real_malloc(size);
+    furi_stub_heap_account_alloc(ptr);
+    return ptr;
+}
+
+void __wrap_free(void* ptr) {
+    furi_stub_heap_account_free(ptr);
+    __real_free(ptr);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void* ptr = __real_calloc(count, size);
+    furi_stub_heap_account_alloc(ptr);
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    size_t old_size = ptr ? malloc_usable_size(ptr) : 0;
+    void* new_ptr = __real_realloc(ptr, size);
+    if(new_ptr || !size) {
+        if(ptr) {
+            furi_stub_heap_stats.free_count++;
+            furi_stub_heap_stats.used_bytes -= old_size;
+        }
+        furi_stub_heap_account_alloc(new_ptr);
+    }
+    return new_ptr;
+}
+
+void furi_stub_heap_get_stats(FuriStubHeapStats* stats) {
+    memcpy(stats, &furi_stub_heap_stats, sizeof(FuriStubHeapStats));
+}
+
+void furi_stub_heap_set_size(size_t size) {
+    furi_stub_heap_size = size;
+}
+
+size_t memmgr_get_free_heap(void) {
+    if(furi_stub_heap_stats.used_bytes >= furi_stub_heap_size) return 0;
+    return furi_stub_heap_size - furi_stub_heap_stats.used_bytes;
+}
+
+size_t memmgr_get_minimum_free_heap(void) {
+    return memmgr_get_free_heap();
+}
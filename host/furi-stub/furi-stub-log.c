@@ -0,0 +1,12 @@
+#include <furi.h>
+#include <stdio.h>
+
+/* Synchronous, without timestamps. Replaced by core/furi/log.c in log_benchmark. */
+void furi_log_print(FuriLogLevel level, const char* format, ...) {
+    if(level > FURI_LOG_LEVEL) return;
+
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
@@ -0,0 +1,77 @@
+#include <furi.h>
+#include <string.h>
+
+/* Records live in a small table indexed by record id, well-known names from
+ * record_config.h come first. There are no services on host, so an unknown
+ * record is opened as NULL: host stubs of storage and dialogs do not need an
+ * instance. */
+
+typedef struct {
+    const char* name;
+    void* data;
+    bool created;
+} FuriStubRecord;
+
+#define ADD_RECORD(id, name) [FuriRecordId##id] = {name, NULL, false},
+static FuriStubRecord furi_stub_records[FURI_RECORD_MAX] = {
+#include <furi/record_config.h>
+};
+#undef ADD_RECORD
+
+static size_t furi_stub_records_count = FuriRecordIdFixedCount;
+
+static FuriStubRecord* furi_stub_record_find(const char* name) {
+    for(size_t i = 0; i < furi_stub_records_count; i++) {
+        if(!strcmp(furi_stub_records[i].name, name)) {
+            return &furi_stub_records[i];
+        }
+    }
+    return NULL;
+}
+
+void furi_record_init() {
+}
+
+FuriRecordId furi_record_get_id(const char* name) {
+    furi_assert(name);
+    FuriStubRecord* record = furi_stub_record_find(name);
+    if(!record) {
+        furi_check(furi_stub_records_count < FURI_RECORD_MAX);
+        record = &furi_stub_records[furi_stub_records_count++];
+        record->name = name;
+    }
+    return record - furi_stub_records;
+}
+
+void furi_record_create(const char* name, void* data) {
+    FuriStubRecord* record = &furi_stub_records[furi_record_get_id(name)];
+    furi_check(!record->created);
+    record->data = data;
+    record->created = true;
+}
+
+bool furi_record_destroy(const char* name) {
+    FuriStubRecord* record = furi_stub_record_find(name);
+    if(!record || !record->created) return false;
+    record->data = NULL;
+    record->created = false;
+    return true;
+}
+
+void* furi_record_open(const char* name) {
+    FuriStubRecord* record = furi_stub_record_find(name);
+    return record ? record->data : NULL;
+}
+
+void* furi_record_open_id(FuriRecordId id) {
+    furi_check(id < furi_stub_records_count);
+    return furi_stub_records[id].data;
+}
+
+void furi_record_close(const char* name) {
+    (void)name;
+}
+
+void furi_record_close_id(FuriRecordId id) {
+    furi_check(id < furi_stub_records_count);
+}
@@ -0,0 +1,221 @@
+#include <storage/storage.h>
+#include <furi-stub.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FURI_STUB_STORAGE_PATH_MAX 512
+
+struct File {
+    FILE* file;
+    FS_Error error_id;
+};
+
+static size_t furi_stub_storage_calls;
+
+size_t furi_stub_storage_get_call_count(void) {
+    return furi_stub_storage_calls;
+}
+
+static void furi_stub_storage_path(const char* path, char* host_path) {
+    const char* root = getenv("FURI_STUB_STORAGE_ROOT");
+    snprintf(host_path, FURI_STUB_STORAGE_PATH_MAX, "%s%s", root ? root : ".", path);
+}
+
+static FS_Error furi_stub_storage_error(int error) {
+    switch(error) {
+    case 0:
+        return FSE_OK;
+    case ENOENT:
+    case ENOTDIR:
+        return FSE_NOT_EXIST;
+    case EEXIST:
+    case ENOTEMPTY:
+        return FSE_EXIST;
+    case EACCES:
+    case EPERM:
+    case EISDIR:
+        return FSE_DENIED;
+    case ENAMETOOLONG:
+        return FSE_INVALID_NAME;
+    default:
+        return FSE_INTERNAL;
+    }
+}
+
+File* storage_file_alloc(Storage* storage) {
+    (void)storage;
+    return furi_alloc(sizeof(File));
+}
+
+void storage_file_free(File* file) {
+    if(storage_file_is_open(file)) storage_file_close(file);
+    free(file);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    ++furi_stub_storage_calls;
+    furi_assert(!file->file);
+
+    char host_path[FURI_STUB_STORAGE_PATH_MAX];
+    furi_stub_storage_path(path, host_path);
+    bool write = access_mode & FSAM_WRITE;
+    bool read = access_mode & FSAM_READ;
+    const char* mode = read ? (write ? "r+b" : "rb") : "r+b";
+
+    errno = 0;
+    struct stat st;
+    bool exist = !stat(host_path, &st);
+    if((open_mode == FSOM_CREATE_NEW) && exist) {
+        file->error_id = FSE_EXIST;
+        return false;
+    }
+    if((open_mode == FSOM_CREATE_ALWAYS) || (open_mode == FSOM_CREATE_NEW) ||
+       (!exist && (open_mode != FSOM_OPEN_EXISTING))) {
+        mode = read ? "w+b" : "wb";
+    }
+    if(open_mode == FSOM_OPEN_APPEND) {
+        mode = read ? "a+b" : "ab";
+    }
+
+    errno = 0;
+    file->file = fopen(host_path, mode);
+    file->error_id = furi_stub_storage_error(file->file ? 0 : errno);
+    return file->file != NULL;
+}
+
+bool storage_file_close(File* file) {
+    ++furi_stub_storage_calls;
+    if(!file->file) return false;
+    file->error_id = furi_stub_storage_error(fclose(file->file) ? errno : 0);
+    file->file = NULL;
+    return file->error_id == FSE_OK;
+}
+
+bool storage_file_is_open(File* file) {
+    return file->file != NULL;
+}
+
+uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read) {
+    ++furi_stub_storage_calls;
+    furi_assert(file->file);
+    size_t read = fread(buff, 1, bytes_to_read, file->file);
+    file->error_id = ferror(file->file) ? FSE_INTERNAL : FSE_OK;
+    return read;
+}
+
+uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write) {
+    ++furi_stub_storage_calls;
+    furi_assert(file->file);
+    size_t written = fwrite(buff, 1, bytes_to_write, file->file);
+    file->error_id = ferror(file->file) ? FSE_INTERNAL : FSE_OK;
+    return written;
+}
+
+size_t storage_file_read_v(File* file, const FileIoVec* iov, size_t iov_count) {
+    ++furi_stub_storage_calls;
+    furi_assert(file->file);
+    size_t read = 0;
+    file->error_id = FSE_OK;
+    for(size_t i = 0; i < iov_count; i++) {
+        size_t buffer_read = fread(iov[i].buff, 1, iov[i].size, file->file);
+        read += buffer_read;
+        if(ferror(file->file)) file->error_id = FSE_INTERNAL;
+        if(buffer_read < iov[i].size) break;
+    }
+    return read;
+}
+
+size_t storage_file_write_v(File* file, const FileIoConstVec* iov, size_t iov_count) {
+    ++furi_stub_storage_calls;
+    furi_assert(file->file);
+    size_t written = 0;
+    file->error_id = FSE_OK;
+    for(size_t i = 0; i < iov_count; i++) {
+        size_t buffer_written = fwrite(iov[i].buff, 1, iov[i].size, file->file);
+        written += buffer_written;
+        if(ferror(file->file)) file->error_id = FSE_INTERNAL;
+        if(buffer_written < iov[i].size) break;
+    }
+    return written;
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    ++furi_stub_storage_calls;
+    furi_assert(file->file);
+    errno = 0;
+    fseek(file->file, offset, from_start ? SEEK_SET : SEEK_CUR);
+    file->error_id = furi_stub_storage_error(errno);
+    return file->error_id == FSE_OK;
+}
+
+uint64_t storage_file_tell(File* file) {
+    ++furi_stub_storage_calls;
+    furi_assert(file->file);
+    file->error_id = FSE_OK;
+    return ftell(file->file);
+}
+
+uint64_t storage_file_size(File* file) {
+    ++furi_stub_storage_calls;
+    furi_assert(file->file);
+    struct stat st;
+    file->error_id = furi_stub_storage_error(fstat(fileno(file->file), &st) ? errno : 0);
+    return file->error_id == FSE_OK ? (uint64_t)st.st_size : 0;
+}
+
+bool storage_file_eof(File* file) {
+    furi_assert(file->file);
+    return storage_file_tell(file) >= storage_file_size(file);
+}
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    (void)storage;
+    char host_path[FURI_STUB_STORAGE_PATH_MAX];
+    furi_stub_storage_path(path, host_path);
+
+    struct stat st;
+    if(stat(host_path, &st)) return furi_stub_storage_error(errno);
+    if(fileinfo) {
+        fileinfo->flags = S_ISDIR(st.st_mode) ? FSF_DIRECTORY : 0;
+        fileinfo->size = st.st_size;
+    }
+    return FSE_OK;
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    (void)storage;
+    char host_path[FURI_STUB_STORAGE_PATH_MAX];
+    furi_stub_storage_path(path, host_path);
+    return furi_stub_storage_error(remove(host_path) ? errno : 0);
+}
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path) {
+    (void)storage;
+    char host_old_path[FURI_STUB_STORAGE_PATH_MAX];
+    char host_new_path[FURI_STUB_STORAGE_PATH_MAX];
+    furi_stub_storage_path(old_path, host_old_path);
+    furi_stub_storage_path(new_path, host_new_path);
+    return furi_stub_storage_error(rename(host_old_path, host_new_path) ? errno : 0);
+}
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path) {
+    (void)storage;
+    char host_path[FURI_STUB_STORAGE_PATH_MAX];
+    furi_stub_storage_path(path, host_path);
+    return furi_stub_storage_error(mkdir(host_path, 0777) ? errno : 0);
+}
+
+FS_Error storage_file_get_error(File* file) {
+    return file->error_id;
+}
+
+const char* storage_file_get_error_desc(File* file) {
+    return filesystem_api_error_get_desc(file->error_id);
+}
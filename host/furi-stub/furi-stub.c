@@ -0,0 +1,17 @@
+#include <furi.h>
+#include <furi-hal.h>
+#include <stdio.h>
+#include <unistd.h>
+
+void __furi_check(void) {
+    fprintf(stderr, "furi_check failed\r\n");
+    abort();
+}
+
+void delay(float milliseconds) {
+    usleep(milliseconds * 1000);
+}
+
+void delay_us(float microseconds) {
+    usleep(microseconds);
+}
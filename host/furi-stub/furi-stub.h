@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Heap usage of code linked against furi-stub, malloc/calloc/realloc/free are wrapped */
+typedef struct {
+    size_t alloc_count;
+    size_t alloc_bytes;
+    size_t free_count;
+    size_t used_bytes;
+} FuriStubHeapStats;
+
+void furi_stub_heap_get_stats(FuriStubHeapStats* stats);
+
+/* Heap size memmgr_get_free_heap() is counted from, 256 MiB by default */
+void furi_stub_heap_set_size(size_t size);
+
+/* Calls of storage file API: open, close, read, write, seek, tell and size.
+ * On target every one of them is a message round trip to storage service */
+size_t furi_stub_storage_get_call_count(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+/* Host stand-in for core/furi.h.
+ * Only the RTOS-independent part of furi is exposed, so libraries that
+ * need nothing more than alloc/assert/log/record can be built and run on Linux. */
+
+#include <furi/common_defines.h>
+#include <furi/check.h>
+#include <furi/memmgr.h>
+#include <furi/log.h>
+#include <furi/record.h>
+
+/* Threads and RTOS primitives are pthreads of furi-stub/freertos, only for
+ * builds which have it on include path */
+#if __has_include(<cmsis_os2.h>)
+#include <cmsis_os2.h>
+#include <task.h>
+#include <furi/thread.h>
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+
+/* newlib integer-only printf family used by firmware code */
+#define sniprintf snprintf
+#define siprintf sprintf
@@ -0,0 +1,5 @@
+#pragma once
+
+/* Host stand-in, delays of furi-stub */
+
+#include <furi-hal.h>
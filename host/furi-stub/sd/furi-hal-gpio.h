@@ -0,0 +1,49 @@
+#pragma once
+
+/* Host stand-ins for f6 furi-hal headers included by SPI SD card driver
+ * (firmware/targets/f6/Src/fatfs/stm32_adafruit_sd.c), only what it uses.
+ * Pins, bus and power are not driven: card is emulated at SD_IO_* link
+ * level by host/fatfs/sd_spi_test.c, which also defines these functions. */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    GpioModeOutputPushPull,
+    GpioModeAltFunctionPushPull,
+} GpioMode;
+
+typedef enum {
+    GpioPullNo,
+    GpioPullUp,
+} GpioPull;
+
+typedef enum {
+    GpioSpeedVeryHigh,
+} GpioSpeed;
+
+typedef enum {
+    GpioAltFn5SPI2 = 5,
+    GpioAltFnUnused = 16,
+} GpioAltFn;
+
+typedef struct {
+    uint16_t pin;
+} GpioPin;
+
+void hal_gpio_init_ex(
+    const GpioPin* gpio,
+    const GpioMode mode,
+    const GpioPull pull,
+    const GpioSpeed speed,
+    const GpioAltFn alt_fn);
+
+void hal_gpio_write(const GpioPin* gpio, const bool state);
+
+#ifdef __cplusplus
+}
+#endif
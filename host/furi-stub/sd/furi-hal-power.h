@@ -0,0 +1,15 @@
+#pragma once
+
+/* Host stand-in, see furi-hal-gpio.h */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void furi_hal_power_enable_external_3_3v();
+
+void furi_hal_power_disable_external_3_3v();
+
+#ifdef __cplusplus
+}
+#endif
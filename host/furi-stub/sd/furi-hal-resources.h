@@ -0,0 +1,18 @@
+#pragma once
+
+/* Host stand-in, see furi-hal-gpio.h */
+
+#include <furi-hal-gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern const GpioPin gpio_sdcard_cs;
+extern const GpioPin gpio_spi_d_miso;
+extern const GpioPin gpio_spi_d_mosi;
+extern const GpioPin gpio_spi_d_sck;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+/* Host stand-in, see furi-hal-gpio.h */
+
+#include <furi-hal-gpio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FuriHalSpiDeviceIdSdCardFast,
+    FuriHalSpiDeviceIdSdCardSlow,
+    FuriHalSpiDeviceIdMax,
+} FuriHalSpiDeviceId;
+
+typedef struct {
+    const GpioPin* chip_select;
+} FuriHalSpiDevice;
+
+const FuriHalSpiDevice* furi_hal_spi_device_get(FuriHalSpiDeviceId device_id);
+
+void furi_hal_spi_device_return(const FuriHalSpiDevice* device);
+
+#ifdef __cplusplus
+}
+#endif
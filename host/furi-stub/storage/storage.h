@@ -0,0 +1,64 @@
+#pragma once
+
+/* Host stand-in for applications/storage/storage.h.
+ * Subset of storage API used by libraries, implemented over stdio in
+ * furi-stub-storage.c. Paths are taken relative to FURI_STUB_STORAGE_ROOT
+ * environment variable (current directory by default), so "/any/subghz/x"
+ * is "$FURI_STUB_STORAGE_ROOT/any/subghz/x" on host. */
+
+#include <furi.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <storage/filesystem-api-defines.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Storage Storage;
+
+File* storage_file_alloc(Storage* storage);
+
+void storage_file_free(File* file);
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode);
+
+bool storage_file_close(File* file);
+
+bool storage_file_is_open(File* file);
+
+uint16_t storage_file_read(File* file, void* buff, uint16_t bytes_to_read);
+
+uint16_t storage_file_write(File* file, const void* buff, uint16_t bytes_to_write);
+
+size_t storage_file_read_v(File* file, const FileIoVec* iov, size_t iov_count);
+
+size_t storage_file_write_v(File* file, const FileIoConstVec* iov, size_t iov_count);
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start);
+
+uint64_t storage_file_tell(File* file);
+
+uint64_t storage_file_size(File* file);
+
+bool storage_file_eof(File* file);
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo);
+
+FS_Error storage_common_remove(Storage* storage, const char* path);
+
+FS_Error storage_common_rename(Storage* storage, const char* old_path, const char* new_path);
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path);
+
+FS_Error storage_file_get_error(File* file);
+
+const char* storage_file_get_error_desc(File* file);
+
+#ifdef __cplusplus
+}
+#endif
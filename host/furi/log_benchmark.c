@@ -0,0 +1,276 @@
+#include <furi.h>
+#include <stm32wbxx_hal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/*
+ * core/furi/log.c built for host, console is a sink which takes as long as
+ * UART of given baud rate would. Several producer threads log numbered
+ * messages: previous furi_log_print(), which printed under mutex from caller
+ * thread, against ring buffer drained by FuriLog thread, in text and binary
+ * mode. Every delivered message is checked to come in order, delivered and
+ * dropped messages must add up to sent ones.
+ */
+
+#define BENCHMARK_PRODUCERS_MAX 16
+#define BENCHMARK_TAG "LogBenchmark"
+
+static const char benchmark_format[] =
+    FURI_LOG_FORMAT(I, BENCHMARK_TAG, "producer %u message %u, %s");
+
+typedef void (*BenchmarkLog)(uint32_t producer, uint32_t message);
+
+typedef struct {
+    size_t producers;
+    size_t messages;
+    uint32_t interval_us;
+    uint32_t baud;
+} BenchmarkConfig;
+
+typedef struct {
+    const BenchmarkConfig* config;
+    BenchmarkLog log;
+    uint32_t producer;
+    uint64_t total_ns;
+    uint64_t max_ns;
+} BenchmarkProducer;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    char line[256];
+    size_t line_size;
+    size_t delivered;
+    size_t dropped;
+    int64_t last[BENCHMARK_PRODUCERS_MAX];
+    uint32_t baud;
+} BenchmarkSink;
+
+static BenchmarkSink benchmark_sink = {.mutex = PTHREAD_MUTEX_INITIALIZER};
+static pthread_mutex_t benchmark_previous_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void benchmark_sink_message(uint32_t producer, uint32_t message) {
+    furi_check(producer < BENCHMARK_PRODUCERS_MAX);
+    furi_check((int64_t)message > benchmark_sink.last[producer]);
+    benchmark_sink.last[producer] = message;
+    benchmark_sink.delivered++;
+}
+
+static void benchmark_sink_line(const char* line) {
+    const char* found;
+    uint32_t producer, message;
+    unsigned long dropped;
+
+    if((found = strstr(line, "producer "))) {
+        furi_check(sscanf(found, "producer %u message %u", &producer, &message) == 2);
+        benchmark_sink_message(producer, message);
+    } else if((found = strstr(line, "[FuriLog]: " FURI_LOG_CLR_RESET))) {
+        found += strlen("[FuriLog]: " FURI_LOG_CLR_RESET);
+        furi_check(sscanf(found, "%lu messages dropped", &dropped) == 1);
+        benchmark_sink.dropped += dropped;
+    }
+}
+
+/* UART sends 10 bits per byte */
+static void benchmark_sink_tx(size_t size) {
+    usleep(size * 10ULL * 1000000 / benchmark_sink.baud);
+}
+
+static int benchmark_sink_vprint(const char* format, va_list args) {
+    char text[256];
+    int length = vsnprintf(text, sizeof(text), format, args);
+    furi_check(length >= 0 && length < (int)sizeof(text));
+
+    pthread_mutex_lock(&benchmark_sink.mutex);
+    for(int i = 0; i < length; i++) {
+        furi_check(benchmark_sink.line_size < sizeof(benchmark_sink.line) - 1);
+        benchmark_sink.line[benchmark_sink.line_size++] = text[i];
+        if(text[i] == '\n') {
+            benchmark_sink.line[benchmark_sink.line_size] = '\0';
+            benchmark_sink_line(benchmark_sink.line);
+            benchmark_sink.line_size = 0;
+        }
+    }
+    pthread_mutex_unlock(&benchmark_sink.mutex);
+
+    benchmark_sink_tx(length);
+    return length;
+}
+
+static int benchmark_sink_print(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = benchmark_sink_vprint(format, args);
+    va_end(args);
+    return length;
+}
+
+static void benchmark_sink_write(const uint8_t* data, size_t size) {
+    uint32_t payload[4];
+    uint8_t sum = 0;
+
+    furi_check(size >= 3 + sizeof(payload) && data[0] == 0x1E && data[1] == size - 3);
+    for(size_t i = 2; i < size - 1; i++) sum += data[i];
+    furi_check(sum == data[size - 1]);
+    /* timestamp, format, producer, message, then string */
+    memcpy(payload, &data[2], sizeof(payload));
+    furi_check(payload[1] == (uint32_t)(uintptr_t)benchmark_format);
+    furi_check(!strcmp((const char*)&data[2 + sizeof(payload)], BENCHMARK_TAG));
+
+    pthread_mutex_lock(&benchmark_sink.mutex);
+    benchmark_sink_message(payload[2], payload[3]);
+    pthread_mutex_unlock(&benchmark_sink.mutex);
+
+    benchmark_sink_tx(size);
+}
+
+static void benchmark_sink_reset(uint32_t baud) {
+    pthread_mutex_lock(&benchmark_sink.mutex);
+    benchmark_sink.line_size = 0;
+    benchmark_sink.delivered = 0;
+    benchmark_sink.dropped = 0;
+    for(size_t i = 0; i < BENCHMARK_PRODUCERS_MAX; i++) benchmark_sink.last[i] = -1;
+    benchmark_sink.baud = baud;
+    pthread_mutex_unlock(&benchmark_sink.mutex);
+}
+
+/* Reference: furi_log_print() before FuriLog thread */
+static void benchmark_log_previous(uint32_t producer, uint32_t message) {
+    pthread_mutex_lock(&benchmark_previous_mutex);
+    benchmark_sink_print("%lu ", (unsigned long)HAL_GetTick());
+    benchmark_sink_print(benchmark_format, producer, message, BENCHMARK_TAG);
+    pthread_mutex_unlock(&benchmark_previous_mutex);
+}
+
+static void benchmark_log(uint32_t producer, uint32_t message) {
+    furi_log_print(FURI_LOG_INFO, benchmark_format, producer, message, BENCHMARK_TAG);
+}
+
+static void* benchmark_producer(void* context) {
+    BenchmarkProducer* producer = context;
+
+    for(uint32_t message = 0; message < producer->config->messages; message++) {
+        uint64_t start = benchmark_time_ns();
+        producer->log(producer->producer, message);
+        uint64_t time = benchmark_time_ns() - start;
+        producer->total_ns += time;
+        if(time > producer->max_ns) producer->max_ns = time;
+        if(producer->config->interval_us) usleep(producer->config->interval_us);
+    }
+    return NULL;
+}
+
+static void benchmark_run(const char* name, BenchmarkLog log, const BenchmarkConfig* config) {
+    BenchmarkProducer producers[BENCHMARK_PRODUCERS_MAX];
+    pthread_t threads[BENCHMARK_PRODUCERS_MAX];
+    size_t sent = config->producers * config->messages;
+
+    benchmark_sink_reset(config->baud);
+    uint32_t dropped_before = furi_log_get_dropped();
+    uint64_t start = benchmark_time_ns();
+    for(size_t i = 0; i < config->producers; i++) {
+        producers[i] = (BenchmarkProducer){.config = config, .log = log, .producer = i};
+        furi_check(pthread_create(&threads[i], NULL, benchmark_producer, &producers[i]) == 0);
+    }
+    uint64_t total_ns = 0;
+    uint64_t max_ns = 0;
+    for(size_t i = 0; i < config->producers; i++) {
+        pthread_join(threads[i], NULL);
+        total_ns += producers[i].total_ns;
+        if(producers[i].max_ns > max_ns) max_ns = producers[i].max_ns;
+    }
+    double seconds = (benchmark_time_ns() - start) / 1e9;
+
+    /* FuriLog thread reports drops after it empties buffer */
+    size_t dropped = furi_log_get_dropped() - dropped_before;
+    for(size_t wait = 0; wait < 60000; wait++) {
+        pthread_mutex_lock(&benchmark_sink.mutex);
+        bool done = (benchmark_sink.delivered + benchmark_sink.dropped == sent);
+        pthread_mutex_unlock(&benchmark_sink.mutex);
+        if(done) break;
+        usleep(1000);
+    }
+    furi_check(benchmark_sink.delivered + dropped == sent);
+    furi_check(benchmark_sink.dropped == dropped);
+
+    printf(
+        "%-10s %10.0f %10.1f %10zu %10zu %10.2f\r\n",
+        name,
+        (double)total_ns / sent,
+        max_ns / 1000.0,
+        benchmark_sink.delivered,
+        dropped,
+        seconds);
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkConfig config = {
+        .producers = 4,
+        .messages = 200,
+        .interval_us = 1000,
+        .baud = 230400,
+    };
+    int opt;
+
+    while((opt = getopt(argc, argv, "p:n:i:b:")) != -1) {
+        switch(opt) {
+        case 'p':
+            config.producers = atoi(optarg);
+            break;
+        case 'n':
+            config.messages = atoi(optarg);
+            break;
+        case 'i':
+            config.interval_us = atoi(optarg);
+            break;
+        case 'b':
+            config.baud = atoi(optarg);
+            break;
+        default:
+            printf(
+                "Usage: %s [-p producers] [-n messages per producer] [-i interval us]"
+                " [-b console baud]\r\n",
+                argv[0]);
+            return 1;
+        }
+    }
+    furi_check(config.producers > 0 && config.producers <= BENCHMARK_PRODUCERS_MAX);
+    furi_check(config.messages > 0);
+    furi_check(config.baud > 0);
+
+    furi_log_init();
+    furi_log_set_print(benchmark_sink_print, benchmark_sink_vprint);
+
+    printf(
+        "%zu producers, %zu messages each every %lu us, console %lu baud, buffer %u\r\n",
+        config.producers,
+        config.messages,
+        (unsigned long)config.interval_us,
+        (unsigned long)config.baud,
+        FURI_LOG_BUFFER_SIZE);
+    printf(
+        "%-10s %10s %10s %10s %10s %10s\r\n",
+        "log",
+        "ns/call",
+        "max us",
+        "delivered",
+        "dropped",
+        "seconds");
+    benchmark_run("previous", benchmark_log_previous, &config);
+    benchmark_run("text", benchmark_log, &config);
+    furi_log_set_binary(benchmark_sink_write);
+    benchmark_run("binary", benchmark_log, &config);
+    furi_log_set_binary(NULL);
+
+    return 0;
+}
@@ -0,0 +1,317 @@
+#include <furi.h>
+#include <furi/memmgr_heap.h>
+#include <FreeRTOS.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+
+/*
+ * Growing strings and arrays on furi heap, core/furi/memmgr_heap.c built for
+ * host: previous realloc(), which allocated new block and copied new size
+ * from old one, against pvPortRealloc(), which resizes block in place when
+ * next block is free and moves only old content otherwise. Containers grow by
+ * half of their size like m-lib ones, several of them at once, with short
+ * lived allocations in between, so next block is not always free.
+ */
+
+/* Heap region, __heap_start__ and __heap_end__ are set by linker flags.
+ * Previous realloc() reads new size from old block, tail keeps it inside. */
+uint8_t memmgr_heap_benchmark_area[MEMMGR_HEAP_BENCHMARK_SIZE + 64 * 1024]
+    __attribute__((aligned(8)));
+
+extern void* pvPortRealloc(void* pv, size_t xWantedSize);
+
+#define BENCHMARK_TEMPS 64
+
+typedef void* (*BenchmarkRealloc)(void* ptr, size_t size);
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t alloc;
+    size_t target;
+    size_t element;
+    uint8_t seed;
+} BenchmarkContainer;
+
+typedef struct {
+    size_t reallocs;
+    size_t moves;
+    size_t copied;
+    size_t failures;
+    size_t max_block;
+    double seconds;
+} BenchmarkResult;
+
+static uint32_t benchmark_random_state;
+
+static uint32_t benchmark_random(void) {
+    benchmark_random_state ^= benchmark_random_state << 13;
+    benchmark_random_state ^= benchmark_random_state >> 17;
+    benchmark_random_state ^= benchmark_random_state << 5;
+    return benchmark_random_state;
+}
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Reference: realloc() of core/furi/memmgr.c before pvPortRealloc() */
+static void* benchmark_realloc_previous(void* ptr, size_t size) {
+    if(size == 0) {
+        vPortFree(ptr);
+        return NULL;
+    }
+
+    void* p;
+    p = pvPortMalloc(size);
+    if(p) {
+        if(ptr != NULL) {
+            memcpy(p, ptr, size);
+            vPortFree(ptr);
+        }
+    }
+    return p;
+}
+
+static void benchmark_container_start(BenchmarkContainer* container) {
+    memset(container, 0, sizeof(BenchmarkContainer));
+    container->seed = benchmark_random();
+    if(benchmark_random() % 2) {
+        /* string, appended by pieces */
+        container->element = 1;
+        container->target = 16 + benchmark_random() % 1024;
+    } else {
+        /* array of structs, pushed one by one */
+        container->element = 4 + (benchmark_random() % 8) * 4;
+        container->target = container->element * (4 + benchmark_random() % 192);
+    }
+}
+
+static void benchmark_container_stop(BenchmarkContainer* container) {
+    for(size_t i = 0; i < container->size; i++) {
+        furi_check(container->data[i] == (uint8_t)(container->seed + i));
+    }
+    vPortFree(container->data);
+    container->data = NULL;
+}
+
+static void benchmark_container_push(
+    BenchmarkContainer* container,
+    BenchmarkRealloc benchmark_realloc,
+    BenchmarkResult* result) {
+    size_t push = container->element;
+    if(push == 1) push += benchmark_random() % 24;
+
+    if(container->size + push > container->alloc) {
+        size_t alloc = container->size + push;
+        alloc += alloc / 2;
+        uint8_t* data = benchmark_realloc(container->data, alloc);
+        result->reallocs++;
+        if(data == NULL) {
+            result->failures++;
+            benchmark_container_stop(container);
+            return;
+        }
+        if(container->data && (data != container->data)) {
+            result->moves++;
+            result->copied += (benchmark_realloc == pvPortRealloc) ? container->alloc : alloc;
+        }
+        container->data = data;
+        container->alloc = alloc;
+    }
+
+    for(size_t i = 0; i < push; i++) {
+        container->data[container->size] = container->seed + container->size;
+        container->size++;
+    }
+}
+
+static void benchmark_run(
+    BenchmarkRealloc benchmark_realloc,
+    size_t steps,
+    size_t live,
+    BenchmarkResult* result) {
+    BenchmarkContainer* containers = calloc(live, sizeof(BenchmarkContainer));
+    void* temps[BENCHMARK_TEMPS] = {0};
+
+    memset(result, 0, sizeof(BenchmarkResult));
+    benchmark_random_state = 0x2545F491;
+    uint64_t start = benchmark_time_ns();
+    for(size_t step = 0; step < steps; step++) {
+        BenchmarkContainer* container = &containers[benchmark_random() % live];
+        if(container->data == NULL) benchmark_container_start(container);
+        benchmark_container_push(container, benchmark_realloc, result);
+        if(container->data && (container->size >= container->target)) {
+            benchmark_container_stop(container);
+        }
+
+        if(benchmark_random() % 4 == 0) {
+            size_t temp = benchmark_random() % BENCHMARK_TEMPS;
+            vPortFree(temps[temp]);
+            temps[temp] = pvPortMalloc(8 + benchmark_random() % 56);
+        }
+    }
+    result->seconds = (benchmark_time_ns() - start) / 1e9;
+    result->max_block = memmgr_heap_get_max_free_block();
+
+    for(size_t i = 0; i < live; i++) {
+        if(containers[i].data) benchmark_container_stop(&containers[i]);
+    }
+    for(size_t i = 0; i < BENCHMARK_TEMPS; i++) {
+        vPortFree(temps[i]);
+    }
+    free(containers);
+}
+
+static void benchmark_print(
+    const char* name,
+    BenchmarkRealloc benchmark_realloc,
+    size_t steps,
+    size_t live) {
+    BenchmarkResult result;
+    benchmark_run(benchmark_realloc, steps, live, &result);
+    printf(
+        "%-14s %10zu %10zu %12zu %10.1f %10zu %10zu\r\n",
+        name,
+        result.reallocs,
+        result.moves,
+        result.copied / 1024,
+        result.seconds * 1e9 / result.reallocs,
+        result.max_block,
+        result.failures);
+}
+
+/* Heap without place for slab page still serves small allocation by block */
+static void benchmark_check_slab_fallback(void) {
+    void* blocks[MEMMGR_HEAP_BENCHMARK_SIZE / 512];
+    size_t count = 0;
+
+    while(count < COUNT_OF(blocks) && (blocks[count] = pvPortMalloc(512)) != NULL) count++;
+    furi_check(count > 1 && count < COUNT_OF(blocks));
+    vPortFree(blocks[--count]);
+    furi_check(memmgr_heap_get_max_free_block() < 1024);
+
+    void* small = pvPortMalloc(200);
+    furi_check(small != NULL);
+    vPortFree(small);
+    while(count) vPortFree(blocks[--count]);
+}
+
+osThreadId_t furi_stub_thread_id = NULL;
+
+static void benchmark_check_trace_stats(size_t finished_threads, size_t leftovers) {
+    MemmgrHeapTraceStats stats;
+    memmgr_heap_get_trace_stats(&stats);
+    furi_check(stats.finished_threads == finished_threads);
+    furi_check(stats.leftovers == leftovers);
+}
+
+/* Leftovers of finished thread stay in heap trace until freed or thread is
+ * traced again, allocations table has no room for are counted per thread */
+static void benchmark_check_trace(void) {
+    osThreadId_t app = (osThreadId_t)0x100;
+    MemmgrHeapTraceCaller callers[4];
+    void* blocks[MEMMGR_HEAP_TRACE_SIZE];
+
+    memmgr_heap_enable_thread_trace(app);
+    furi_stub_thread_id = app;
+    void* leftover_small = pvPortMalloc(100);
+    void* leftover_large = pvPortMalloc(300);
+    vPortFree(pvPortMalloc(20));
+    furi_stub_thread_id = NULL;
+    furi_check(memmgr_heap_get_thread_memory(app) >= 400);
+    memmgr_heap_disable_thread_trace(app);
+
+    benchmark_check_trace_stats(1, 2);
+    furi_check(memmgr_heap_get_trace_callers(callers, COUNT_OF(callers), false) == 0);
+    size_t count = memmgr_heap_get_trace_callers(callers, COUNT_OF(callers), true);
+    size_t leftovers = 0;
+    for(size_t i = 0; i < count; i++) leftovers += callers[i].count;
+    furi_check(leftovers == 2);
+
+    /* freed by other thread */
+    vPortFree(leftover_small);
+    benchmark_check_trace_stats(1, 1);
+
+    /* traced again, table overflows */
+    memmgr_heap_enable_thread_trace(app);
+    benchmark_check_trace_stats(0, 0);
+    furi_stub_thread_id = app;
+    for(size_t i = 0; i < COUNT_OF(blocks); i++) blocks[i] = pvPortMalloc(8);
+    furi_stub_thread_id = NULL;
+    furi_check(memmgr_heap_get_thread_dropped(app) == MEMMGR_HEAP_TRACE_SIZE / 4);
+    for(size_t i = 0; i < COUNT_OF(blocks); i++) vPortFree(blocks[i]);
+    memmgr_heap_disable_thread_trace(app);
+    benchmark_check_trace_stats(0, 0);
+
+    /* every slot has leftovers, new thread takes slot of one of them */
+    for(size_t i = 0; i < 9; i++) {
+        osThreadId_t thread = (osThreadId_t)(0x200 + i);
+        memmgr_heap_enable_thread_trace(thread);
+        furi_stub_thread_id = thread;
+        blocks[i] = pvPortMalloc(16);
+        furi_stub_thread_id = NULL;
+        memmgr_heap_disable_thread_trace(thread);
+    }
+    benchmark_check_trace_stats(8, 8);
+    for(size_t i = 0; i < 9; i++) vPortFree(blocks[i]);
+    benchmark_check_trace_stats(0, 0);
+
+    vPortFree(leftover_large);
+}
+
+int main(int argc, char* argv[]) {
+    size_t steps = 200000;
+    size_t live = 24;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:l:")) != -1) {
+        switch(opt) {
+        case 'n':
+            steps = atoi(optarg);
+            break;
+        case 'l':
+            live = atoi(optarg);
+            break;
+        default:
+            printf("Usage: %s [-n steps] [-l live containers]\r\n", argv[0]);
+            return 1;
+        }
+    }
+    furi_check(steps > 0);
+    furi_check(live > 0);
+
+    /* first allocation initializes heap */
+    vPortFree(pvPortMalloc(1));
+    size_t free_heap = xPortGetFreeHeapSize();
+
+    printf(
+        "%zu steps, %zu live containers, heap %u KiB\r\n",
+        steps,
+        live,
+        MEMMGR_HEAP_BENCHMARK_SIZE / 1024);
+    printf(
+        "%-14s %10s %10s %12s %10s %10s %10s\r\n",
+        "realloc",
+        "reallocs",
+        "moves",
+        "copied KiB",
+        "ns/realloc",
+        "max block",
+        "failures");
+    benchmark_print("previous", benchmark_realloc_previous, steps, live);
+    furi_check(xPortGetFreeHeapSize() == free_heap);
+    benchmark_print("pvPortRealloc", pvPortRealloc, steps, live);
+    furi_check(xPortGetFreeHeapSize() == free_heap);
+    benchmark_check_slab_fallback();
+    furi_check(xPortGetFreeHeapSize() == free_heap);
+    benchmark_check_trace();
+    furi_check(xPortGetFreeHeapSize() == free_heap);
+
+    return 0;
+}
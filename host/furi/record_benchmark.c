@@ -0,0 +1,256 @@
+#include <furi.h>
+#include <furi-stub.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include <pthread.h>
+
+/*
+ * core/furi/record.c built for host, records mutex is pthread one of cmsis
+ * stand-in. Open/close pairs of a created record: by name and by id against
+ * model of previous furi_record_open(), which copied name into heap string,
+ * looked it up in m-lib dict of string keys and pushed caller thread to holder
+ * set, all of it once more on close. Model is open addressing with FNV-1a hash
+ * and strcmp, so it does not need m-lib and likely is cheaper than the real
+ * thing. Well-known records are looked up by literal, same pointer as in
+ * record table, and by copy of the name, application ones are always compared.
+ * Before that, more threads than there ever were waiter slots wait for open
+ * of a record which is created only after all of them went to sleep.
+ */
+
+#define BENCHMARK_DYNAMIC_RECORDS 12
+#define BENCHMARK_PREVIOUS_RECORDS 64
+#define BENCHMARK_PREVIOUS_HOLDERS 8
+#define BENCHMARK_WAITERS 40
+#define BENCHMARK_WAITERS_TIMEOUT 5000
+
+typedef struct {
+    char* name;
+    void* data;
+    uint32_t holders[BENCHMARK_PREVIOUS_HOLDERS];
+} BenchmarkPreviousRecord;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    BenchmarkPreviousRecord records[BENCHMARK_PREVIOUS_RECORDS];
+} BenchmarkPrevious;
+
+typedef struct {
+    double pairs_per_second;
+    double allocs_per_pair;
+} BenchmarkResult;
+
+typedef void (*BenchmarkPair)(const char* name, FuriRecordId id);
+
+static BenchmarkPrevious benchmark_previous = {.mutex = PTHREAD_MUTEX_INITIALIZER};
+static void* volatile benchmark_sink;
+static uint32_t benchmark_waiters_done;
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t benchmark_previous_hash(const char* name) {
+    uint32_t hash = 2166136261U;
+    while(*name) hash = (hash ^ (uint8_t)*name++) * 16777619U;
+    return hash;
+}
+
+/* string_init_set_str() */
+static char* benchmark_previous_string(const char* name) {
+    size_t size = strlen(name) + 1;
+    char* string = malloc(size);
+    furi_check(string);
+    memcpy(string, name, size);
+    return string;
+}
+
+static BenchmarkPreviousRecord* benchmark_previous_get(const char* name) {
+    uint32_t index = benchmark_previous_hash(name);
+    for(size_t i = 0; i < BENCHMARK_PREVIOUS_RECORDS; i++, index++) {
+        BenchmarkPreviousRecord* record =
+            &benchmark_previous.records[index % BENCHMARK_PREVIOUS_RECORDS];
+        if(!record->name || !strcmp(record->name, name)) return record;
+    }
+    /* records are full */
+    furi_check(false);
+    return NULL;
+}
+
+static void benchmark_previous_create(const char* name, void* data) {
+    BenchmarkPreviousRecord* record = benchmark_previous_get(name);
+    furi_check(!record->name);
+    record->name = benchmark_previous_string(name);
+    record->data = data;
+}
+
+static uint32_t* benchmark_previous_holder(BenchmarkPreviousRecord* record, uint32_t thread) {
+    uint32_t index = thread * 2654435761U;
+    for(size_t i = 0; i < BENCHMARK_PREVIOUS_HOLDERS; i++, index++) {
+        uint32_t* holder = &record->holders[index % BENCHMARK_PREVIOUS_HOLDERS];
+        if(*holder == thread || *holder == 0) return holder;
+    }
+    /* holders are full */
+    furi_check(false);
+    return NULL;
+}
+
+/* Reference: furi_record_open() and furi_record_close() with m-lib dict */
+static void benchmark_pair_previous(const char* name, FuriRecordId id) {
+    uint32_t thread = 1;
+    char* name_str = benchmark_previous_string(name);
+    pthread_mutex_lock(&benchmark_previous.mutex);
+    BenchmarkPreviousRecord* record = benchmark_previous_get(name_str);
+    *benchmark_previous_holder(record, thread) = thread;
+    pthread_mutex_unlock(&benchmark_previous.mutex);
+    benchmark_sink = record->data;
+    free(name_str);
+
+    name_str = benchmark_previous_string(name);
+    pthread_mutex_lock(&benchmark_previous.mutex);
+    record = benchmark_previous_get(name_str);
+    *benchmark_previous_holder(record, thread) = 0;
+    pthread_mutex_unlock(&benchmark_previous.mutex);
+    free(name_str);
+}
+
+static void benchmark_waiter(void* context) {
+    furi_check(furi_record_open("late") == context);
+    furi_record_close("late");
+    __atomic_add_fetch(&benchmark_waiters_done, 1, __ATOMIC_SEQ_CST);
+}
+
+static void benchmark_check_waiters(void) {
+    static char late[] = "late";
+    for(size_t i = 0; i < BENCHMARK_WAITERS; i++) {
+        furi_check(osThreadNew(benchmark_waiter, late, NULL));
+    }
+    /* let all of them block in furi_record_open() */
+    osDelay(100);
+    furi_check(!__atomic_load_n(&benchmark_waiters_done, __ATOMIC_SEQ_CST));
+    furi_record_create("late", late);
+
+    uint32_t waited = 0;
+    while(__atomic_load_n(&benchmark_waiters_done, __ATOMIC_SEQ_CST) < BENCHMARK_WAITERS) {
+        furi_check(waited++ < BENCHMARK_WAITERS_TIMEOUT);
+        osDelay(1);
+    }
+    furi_check(furi_record_destroy("late"));
+    printf("%u threads waited for record creation\r\n", BENCHMARK_WAITERS);
+}
+
+static void benchmark_pair_name(const char* name, FuriRecordId id) {
+    benchmark_sink = furi_record_open(name);
+    furi_record_close(name);
+}
+
+static void benchmark_pair_id(const char* name, FuriRecordId id) {
+    benchmark_sink = furi_record_open_id(id);
+    furi_record_close_id(id);
+}
+
+static void benchmark_run(
+    BenchmarkPair pair,
+    const char* name,
+    FuriRecordId id,
+    size_t pairs,
+    BenchmarkResult* result) {
+    FuriStubHeapStats before, after;
+
+    furi_stub_heap_get_stats(&before);
+    uint64_t start = benchmark_time_ns();
+    for(size_t i = 0; i < pairs; i++) {
+        pair(name, id);
+    }
+    double seconds = (benchmark_time_ns() - start) / 1e9;
+    furi_stub_heap_get_stats(&after);
+
+    result->pairs_per_second = pairs / seconds;
+    result->allocs_per_pair = (double)(after.alloc_count - before.alloc_count) / pairs;
+}
+
+static void benchmark_print(const char* record, const char* name, size_t pairs) {
+    BenchmarkResult previous, by_name, by_id;
+    FuriRecordId id = furi_record_get_id(name);
+
+    benchmark_run(benchmark_pair_previous, name, id, pairs, &previous);
+    benchmark_run(benchmark_pair_name, name, id, pairs, &by_name);
+    benchmark_run(benchmark_pair_id, name, id, pairs, &by_id);
+    printf(
+        "%-16s %12.0f %8.1f %12.0f %8.1f %12.0f %8.1f\r\n",
+        record,
+        previous.pairs_per_second,
+        previous.allocs_per_pair,
+        by_name.pairs_per_second,
+        by_name.allocs_per_pair,
+        by_id.pairs_per_second,
+        by_id.allocs_per_pair);
+}
+
+int main(int argc, char* argv[]) {
+    size_t pairs = 2000000;
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:")) != -1) {
+        switch(opt) {
+        case 'n':
+            pairs = atoi(optarg);
+            break;
+        default:
+            printf("Usage: %s [-n pairs]\r\n", argv[0]);
+            return 1;
+        }
+    }
+    furi_check(pairs > 0);
+
+    furi_record_init();
+    benchmark_check_waiters();
+
+    /* every well-known record and some application ones after them */
+    static const char* const fixed_names[] = {
+#define ADD_RECORD(id, name) name,
+#include <furi/record_config.h>
+#undef ADD_RECORD
+    };
+    char dynamic_names[BENCHMARK_DYNAMIC_RECORDS][16];
+    for(size_t i = 0; i < FuriRecordIdFixedCount; i++) {
+        furi_record_create(fixed_names[i], (void*)fixed_names[i]);
+        benchmark_previous_create(fixed_names[i], (void*)fixed_names[i]);
+    }
+    for(size_t i = 0; i < BENCHMARK_DYNAMIC_RECORDS; i++) {
+        snprintf(dynamic_names[i], sizeof(dynamic_names[i]), "app_%zu", i);
+        furi_record_create(dynamic_names[i], dynamic_names[i]);
+        benchmark_previous_create(dynamic_names[i], dynamic_names[i]);
+    }
+    furi_check(furi_record_get_id("storage") == FuriRecordIdStorage);
+    furi_check(furi_record_open_id(FuriRecordIdStorage) == furi_record_open("storage"));
+    furi_record_close_id(FuriRecordIdStorage);
+    furi_record_close("storage");
+
+    char storage_copy[] = "storage";
+
+    printf(
+        "%zu open/close pairs, %u records\r\n",
+        pairs,
+        FuriRecordIdFixedCount + BENCHMARK_DYNAMIC_RECORDS);
+    printf(
+        "%-16s %12s %8s %12s %8s %12s %8s\r\n",
+        "record",
+        "previous/s",
+        "allocs",
+        "name/s",
+        "allocs",
+        "id/s",
+        "allocs");
+    benchmark_print("storage", "storage", pairs);
+    benchmark_print("storage, copy", storage_copy, pairs);
+    benchmark_print("dolphin", "dolphin", pairs);
+    const char* last_dynamic = dynamic_names[BENCHMARK_DYNAMIC_RECORDS - 1];
+    benchmark_print(last_dynamic, last_dynamic, pairs);
+
+    return 0;
+}
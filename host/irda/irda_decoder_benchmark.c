@@ -0,0 +1,217 @@
+#include <furi.h>
+#include <furi-stub.h>
+#include <stdio.h>
+#include <time.h>
+#include "irda.h"
+#include "irda_protocol_defs_i.h"
+#include "test_data/irda_nec_test_data.srcdata"
+#include "test_data/irda_necext_test_data.srcdata"
+#include "test_data/irda_samsung_test_data.srcdata"
+#include "test_data/irda_rc6_test_data.srcdata"
+#include "test_data/irda_rc5_test_data.srcdata"
+#include "test_data/irda_sirc_test_data.srcdata"
+
+#define BENCHMARK_DATA(name, decoder) {#name, (name), COUNT_OF(name), (decoder)}
+#define BENCHMARK_MIN_EDGES 2000000
+
+typedef struct {
+    const char* name;
+    const uint32_t* timings;
+    size_t timings_len;
+    size_t decoder; /* index in fanout_decoders of protocol the data is for */
+} BenchmarkData;
+
+typedef struct {
+    const char* name;
+    void* (*alloc)(void);
+    IrdaMessage* (*decode)(void* ctx, bool level, uint32_t duration);
+    void (*free)(void* ctx);
+} FanoutDecoder;
+
+static const BenchmarkData benchmark_data[] = {
+    BENCHMARK_DATA(test_decoder_nec_input1, 0),
+    BENCHMARK_DATA(test_decoder_nec_input2, 0),
+    BENCHMARK_DATA(test_decoder_necext_input1, 0),
+    BENCHMARK_DATA(test_decoder_samsung32_input1, 1),
+    BENCHMARK_DATA(test_decoder_rc6_input1, 3),
+    BENCHMARK_DATA(test_decoder_rc5_input_all_repeats, 2),
+    BENCHMARK_DATA(test_decoder_sirc_input1, 4),
+    BENCHMARK_DATA(test_decoder_sirc_input5, 4),
+};
+
+/* Reference: every timing goes to every decoder, as irda_decode() used to do.
+ * NEC and Samsung32 decode PDM, RC5 and RC6 Manchester, SIRC PWM */
+static const FanoutDecoder fanout_decoders[] = {
+    {"NEC", irda_decoder_nec_alloc, irda_decoder_nec_decode, irda_decoder_nec_free},
+    {"Samsung32",
+     irda_decoder_samsung32_alloc,
+     irda_decoder_samsung32_decode,
+     irda_decoder_samsung32_free},
+    {"RC5", irda_decoder_rc5_alloc, irda_decoder_rc5_decode, irda_decoder_rc5_free},
+    {"RC6", irda_decoder_rc6_alloc, irda_decoder_rc6_decode, irda_decoder_rc6_free},
+    {"SIRC", irda_decoder_sirc_alloc, irda_decoder_sirc_decode, irda_decoder_sirc_free},
+};
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t benchmark_dispatch(const BenchmarkData* data, uint32_t rounds) {
+    IrdaDecoderHandler* handler = irda_alloc_decoder();
+    uint32_t messages = 0;
+
+    for(uint32_t round = 0; round < rounds; ++round) {
+        bool level = false;
+        for(size_t i = 0; i < data->timings_len; ++i) {
+            if(irda_decode(handler, level, data->timings[i])) ++messages;
+            level = !level;
+        }
+    }
+
+    irda_free_decoder(handler);
+    return messages;
+}
+
+static uint32_t benchmark_batch(const BenchmarkData* data, uint32_t rounds) {
+    IrdaDecoderHandler* handler = irda_alloc_decoder();
+    LevelDuration* timings = furi_alloc(sizeof(LevelDuration) * data->timings_len);
+    uint32_t messages = 0;
+    bool level = false;
+
+    for(size_t i = 0; i < data->timings_len; ++i) {
+        timings[i] = level_duration_make(level, data->timings[i]);
+        level = !level;
+    }
+
+    for(uint32_t round = 0; round < rounds; ++round) {
+        messages += irda_decode_batch(handler, timings, data->timings_len, NULL, NULL);
+    }
+
+    free(timings);
+    irda_free_decoder(handler);
+    return messages;
+}
+
+static uint32_t benchmark_fanout(const BenchmarkData* data, uint32_t rounds) {
+    void* ctx[COUNT_OF(fanout_decoders)];
+    uint32_t messages = 0;
+
+    for(size_t j = 0; j < COUNT_OF(fanout_decoders); ++j) {
+        ctx[j] = fanout_decoders[j].alloc();
+    }
+
+    for(uint32_t round = 0; round < rounds; ++round) {
+        bool level = false;
+        for(size_t i = 0; i < data->timings_len; ++i) {
+            bool decoded = false;
+            for(size_t j = 0; j < COUNT_OF(fanout_decoders); ++j) {
+                if(fanout_decoders[j].decode(ctx[j], level, data->timings[i])) decoded = true;
+            }
+            if(decoded) ++messages;
+            level = !level;
+        }
+    }
+
+    for(size_t j = 0; j < COUNT_OF(fanout_decoders); ++j) {
+        fanout_decoders[j].free(ctx[j]);
+    }
+    return messages;
+}
+
+/* Only decoder of data protocol: cost of common decoder path it uses */
+static uint32_t benchmark_own(const BenchmarkData* data, uint32_t rounds) {
+    const FanoutDecoder* decoder = &fanout_decoders[data->decoder];
+    void* ctx = decoder->alloc();
+    uint32_t messages = 0;
+
+    for(uint32_t round = 0; round < rounds; ++round) {
+        bool level = false;
+        for(size_t i = 0; i < data->timings_len; ++i) {
+            if(decoder->decode(ctx, level, data->timings[i])) ++messages;
+            level = !level;
+        }
+    }
+
+    decoder->free(ctx);
+    return messages;
+}
+
+static void benchmark_print_heap(const char* name, const FuriStubHeapStats* before) {
+    FuriStubHeapStats after;
+    furi_stub_heap_get_stats(&after);
+    printf(
+        "%-36s %8zu bytes %4zu allocations\r\n",
+        name,
+        after.alloc_bytes - before->alloc_bytes,
+        after.alloc_count - before->alloc_count);
+}
+
+static void benchmark_heap(void) {
+    FuriStubHeapStats before;
+
+    printf("\r\nHeap allocated per decoder\r\n");
+    for(size_t i = 0; i < COUNT_OF(fanout_decoders); ++i) {
+        furi_stub_heap_get_stats(&before);
+        void* ctx = fanout_decoders[i].alloc();
+        benchmark_print_heap(fanout_decoders[i].name, &before);
+        fanout_decoders[i].free(ctx);
+    }
+
+    furi_stub_heap_get_stats(&before);
+    IrdaDecoderHandler* handler = irda_alloc_decoder();
+    benchmark_print_heap("irda_alloc_decoder() total", &before);
+    irda_free_decoder(handler);
+}
+
+int main(void) {
+    printf(
+        "%-36s %8s %12s %10s %10s %10s %10s\r\n",
+        "data set",
+        "frames",
+        "frames/s",
+        "ns/edge",
+        "batch",
+        "fanout",
+        "own");
+
+    for(size_t i = 0; i < COUNT_OF(benchmark_data); ++i) {
+        const BenchmarkData* data = &benchmark_data[i];
+        uint32_t rounds = BENCHMARK_MIN_EDGES / data->timings_len + 1;
+        double edges = (double)rounds * data->timings_len;
+
+        uint64_t start = benchmark_time_ns();
+        uint32_t fanout_frames = benchmark_fanout(data, rounds);
+        double fanout_ns = (benchmark_time_ns() - start) / edges;
+
+        start = benchmark_time_ns();
+        uint32_t frames = benchmark_dispatch(data, rounds);
+        double dispatch_ns = (benchmark_time_ns() - start) / edges;
+
+        start = benchmark_time_ns();
+        uint32_t batch_frames = benchmark_batch(data, rounds);
+        double batch_ns = (benchmark_time_ns() - start) / edges;
+
+        start = benchmark_time_ns();
+        uint32_t own_frames = benchmark_own(data, rounds);
+        double own_ns = (benchmark_time_ns() - start) / edges;
+
+        bool frames_match = (fanout_frames == frames) && (batch_frames == frames) &&
+                            (own_frames == frames);
+        printf(
+            "%-36s %8u %12.0f %10.2f %10.2f %10.2f %10.2f%s\r\n",
+            data->name,
+            frames / rounds,
+            frames * 1e9 / (dispatch_ns * edges),
+            dispatch_ns,
+            batch_ns,
+            fanout_ns,
+            own_ns,
+            frames_match ? "" : "  (decoded frames differ!)");
+    }
+
+    benchmark_heap();
+
+    return 0;
+}
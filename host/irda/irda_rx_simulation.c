@@ -0,0 +1,331 @@
+#include <furi.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include <math.h>
+#include <toolbox/level_duration_pingpong.h>
+#include "irda.h"
+#include "test_data/irda_nec_test_data.srcdata"
+#include "test_data/irda_necext_test_data.srcdata"
+#include "test_data/irda_samsung_test_data.srcdata"
+#include "test_data/irda_rc6_test_data.srcdata"
+#include "test_data/irda_rc5_test_data.srcdata"
+#include "test_data/irda_sirc_test_data.srcdata"
+
+/*
+ * Replays test_data edges at a fixed edge rate through a model of IRDA RX
+ * running on a single CPU: ISR cost is paid per edge and is taken from
+ * consumer, consumer cost is host decoding time per edge (measured once,
+ * scaled) plus a wakeup per signal. Timings are decoded for real, so
+ * frames show what survived. Timings are dropped when there is no room for them,
+ * max sustainable rate is the highest rate without drops.
+ *
+ * stream:    irda_worker before buffered capture - ISR sends every edge to
+ *            stream buffer and signals thread, thread drains it by chunks.
+ * ping-pong: ISR stores edges into one of 2 buffers, thread decodes
+ *            filled buffer in place and releases it.
+ */
+
+#define SIMULATION_DATA(name) {(name), COUNT_OF(name)}
+#define SIMULATION_EDGES 200000
+#define SIMULATION_STREAM_CHUNK 64
+
+typedef struct {
+    const uint32_t* timings;
+    size_t timings_len;
+} SimulationData;
+
+typedef struct {
+    double scale;
+    double stream_isr_ns;
+    double pingpong_isr_ns;
+    double wakeup_ns;
+    size_t buffer_size;
+} SimulationCost;
+
+typedef struct {
+    size_t dropped;
+    size_t frames;
+} SimulationResult;
+
+typedef struct {
+    bool delivered;
+    const LevelDuration* buffer;
+    size_t size;
+    bool overrun;
+} SimulationDelivery;
+
+static const SimulationData simulation_data[] = {
+    SIMULATION_DATA(test_decoder_nec_input1),
+    SIMULATION_DATA(test_decoder_nec_input2),
+    SIMULATION_DATA(test_decoder_necext_input1),
+    SIMULATION_DATA(test_decoder_samsung32_input1),
+    SIMULATION_DATA(test_decoder_rc6_input1),
+    SIMULATION_DATA(test_decoder_rc5_input_all_repeats),
+    SIMULATION_DATA(test_decoder_sirc_input1),
+    SIMULATION_DATA(test_decoder_sirc_input5),
+};
+
+static LevelDuration* simulation_edges;
+static double simulation_edge_ns;
+
+static uint64_t simulation_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void simulation_edges_fill(void) {
+    simulation_edges = furi_alloc(sizeof(LevelDuration) * SIMULATION_EDGES);
+    size_t k = 0;
+    while(k < SIMULATION_EDGES) {
+        for(size_t i = 0; (i < COUNT_OF(simulation_data)) && (k < SIMULATION_EDGES); ++i) {
+            bool level = false;
+            for(size_t j = 0; (j < simulation_data[i].timings_len) && (k < SIMULATION_EDGES);
+                ++j) {
+                simulation_edges[k++] = level_duration_make(level, simulation_data[i].timings[j]);
+                level = !level;
+            }
+        }
+    }
+}
+
+/* host time is noisy, best of few runs is taken as decoding cost */
+static void simulation_calibrate(void) {
+    for(size_t i = 0; i < 5; ++i) {
+        IrdaDecoderHandler* decoder = irda_alloc_decoder();
+        uint64_t start = simulation_time_ns();
+        irda_decode_batch(decoder, simulation_edges, SIMULATION_EDGES, NULL, NULL);
+        double edge_ns = (double)(simulation_time_ns() - start) / SIMULATION_EDGES;
+        irda_free_decoder(decoder);
+        if(!i || (edge_ns < simulation_edge_ns)) simulation_edge_ns = edge_ns;
+    }
+}
+
+/* decode and return target time spent, as if CPU is shared with ISR load */
+static double simulation_decode(
+    IrdaDecoderHandler* decoder,
+    const LevelDuration* timings,
+    size_t timings_cnt,
+    const SimulationCost* cost,
+    double isr_load,
+    SimulationResult* result) {
+    result->frames += irda_decode_batch(decoder, timings, timings_cnt, NULL, NULL);
+    return timings_cnt * simulation_edge_ns * cost->scale / (1.0 - isr_load);
+}
+
+static bool simulation_stream(double rate, const SimulationCost* cost, SimulationResult* result) {
+    double period = 1e9 / rate;
+    double isr_load = cost->stream_isr_ns / period;
+    if(isr_load >= 1.0) return false;
+
+    size_t capacity = 2 * cost->buffer_size;
+    LevelDuration* ring = furi_alloc(sizeof(LevelDuration) * capacity);
+    LevelDuration chunk[SIMULATION_STREAM_CHUNK];
+    IrdaDecoderHandler* decoder = irda_alloc_decoder();
+    size_t head = 0;
+    size_t count = 0;
+    bool waiting = true;
+    double next_receive = 0;
+
+    memset(result, 0, sizeof(*result));
+    for(size_t k = 0; k < SIMULATION_EDGES; ++k) {
+        double arrival = k * period;
+
+        while(!waiting && (next_receive <= arrival)) {
+            if(!count) {
+                waiting = true;
+                break;
+            }
+            size_t received = MIN(count, COUNT_OF(chunk));
+            for(size_t i = 0; i < received; ++i) {
+                chunk[i] = ring[(head + i) % capacity];
+            }
+            head = (head + received) % capacity;
+            count -= received;
+            next_receive += simulation_decode(decoder, chunk, received, cost, isr_load, result);
+        }
+
+        if(count == capacity) {
+            ++result->dropped;
+        } else {
+            ring[(head + count) % capacity] = simulation_edges[k];
+            ++count;
+            if(waiting) {
+                waiting = false;
+                next_receive = arrival + cost->wakeup_ns / (1.0 - isr_load);
+            }
+        }
+    }
+
+    irda_free_decoder(decoder);
+    free(ring);
+    return !result->dropped;
+}
+
+static void simulation_pingpong_callback(
+    void* context,
+    const LevelDuration* buffer,
+    size_t size,
+    bool overrun) {
+    SimulationDelivery* delivery = context;
+    delivery->delivered = true;
+    delivery->buffer = buffer;
+    delivery->size = size;
+    delivery->overrun = overrun;
+}
+
+static bool simulation_pingpong(double rate, const SimulationCost* cost, SimulationResult* result) {
+    double period = 1e9 / rate;
+    double isr_load = cost->pingpong_isr_ns / period;
+    if(isr_load >= 1.0) return false;
+
+    LevelDuration* buffer = furi_alloc(sizeof(LevelDuration) * 2 * cost->buffer_size);
+    IrdaDecoderHandler* decoder = irda_alloc_decoder();
+    LevelDurationPingPong pingpong;
+    SimulationDelivery delivery = {0};
+    const LevelDuration* released[2] = {0};
+    double release_time[2] = {0};
+    size_t release_cnt = 0;
+    double consumer_free = 0;
+
+    level_duration_pingpong_init(
+        &pingpong, buffer, cost->buffer_size, simulation_pingpong_callback, &delivery);
+    memset(result, 0, sizeof(*result));
+    for(size_t k = 0; k < SIMULATION_EDGES; ++k) {
+        double arrival = k * period;
+
+        /* buffers are decoded in order they are handed over */
+        while(release_cnt && (release_time[0] <= arrival)) {
+            level_duration_pingpong_release(&pingpong, released[0]);
+            released[0] = released[1];
+            release_time[0] = release_time[1];
+            --release_cnt;
+        }
+
+        if(!level_duration_pingpong_put(&pingpong, simulation_edges[k])) {
+            ++result->dropped;
+        }
+
+        if(delivery.delivered) {
+            delivery.delivered = false;
+            double start = consumer_free;
+            if(start <= arrival) {
+                start = arrival + cost->wakeup_ns / (1.0 - isr_load);
+            }
+            if(delivery.overrun) irda_reset_decoder(decoder);
+            consumer_free = start + simulation_decode(
+                                        decoder, delivery.buffer, delivery.size, cost, isr_load, result);
+            furi_check(release_cnt < 2);
+            released[release_cnt] = delivery.buffer;
+            release_time[release_cnt] = consumer_free;
+            ++release_cnt;
+        }
+    }
+
+    irda_free_decoder(decoder);
+    free(buffer);
+    return !result->dropped;
+}
+
+typedef bool (*SimulationModel)(double rate, const SimulationCost* cost, SimulationResult* result);
+
+static double simulation_max_rate(
+    SimulationModel model,
+    const SimulationCost* cost,
+    SimulationResult* result) {
+    SimulationResult probe;
+    double low = 1e3;
+    double high = 1e9;
+
+    if(!model(low, cost, result)) return 0;
+    /* bisection in log scale, 1% precision is enough */
+    while(high / low > 1.01) {
+        double middle = sqrt(low * high);
+        if(model(middle, cost, &probe)) {
+            low = middle;
+            *result = probe;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void simulation_print(
+    const char* name,
+    SimulationModel model,
+    const SimulationCost* cost,
+    double rate) {
+    SimulationResult result;
+
+    if(rate == 0) {
+        rate = simulation_max_rate(model, cost, &result);
+    } else {
+        model(rate, cost, &result);
+    }
+    printf(
+        "%-12s %14.0f %10zu %10zu\r\n", name, rate, result.dropped, result.frames);
+}
+
+int main(int argc, char* argv[]) {
+    SimulationCost cost = {
+        .scale = 20,
+        .stream_isr_ns = 3000,
+        .pingpong_isr_ns = 300,
+        .wakeup_ns = 5000,
+        .buffer_size = 64,
+    };
+    double rate = 0;
+    int opt;
+
+    while((opt = getopt(argc, argv, "r:x:i:p:w:b:")) != -1) {
+        switch(opt) {
+        case 'r':
+            rate = atof(optarg);
+            break;
+        case 'x':
+            cost.scale = atof(optarg);
+            break;
+        case 'i':
+            cost.stream_isr_ns = atof(optarg);
+            break;
+        case 'p':
+            cost.pingpong_isr_ns = atof(optarg);
+            break;
+        case 'w':
+            cost.wakeup_ns = atof(optarg);
+            break;
+        case 'b':
+            cost.buffer_size = atoi(optarg);
+            break;
+        default:
+            printf(
+                "Usage: %s [-r edges/s] [-x decode time scale] [-i stream isr ns]"
+                " [-p ping-pong isr ns] [-w wakeup ns] [-b buffer size]\r\n",
+                argv[0]);
+            return 1;
+        }
+    }
+    furi_check(cost.buffer_size > 0);
+
+    simulation_edges_fill();
+    simulation_calibrate();
+    printf(
+        "%d edges, buffer %zu timings, decode %.2f ns/edge x%.1f, isr %.0f/%.0f ns, wakeup %.0f ns\r\n",
+        SIMULATION_EDGES,
+        cost.buffer_size,
+        simulation_edge_ns,
+        cost.scale,
+        cost.stream_isr_ns,
+        cost.pingpong_isr_ns,
+        cost.wakeup_ns);
+    printf(
+        "%-12s %14s %10s %10s\r\n", "model", rate ? "edges/s" : "max edges/s", "dropped", "frames");
+    simulation_print("stream", simulation_stream, &cost, rate);
+    simulation_print("ping-pong", simulation_pingpong, &cost, rate);
+
+    free(simulation_edges);
+    return 0;
+}
@@ -0,0 +1,350 @@
+#include <furi.h>
+#include <furi-hal-irda.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
+#include "irda.h"
+#include "irda_raw.h"
+
+/*
+ * Model of universal remote brute force transmission: stream of signals of
+ * every protocol (and raw), grouped by protocol like in universal database.
+ * Airtime of every signal is taken from TX data callback, same as
+ * irda_worker feeds furi-hal-irda DMA with, including protocol inter-frame
+ * gap, which encoder sends first. Callback cost is measured on host.
+ *
+ * theoretical: signals sent back to back, only protocol gaps between them.
+ * sync:        signal is read, carrier is started, signal is sent, carrier
+ *              is stopped, then next one is read (irda_send() per signal).
+ * pipelined:   app tick fills irda_worker TX queue, worker encodes next
+ *              signal while previous one is on air, carrier is restarted only
+ *              when frequency changes. Stall is a signal which was not
+ *              ready when previous one ended.
+ */
+
+#define SIMULATION_PROTOCOL_RAW IrdaProtocolMAX
+
+typedef struct {
+    size_t signals;
+    size_t group;
+    size_t queue_size;
+    double scale;
+    double fetch_us;
+    double start_us;
+    double stop_us;
+    double tick_us;
+} SimulationCost;
+
+typedef struct {
+    /* SIMULATION_PROTOCOL_RAW for raw signal */
+    int protocol;
+    IrdaMessage message;
+    uint32_t frequency;
+    double air_us;
+    double prepare_us;
+} SimulationSignal;
+
+typedef struct {
+    IrdaEncoderHandler* encoder;
+    const SimulationSignal* signal;
+    const IrdaRawSignal* raw;
+    IrdaRawSignalIterator iterator;
+    size_t raw_cnt;
+    size_t raw_timings_cnt;
+} SimulationTx;
+
+typedef struct {
+    double seconds;
+    size_t stalls;
+    size_t restarts;
+} SimulationResult;
+
+static IrdaRawSignal* simulation_raw;
+
+static uint64_t simulation_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* same as irda_worker_tx_fill_buffer() does for each timing */
+static FuriHalIrdaTxGetDataState
+    simulation_tx_data_callback(void* context, uint32_t* duration, bool* level) {
+    SimulationTx* tx = context;
+    IrdaStatus status;
+
+    if(tx->signal->protocol != SIMULATION_PROTOCOL_RAW) {
+        status = irda_encode(tx->encoder, duration, level);
+        furi_check(status != IrdaStatusError);
+    } else {
+        if(tx->raw_cnt == 0) {
+            *duration = IRDA_RAW_TX_TIMING_DELAY_US;
+            irda_raw_signal_iterator_init(&tx->iterator, tx->raw);
+        } else {
+            bool next = irda_raw_signal_iterator_next(&tx->iterator, duration);
+            furi_check(next);
+        }
+        *level = tx->raw_cnt % 2;
+        ++tx->raw_cnt;
+        if(tx->raw_cnt >= tx->raw_timings_cnt) {
+            tx->raw_cnt = 0;
+            status = IrdaStatusDone;
+        } else {
+            status = IrdaStatusOk;
+        }
+    }
+
+    return (status == IrdaStatusDone) ? FuriHalIrdaTxGetDataStateDone :
+                                        FuriHalIrdaTxGetDataStateOk;
+}
+
+static void simulation_tx_start(SimulationTx* tx, const SimulationSignal* signal) {
+    tx->signal = signal;
+    tx->raw_cnt = 0;
+    if(signal->protocol == SIMULATION_PROTOCOL_RAW) {
+        tx->raw = simulation_raw;
+        tx->raw_timings_cnt = irda_raw_signal_get_timings_count(simulation_raw) + 1;
+    } else {
+        irda_reset_encoder(tx->encoder, &signal->message);
+    }
+}
+
+/* raw signal is what was learned from NEC remote, without leading gap */
+static IrdaRawSignal* simulation_raw_alloc(IrdaEncoderHandler* encoder) {
+    IrdaMessage message = {.protocol = IrdaProtocolNEC, .address = 0x04, .command = 0x08};
+    uint32_t timings[128];
+    size_t timings_cnt = 0;
+    IrdaStatus status;
+
+    irda_reset_encoder(encoder, &message);
+    do {
+        uint32_t duration;
+        bool level;
+        status = irda_encode(encoder, &duration, &level);
+        if(level || timings_cnt) {
+            furi_check(timings_cnt < COUNT_OF(timings));
+            timings[timings_cnt++] = duration;
+        }
+    } while(status == IrdaStatusOk);
+
+    return irda_raw_signal_encode(timings, timings_cnt, IRDA_RAW_QUANTIZATION_US);
+}
+
+static SimulationSignal* simulation_signals_alloc(const SimulationCost* cost) {
+    SimulationSignal* signals = furi_alloc(sizeof(SimulationSignal) * cost->signals);
+    IrdaEncoderHandler* encoder = irda_alloc_encoder();
+    SimulationTx tx = {.encoder = encoder};
+
+    simulation_raw = simulation_raw_alloc(encoder);
+    for(size_t i = 0; i < cost->signals; ++i) {
+        SimulationSignal* signal = &signals[i];
+        signal->protocol = (i / cost->group) % (IrdaProtocolMAX + 1);
+        if(signal->protocol == SIMULATION_PROTOCOL_RAW) {
+            signal->frequency = IRDA_COMMON_CARRIER_FREQUENCY;
+        } else {
+            IrdaProtocol protocol = signal->protocol;
+            uint8_t address_length = irda_get_protocol_address_length(protocol);
+            uint8_t command_length = irda_get_protocol_command_length(protocol);
+            signal->message.protocol = protocol;
+            signal->message.address = (i * 7) & ((1UL << address_length) - 1);
+            signal->message.command = (i * 13) & ((1UL << command_length) - 1);
+            signal->frequency = irda_get_protocol_frequency(protocol);
+        }
+
+        /* host time is noisy, best of few runs is taken as callback cost */
+        for(size_t run = 0; run < 5; ++run) {
+            uint64_t start = simulation_time_ns();
+            double air_us = 0;
+            FuriHalIrdaTxGetDataState state;
+            simulation_tx_start(&tx, signal);
+            do {
+                uint32_t duration;
+                bool level;
+                state = simulation_tx_data_callback(&tx, &duration, &level);
+                air_us += duration;
+            } while(state == FuriHalIrdaTxGetDataStateOk);
+            double prepare_us = (simulation_time_ns() - start) / 1000.0 * cost->scale;
+            if(!run || (prepare_us < signal->prepare_us)) signal->prepare_us = prepare_us;
+            signal->air_us = air_us;
+        }
+    }
+
+    irda_free_encoder(encoder);
+    return signals;
+}
+
+static void simulation_theoretical(
+    const SimulationSignal* signals,
+    const SimulationCost* cost,
+    SimulationResult* result) {
+    memset(result, 0, sizeof(*result));
+    for(size_t i = 0; i < cost->signals; ++i) {
+        result->seconds += signals[i].air_us / 1e6;
+    }
+}
+
+static void
+    simulation_sync(const SimulationSignal* signals, const SimulationCost* cost, SimulationResult* result) {
+    double time = 0;
+
+    memset(result, 0, sizeof(*result));
+    for(size_t i = 0; i < cost->signals; ++i) {
+        time += cost->fetch_us + cost->start_us + signals[i].air_us + cost->stop_us;
+        ++result->restarts;
+    }
+    result->seconds = time / 1e6;
+}
+
+static void simulation_pipelined(
+    const SimulationSignal* signals,
+    const SimulationCost* cost,
+    SimulationResult* result) {
+    double* ready = furi_alloc(sizeof(double) * cost->signals);
+    double* taken = furi_alloc(sizeof(double) * cost->signals);
+    size_t produced = 0;
+    size_t taken_cnt = 0;
+    double tick = 0;
+    double air_start = 0;
+    double air_end = 0;
+
+    memset(result, 0, sizeof(*result));
+    for(size_t i = 0; i < cost->signals; ++i) {
+        /* app tick reads signals from index while there is space in queue */
+        while(produced <= i) {
+            while((taken_cnt < i) && (taken[taken_cnt] <= tick)) ++taken_cnt;
+            double producer = tick;
+            while((produced - taken_cnt < cost->queue_size) && (produced < cost->signals)) {
+                producer += cost->fetch_us;
+                ready[produced++] = producer;
+            }
+            tick = MAX(tick + cost->tick_us, producer);
+        }
+
+        /* next signal is requested once previous one is encoded into
+         * stream buffer, which holds whole signal, so when it starts */
+        double request = i ? air_start : 0;
+        taken[i] = MAX(request, ready[i]);
+        double prepared = taken[i] + signals[i].prepare_us;
+
+        if(!i || (signals[i].frequency != signals[i - 1].frequency)) {
+            /* worker waits for end of transmission and restarts carrier */
+            air_start = MAX(air_end + (i ? cost->stop_us : 0), prepared) + cost->start_us;
+            ++result->restarts;
+        } else {
+            if(prepared > air_end) ++result->stalls;
+            air_start = MAX(air_end, prepared);
+        }
+        air_end = air_start + signals[i].air_us;
+    }
+    result->seconds = air_end / 1e6;
+
+    free(taken);
+    free(ready);
+}
+
+typedef void (*SimulationModel)(
+    const SimulationSignal* signals,
+    const SimulationCost* cost,
+    SimulationResult* result);
+
+static void simulation_print(
+    const char* name,
+    SimulationModel model,
+    const SimulationSignal* signals,
+    const SimulationCost* cost,
+    double theoretical_seconds) {
+    SimulationResult result;
+
+    model(signals, cost, &result);
+    printf(
+        "%-12s %12.2f %9.1f%% %10zu %10zu\r\n",
+        name,
+        cost->signals / result.seconds,
+        100.0 * theoretical_seconds / result.seconds,
+        result.restarts,
+        result.stalls);
+}
+
+int main(int argc, char* argv[]) {
+    SimulationCost cost = {
+        .signals = 1000,
+        .group = 16,
+        .queue_size = 8,
+        .scale = 20,
+        .fetch_us = 1000,
+        .start_us = 200,
+        .stop_us = 500,
+        .tick_us = 100000,
+    };
+    int opt;
+
+    while((opt = getopt(argc, argv, "n:g:q:x:f:s:t:k:")) != -1) {
+        switch(opt) {
+        case 'n':
+            cost.signals = atoi(optarg);
+            break;
+        case 'g':
+            cost.group = atoi(optarg);
+            break;
+        case 'q':
+            cost.queue_size = atoi(optarg);
+            break;
+        case 'x':
+            cost.scale = atof(optarg);
+            break;
+        case 'f':
+            cost.fetch_us = atof(optarg);
+            break;
+        case 's':
+            cost.start_us = atof(optarg);
+            break;
+        case 't':
+            cost.stop_us = atof(optarg);
+            break;
+        case 'k':
+            cost.tick_us = atof(optarg) * 1000;
+            break;
+        default:
+            printf(
+                "Usage: %s [-n signals] [-g signals per protocol] [-q queue size]"
+                " [-x callback time scale] [-f fetch us] [-s start us] [-t stop us]"
+                " [-k tick ms]\r\n",
+                argv[0]);
+            return 1;
+        }
+    }
+    furi_check(cost.signals > 0);
+    furi_check(cost.group > 0);
+    furi_check(cost.queue_size > 0);
+
+    SimulationSignal* signals = simulation_signals_alloc(&cost);
+    double prepare_us = 0;
+    for(size_t i = 0; i < cost.signals; ++i) prepare_us += signals[i].prepare_us;
+
+    SimulationResult theoretical;
+    simulation_theoretical(signals, &cost, &theoretical);
+    printf(
+        "%zu signals by %zu per protocol, airtime %.1f s, callback %.1f us/signal x%.1f\r\n",
+        cost.signals,
+        cost.group,
+        theoretical.seconds,
+        prepare_us / cost.signals,
+        cost.scale);
+    printf(
+        "queue %zu, fetch %.0f us, carrier start %.0f us, stop %.0f us, tick %.0f ms\r\n",
+        cost.queue_size,
+        cost.fetch_us,
+        cost.start_us,
+        cost.stop_us,
+        cost.tick_us / 1000);
+    printf(
+        "%-12s %12s %10s %10s %10s\r\n", "model", "signals/s", "airtime", "restarts", "stalls");
+    simulation_print("theoretical", simulation_theoretical, signals, &cost, theoretical.seconds);
+    simulation_print("sync", simulation_sync, signals, &cost, theoretical.seconds);
+    simulation_print("pipelined", simulation_pipelined, signals, &cost, theoretical.seconds);
+
+    irda_raw_signal_free(simulation_raw);
+    free(signals);
+    return 0;
+}
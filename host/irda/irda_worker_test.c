@@ -0,0 +1,477 @@
+#include <furi.h>
+#include <furi-hal-irda.h>
+#include <notification/notification-messages.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include "irda.h"
+#include "irda_raw.h"
+#include "irda_worker.h"
+#include "minunit_vars.h"
+#include "minunit.h"
+#include <toolbox/level_duration_pingpong.h>
+
+/*
+ * lib/irda/worker/irda_worker.c TX state machine against host furi-hal-irda:
+ * "DMA" thread takes timings from worker data callback one by one, sleeps
+ * for their duration divided by TEST_TIME_SCALE, calls signal sent callback
+ * at every packet end and stops after last one, or at packet end once stop
+ * is requested, as furi-hal-irda does. Queue is filled like brute force of
+ * universal remote fills it, every packet is checked against signal queued.
+ *
+ * RX "timer" thread replays NEC frames into ping-pong buffers as buffered
+ * capture of furi-hal-irda does: full buffer is handed over at once, partial
+ * one at the end of frame, then timeout is reported. Buffer released while
+ * buffered capture is off fails, same as furi_assert() in furi-hal-irda.
+ */
+
+#define TEST_TIME_SCALE 20
+#define TEST_SIGNALS_MAX 256
+#define TEST_TIMEOUT_MS 20000
+#define TEST_RX_TIMINGS_MAX 256
+#define TEST_RX_START_STOP_CYCLES 150
+
+typedef enum {
+    TestHalIdle,
+    TestHalTx,
+    TestHalStopReq,
+    TestHalStopped,
+} TestHalState;
+
+typedef struct {
+    size_t timings_cnt;
+    uint32_t air_us;
+    uint32_t frequency;
+} TestPacket;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t thread;
+    TestHalState state;
+    uint32_t frequency;
+
+    FuriHalIrdaTxGetDataISRCallback data_callback;
+    void* data_context;
+    FuriHalIrdaTxSignalSentISRCallback sent_callback;
+    void* sent_context;
+
+    size_t starts;
+    size_t packets_cnt;
+    TestPacket packets[TEST_SIGNALS_MAX];
+
+    struct {
+        pthread_t thread;
+        volatile bool running;
+        volatile bool buffered;
+        LevelDurationPingPong pingpong;
+        FuriHalIrdaRxTimeoutCallback timeout_callback;
+        void* timeout_context;
+        size_t timings_cnt;
+        LevelDuration timings[TEST_RX_TIMINGS_MAX];
+    } rx;
+} TestHal;
+
+typedef struct {
+    IrdaWorker* worker;
+    IrdaMessage messages[TEST_SIGNALS_MAX];
+    IrdaRawSignal* raw;
+    TestPacket expected[TEST_SIGNALS_MAX];
+    size_t signals_cnt;
+    size_t queued_cnt;
+    volatile uint32_t sent_cnt;
+} TestTx;
+
+static TestHal test_hal = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+};
+
+void notification_message(NotificationApp* app, const NotificationSequence* sequence) {
+    (void)app;
+    (void)sequence;
+}
+
+/* NEC frames with gap between them, as long as timeout of worker */
+static void* test_hal_rx_thread(void* context) {
+    while(test_hal.rx.running) {
+        for(size_t i = 0; test_hal.rx.running && (i < test_hal.rx.timings_cnt); i++) {
+            level_duration_pingpong_put(&test_hal.rx.pingpong, test_hal.rx.timings[i]);
+            usleep(level_duration_get_duration(test_hal.rx.timings[i]) / TEST_TIME_SCALE);
+        }
+        if(!test_hal.rx.running) break;
+        level_duration_pingpong_flush(&test_hal.rx.pingpong);
+        usleep(IRDA_RAW_RX_TIMING_DELAY_US / TEST_TIME_SCALE);
+        if(test_hal.rx.timeout_callback) test_hal.rx.timeout_callback(test_hal.rx.timeout_context);
+    }
+    return NULL;
+}
+
+void furi_hal_irda_async_rx_start(void) {
+    furi_check(!test_hal.rx.running);
+    furi_check(test_hal.rx.buffered);
+    test_hal.rx.running = true;
+    furi_check(pthread_create(&test_hal.rx.thread, NULL, test_hal_rx_thread, NULL) == 0);
+}
+
+/* no capture interrupt after stop */
+void furi_hal_irda_async_rx_stop(void) {
+    furi_check(test_hal.rx.running);
+    test_hal.rx.running = false;
+    pthread_join(test_hal.rx.thread, NULL);
+}
+
+void furi_hal_irda_async_rx_set_timeout(uint32_t timeout_us) {
+}
+
+void furi_hal_irda_async_rx_set_timeout_isr_callback(
+    FuriHalIrdaRxTimeoutCallback callback,
+    void* ctx) {
+    test_hal.rx.timeout_callback = callback;
+    test_hal.rx.timeout_context = ctx;
+}
+
+void furi_hal_irda_async_rx_set_buffer_isr_callback(
+    LevelDuration* buffer,
+    size_t size,
+    FuriHalIrdaRxBufferCallback callback,
+    void* ctx) {
+    furi_check(!test_hal.rx.running);
+    if(callback) {
+        level_duration_pingpong_init(&test_hal.rx.pingpong, buffer, size, callback, ctx);
+    }
+    test_hal.rx.buffered = (callback != NULL);
+}
+
+void furi_hal_irda_async_rx_release_buffer(const LevelDuration* buffer) {
+    furi_check(test_hal.rx.buffered);
+    level_duration_pingpong_release(&test_hal.rx.pingpong, buffer);
+}
+
+void furi_hal_irda_async_tx_set_data_isr_callback(
+    FuriHalIrdaTxGetDataISRCallback callback,
+    void* context) {
+    pthread_mutex_lock(&test_hal.mutex);
+    furi_check(test_hal.state == TestHalIdle);
+    test_hal.data_callback = callback;
+    test_hal.data_context = context;
+    pthread_mutex_unlock(&test_hal.mutex);
+}
+
+void furi_hal_irda_async_tx_set_signal_sent_isr_callback(
+    FuriHalIrdaTxSignalSentISRCallback callback,
+    void* context) {
+    pthread_mutex_lock(&test_hal.mutex);
+    test_hal.sent_callback = callback;
+    test_hal.sent_context = context;
+    pthread_mutex_unlock(&test_hal.mutex);
+}
+
+static void* test_hal_tx_thread(void* context) {
+    TestPacket packet = {.frequency = test_hal.frequency};
+    bool stop = false;
+
+    while(!stop) {
+        uint32_t duration;
+        bool level;
+        FuriHalIrdaTxGetDataState state =
+            test_hal.data_callback(test_hal.data_context, &duration, &level);
+        packet.timings_cnt++;
+        packet.air_us += duration;
+        usleep(duration / TEST_TIME_SCALE);
+
+        if(state == FuriHalIrdaTxGetDataStateOk) continue;
+
+        pthread_mutex_lock(&test_hal.mutex);
+        furi_check(test_hal.packets_cnt < TEST_SIGNALS_MAX);
+        test_hal.packets[test_hal.packets_cnt++] = packet;
+        stop = (state == FuriHalIrdaTxGetDataStateLastDone) || (test_hal.state == TestHalStopReq);
+        FuriHalIrdaTxSignalSentISRCallback sent_callback = test_hal.sent_callback;
+        void* sent_context = test_hal.sent_context;
+        pthread_mutex_unlock(&test_hal.mutex);
+
+        if(sent_callback) sent_callback(sent_context);
+        packet = (TestPacket){.frequency = test_hal.frequency};
+    }
+
+    pthread_mutex_lock(&test_hal.mutex);
+    test_hal.state = TestHalStopped;
+    pthread_cond_broadcast(&test_hal.cond);
+    pthread_mutex_unlock(&test_hal.mutex);
+    return NULL;
+}
+
+void furi_hal_irda_async_tx_start(uint32_t freq, float duty_cycle) {
+    pthread_mutex_lock(&test_hal.mutex);
+    furi_check(test_hal.state == TestHalIdle);
+    furi_check(test_hal.data_callback);
+    test_hal.state = TestHalTx;
+    test_hal.frequency = freq;
+    test_hal.starts++;
+    pthread_mutex_unlock(&test_hal.mutex);
+
+    furi_check(pthread_create(&test_hal.thread, NULL, test_hal_tx_thread, NULL) == 0);
+}
+
+void furi_hal_irda_async_tx_wait_termination(void) {
+    pthread_mutex_lock(&test_hal.mutex);
+    furi_check(test_hal.state != TestHalIdle);
+    while(test_hal.state != TestHalStopped) {
+        pthread_cond_wait(&test_hal.cond, &test_hal.mutex);
+    }
+    test_hal.state = TestHalIdle;
+    pthread_mutex_unlock(&test_hal.mutex);
+
+    pthread_join(test_hal.thread, NULL);
+}
+
+void furi_hal_irda_async_tx_stop(void) {
+    pthread_mutex_lock(&test_hal.mutex);
+    if(test_hal.state == TestHalTx) test_hal.state = TestHalStopReq;
+    pthread_mutex_unlock(&test_hal.mutex);
+
+    furi_hal_irda_async_tx_wait_termination();
+}
+
+static void test_hal_reset(void) {
+    pthread_mutex_lock(&test_hal.mutex);
+    furi_check(test_hal.state == TestHalIdle);
+    test_hal.starts = 0;
+    test_hal.packets_cnt = 0;
+    pthread_mutex_unlock(&test_hal.mutex);
+}
+
+static size_t test_hal_get_packets_cnt(void) {
+    pthread_mutex_lock(&test_hal.mutex);
+    size_t packets_cnt = test_hal.packets_cnt;
+    pthread_mutex_unlock(&test_hal.mutex);
+    return packets_cnt;
+}
+
+static void test_tx_signal_sent_callback(void* context) {
+    TestTx* tx = context;
+    tx->sent_cnt = tx->sent_cnt + 1;
+}
+
+/* raw for every 5th signal, groups of 4 signals of same protocol otherwise,
+ * so carrier frequency changes often */
+static bool test_tx_is_raw(size_t index) {
+    return (index % 5) == 4;
+}
+
+static void test_tx_alloc(TestTx* tx, size_t signals_cnt) {
+    IrdaEncoderHandler* encoder = irda_alloc_encoder();
+    uint32_t timings[128];
+    size_t timings_cnt = 0;
+
+    memset(tx, 0, sizeof(TestTx));
+    tx->signals_cnt = signals_cnt;
+
+    IrdaMessage nec = {.protocol = IrdaProtocolNEC, .address = 0x04, .command = 0x08};
+    irda_reset_encoder(encoder, &nec);
+    IrdaStatus status;
+    do {
+        uint32_t duration;
+        bool level;
+        status = irda_encode(encoder, &duration, &level);
+        if(level || timings_cnt) timings[timings_cnt++] = duration;
+    } while(status == IrdaStatusOk);
+    tx->raw = irda_raw_signal_encode(timings, timings_cnt, 0);
+
+    for(size_t i = 0; i < signals_cnt; i++) {
+        TestPacket* expected = &tx->expected[i];
+        if(test_tx_is_raw(i)) {
+            expected->timings_cnt = timings_cnt + 1;
+            expected->air_us = IRDA_RAW_TX_TIMING_DELAY_US;
+            for(size_t j = 0; j < timings_cnt; j++) expected->air_us += timings[j];
+            expected->frequency = IRDA_COMMON_CARRIER_FREQUENCY;
+            continue;
+        }
+
+        IrdaProtocol protocol = (i / 4) % IrdaProtocolMAX;
+        IrdaMessage* message = &tx->messages[i];
+        message->protocol = protocol;
+        message->address = (i * 7) & ((1UL << irda_get_protocol_address_length(protocol)) - 1);
+        message->command = (i * 13) & ((1UL << irda_get_protocol_command_length(protocol)) - 1);
+        expected->frequency = irda_get_protocol_frequency(protocol);
+        irda_reset_encoder(encoder, message);
+        do {
+            uint32_t duration;
+            bool level;
+            status = irda_encode(encoder, &duration, &level);
+            expected->timings_cnt++;
+            expected->air_us += duration;
+        } while(status == IrdaStatusOk);
+    }
+
+    irda_free_encoder(encoder);
+    tx->worker = irda_worker_alloc();
+    irda_worker_tx_set_get_signal_callback(
+        tx->worker, irda_worker_tx_get_signal_queue_callback, tx);
+    irda_worker_tx_set_signal_sent_callback(tx->worker, test_tx_signal_sent_callback, tx);
+    test_hal_reset();
+}
+
+static void test_tx_free(TestTx* tx) {
+    irda_worker_free(tx->worker);
+    irda_raw_signal_free(tx->raw);
+}
+
+/* same as IrdaAppBruteForce::fill_queue() */
+static void test_tx_fill_queue(TestTx* tx) {
+    while((tx->queued_cnt < tx->signals_cnt) && irda_worker_tx_queue_get_space(tx->worker)) {
+        bool queued;
+        if(test_tx_is_raw(tx->queued_cnt)) {
+            queued = irda_worker_tx_queue_raw_signal(tx->worker, tx->raw, 0);
+        } else {
+            queued =
+                irda_worker_tx_queue_decoded_signal(tx->worker, &tx->messages[tx->queued_cnt], 0);
+        }
+        furi_check(queued);
+        if(++tx->queued_cnt == tx->signals_cnt) {
+            furi_check(irda_worker_tx_queue_finish(tx->worker, 0));
+        }
+    }
+}
+
+/* app tick is 100 ms, scaled as airtime */
+static void test_tx_run(TestTx* tx, size_t stop_after) {
+    test_tx_fill_queue(tx);
+    irda_worker_tx_start(tx->worker);
+    for(size_t time = 0; time < TEST_TIMEOUT_MS; time += 5) {
+        test_tx_fill_queue(tx);
+        if(tx->sent_cnt >= stop_after) break;
+        usleep(5000);
+    }
+    irda_worker_tx_stop(tx->worker);
+}
+
+static void test_tx_check_packets(TestTx* tx, size_t packets_cnt) {
+    for(size_t i = 0; i < packets_cnt; i++) {
+        mu_assert_int_eq(tx->expected[i].timings_cnt, test_hal.packets[i].timings_cnt);
+        mu_assert_int_eq(tx->expected[i].air_us, test_hal.packets[i].air_us);
+        mu_assert_int_eq(tx->expected[i].frequency, test_hal.packets[i].frequency);
+    }
+}
+
+MU_TEST(irda_worker_tx_queue_finish_test) {
+    TestTx tx;
+    test_tx_alloc(&tx, 60);
+
+    /* without stop: worker has to report last signal by itself */
+    test_tx_run(&tx, tx.signals_cnt);
+    mu_assert_int_eq(tx.signals_cnt, tx.sent_cnt);
+    mu_assert_int_eq(tx.signals_cnt, test_hal_get_packets_cnt());
+    test_tx_check_packets(&tx, tx.signals_cnt);
+    /* carrier is restarted only when frequency changes */
+    size_t restarts = 1;
+    for(size_t i = 1; i < tx.signals_cnt; i++) {
+        restarts += (tx.expected[i].frequency != tx.expected[i - 1].frequency);
+    }
+    mu_assert_int_eq(restarts, test_hal.starts);
+
+    test_tx_free(&tx);
+}
+
+MU_TEST(irda_worker_tx_stop_test) {
+    TestTx tx;
+    test_tx_alloc(&tx, 60);
+
+    /* every packet which ended is reported once, none is lost to flag coalescing */
+    test_tx_run(&tx, 10);
+    mu_assert(tx.sent_cnt >= 10, "stopped before 10 signals were sent");
+    mu_assert(tx.sent_cnt < tx.signals_cnt, "all signals were sent before stop");
+    mu_assert_int_eq(test_hal_get_packets_cnt(), tx.sent_cnt);
+    test_tx_check_packets(&tx, tx.sent_cnt);
+
+    test_tx_free(&tx);
+}
+
+MU_TEST(irda_worker_tx_single_test) {
+    TestTx tx;
+    test_tx_alloc(&tx, 1);
+
+    test_tx_run(&tx, tx.signals_cnt);
+    mu_assert_int_eq(1, tx.sent_cnt);
+    mu_assert_int_eq(1, test_hal_get_packets_cnt());
+    test_tx_check_packets(&tx, 1);
+
+    test_tx_free(&tx);
+}
+
+static void test_rx_received_callback(void* context, IrdaWorkerSignal* received_signal) {
+    volatile size_t* decoded_cnt = context;
+    if(irda_worker_signal_is_decoded(received_signal)) {
+        const IrdaMessage* message = irda_worker_get_decoded_signal(received_signal);
+        furi_check(message->protocol == IrdaProtocolNEC);
+        *decoded_cnt = *decoded_cnt + 1;
+    }
+    /* slow consumer: stop comes while buffer is being processed */
+    usleep(500);
+}
+
+/* two frames, first one is decoded by space before second, in the middle of buffers */
+static void test_rx_set_frames(void) {
+    IrdaEncoderHandler* encoder = irda_alloc_encoder();
+    IrdaMessage nec = {.protocol = IrdaProtocolNEC, .address = 0x04, .command = 0x08};
+
+    test_hal.rx.timings_cnt = 0;
+    for(size_t frame = 0; frame < 2; frame++) {
+        irda_reset_encoder(encoder, &nec);
+        IrdaStatus status;
+        do {
+            uint32_t duration;
+            bool level;
+            status = irda_encode(encoder, &duration, &level);
+            if(!level && !test_hal.rx.timings_cnt) continue;
+            furi_check(test_hal.rx.timings_cnt < TEST_RX_TIMINGS_MAX);
+            test_hal.rx.timings[test_hal.rx.timings_cnt++] =
+                level_duration_make(level, duration);
+        } while(status == IrdaStatusOk);
+    }
+
+    irda_free_encoder(encoder);
+}
+
+MU_TEST(irda_worker_rx_start_stop_test) {
+    volatile size_t decoded_cnt = 0;
+    test_rx_set_frames();
+    IrdaWorker* worker = irda_worker_alloc();
+    irda_worker_rx_set_received_signal_callback(
+        worker, test_rx_received_callback, (void*)&decoded_cnt);
+
+    /* stop at every point of frame: in the middle, on buffer hand over, in gap */
+    for(size_t i = 0; i < TEST_RX_START_STOP_CYCLES; i++) {
+        irda_worker_rx_start(worker);
+        usleep((i * 397) % 40000);
+        irda_worker_rx_stop(worker);
+    }
+    mu_check(!test_hal.rx.buffered);
+
+    /* and it still decodes after that */
+    size_t stressed_cnt = decoded_cnt;
+    irda_worker_rx_start(worker);
+    usleep(100000);
+    irda_worker_rx_stop(worker);
+    mu_check(decoded_cnt > stressed_cnt);
+
+    irda_worker_free(worker);
+}
+
+MU_TEST_SUITE(test_irda_worker_tx) {
+    MU_RUN_TEST(irda_worker_tx_queue_finish_test);
+    MU_RUN_TEST(irda_worker_tx_stop_test);
+    MU_RUN_TEST(irda_worker_tx_single_test);
+}
+
+MU_TEST_SUITE(test_irda_worker_rx) {
+    MU_RUN_TEST(irda_worker_rx_start_stop_test);
+}
+
+int main(void) {
+    MU_RUN_SUITE(test_irda_worker_tx);
+    MU_RUN_SUITE(test_irda_worker_rx);
+    MU_REPORT();
+
+    return minunit_fail;
+}
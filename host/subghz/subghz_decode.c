@@ -0,0 +1,247 @@
+#include <furi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "subghz_replay.h"
+
+/*
+ * Offline decoder: replays RAW captures through the same protocol registry
+ * as SubGhz app, prints every decoded frame with its edge index and time
+ * in capture, then reports per protocol cost:
+ *  - parse: ns/edge of parser alone over the whole capture
+ *  - to_str: us/frame of subghz_protocol_common_to_str(), this is where
+ *    KeeLoq and Star Line search manufacture keystore
+ *  - pipeline: edges/s of subghz_protocol_parse_pairs() fed in worker
+ *    sized chunks, with to_str of every frame, as SubGhz app does it
+ * Keystore (-k) and Nice FloR-S table (-n) are host paths. Without
+ * captures a synthetic one is replayed.
+ */
+
+#define DECODE_MIN_EDGES 2000000
+#define DECODE_CHUNK 64
+
+typedef struct {
+    uint32_t frames;
+    uint64_t to_str_ns;
+    double parse_ns;
+} DecodeProtocolStats;
+
+typedef struct {
+    const char* keystore;
+    const char* rainbow_table;
+    bool resident;
+    bool quiet;
+} DecodeOptions;
+
+typedef struct {
+    string_t text;
+    size_t edge;
+    uint64_t time_us;
+    bool print;
+    DecodeProtocolStats stats[SUBGHZ_REPLAY_PARSERS_COUNT];
+} DecodeContext;
+
+static uint64_t decode_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static size_t decode_parser_index(const char* name) {
+    size_t i = 0;
+    while(i < SUBGHZ_REPLAY_PARSERS_COUNT && strcmp(subghz_replay_parsers[i].name, name)) i++;
+    furi_check(i < SUBGHZ_REPLAY_PARSERS_COUNT);
+    return i;
+}
+
+static void decode_frame_skip(SubGhzProtocolCommon* parser, void* context) {
+    (void)parser;
+    (void)context;
+}
+
+static void decode_frame_callback(SubGhzProtocolCommon* parser, void* context) {
+    DecodeContext* decode = context;
+    DecodeProtocolStats* stats = &decode->stats[decode_parser_index(parser->name)];
+
+    string_clean(decode->text);
+    uint64_t start = decode_time_ns();
+    subghz_protocol_common_to_str(parser, decode->text);
+    stats->to_str_ns += decode_time_ns() - start;
+    stats->frames++;
+
+    if(decode->print) {
+        printf(
+            "edge %zu, %llu.%06llu s\r\n%s\r\n",
+            decode->edge,
+            (unsigned long long)(decode->time_us / 1000000),
+            (unsigned long long)(decode->time_us % 1000000),
+            string_get_cstr(decode->text));
+    }
+}
+
+static SubGhzProtocol* decode_protocol_alloc(const DecodeOptions* options) {
+    SubGhzProtocol* protocol = subghz_protocol_alloc();
+    if(options->keystore) subghz_protocol_load_keeloq_file(protocol, options->keystore);
+    if(options->rainbow_table) {
+        subghz_protocol_load_nice_flor_s_file(
+            protocol, options->rainbow_table, options->resident);
+    }
+    return protocol;
+}
+
+/* Edge by edge, frames are printed and to_str is timed */
+static void decode_frames(
+    const SubGhzReplayCapture* capture,
+    SubGhzProtocol* protocol,
+    DecodeContext* decode) {
+    decode->time_us = 0;
+    decode->print = true;
+    subghz_protocol_reset(protocol);
+    for(size_t i = 0; i < capture->edges_cnt; i++) {
+        decode->edge = i;
+        subghz_protocol_parse(
+            protocol,
+            level_duration_get_level(capture->edges[i]),
+            level_duration_get_duration(capture->edges[i]));
+        decode->time_us += level_duration_get_duration(capture->edges[i]);
+    }
+    decode->print = false;
+}
+
+/* Returns ns/edge of registry with to_str of every decoded frame */
+static double decode_pipeline(
+    const SubGhzReplayCapture* capture,
+    SubGhzProtocol* protocol,
+    uint32_t rounds) {
+    subghz_protocol_reset(protocol);
+    uint64_t start = decode_time_ns();
+    for(uint32_t round = 0; round < rounds; round++) {
+        for(size_t i = 0; i < capture->edges_cnt; i += DECODE_CHUNK) {
+            subghz_protocol_parse_pairs(
+                protocol, &capture->edges[i], MIN(DECODE_CHUNK, capture->edges_cnt - i));
+        }
+    }
+    return (double)(decode_time_ns() - start) / rounds / capture->edges_cnt;
+}
+
+/* Every parser alone, frames are skipped so only parsing is counted */
+static void decode_parsers(
+    const SubGhzReplayCapture* capture,
+    SubGhzProtocol* protocol,
+    DecodeContext* decode,
+    uint32_t rounds) {
+    for(size_t j = 0; j < SUBGHZ_REPLAY_PARSERS_COUNT; j++) {
+        SubGhzProtocolCommon* parser =
+            subghz_protocol_get_by_name(protocol, subghz_replay_parsers[j].name);
+        furi_check(parser);
+        parser->callback = decode_frame_skip;
+
+        uint64_t start = decode_time_ns();
+        for(uint32_t round = 0; round < rounds; round++) {
+            for(size_t i = 0; i < capture->edges_cnt; i++) {
+                subghz_replay_parsers[j].parse(
+                    parser,
+                    level_duration_get_level(capture->edges[i]),
+                    level_duration_get_duration(capture->edges[i]));
+            }
+        }
+        decode->stats[j].parse_ns =
+            (double)(decode_time_ns() - start) / rounds / capture->edges_cnt;
+    }
+}
+
+static void decode_run(const SubGhzReplayCapture* capture, const DecodeOptions* options) {
+    uint32_t rounds = DECODE_MIN_EDGES / capture->edges_cnt + 1;
+    SubGhzProtocol* protocol = decode_protocol_alloc(options);
+    DecodeContext* decode = furi_alloc(sizeof(DecodeContext));
+    string_init(decode->text);
+    subghz_protocol_enable_dump(protocol, decode_frame_callback, decode);
+
+    printf("%s: %zu edges\r\n", capture->name, capture->edges_cnt);
+    if(!options->quiet) decode_frames(capture, protocol, decode);
+
+    memset(decode->stats, 0, sizeof(decode->stats));
+    double pipeline_ns = decode_pipeline(capture, protocol, rounds);
+    decode_parsers(capture, protocol, decode, rounds);
+
+    printf("%-16s %8s %10s %12s\r\n", "protocol", "frames", "parse ns", "to_str us");
+    double parse_ns = 0;
+    for(size_t j = 0; j < SUBGHZ_REPLAY_PARSERS_COUNT; j++) {
+        const DecodeProtocolStats* stats = &decode->stats[j];
+        parse_ns += stats->parse_ns;
+        printf(
+            "%-16s %8lu %10.2f %12.2f\r\n",
+            subghz_replay_parsers[j].name,
+            (unsigned long)(stats->frames / rounds),
+            stats->parse_ns,
+            stats->frames ? stats->to_str_ns / 1e3 / stats->frames : 0.0);
+    }
+    printf(
+        "%-16s %8s %10.2f\r\npipeline %.2f ns/edge, %.0f edges/s\r\n\r\n",
+        "all parsers",
+        "",
+        parse_ns,
+        pipeline_ns,
+        1e9 / pipeline_ns);
+
+    string_clear(decode->text);
+    free(decode);
+    subghz_protocol_free(protocol);
+}
+
+static void decode_usage(const char* name) {
+    printf(
+        "Usage: %s [-k keystore] [-n nice_flor_s_table] [-r] [-q] [capture...]\r\n"
+        "  -k  manufacture keystore, text or compiled\r\n"
+        "  -n  Nice FloR-S rainbow table\r\n"
+        "  -r  read whole rainbow table to RAM\r\n"
+        "  -q  do not print decoded frames\r\n",
+        name);
+}
+
+int main(int argc, char* argv[]) {
+    DecodeOptions options = {0};
+    int opt;
+    while((opt = getopt(argc, argv, "k:n:rqh")) != -1) {
+        switch(opt) {
+        case 'k':
+            options.keystore = optarg;
+            break;
+        case 'n':
+            options.rainbow_table = optarg;
+            break;
+        case 'r':
+            options.resident = true;
+            break;
+        case 'q':
+            options.quiet = true;
+            break;
+        default:
+            decode_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    /* keystore and table paths are host paths */
+    setenv("FURI_STUB_STORAGE_ROOT", "", 1);
+
+    int result = 0;
+    for(int i = optind; i < ((argc > optind) ? argc : optind + 1); i++) {
+        SubGhzReplayCapture capture = {0};
+        if(argc > optind) {
+            if(!subghz_replay_capture_load(&capture, argv[i])) {
+                printf("%s: failed to load\r\n", argv[i]);
+                result = 1;
+                continue;
+            }
+        } else {
+            subghz_replay_capture_synthesize(&capture);
+        }
+        decode_run(&capture, &options);
+        subghz_replay_capture_free(&capture);
+    }
+
+    return result;
+}
@@ -0,0 +1,208 @@
+#include <furi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/protocols/subghz_protocol_keeloq_common.h>
+
+/*
+ * Manufacture key search of KeeLoq decoder: subghz_keystore_keeloq_find()
+ * against key by key search, as subghz_protocol_keeloq selector used to do.
+ * Keystore of random keys is written to temporary file and loaded with
+ * subghz_keystore_load(), parcels are encrypted with keys from the end of
+ * keystore, so both searches walk most of it. Keys/s counts keystore
+ * entries, every learning type allowed for entry is tried. Only 14 bits of
+ * decrypt are checked, so some parcels match an earlier key by chance:
+ * found counts must be equal, not necessarily equal to amount of parcels.
+ */
+
+#define BENCHMARK_KEYS 512
+#define BENCHMARK_PARCELS 64
+#define BENCHMARK_MASK 0xF3FF0000
+
+typedef struct {
+    uint32_t fix;
+    uint32_t hop;
+    size_t index;
+    uint32_t decrypt;
+} BenchmarkParcel;
+
+static uint32_t benchmark_random_state = 0x2545F491;
+
+static uint32_t benchmark_random(void) {
+    benchmark_random_state ^= benchmark_random_state << 13;
+    benchmark_random_state ^= benchmark_random_state >> 17;
+    benchmark_random_state ^= benchmark_random_state << 5;
+    return benchmark_random_state;
+}
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool benchmark_match(uint32_t decrypt, uint32_t fix) {
+    uint32_t value = (fix >> 28) << 28 | (fix & 0x3FF) << 16;
+    return ((decrypt & BENCHMARK_MASK) == value) ||
+           ((decrypt & BENCHMARK_MASK) == (value & 0xF0000000));
+}
+
+/* Reference: every learning type of every key is decrypted in turn */
+static SubGhzKey* benchmark_reference_find(
+    SubGhzKeystore* keystore,
+    uint32_t fix,
+    uint32_t hop,
+    uint32_t* decrypt) {
+    for
+        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
+            uint64_t key = manufacture_code->key;
+            uint64_t key_mirror = 0;
+            for(uint8_t i = 0; i < 64; i += 8) {
+                key_mirror |= (uint64_t)(uint8_t)(key >> i) << (56 - i);
+            }
+
+            if(manufacture_code->type != KEELOQ_LEARNING_NORMAL) {
+                *decrypt = subghz_protocol_keeloq_common_decrypt(hop, key);
+                if(benchmark_match(*decrypt, fix)) return manufacture_code;
+            }
+            if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+                *decrypt = subghz_protocol_keeloq_common_decrypt(hop, key_mirror);
+                if(benchmark_match(*decrypt, fix)) return manufacture_code;
+            }
+            if(manufacture_code->type != KEELOQ_LEARNING_SIMPLE) {
+                *decrypt = subghz_protocol_keeloq_common_decrypt(
+                    hop, subghz_protocol_keeloq_common_normal_learning(fix, key));
+                if(benchmark_match(*decrypt, fix)) return manufacture_code;
+            }
+            if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+                *decrypt = subghz_protocol_keeloq_common_decrypt(
+                    hop, subghz_protocol_keeloq_common_normal_learning(fix, key_mirror));
+                if(benchmark_match(*decrypt, fix)) return manufacture_code;
+            }
+        }
+    return NULL;
+}
+
+static SubGhzKey* benchmark_slice_find(
+    SubGhzKeystore* keystore,
+    uint32_t fix,
+    uint32_t hop,
+    uint32_t* decrypt) {
+    uint32_t value = (fix >> 28) << 28 | (fix & 0x3FF) << 16;
+    return subghz_keystore_keeloq_find(
+        keystore, fix, hop, BENCHMARK_MASK, value, value & 0xF0000000, decrypt);
+}
+
+static bool benchmark_keystore_write(const char* path) {
+    static const uint16_t types[] = {
+        KEELOQ_LEARNING_UNKNOWN,
+        KEELOQ_LEARNING_UNKNOWN,
+        KEELOQ_LEARNING_SIMPLE,
+        KEELOQ_LEARNING_NORMAL,
+    };
+    FILE* file = fopen(path, "w");
+    if(!file) return false;
+
+    for(size_t i = 0; i < BENCHMARK_KEYS; ++i) {
+        uint64_t key = (uint64_t)benchmark_random() << 32 | benchmark_random();
+        fprintf(
+            file,
+            "%016llX:%hu:Manufacture_%zu\n",
+            (unsigned long long)key,
+            types[i % COUNT_OF(types)],
+            i);
+    }
+    fclose(file);
+    return true;
+}
+
+/* Parcels of keys near the end of keystore, learning type is picked at random */
+static void benchmark_parcels_fill(SubGhzKeystore* keystore, BenchmarkParcel* parcels) {
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    size_t keys_cnt = SubGhzKeyArray_size(*keys);
+
+    for(size_t i = 0; i < BENCHMARK_PARCELS; ++i) {
+        BenchmarkParcel* parcel = &parcels[i];
+        parcel->index = keys_cnt - 1 - benchmark_random() % MIN(keys_cnt, 16);
+        SubGhzKey* manufacture_code = SubGhzKeyArray_get(*keys, parcel->index);
+        uint64_t key = manufacture_code->key;
+        uint8_t type = benchmark_random() % 4;
+
+        if(manufacture_code->type == KEELOQ_LEARNING_SIMPLE) type = 0;
+        if(manufacture_code->type == KEELOQ_LEARNING_NORMAL) type = 2;
+        if(type & 1) key = subghz_protocol_keeloq_common_mirror(key);
+
+        parcel->fix = benchmark_random();
+        if(type & 2) key = subghz_protocol_keeloq_common_normal_learning(parcel->fix, key);
+
+        parcel->decrypt = (parcel->fix >> 28) << 28 | (parcel->fix & 0x3FF) << 16 |
+                          (benchmark_random() & 0xFFFF);
+        parcel->hop = subghz_protocol_keeloq_common_encrypt(parcel->decrypt, key);
+    }
+}
+
+typedef SubGhzKey* (*BenchmarkFind)(SubGhzKeystore*, uint32_t, uint32_t, uint32_t*);
+
+/* returns amount of parcels found with expected key and decrypt */
+static size_t benchmark_run(
+    SubGhzKeystore* keystore,
+    const BenchmarkParcel* parcels,
+    BenchmarkFind find,
+    bool repeat,
+    double* keys_per_s) {
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    size_t found = 0;
+    uint64_t keys_tested = 0;
+
+    uint64_t start = benchmark_time_ns();
+    for(size_t i = 0; i < BENCHMARK_PARCELS; ++i) {
+        for(size_t j = 0; j < (repeat ? 4 : 1); ++j) {
+            uint32_t decrypt = 0;
+            SubGhzKey* manufacture_code = find(keystore, parcels[i].fix, parcels[i].hop, &decrypt);
+            if((manufacture_code == SubGhzKeyArray_get(*keys, parcels[i].index)) &&
+               (decrypt == parcels[i].decrypt)) {
+                ++found;
+            }
+            keys_tested += parcels[i].index + 1;
+        }
+    }
+    *keys_per_s = keys_tested * 1e9 / (benchmark_time_ns() - start);
+    return repeat ? found / 4 : found;
+}
+
+int main(void) {
+    char path[] = "/tmp/subghz_keeloq_benchmarkXXXXXX";
+    int fd = mkstemp(path);
+    furi_check(fd >= 0);
+    close(fd);
+    furi_check(benchmark_keystore_write(path));
+
+    /* keystore path is absolute host path */
+    setenv("FURI_STUB_STORAGE_ROOT", "", 1);
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+    subghz_keystore_load(keystore, path);
+    unlink(path);
+
+    BenchmarkParcel parcels[BENCHMARK_PARCELS];
+    benchmark_parcels_fill(keystore, parcels);
+
+    printf(
+        "%zu keys, %d parcels\r\n",
+        SubGhzKeyArray_size(*subghz_keystore_get_data(keystore)),
+        BENCHMARK_PARCELS);
+    printf("%-28s %12s %8s\r\n", "search", "keys/s", "found");
+
+    double keys_per_s;
+    size_t found = benchmark_run(keystore, parcels, benchmark_reference_find, false, &keys_per_s);
+    printf("%-28s %12.0f %8zu\r\n", "key by key", keys_per_s, found);
+    found = benchmark_run(keystore, parcels, benchmark_slice_find, false, &keys_per_s);
+    printf("%-28s %12.0f %8zu\r\n", "bitsliced, new serial", keys_per_s, found);
+    found = benchmark_run(keystore, parcels, benchmark_slice_find, true, &keys_per_s);
+    printf("%-28s %12.0f %8zu\r\n", "bitsliced, repeated serial", keys_per_s, found);
+
+    subghz_keystore_free(keystore);
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include <furi.h>
+#include <furi-stub.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <m-string.h>
+#include <storage/storage.h>
+#include <lib/subghz/subghz_keystore.h>
+
+/*
+ * Keystore loading: text keystore read 64 bytes at a time into m-string
+ * and sscanf'ed line by line, as subghz_keystore_load() used to do,
+ * against current loader on the same text file and on its compiled
+ * version. Heap allocations are counted with furi-stub wrappers. Name
+ * lookup compares hashed subghz_keystore_get_by_name() with strcmp walk.
+ */
+
+#define BENCHMARK_KEYS 2048
+#define BENCHMARK_NAMES 300
+#define BENCHMARK_LOADS 20
+#define BENCHMARK_LOOKUPS 20000
+
+static uint32_t benchmark_random_state = 0x2545F491;
+
+static uint32_t benchmark_random(void) {
+    benchmark_random_state ^= benchmark_random_state << 13;
+    benchmark_random_state ^= benchmark_random_state >> 17;
+    benchmark_random_state ^= benchmark_random_state << 5;
+    return benchmark_random_state;
+}
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* loaders print file names, hide them while measuring */
+static void benchmark_quiet(bool quiet) {
+    static int console = -1;
+    fflush(stdout);
+    if(quiet) {
+        console = dup(STDOUT_FILENO);
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    } else {
+        dup2(console, STDOUT_FILENO);
+        close(console);
+    }
+}
+
+/* Reference: loader before compiled keystores, keys and names are counted only */
+static size_t benchmark_reference_load(const char* file_name) {
+    File* file = storage_file_alloc(furi_record_open("storage"));
+    string_t line;
+    string_init(line);
+    size_t keys = 0;
+    if(storage_file_open(file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        char buffer[64];
+        uint16_t ret;
+        do {
+            ret = storage_file_read(file, buffer, sizeof(buffer));
+            for(uint16_t i = 0; i < ret; i++) {
+                if(buffer[i] == '\n' && string_size(line) > 0) {
+                    uint16_t type = 0;
+                    char skey[17] = {0};
+                    char name[65] = {0};
+                    if(sscanf(string_get_cstr(line), "%16s:%hu:%64s", skey, &type, name) == 3) {
+                        string_t key_name;
+                        string_init_set_str(key_name, name);
+                        strtoull(skey, NULL, 16);
+                        string_clear(key_name);
+                        keys++;
+                    }
+                    string_clean(line);
+                } else {
+                    string_push_back(line, buffer[i]);
+                }
+            }
+        } while(ret > 0);
+    }
+    string_clear(line);
+    storage_file_close(file);
+    storage_file_free(file);
+    furi_record_close("storage");
+    return keys;
+}
+
+static size_t benchmark_load(const char* file_name) {
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+    subghz_keystore_load(keystore, file_name);
+    size_t keys = SubGhzKeyArray_size(*subghz_keystore_get_data(keystore));
+    subghz_keystore_free(keystore);
+    return keys;
+}
+
+static void benchmark_print_load(const char* name, size_t (*load)(const char*), const char* path) {
+    FuriStubHeapStats before, after;
+    size_t keys = 0;
+
+    benchmark_quiet(true);
+    furi_stub_heap_get_stats(&before);
+    uint64_t start = benchmark_time_ns();
+    for(size_t i = 0; i < BENCHMARK_LOADS; ++i) {
+        keys = load(path);
+    }
+    double load_us = (benchmark_time_ns() - start) / 1e3 / BENCHMARK_LOADS;
+    furi_stub_heap_get_stats(&after);
+    benchmark_quiet(false);
+
+    printf(
+        "%-28s %8zu %10.1f %12zu\r\n",
+        name,
+        keys,
+        load_us,
+        (after.alloc_count - before.alloc_count) / BENCHMARK_LOADS);
+}
+
+static void benchmark_write(const char* text_path, const char* binary_path) {
+    FILE* text = fopen(text_path, "w");
+    FILE* binary = fopen(binary_path, "wb");
+    furi_check(text && binary);
+
+    char names[BENCHMARK_NAMES * 16];
+    size_t names_size = 0;
+    uint32_t name_offsets[BENCHMARK_NAMES];
+    for(size_t i = 0; i < BENCHMARK_NAMES; ++i) {
+        name_offsets[i] = names_size;
+        names_size += sprintf(&names[names_size], "Manufacture_%zu", i) + 1;
+    }
+
+    SubGhzKeystoreBinaryHeader header = {
+        .magic = SUBGHZ_KEYSTORE_BINARY_MAGIC,
+        .version = SUBGHZ_KEYSTORE_BINARY_VERSION,
+        .key_count = BENCHMARK_KEYS,
+        .names_size = names_size,
+    };
+    fwrite(&header, sizeof(header), 1, binary);
+    for(size_t i = 0; i < BENCHMARK_KEYS; ++i) {
+        SubGhzKeystoreBinaryRecord record = {
+            .key = (uint64_t)benchmark_random() << 32 | benchmark_random(),
+            .type = i % 3,
+            .name = name_offsets[i % BENCHMARK_NAMES],
+        };
+        fwrite(&record, sizeof(record), 1, binary);
+        fprintf(
+            text,
+            "%016llX:%hu:%s\n",
+            (unsigned long long)record.key,
+            record.type,
+            &names[record.name]);
+    }
+    fwrite(names, names_size, 1, binary);
+    fclose(binary);
+    fclose(text);
+}
+
+static void benchmark_lookup(const char* path) {
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+    benchmark_quiet(true);
+    subghz_keystore_load(keystore, path);
+    benchmark_quiet(false);
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    char name[32];
+    size_t found = 0;
+
+    benchmark_random_state = 0x2545F491;
+    uint64_t start = benchmark_time_ns();
+    for(size_t i = 0; i < BENCHMARK_LOOKUPS; ++i) {
+        snprintf(name, sizeof(name), "Manufacture_%lu", (unsigned long)(benchmark_random() % BENCHMARK_NAMES));
+        for
+            M_EACH(manufacture_code, *keys, SubGhzKeyArray_t) {
+                if(!strcmp(manufacture_code->name, name)) {
+                    ++found;
+                    break;
+                }
+            }
+    }
+    double walk_ns = (double)(benchmark_time_ns() - start) / BENCHMARK_LOOKUPS;
+    printf("%-28s %10.1f ns %8zu\r\n", "strcmp walk", walk_ns, found);
+
+    found = 0;
+    benchmark_random_state = 0x2545F491;
+    start = benchmark_time_ns();
+    for(size_t i = 0; i < BENCHMARK_LOOKUPS; ++i) {
+        snprintf(name, sizeof(name), "Manufacture_%lu", (unsigned long)(benchmark_random() % BENCHMARK_NAMES));
+        if(subghz_keystore_get_by_name(keystore, name)) ++found;
+    }
+    double hash_ns = (double)(benchmark_time_ns() - start) / BENCHMARK_LOOKUPS;
+    printf("%-28s %10.1f ns %8zu\r\n", "hashed", hash_ns, found);
+
+    subghz_keystore_free(keystore);
+}
+
+int main(void) {
+    char text_path[] = "/tmp/subghz_keystore_benchmarkXXXXXX";
+    char binary_path[] = "/tmp/subghz_keystore_benchmarkXXXXXX";
+    int fd = mkstemp(text_path);
+    furi_check(fd >= 0);
+    close(fd);
+    fd = mkstemp(binary_path);
+    furi_check(fd >= 0);
+    close(fd);
+    benchmark_write(text_path, binary_path);
+
+    /* keystore path is absolute host path */
+    setenv("FURI_STUB_STORAGE_ROOT", "", 1);
+
+    printf("%d keys, %d names\r\n", BENCHMARK_KEYS, BENCHMARK_NAMES);
+    printf("%-28s %8s %10s %12s\r\n", "load", "keys", "us/load", "allocations");
+    benchmark_print_load("text, line by line (before)", benchmark_reference_load, text_path);
+    benchmark_print_load("text, bulk read", benchmark_load, text_path);
+    benchmark_print_load("compiled", benchmark_load, binary_path);
+
+    printf("\r\n%-28s %13s %8s\r\n", "name lookup", "per lookup", "found");
+    benchmark_lookup(binary_path);
+
+    unlink(text_path);
+    unlink(binary_path);
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <furi.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "subghz_replay.h"
+
+/*
+ * Replays RAW captures through subghz_protocol_parse() and through every
+ * parser in turn, as subghz_protocol_parse() used to do.
+ * Without arguments a capture is synthesized: random noise with frames
+ * of every protocol that has an encoder.
+ */
+
+#define BENCHMARK_MIN_EDGES 2000000
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void benchmark_frame_callback(SubGhzProtocolCommon* parser, void* context) {
+    (void)parser;
+    uint32_t* frames = context;
+    (*frames)++;
+}
+
+static uint32_t benchmark_registry(const SubGhzReplayCapture* capture, uint32_t rounds) {
+    SubGhzProtocol* protocol = subghz_protocol_alloc();
+    uint32_t frames = 0;
+
+    subghz_protocol_enable_dump(protocol, benchmark_frame_callback, &frames);
+    for(uint32_t round = 0; round < rounds; round++) {
+        for(size_t i = 0; i < capture->edges_cnt; i++) {
+            subghz_protocol_parse(
+                protocol,
+                level_duration_get_level(capture->edges[i]),
+                level_duration_get_duration(capture->edges[i]));
+        }
+    }
+
+    subghz_protocol_free(protocol);
+    return frames;
+}
+
+static uint32_t benchmark_fanout(const SubGhzReplayCapture* capture, uint32_t rounds) {
+    SubGhzProtocol* protocol = subghz_protocol_alloc();
+    SubGhzProtocolCommon* parsers[SUBGHZ_REPLAY_PARSERS_COUNT];
+    uint32_t frames = 0;
+
+    subghz_protocol_enable_dump(protocol, benchmark_frame_callback, &frames);
+    for(size_t j = 0; j < SUBGHZ_REPLAY_PARSERS_COUNT; j++) {
+        parsers[j] = subghz_protocol_get_by_name(protocol, subghz_replay_parsers[j].name);
+        furi_check(parsers[j]);
+    }
+
+    for(uint32_t round = 0; round < rounds; round++) {
+        for(size_t i = 0; i < capture->edges_cnt; i++) {
+            bool level = level_duration_get_level(capture->edges[i]);
+            uint32_t duration = level_duration_get_duration(capture->edges[i]);
+            for(size_t j = 0; j < SUBGHZ_REPLAY_PARSERS_COUNT; j++) {
+                subghz_replay_parsers[j].parse(parsers[j], level, duration);
+            }
+        }
+    }
+
+    subghz_protocol_free(protocol);
+    return frames;
+}
+
+static void benchmark_run(const SubGhzReplayCapture* capture) {
+    uint32_t rounds = BENCHMARK_MIN_EDGES / capture->edges_cnt + 1;
+    double edges = (double)rounds * capture->edges_cnt;
+
+    uint64_t start = benchmark_time_ns();
+    uint32_t fanout_frames = benchmark_fanout(capture, rounds);
+    double fanout_ns = (benchmark_time_ns() - start) / edges;
+
+    start = benchmark_time_ns();
+    uint32_t frames = benchmark_registry(capture, rounds);
+    double registry_ns = (benchmark_time_ns() - start) / edges;
+
+    printf(
+        "%-24s %8zu %8u %10.2f %12.0f %10.2f %12.0f%s\r\n",
+        capture->name,
+        capture->edges_cnt,
+        frames / rounds,
+        registry_ns,
+        1e9 / registry_ns,
+        fanout_ns,
+        1e9 / fanout_ns,
+        (frames == fanout_frames) ? "" : "  (decoded frames differ!)");
+}
+
+int main(int argc, char* argv[]) {
+    printf(
+        "%-24s %8s %8s %10s %12s %10s %12s\r\n",
+        "capture",
+        "edges",
+        "frames",
+        "ns/edge",
+        "edges/s",
+        "fanout",
+        "edges/s");
+
+    for(int i = 0; i < ((argc > 1) ? argc - 1 : 1); i++) {
+        SubGhzReplayCapture capture = {0};
+        if(argc > 1) {
+            if(!subghz_replay_capture_load(&capture, argv[i + 1])) {
+                printf("%-24s failed to load\r\n", argv[i + 1]);
+                continue;
+            }
+        } else {
+            subghz_replay_capture_synthesize(&capture);
+        }
+        benchmark_run(&capture);
+        subghz_replay_capture_free(&capture);
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <furi.h>
+#include <furi-stub.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <file-worker.h>
+#include <lib/subghz/subghz_rainbow_table.h>
+
+/*
+ * Nice FloR-S rainbow table lookups: a decoded packet reads 2 bytes of
+ * counter table and 1 byte of key table. Table of random bytes is written
+ * to temporary file and read with FileWorker opened per byte, as the
+ * decoder used to do, through SubGhzRainbowTable block cache and
+ * from resident table. Storage stub is stdio, so on device open/close
+ * is much more expensive relative to cached reads than here.
+ */
+
+#define BENCHMARK_TABLE_SIZE (0x20000 + 0x100)
+#define BENCHMARK_PACKETS 20000
+
+static uint32_t benchmark_random_state = 0x2545F491;
+
+static uint32_t benchmark_random(void) {
+    benchmark_random_state ^= benchmark_random_state << 13;
+    benchmark_random_state ^= benchmark_random_state >> 17;
+    benchmark_random_state ^= benchmark_random_state << 5;
+    return benchmark_random_state;
+}
+
+static uint64_t benchmark_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+typedef uint8_t (*BenchmarkGetByte)(void* context, uint32_t address);
+
+static uint8_t benchmark_file_worker_get_byte(void* context, uint32_t address) {
+    const char* file_name = context;
+    uint8_t buffer = 0;
+    FileWorker* file_worker = file_worker_alloc(true);
+    if(file_worker_open(file_worker, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        file_worker_seek(file_worker, address, true);
+        file_worker_read(file_worker, &buffer, 1);
+    }
+    file_worker_close(file_worker);
+    file_worker_free(file_worker);
+    return buffer;
+}
+
+static uint8_t benchmark_rainbow_table_get_byte(void* context, uint32_t address) {
+    uint8_t buffer = 0;
+    subghz_rainbow_table_get_byte(context, address, &buffer);
+    return buffer;
+}
+
+/* Same lookups as subghz_nice_flor_s_decoder_decrypt(), returns checksum */
+static uint32_t benchmark_run(BenchmarkGetByte get_byte, void* context, double* packets_per_s) {
+    uint32_t checksum = 0;
+    benchmark_random_state = 0x2545F491;
+
+    uint64_t start = benchmark_time_ns();
+    for(size_t i = 0; i < BENCHMARK_PACKETS; ++i) {
+        uint16_t p3p4 = benchmark_random();
+        uint16_t cnt = get_byte(context, p3p4 * 2) << 8 | get_byte(context, p3p4 * 2 + 1);
+        uint8_t k = (uint8_t)(p3p4 & 0x00FF) ^ get_byte(context, 0x20000 | (cnt & 0x00ff));
+        checksum = checksum * 31 + (cnt ^ k);
+    }
+    *packets_per_s = BENCHMARK_PACKETS * 1e9 / (benchmark_time_ns() - start);
+    return checksum;
+}
+
+int main(void) {
+    char path[] = "/tmp/subghz_rainbow_table_benchmarkXXXXXX";
+    int fd = mkstemp(path);
+    furi_check(fd >= 0);
+    close(fd);
+
+    FILE* file = fopen(path, "wb");
+    furi_check(file);
+    for(size_t i = 0; i < BENCHMARK_TABLE_SIZE; ++i) {
+        fputc(benchmark_random() & 0xFF, file);
+    }
+    fclose(file);
+
+    /* table path is absolute host path */
+    setenv("FURI_STUB_STORAGE_ROOT", "", 1);
+    SubGhzRainbowTable* table = subghz_rainbow_table_alloc();
+    double packets_per_s;
+
+    printf("%d bytes table, %d packets\r\n", BENCHMARK_TABLE_SIZE, BENCHMARK_PACKETS);
+    printf("%-28s %12s %10s\r\n", "lookup", "packets/s", "checksum");
+
+    uint32_t checksum = benchmark_run(benchmark_file_worker_get_byte, path, &packets_per_s);
+    printf("%-28s %12.0f %10lX\r\n", "file worker per byte", packets_per_s, (unsigned long)checksum);
+
+    furi_check(subghz_rainbow_table_open(table, path, false));
+    checksum = benchmark_run(benchmark_rainbow_table_get_byte, table, &packets_per_s);
+    printf("%-28s %12.0f %10lX\r\n", "block cache", packets_per_s, (unsigned long)checksum);
+
+    furi_check(subghz_rainbow_table_open(table, path, true));
+    furi_check(subghz_rainbow_table_is_resident(table));
+    checksum = benchmark_run(benchmark_rainbow_table_get_byte, table, &packets_per_s);
+    printf("%-28s %12.0f %10lX\r\n", "resident", packets_per_s, (unsigned long)checksum);
+
+    /* not enough heap: falls back to block cache */
+    furi_stub_heap_set_size(64 * 1024);
+    furi_check(subghz_rainbow_table_open(table, path, true));
+    furi_check(!subghz_rainbow_table_is_resident(table));
+
+    subghz_rainbow_table_free(table);
+    unlink(path);
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "subghz_replay.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <lib/subghz/protocols/subghz_protocol_came.h>
+#include <lib/subghz/protocols/subghz_protocol_keeloq.h>
+#include <lib/subghz/protocols/subghz_protocol_princeton.h>
+#include <lib/subghz/protocols/subghz_protocol_nice_flo.h>
+#include <lib/subghz/protocols/subghz_protocol_nice_flor_s.h>
+#include <lib/subghz/protocols/subghz_protocol_gate_tx.h>
+#include <lib/subghz/protocols/subghz_protocol_ido.h>
+#include <lib/subghz/protocols/subghz_protocol_faac_slh.h>
+#include <lib/subghz/protocols/subghz_protocol_nero_sketch.h>
+#include <lib/subghz/protocols/subghz_protocol_star_line.h>
+#include <lib/subghz/protocols/subghz_protocol_nero_radio.h>
+
+#define SUBGHZ_REPLAY_NOISE_EDGES 2000
+
+const SubGhzReplayParser subghz_replay_parsers[SUBGHZ_REPLAY_PARSERS_COUNT] = {
+    {"CAME", (SubGhzReplayParse)subghz_protocol_came_parse},
+    {"KeeLoq", (SubGhzReplayParse)subghz_protocol_keeloq_parse},
+    {"Princeton", (SubGhzReplayParse)subghz_decoder_princeton_parse},
+    {"Nice FLO", (SubGhzReplayParse)subghz_protocol_nice_flo_parse},
+    {"Nice FloR-S", (SubGhzReplayParse)subghz_protocol_nice_flor_s_parse},
+    {"GateTX", (SubGhzReplayParse)subghz_protocol_gate_tx_parse},
+    {"iDo 117/111", (SubGhzReplayParse)subghz_protocol_ido_parse},
+    {"Faac SLH", (SubGhzReplayParse)subghz_protocol_faac_slh_parse},
+    {"Nero Sketch", (SubGhzReplayParse)subghz_protocol_nero_sketch_parse},
+    {"Star Line", (SubGhzReplayParse)subghz_protocol_star_line_parse},
+    {"Nero Radio", (SubGhzReplayParse)subghz_protocol_nero_radio_parse},
+};
+
+/* Static protocols which can be encoded without keys */
+static const char* subghz_replay_synthetic_protocols[] = {
+    "CAME",
+    "Princeton",
+    "Nice FLO",
+    "GateTX",
+    "Nero Sketch",
+    "Nero Radio",
+};
+
+void subghz_replay_capture_add(SubGhzReplayCapture* capture, bool level, uint32_t duration) {
+    if(capture->edges_cnt == capture->edges_size) {
+        capture->edges_size = capture->edges_size ? capture->edges_size * 2 : 1024;
+        capture->edges = realloc(capture->edges, capture->edges_size * sizeof(LevelDuration));
+        furi_check(capture->edges);
+    }
+    capture->edges[capture->edges_cnt++] = level_duration_make(level, duration);
+}
+
+bool subghz_replay_capture_load(SubGhzReplayCapture* capture, const char* path) {
+    FILE* file = fopen(path, "r");
+    if(!file) return false;
+
+    char token[32];
+    capture->name = path;
+    while(fscanf(file, "%31s", token) == 1) {
+        char* end;
+        long duration = strtol(token, &end, 10);
+        if(*end || !duration) continue;
+        subghz_replay_capture_add(capture, duration > 0, labs(duration));
+    }
+    fclose(file);
+    return capture->edges_cnt > 0;
+}
+
+static uint32_t subghz_replay_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+void subghz_replay_capture_synthesize(SubGhzReplayCapture* capture) {
+    SubGhzProtocol* protocol = subghz_protocol_alloc();
+    SubGhzProtocolCommonEncoder* encoder = subghz_protocol_encoder_common_alloc();
+    uint32_t random = 0x12345678;
+    bool level = false;
+
+    capture->name = "synthetic";
+    for(size_t i = 0; i < COUNT_OF(subghz_replay_synthetic_protocols); i++) {
+        SubGhzProtocolCommon* common =
+            subghz_protocol_get_by_name(protocol, subghz_replay_synthetic_protocols[i]);
+        furi_check(common && common->get_upload_protocol);
+
+        /* noise is what receiver gets most of the time */
+        for(size_t j = 0; j < SUBGHZ_REPLAY_NOISE_EDGES; j++) {
+            subghz_replay_capture_add(capture, level, 50 + subghz_replay_random(&random) % 1500);
+            level = !level;
+        }
+
+        common->code_last_count_bit = common->code_min_count_bit_for_found;
+        common->code_last_found = ((uint64_t)subghz_replay_random(&random) << 32 |
+                                   subghz_replay_random(&random)) &
+                                  ((1ULL << common->code_last_count_bit) - 1);
+        furi_check(common->get_upload_protocol(common, encoder));
+        for(size_t repeat = 0; repeat < 3; repeat++) {
+            for(size_t j = 0; j < encoder->size_upload; j++) {
+                level = level_duration_get_level(encoder->upload[j]);
+                subghz_replay_capture_add(
+                    capture, level, level_duration_get_duration(encoder->upload[j]));
+                level = !level;
+            }
+        }
+    }
+
+    subghz_protocol_encoder_common_free(encoder);
+    subghz_protocol_free(protocol);
+}
+
+void subghz_replay_capture_free(SubGhzReplayCapture* capture) {
+    free(capture->edges);
+    capture->edges = NULL;
+    capture->edges_cnt = 0;
+    capture->edges_size = 0;
+}
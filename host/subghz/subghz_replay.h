@@ -0,0 +1,39 @@
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/protocols/subghz_protocol.h>
+
+/*
+ * Host helpers to replay Sub-GHz RAW captures. RAW capture is a text file
+ * of signed durations in us: positive is high level, negative is low,
+ * anything else (like "RAW_Data:" of .sub files) is skipped.
+ */
+
+typedef void (*SubGhzReplayParse)(void* instance, bool level, uint32_t duration);
+
+typedef struct {
+    const char* name;
+    SubGhzReplayParse parse;
+} SubGhzReplayParser;
+
+typedef struct {
+    const char* name;
+    LevelDuration* edges;
+    size_t edges_cnt;
+    size_t edges_size;
+} SubGhzReplayCapture;
+
+#define SUBGHZ_REPLAY_PARSERS_COUNT 11
+
+/* Every parser of subghz_protocol, in registry order, to drive them one by one */
+extern const SubGhzReplayParser subghz_replay_parsers[SUBGHZ_REPLAY_PARSERS_COUNT];
+
+void subghz_replay_capture_add(SubGhzReplayCapture* capture, bool level, uint32_t duration);
+
+/* false if file can't be read or has no durations */
+bool subghz_replay_capture_load(SubGhzReplayCapture* capture, const char* path);
+
+/* Random noise with 3 repeats of frame of every static protocol that has an encoder */
+void subghz_replay_capture_synthesize(SubGhzReplayCapture* capture);
+
+void subghz_replay_capture_free(SubGhzReplayCapture* capture);
@@ -0,0 +1,13 @@
+#include <stdio.h>
+#include <furi.h>
+#include "minunit_vars.h"
+
+int run_minunit_test_irda_decoder_encoder();
+
+int main(void) {
+    int test_result = 0;
+
+    test_result |= run_minunit_test_irda_decoder_encoder();
+
+    return test_result;
+}
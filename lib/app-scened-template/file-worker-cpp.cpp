@@ -45,6 +45,10 @@ bool FileWorkerCpp::seek(uint64_t position, bool from_start) {
     return file_worker_seek(file_worker, position, from_start);
 }
 
+bool FileWorkerCpp::size(uint64_t* size) {
+    return file_worker_size(file_worker, size);
+}
+
 bool FileWorkerCpp::write(const void* buffer, uint16_t bytes_to_write) {
     return file_worker_write(file_worker, buffer, bytes_to_write);
 }
@@ -67,8 +71,12 @@ bool FileWorkerCpp::file_select(
         file_worker, path, extension, result, result_size, selected_filename);
 }
 
-bool FileWorkerCpp::read_until_buffered(string_t str_result, char* file_buf, size_t* file_buf_cnt, size_t max_length, char separator) {
-    return file_worker_read_until_buffered(file_worker, str_result, file_buf, file_buf_cnt, max_length, separator);
+bool FileWorkerCpp::read_line(char** line, size_t* length, char separator) {
+    return file_worker_read_line(file_worker, line, length, separator);
+}
+
+void FileWorkerCpp::set_read_buffer_size(uint16_t size) {
+    file_worker_set_read_buffer_size(file_worker, size);
 }
 
 bool FileWorkerCpp::get_value_from_key(string_t key, char delimiter, string_t value) {
@@ -88,6 +88,14 @@ public:
      */
     bool seek(uint64_t position, bool from_start);
 
+    /**
+     * @brief Get size of opened file
+     * 
+     * @param size 
+     * @return true on success  
+     */
+    bool size(uint64_t* size);
+
     /**
      * @brief Write data to file.
      * 
@@ -131,17 +139,24 @@ public:
         const char* selected_filename);
 
     /**
-     * @brief Reads data from a file until separator or EOF is found.
-     * Moves seek pointer to the next symbol after the separator. The separator is included in the result.
+     * @brief Reads line from a file into read buffer, without copying.
+     * Line is terminated with '\0' in place of separator and stays valid until next FileWorker call.
+     * Lines longer than read buffer are skipped, see set_read_buffer_size.
      *
-     * @param result
-     * @param file_buf
-     * @param file_buf_cnt
-     * @param max_length
+     * @param line pointer to line in read buffer
+     * @param length line length, separator is not included
      * @param separator
-     * @return true on success
+     * @return true if line is read, false on EOF or error
+     */
+    bool read_line(char** line, size_t* length, char separator = '\n');
+
+    /**
+     * @brief Set size of read ahead buffer, 256 bytes by default.
+     * Can't be changed while there is unread data in buffer.
+     *
+     * @param size
      */
-    bool read_until_buffered(string_t str_result, char* file_buf, size_t* file_buf_cnt, size_t max_length, char separator = '\n');
+    void set_read_buffer_size(uint16_t size);
 
     /**
      * @brief Gets value from key
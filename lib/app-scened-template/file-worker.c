@@ -4,10 +4,20 @@
 #include <dialogs/dialogs.h>
 #include <furi.h>
 
+/* default size of read ahead buffer */
+#define FILE_WORKER_READ_BUFFER_SIZE 256
+
 struct FileWorker {
     Storage* api;
     bool silent;
     File* file;
+    /* read ahead buffer, allocated on first read and freed on close.
+     * Data between read_start and read_end is already read from file,
+     * but not consumed, so file offset is ahead of logical position. */
+    char* read_buffer;
+    size_t read_buffer_size;
+    size_t read_start;
+    size_t read_end;
 };
 
 bool file_worker_check_common_errors(FileWorker* file_worker);
@@ -19,19 +29,26 @@ bool file_worker_write_internal(
     uint16_t bytes_to_write);
 bool file_worker_tell_internal(FileWorker* file_worker, uint64_t* position);
 bool file_worker_seek_internal(FileWorker* file_worker, uint64_t position, bool from_start);
+bool file_worker_fill_buffer(FileWorker* file_worker);
+bool file_worker_sync_position(FileWorker* file_worker);
 
 FileWorker* file_worker_alloc(bool _silent) {
     FileWorker* file_worker = malloc(sizeof(FileWorker));
     file_worker->silent = _silent;
-    file_worker->api = furi_record_open("storage");
+    file_worker->api = furi_record_open_id(FuriRecordIdStorage);
     file_worker->file = storage_file_alloc(file_worker->api);
+    file_worker->read_buffer = NULL;
+    file_worker->read_buffer_size = FILE_WORKER_READ_BUFFER_SIZE;
+    file_worker->read_start = 0;
+    file_worker->read_end = 0;
 
     return file_worker;
 }
 
 void file_worker_free(FileWorker* file_worker) {
+    free(file_worker->read_buffer);
     storage_file_free(file_worker->file);
-    furi_record_close("storage");
+    furi_record_close_id(FuriRecordIdStorage);
     free(file_worker);
 }
 
@@ -40,6 +57,8 @@ bool file_worker_open(
     const char* filename,
     FS_AccessMode access_mode,
     FS_OpenMode open_mode) {
+    file_worker->read_start = 0;
+    file_worker->read_end = 0;
     bool result = storage_file_open(file_worker->file, filename, access_mode, open_mode);
 
     if(!result) {
@@ -54,6 +73,10 @@ bool file_worker_close(FileWorker* file_worker) {
     if(storage_file_is_open(file_worker->file)) {
         storage_file_close(file_worker->file);
     }
+    free(file_worker->read_buffer);
+    file_worker->read_buffer = NULL;
+    file_worker->read_start = 0;
+    file_worker->read_end = 0;
 
     return file_worker_check_common_errors(file_worker);
 }
@@ -89,43 +112,98 @@ bool file_worker_read(FileWorker* file_worker, void* buffer, uint16_t bytes_to_r
 
 bool file_worker_read_until(FileWorker* file_worker, string_t str_result, char separator) {
     string_clean(str_result);
-    const uint8_t buffer_size = 32;
-    uint8_t buffer[buffer_size];
 
-    do {
-        uint16_t read_count = storage_file_read(file_worker->file, buffer, buffer_size);
-        if(storage_file_get_error(file_worker->file) != FSE_OK) {
-            file_worker_show_error_internal(file_worker, "Cannot read\nfile");
-            return false;
+    while(true) {
+        if(file_worker->read_start == file_worker->read_end) {
+            if(!file_worker_fill_buffer(file_worker)) {
+                file_worker_show_error_internal(file_worker, "Cannot read\nfile");
+                return false;
+            }
+            if(file_worker->read_start == file_worker->read_end) break;
+        }
+
+        char* start = &file_worker->read_buffer[file_worker->read_start];
+        size_t available = file_worker->read_end - file_worker->read_start;
+        char* found = memchr(start, separator, available);
+        size_t length = found ? (size_t)(found - start) : available;
+        for(size_t i = 0; i < length; i++) {
+            string_push_back(str_result, start[i]);
         }
+        file_worker->read_start += found ? length + 1 : length;
 
-        bool result = false;
-        for(uint16_t i = 0; i < read_count; i++) {
-            if(buffer[i] == separator) {
-                uint64_t position;
-                if(!file_worker_tell_internal(file_worker, &position)) {
-                    return false;
-                }
+        if(found) break;
+    }
 
-                position = position - read_count + i + 1;
+    return file_worker_check_common_errors(file_worker);
+}
 
-                if(!file_worker_seek_internal(file_worker, position, true)) {
-                    return false;
-                }
+bool file_worker_read_line(FileWorker* file_worker, char** line, size_t* length, char separator) {
+    furi_assert(line);
+    furi_assert(length);
+
+    /* line doesn't fit into buffer and is being skipped */
+    bool skip = false;
+    /* unread data already searched for separator */
+    size_t searched = 0;
+
+    while(true) {
+        size_t available = file_worker->read_end - file_worker->read_start;
+        char* found = NULL;
+        if(available > searched) {
+            found = memchr(
+                &file_worker->read_buffer[file_worker->read_start + searched],
+                separator,
+                available - searched);
+        }
 
-                result = true;
-                break;
-            } else {
-                string_push_back(str_result, buffer[i]);
+        if(found) {
+            char* start = &file_worker->read_buffer[file_worker->read_start];
+            size_t found_length = found - start;
+            file_worker->read_start += found_length + 1;
+            if(skip) {
+                skip = false;
+                searched = 0;
+                continue;
             }
+            *found = '\0';
+            *line = start;
+            *length = found_length;
+            return true;
         }
 
-        if(result || read_count == 0) {
-            break;
+        if(available == file_worker->read_buffer_size) {
+            skip = true;
+            file_worker->read_start = file_worker->read_end;
+            available = 0;
         }
-    } while(true);
+        searched = available;
 
-    return file_worker_check_common_errors(file_worker);
+        if(!file_worker_fill_buffer(file_worker)) {
+            file_worker_show_error_internal(file_worker, "Cannot read\nfile");
+            return false;
+        }
+
+        if(file_worker->read_end - file_worker->read_start == available) {
+            /* end of file, last line may have no separator */
+            if(skip || !available) return false;
+            file_worker->read_buffer[file_worker->read_end] = '\0';
+            *line = &file_worker->read_buffer[file_worker->read_start];
+            *length = available;
+            file_worker->read_start = file_worker->read_end;
+            return true;
+        }
+    }
+}
+
+void file_worker_set_read_buffer_size(FileWorker* file_worker, uint16_t size) {
+    furi_assert(size > 0);
+    furi_assert(file_worker->read_start == file_worker->read_end);
+
+    free(file_worker->read_buffer);
+    file_worker->read_buffer = NULL;
+    file_worker->read_buffer_size = size;
+    file_worker->read_start = 0;
+    file_worker->read_end = 0;
 }
 
 bool file_worker_read_hex(FileWorker* file_worker, uint8_t* buffer, uint16_t bytes_to_read) {
@@ -174,6 +252,16 @@ bool file_worker_seek(FileWorker* file_worker, uint64_t position, bool from_star
     return file_worker_check_common_errors(file_worker);
 }
 
+bool file_worker_size(FileWorker* file_worker, uint64_t* size) {
+    *size = storage_file_size(file_worker->file);
+    if(storage_file_get_error(file_worker->file) != FSE_OK) {
+        file_worker_show_error_internal(file_worker, "Cannot get\nfile size");
+        return false;
+    }
+
+    return file_worker_check_common_errors(file_worker);
+}
+
 bool file_worker_write(FileWorker* file_worker, const void* buffer, uint16_t bytes_to_write) {
     if(!file_worker_write_internal(file_worker, buffer, bytes_to_write)) {
         return false;
@@ -245,20 +333,47 @@ void file_worker_show_error_internal(FileWorker* file_worker, const char* error_
 }
 
 bool file_worker_read_internal(FileWorker* file_worker, void* buffer, uint16_t bytes_to_read) {
-    uint16_t read_count = storage_file_read(file_worker->file, buffer, bytes_to_read);
+    uint8_t* data = buffer;
+    bool result = true;
+
+    size_t buffered = MIN(file_worker->read_end - file_worker->read_start, bytes_to_read);
+    if(buffered) {
+        memcpy(data, &file_worker->read_buffer[file_worker->read_start], buffered);
+        file_worker->read_start += buffered;
+        data += buffered;
+        bytes_to_read -= buffered;
+    }
+
+    if(bytes_to_read >= file_worker->read_buffer_size) {
+        /* no point to copy large reads through buffer */
+        uint16_t read_count = storage_file_read(file_worker->file, data, bytes_to_read);
+        result = (storage_file_get_error(file_worker->file) == FSE_OK) &&
+                 (read_count == bytes_to_read);
+    } else if(bytes_to_read) {
+        result = file_worker_fill_buffer(file_worker) &&
+                 (file_worker->read_end - file_worker->read_start >= bytes_to_read);
+        if(result) {
+            memcpy(data, &file_worker->read_buffer[file_worker->read_start], bytes_to_read);
+            file_worker->read_start += bytes_to_read;
+        }
+    }
 
-    if(storage_file_get_error(file_worker->file) != FSE_OK || read_count != bytes_to_read) {
+    if(!result) {
         file_worker_show_error_internal(file_worker, "Cannot read\nfile");
-        return false;
     }
 
-    return true;
+    return result;
 }
 
 bool file_worker_write_internal(
     FileWorker* file_worker,
     const void* buffer,
     uint16_t bytes_to_write) {
+    if(!file_worker_sync_position(file_worker)) {
+        file_worker_show_error_internal(file_worker, "Cannot write\nto file");
+        return false;
+    }
+
     uint16_t write_count = storage_file_write(file_worker->file, buffer, bytes_to_write);
 
     if(storage_file_get_error(file_worker->file) != FSE_OK || write_count != bytes_to_write) {
@@ -270,7 +385,8 @@ bool file_worker_write_internal(
 }
 
 bool file_worker_tell_internal(FileWorker* file_worker, uint64_t* position) {
-    *position = storage_file_tell(file_worker->file);
+    *position = storage_file_tell(file_worker->file) -
+                (file_worker->read_end - file_worker->read_start);
 
     if(storage_file_get_error(file_worker->file) != FSE_OK) {
         file_worker_show_error_internal(file_worker, "Cannot tell\nfile offset");
@@ -281,6 +397,17 @@ bool file_worker_tell_internal(FileWorker* file_worker, uint64_t* position) {
 }
 
 bool file_worker_seek_internal(FileWorker* file_worker, uint64_t position, bool from_start) {
+    size_t buffered = file_worker->read_end - file_worker->read_start;
+    if(!from_start && (position <= buffered)) {
+        file_worker->read_start += position;
+        return true;
+    }
+    if(!from_start) {
+        position -= buffered;
+    }
+    file_worker->read_start = 0;
+    file_worker->read_end = 0;
+
     storage_file_seek(file_worker->file, position, from_start);
     if(storage_file_get_error(file_worker->file) != FSE_OK) {
         file_worker_show_error_internal(file_worker, "Cannot seek\nfile");
@@ -290,96 +417,66 @@ bool file_worker_seek_internal(FileWorker* file_worker, uint64_t position, bool
     return true;
 }
 
-bool file_worker_read_until_buffered(
-    FileWorker* file_worker,
-    string_t str_result,
-    char* file_buf,
-    size_t* file_buf_cnt,
-    size_t file_buf_size,
-    char separator) {
-    furi_assert(string_capacity(str_result) > 0);
-
-    // fs_api->file.read now supports up to 512 bytes reading at a time
-    furi_assert(file_buf_size <= 512);
-
-    string_clean(str_result);
-    size_t newline_index = 0;
-    bool found_eol = false;
-    bool max_length_exceeded = false;
-    size_t max_length = string_capacity(str_result) - 1;
-
-    while(1) {
-        if(*file_buf_cnt > 0) {
-            size_t end_index = 0;
-            char* endline_ptr = (char*)memchr(file_buf, separator, *file_buf_cnt);
-            newline_index = endline_ptr - file_buf;
-
-            if(endline_ptr == 0) {
-                end_index = *file_buf_cnt;
-            } else if(newline_index < *file_buf_cnt) {
-                end_index = newline_index + 1;
-                found_eol = true;
-            } else {
-                furi_assert(0);
-            }
-
-            if(max_length && (string_size(str_result) + end_index > max_length))
-                max_length_exceeded = true;
-
-            if(!max_length_exceeded) {
-                for(size_t i = 0; i < end_index; ++i) {
-                    string_push_back(str_result, file_buf[i]);
-                }
-            }
+/* Move unread data to the beginning of buffer and read more after it */
+bool file_worker_fill_buffer(FileWorker* file_worker) {
+    if(!file_worker->read_buffer) {
+        /* one more byte to terminate last line of file */
+        file_worker->read_buffer = malloc(file_worker->read_buffer_size + 1);
+    }
 
-            memmove(file_buf, &file_buf[end_index], *file_buf_cnt - end_index);
-            *file_buf_cnt = *file_buf_cnt - end_index;
-            if(found_eol) break;
-        }
+    size_t buffered = file_worker->read_end - file_worker->read_start;
+    if(file_worker->read_start) {
+        memmove(
+            file_worker->read_buffer,
+            &file_worker->read_buffer[file_worker->read_start],
+            buffered);
+        file_worker->read_start = 0;
+        file_worker->read_end = buffered;
+    }
 
-        *file_buf_cnt += storage_file_read(
-            file_worker->file, &file_buf[*file_buf_cnt], file_buf_size - *file_buf_cnt);
-        if(storage_file_get_error(file_worker->file) != FSE_OK) {
-            file_worker_show_error_internal(file_worker, "Cannot read\nfile");
-            string_clear(str_result);
-            *file_buf_cnt = 0;
-            break;
-        }
-        if(*file_buf_cnt == 0) {
-            break; // end of reading
-        }
+    uint16_t read_count = storage_file_read(
+        file_worker->file,
+        &file_worker->read_buffer[buffered],
+        file_worker->read_buffer_size - buffered);
+    if(storage_file_get_error(file_worker->file) != FSE_OK) {
+        file_worker->read_start = 0;
+        file_worker->read_end = 0;
+        return false;
     }
+    file_worker->read_end += read_count;
 
-    if(max_length_exceeded) string_clean(str_result);
+    return true;
+}
 
-    return string_size(str_result) || *file_buf_cnt;
+/* Return file offset to logical position, dropping read ahead data */
+bool file_worker_sync_position(FileWorker* file_worker) {
+    if(file_worker->read_start == file_worker->read_end) return true;
+
+    uint64_t position;
+    return file_worker_tell_internal(file_worker, &position) &&
+           file_worker_seek_internal(file_worker, position, true);
 }
 
 bool file_worker_get_value_from_key(FileWorker* file_worker, string_t key, char delimiter, string_t value) {
     bool found = false;
-    string_t next_line;
-    string_t next_key;
-    string_init(next_line);
-    string_init(next_key);
-    size_t delim_pos = 0;
-
-    while(file_worker_read_until(file_worker, next_line, '\n')) {
-        delim_pos = string_search_char(next_line, delimiter);
-        if(delim_pos == STRING_FAILURE) {
+    size_t key_length = string_size(key);
+    char* line;
+    size_t line_length;
+
+    while(file_worker_read_line(file_worker, &line, &line_length, '\n')) {
+        char* delim = memchr(line, delimiter, line_length);
+        if(!delim) {
             break;
         }
-        string_set_n(next_key, next_line, 0, delim_pos);
-        if(string_equal_p(next_key, key)) {
-            string_right(next_line, delim_pos);
-            string_strim(next_line);
-            string_set(value, next_line);
+        if(((size_t)(delim - line) == key_length) &&
+           !memcmp(line, string_get_cstr(key), key_length)) {
+            string_set_str(value, delim);
+            string_strim(value);
             found = true;
             break;
         }
     }
 
-    string_clear(next_line);
-    string_clear(next_key);
     return found;
 }
 
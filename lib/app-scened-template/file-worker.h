@@ -89,6 +89,29 @@ bool file_worker_read(FileWorker* file_worker, void* buffer, uint16_t bytes_to_r
  */
 bool file_worker_read_until(FileWorker* file_worker, string_t result, char separator);
 
+/**
+ * @brief Reads line from a file into read buffer, without copying.
+ * Line is terminated with '\0' in place of separator and stays valid until next FileWorker call.
+ * Lines longer than read buffer are skipped, see file_worker_set_read_buffer_size.
+ * 
+ * @param file_worker FileWorker instance 
+ * @param line pointer to line in read buffer
+ * @param length line length, separator is not included
+ * @param separator 
+ * @return true if line is read, false on EOF or error
+ */
+bool file_worker_read_line(FileWorker* file_worker, char** line, size_t* length, char separator);
+
+/**
+ * @brief Set size of read ahead buffer, 256 bytes by default.
+ * Reads and line reads are served from buffer, so files are read by blocks of this size.
+ * Can't be changed while there is unread data in buffer.
+ * 
+ * @param file_worker FileWorker instance 
+ * @param size 
+ */
+void file_worker_set_read_buffer_size(FileWorker* file_worker, uint16_t size);
+
 /**
  * @brief Reads data in hexadecimal space-delimited format. For example "AF FF" in a file - [175, 255] in a read buffer.
  * 
@@ -118,6 +141,15 @@ bool file_worker_tell(FileWorker* file_worker, uint64_t* position);
  */
 bool file_worker_seek(FileWorker* file_worker, uint64_t position, bool from_start);
 
+/**
+ * @brief Get size of opened file
+ * 
+ * @param file_worker FileWorker instance 
+ * @param size 
+ * @return true on success  
+ */
+bool file_worker_size(FileWorker* file_worker, uint64_t* size);
+
 /**
  * @brief Write data to file.
  * 
@@ -165,26 +197,6 @@ bool file_worker_file_select(
     uint8_t selected_filename_size,
     const char* preselected_filename);
 
-/**
- * @brief Reads data from a file until separator or EOF is found.
- * The separator is included in the result.
- *
- * @param file_worker FileWorker instance
- * @param str_result
- * @param file_buf
- * @param file_buf_cnt
- * @param max_length
- * @param separator
- * @return true on success
- */
-bool file_worker_read_until_buffered(
-    FileWorker* file_worker,
-    string_t str_result,
-    char* file_buf,
-    size_t* file_buf_cnt,
-    size_t max_length,
-    char separator);
-
 /**
  * @brief Gets value from key
  *
@@ -8,15 +8,6 @@
 
 static void irda_common_decoder_reset_state(IrdaCommonDecoder* decoder);
 
-static inline size_t consume_samples(uint32_t* array, size_t len, size_t shift) {
-    furi_assert(len >= shift);
-    len -= shift;
-    for (int i = 0; i < len; ++i)
-        array[i] = array[i + shift];
-
-    return len;
-}
-
 static inline void accumulate_lsb(IrdaCommonDecoder* decoder, bool bit) {
     uint16_t index = decoder->databit_cnt / 8;
     uint8_t shift = decoder->databit_cnt % 8;   // LSB first
@@ -42,7 +33,7 @@ static bool irda_check_preamble(IrdaCommonDecoder* decoder) {
     // align to start at Mark timing
     if (!start_level) {
         if (decoder->timings_cnt > 0) {
-            decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+            irda_common_decoder_consume(decoder, 1);
         }
     }
 
@@ -51,16 +42,12 @@ static bool irda_check_preamble(IrdaCommonDecoder* decoder) {
     }
 
     while ((!result) && (decoder->timings_cnt >= 2)) {
-        float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
-        uint16_t preamble_mark = decoder->protocol->timings.preamble_mark;
-        uint16_t preamble_space = decoder->protocol->timings.preamble_space;
-
-        if ((MATCH_TIMING(decoder->timings[0], preamble_mark, preamble_tolerance))
-            && (MATCH_TIMING(decoder->timings[1], preamble_space, preamble_tolerance))) {
+        if (irda_timing_match(irda_common_decoder_timing(decoder, 0), decoder->bounds.preamble_mark)
+            && irda_timing_match(irda_common_decoder_timing(decoder, 1), decoder->bounds.preamble_space)) {
             result = true;
         }
 
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 2);
+        irda_common_decoder_consume(decoder, 2);
     }
 
     return result;
@@ -70,18 +57,13 @@ static bool irda_check_preamble(IrdaCommonDecoder* decoder) {
 IrdaStatus irda_common_decode_pdm(IrdaCommonDecoder* decoder) {
     furi_assert(decoder);
 
-    uint32_t* timings = decoder->timings;
     IrdaStatus status = IrdaStatusError;
-    uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
-    uint16_t bit1_mark = decoder->protocol->timings.bit1_mark;
-    uint16_t bit1_space = decoder->protocol->timings.bit1_space;
-    uint16_t bit0_mark = decoder->protocol->timings.bit0_mark;
-    uint16_t bit0_space = decoder->protocol->timings.bit0_space;
+    const IrdaCommonDecoderBounds* bounds = &decoder->bounds;
 
     while (1) {
         // Stop bit
         if ((decoder->databit_cnt == decoder->protocol->databit_len) && (decoder->timings_cnt == 1)) {
-            if (MATCH_TIMING(timings[0], bit1_mark, bit_tolerance)) {
+            if (irda_timing_match(irda_common_decoder_timing(decoder, 0), bounds->bit1_mark)) {
                 decoder->timings_cnt = 0;
                 status = IrdaStatusReady;
             } else {
@@ -91,17 +73,19 @@ IrdaStatus irda_common_decode_pdm(IrdaCommonDecoder* decoder) {
         }
 
         if (decoder->timings_cnt >= 2) {
-            if (MATCH_TIMING(timings[0], bit1_mark, bit_tolerance)
-                && MATCH_TIMING(timings[1], bit1_space, bit_tolerance)) {
+            uint32_t mark = irda_common_decoder_timing(decoder, 0);
+            uint32_t space = irda_common_decoder_timing(decoder, 1);
+            if (irda_timing_match(mark, bounds->bit1_mark)
+                && irda_timing_match(space, bounds->bit1_space)) {
                 accumulate_lsb(decoder, 1);
-            } else if (MATCH_TIMING(timings[0], bit0_mark, bit_tolerance)
-                && MATCH_TIMING(timings[1], bit0_space, bit_tolerance)) {
+            } else if (irda_timing_match(mark, bounds->bit0_mark)
+                && irda_timing_match(space, bounds->bit0_space)) {
                 accumulate_lsb(decoder, 0);
             } else {
                 status = IrdaStatusError;
                 break;
             }
-            decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 2);
+            irda_common_decoder_consume(decoder, 2);
         } else {
             status = IrdaStatusOk;
             break;
@@ -115,16 +99,14 @@ IrdaStatus irda_common_decode_pdm(IrdaCommonDecoder* decoder) {
 IrdaStatus irda_common_decode_manchester(IrdaCommonDecoder* decoder) {
     furi_assert(decoder);
     IrdaStatus status = IrdaStatusOk;
-    uint16_t bit = decoder->protocol->timings.bit1_mark;
-    uint16_t tolerance = decoder->protocol->timings.bit_tolerance;
 
     while (decoder->timings_cnt) {
-        uint32_t timing = decoder->timings[0];
+        uint32_t timing = irda_common_decoder_timing(decoder, 0);
         bool* switch_detect = &decoder->switch_detect;
         furi_assert((*switch_detect == true) || (*switch_detect == false));
 
-        bool single_timing = MATCH_TIMING(timing, bit, tolerance);
-        bool double_timing = MATCH_TIMING(timing, 2*bit, tolerance);
+        bool single_timing = irda_timing_match(timing, decoder->bounds.bit1_mark);
+        bool double_timing = irda_timing_match(timing, decoder->bounds.bit1_mark_x2);
 
         if(!single_timing && !double_timing) {
             status = IrdaStatusError;
@@ -150,7 +132,7 @@ IrdaStatus irda_common_decode_manchester(IrdaCommonDecoder* decoder) {
                 *switch_detect = 0;
         }
 
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+        irda_common_decoder_consume(decoder, 1);
         status = IrdaStatusOk;
         bool level = (decoder->level + decoder->timings_cnt) % 2;
 
@@ -183,32 +165,29 @@ IrdaStatus irda_common_decode_manchester(IrdaCommonDecoder* decoder) {
 IrdaStatus irda_common_decode_pwm(IrdaCommonDecoder* decoder) {
     furi_assert(decoder);
 
-    uint32_t* timings = decoder->timings;
     IrdaStatus status = IrdaStatusOk;
-    uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
-    uint16_t bit1_mark = decoder->protocol->timings.bit1_mark;
-    uint16_t bit1_space = decoder->protocol->timings.bit1_space;
-    uint16_t bit0_mark = decoder->protocol->timings.bit0_mark;
+    const IrdaCommonDecoderBounds* bounds = &decoder->bounds;
 
     while (decoder->timings_cnt) {
         bool level = (decoder->level + decoder->timings_cnt + 1) % 2;
+        uint32_t timing = irda_common_decoder_timing(decoder, 0);
 
         if (level) {
-            if (MATCH_TIMING(timings[0], bit1_mark, bit_tolerance)) {
+            if (irda_timing_match(timing, bounds->bit1_mark)) {
                 accumulate_lsb(decoder, 1);
-            } else if (MATCH_TIMING(timings[0], bit0_mark, bit_tolerance)) {
+            } else if (irda_timing_match(timing, bounds->bit0_mark)) {
                 accumulate_lsb(decoder, 0);
             } else {
                 status = IrdaStatusError;
                 break;
             }
         } else {
-            if (!MATCH_TIMING(timings[0], bit1_space, bit_tolerance)) {
+            if (!irda_timing_match(timing, bounds->bit1_space)) {
                 status = IrdaStatusError;
                 break;
             }
         }
-        decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+        irda_common_decoder_consume(decoder, 1);
 
         if (decoder->databit_cnt == decoder->protocol->databit_len) {
             status = IrdaStatusReady;
@@ -225,14 +204,16 @@ IrdaMessage* irda_common_decode(IrdaCommonDecoder* decoder, bool level, uint32_t
     IrdaMessage* message = 0;
     IrdaStatus status = IrdaStatusError;
 
-    if (decoder->level == level) {
+    /* Idle decoder has nothing to drop, and it may have been skipped by
+     * dispatcher (irda_decode()), so its level is not reliable */
+    if ((decoder->level == level) && !irda_common_decoder_is_idle(decoder)) {
         irda_common_decoder_reset(decoder);
     }
     decoder->level = level;   // start with low level (Space timing)
 
-    decoder->timings[decoder->timings_cnt] = duration;
+    furi_check(decoder->timings_cnt < IRDA_COMMON_DECODER_TIMINGS);
+    decoder->timings[(decoder->timings_head + decoder->timings_cnt) & (IRDA_COMMON_DECODER_TIMINGS - 1)] = duration;
     decoder->timings_cnt++;
-    furi_check(decoder->timings_cnt <= sizeof(decoder->timings));
 
     while(1) {
         switch (decoder->state) {
@@ -279,6 +260,25 @@ IrdaMessage* irda_common_decode(IrdaCommonDecoder* decoder, bool level, uint32_t
     return message;
 }
 
+static IrdaTimingBounds irda_common_decoder_bounds(uint32_t timing, uint32_t tolerance) {
+    IrdaTimingBounds bounds = IRDA_TIMING_BOUNDS(timing, tolerance);
+    return bounds;
+}
+
+static void irda_common_decoder_init_bounds(IrdaCommonDecoder* decoder) {
+    const IrdaTimings* timings = &decoder->protocol->timings;
+    IrdaCommonDecoderBounds* bounds = &decoder->bounds;
+
+    bounds->preamble_mark = irda_common_decoder_bounds(timings->preamble_mark, timings->preamble_tolerance);
+    bounds->preamble_space = irda_common_decoder_bounds(timings->preamble_space, timings->preamble_tolerance);
+    bounds->bit1_mark = irda_common_decoder_bounds(timings->bit1_mark, timings->bit_tolerance);
+    bounds->bit1_space = irda_common_decoder_bounds(timings->bit1_space, timings->bit_tolerance);
+    bounds->bit0_mark = irda_common_decoder_bounds(timings->bit0_mark, timings->bit_tolerance);
+    bounds->bit0_space = irda_common_decoder_bounds(timings->bit0_space, timings->bit_tolerance);
+    bounds->bit1_mark_x2 = irda_common_decoder_bounds(2 * timings->bit1_mark, timings->bit_tolerance);
+    bounds->bit1_mark_x3 = irda_common_decoder_bounds(3 * timings->bit1_mark, timings->bit_tolerance);
+}
+
 void* irda_common_decoder_alloc(const IrdaCommonProtocolSpec* protocol) {
     furi_assert(protocol);
 
@@ -289,6 +289,7 @@ void* irda_common_decoder_alloc(const IrdaCommonProtocolSpec* protocol) {
     memset(decoder, 0, alloc_size);
     decoder->protocol = protocol;
     decoder->level = true;
+    irda_common_decoder_init_bounds(decoder);
     return decoder;
 }
 
@@ -304,11 +305,27 @@ void irda_common_decoder_reset_state(IrdaCommonDecoder* decoder) {
     decoder->message.protocol = IrdaProtocolUnknown;
     if (decoder->protocol->timings.preamble_mark == 0) {
         if (decoder->timings_cnt > 0) {
-            decoder->timings_cnt = consume_samples(decoder->timings, decoder->timings_cnt, 1);
+            irda_common_decoder_consume(decoder, 1);
         }
     }
 }
 
+bool irda_common_decoder_is_idle(IrdaCommonDecoder* decoder) {
+    furi_assert(decoder);
+
+    bool idle = false;
+    if (!decoder->timings_cnt) {
+        if (decoder->state == IrdaCommonDecoderStateWaitPreamble) {
+            idle = true;
+        } else if (decoder->state == IrdaCommonDecoderStateDecode) {
+            /* no preamble - decoder waits for first bit in Decode state */
+            idle = !decoder->protocol->timings.preamble_mark && !decoder->databit_cnt;
+        }
+    }
+
+    return idle;
+}
+
 void irda_common_decoder_reset(IrdaCommonDecoder* decoder) {
     furi_assert(decoder);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <furi.h>
 #include "irda.h"
 #include "irda_i.h"
 
@@ -8,6 +9,18 @@
 #define MATCH_TIMING(x, v, delta)       (  ((x) < (v + delta)) \
                                         && ((x) > (v - delta)))
 
+/* Ring of received timings, power of 2 */
+#define IRDA_COMMON_DECODER_TIMINGS     8
+
+/* Exclusive bounds of timing, same window as MATCH_TIMING(x, v, delta) */
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+} IrdaTimingBounds;
+
+#define IRDA_TIMING_BOUNDS(v, delta)    { .min = ((v) > (delta)) ? ((v) - (delta)) : 0, \
+                                          .max = (v) + (delta) }
+
 typedef struct IrdaCommonDecoder IrdaCommonDecoder;
 typedef struct IrdaCommonEncoder IrdaCommonEncoder;
 
@@ -40,12 +53,26 @@ typedef enum {
     IrdaCommonEncoderStateEncodeRepeat,
 } IrdaCommonStateEncoder;
 
+/* Bounds derived from IrdaCommonProtocolSpec timings when decoder is allocated */
+typedef struct {
+    IrdaTimingBounds preamble_mark;
+    IrdaTimingBounds preamble_space;
+    IrdaTimingBounds bit1_mark;
+    IrdaTimingBounds bit1_space;
+    IrdaTimingBounds bit0_mark;
+    IrdaTimingBounds bit0_space;
+    IrdaTimingBounds bit1_mark_x2;      /* manchester: double time-quant */
+    IrdaTimingBounds bit1_mark_x3;      /* manchester: RC6 toggle bit */
+} IrdaCommonDecoderBounds;
+
 struct IrdaCommonDecoder {
     const IrdaCommonProtocolSpec* protocol;
     void* context;
-    uint32_t timings[6];
+    IrdaCommonDecoderBounds bounds;
+    uint32_t timings[IRDA_COMMON_DECODER_TIMINGS];
     IrdaMessage message;
     IrdaCommonStateDecoder state;
+    uint8_t timings_head;       /* index of oldest timing in ring */
     uint8_t timings_cnt;
     bool switch_detect;
     bool level;
@@ -64,6 +91,21 @@ struct IrdaCommonEncoder {
     uint8_t data[];
 };
 
+static inline bool irda_timing_match(uint32_t timing, IrdaTimingBounds bounds) {
+    return (timing > bounds.min) && (timing < bounds.max);
+}
+
+/* index 0 is the oldest timing not consumed by decoder yet */
+static inline uint32_t irda_common_decoder_timing(const IrdaCommonDecoder* decoder, uint8_t index) {
+    return decoder->timings[(decoder->timings_head + index) & (IRDA_COMMON_DECODER_TIMINGS - 1)];
+}
+
+static inline void irda_common_decoder_consume(IrdaCommonDecoder* decoder, uint8_t count) {
+    furi_assert(decoder->timings_cnt >= count);
+    decoder->timings_head = (decoder->timings_head + count) & (IRDA_COMMON_DECODER_TIMINGS - 1);
+    decoder->timings_cnt -= count;
+}
+
 IrdaMessage* irda_common_decode(IrdaCommonDecoder *decoder, bool level, uint32_t duration);
 IrdaStatus irda_common_decode_pdm(IrdaCommonDecoder* decoder);
 IrdaStatus irda_common_decode_pwm(IrdaCommonDecoder* decoder);
@@ -71,6 +113,7 @@ IrdaStatus irda_common_decode_manchester(IrdaCommonDecoder* decoder);
 void* irda_common_decoder_alloc(const IrdaCommonProtocolSpec *protocol);
 void irda_common_decoder_free(IrdaCommonDecoder* decoder);
 void irda_common_decoder_reset(IrdaCommonDecoder* decoder);
+bool irda_common_decoder_is_idle(IrdaCommonDecoder* decoder);
 
 IrdaStatus irda_common_encode(IrdaCommonEncoder* encoder, uint32_t* duration, bool* polarity);
 IrdaStatus irda_common_encode_pdwm(IrdaCommonEncoder* encoder, uint32_t* duration, bool* polarity);
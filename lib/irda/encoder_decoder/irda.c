@@ -15,6 +15,8 @@ typedef struct {
     IrdaDecoderReset reset;
     IrdaFree free;
     IrdaDecoderCheckReady check_ready;
+    IrdaDecoderIsIdle is_idle;
+    const IrdaCommonProtocolSpec* protocol;
 } IrdaDecoders;
 
 typedef struct {
@@ -24,8 +26,17 @@ typedef struct {
     IrdaFree free;
 } IrdaEncoders;
 
+/* Timings are sorted into buckets to find out at once which of idle
+ * decoders can start new frame from this timing. */
+#define IRDA_DECODER_START_BUCKET_SHIFT     8       /* 256 us per bucket */
+#define IRDA_DECODER_START_BUCKETS          64      /* longer timings go to last bucket */
+
 struct IrdaDecoderHandler {
     void** ctx;
+    /* bitmask of decoders in the middle of frame, they get every timing */
+    uint32_t alive;
+    /* bitmask of decoders which can start frame, indexed by [level][bucket] */
+    uint32_t start[2][IRDA_DECODER_START_BUCKETS];
 };
 
 struct IrdaEncoderHandler {
@@ -45,6 +56,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .alloc = irda_decoder_nec_alloc,
           .decode = irda_decoder_nec_decode,
           .reset = irda_decoder_nec_reset,
+          .is_idle = irda_decoder_nec_is_idle,
+          .protocol = &protocol_nec,
           .free = irda_decoder_nec_free},
       .encoder = {
           .alloc = irda_encoder_nec_alloc,
@@ -58,6 +71,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .alloc = irda_decoder_samsung32_alloc,
           .decode = irda_decoder_samsung32_decode,
           .reset = irda_decoder_samsung32_reset,
+          .is_idle = irda_decoder_samsung32_is_idle,
+          .protocol = &protocol_samsung32,
           .free = irda_decoder_samsung32_free},
       .encoder = {
           .alloc = irda_encoder_samsung32_alloc,
@@ -71,6 +86,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .alloc = irda_decoder_rc5_alloc,
           .decode = irda_decoder_rc5_decode,
           .reset = irda_decoder_rc5_reset,
+          .is_idle = irda_decoder_rc5_is_idle,
+          .protocol = &protocol_rc5,
           .free = irda_decoder_rc5_free},
       .encoder = {
           .alloc = irda_encoder_rc5_alloc,
@@ -84,6 +101,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .alloc = irda_decoder_rc6_alloc,
           .decode = irda_decoder_rc6_decode,
           .reset = irda_decoder_rc6_reset,
+          .is_idle = irda_decoder_rc6_is_idle,
+          .protocol = &protocol_rc6,
           .free = irda_decoder_rc6_free},
       .encoder = {
           .alloc = irda_encoder_rc6_alloc,
@@ -98,6 +117,8 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
           .decode = irda_decoder_sirc_decode,
           .reset = irda_decoder_sirc_reset,
           .check_ready = irda_decoder_sirc_check_ready,
+          .is_idle = irda_decoder_sirc_is_idle,
+          .protocol = &protocol_sirc,
           .free = irda_decoder_sirc_free},
       .encoder = {
           .alloc = irda_encoder_sirc_alloc,
@@ -109,27 +130,112 @@ static const IrdaEncoderDecoder irda_encoder_decoder[] = {
 };
 
 
+_Static_assert(COUNT_OF(irda_encoder_decoder) <= 32, "alive/start bitmasks hold up to 32 decoders");
+
 static int irda_find_index_by_protocol(IrdaProtocol protocol);
 static const IrdaProtocolSpecification* irda_get_spec_by_protocol(IrdaProtocol protocol);
 
-const IrdaMessage* irda_decode(IrdaDecoderHandler* handler, bool level, uint32_t duration) {
-    furi_assert(handler);
+static void irda_decoder_add_start_window(IrdaDecoderHandler* handler, int index, bool level, uint32_t timing, uint32_t tolerance) {
+    uint32_t low = (timing > tolerance) ? (timing - tolerance) : 0;
+    uint32_t high = timing + tolerance;
+    uint32_t first = MIN(low >> IRDA_DECODER_START_BUCKET_SHIFT, IRDA_DECODER_START_BUCKETS - 1);
+    uint32_t last = MIN(high >> IRDA_DECODER_START_BUCKET_SHIFT, IRDA_DECODER_START_BUCKETS - 1);
 
-    IrdaMessage* message = NULL;
-    IrdaMessage* result = NULL;
+    for (uint32_t bucket = first; bucket <= last; ++bucket) {
+        handler->start[level][bucket] |= 1UL << index;
+    }
+}
+
+/*
+ * Idle decoder can leave idle state only on timing which starts a frame:
+ * preamble mark, or first bit for protocols without preamble. All other
+ * timings would be dropped by it anyway, so they are not passed to it.
+ */
+static void irda_decoder_fill_start_buckets(IrdaDecoderHandler* handler) {
+    memset(handler->start, 0, sizeof(handler->start));
 
     for (int i = 0; i < COUNT_OF(irda_encoder_decoder); ++i) {
-        if (irda_encoder_decoder[i].decoder.decode) {
-            message = irda_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
-            if (!result && message) {
-                result = message;
+        const IrdaDecoders* decoder = &irda_encoder_decoder[i].decoder;
+        const IrdaCommonProtocolSpec* protocol = decoder->protocol;
+
+        if (!decoder->decode) {
+            continue;
+        } else if (!decoder->is_idle || !protocol) {
+            /* can't tell when it is idle - feed it with everything */
+            irda_decoder_add_start_window(handler, i, false, 0, UINT32_MAX);
+            irda_decoder_add_start_window(handler, i, true, 0, UINT32_MAX);
+        } else if (protocol->timings.preamble_mark) {
+            irda_decoder_add_start_window(handler, i, true,
+                protocol->timings.preamble_mark, protocol->timings.preamble_tolerance);
+        } else {
+            uint16_t bit = protocol->timings.bit1_mark;
+            uint32_t tolerance = protocol->timings.bit_tolerance;
+            for (int level = 0; level < 2; ++level) {
+                irda_decoder_add_start_window(handler, i, level, bit, tolerance);
+                irda_decoder_add_start_window(handler, i, level, 2 * bit, tolerance);
             }
         }
     }
+}
+
+static inline IrdaMessage* irda_decode_timing(IrdaDecoderHandler* handler, bool level, uint32_t duration) {
+    IrdaMessage* message = NULL;
+    IrdaMessage* result = NULL;
+    uint32_t bucket = MIN(duration >> IRDA_DECODER_START_BUCKET_SHIFT, IRDA_DECODER_START_BUCKETS - 1);
+    uint32_t feed = handler->alive | handler->start[level][bucket];
+
+    while (feed) {
+        int i = __builtin_ctz(feed);
+        feed &= feed - 1;
+
+        const IrdaDecoders* decoder = &irda_encoder_decoder[i].decoder;
+        message = decoder->decode(handler->ctx[i], level, duration);
+        if (!result && message) {
+            result = message;
+        }
+
+        if (decoder->is_idle && decoder->is_idle(handler->ctx[i])) {
+            handler->alive &= ~(1UL << i);
+        } else {
+            handler->alive |= 1UL << i;
+        }
+    }
 
     return result;
 }
 
+const IrdaMessage* irda_decode(IrdaDecoderHandler* handler, bool level, uint32_t duration) {
+    furi_assert(handler);
+
+    return irda_decode_timing(handler, level, duration);
+}
+
+size_t irda_decode_batch(
+    IrdaDecoderHandler* handler,
+    const LevelDuration* timings,
+    size_t timings_cnt,
+    IrdaDecodeBatchCallback callback,
+    void* context) {
+    furi_assert(handler);
+    furi_assert(timings || !timings_cnt);
+
+    size_t decoded_cnt = 0;
+
+    for (size_t i = 0; i < timings_cnt; ++i) {
+        bool level = level_duration_get_level(timings[i]);
+        uint32_t duration = level_duration_get_duration(timings[i]);
+        const IrdaMessage* message = irda_decode_timing(handler, level, duration);
+        if (message) {
+            ++decoded_cnt;
+            if (callback) {
+                callback(context, message, i);
+            }
+        }
+    }
+
+    return decoded_cnt;
+}
+
 IrdaDecoderHandler* irda_alloc_decoder(void) {
     IrdaDecoderHandler* handler = furi_alloc(sizeof(IrdaDecoderHandler));
     handler->ctx = furi_alloc(sizeof(void*) * COUNT_OF(irda_encoder_decoder));
@@ -140,6 +246,7 @@ IrdaDecoderHandler* irda_alloc_decoder(void) {
             handler->ctx[i] = irda_encoder_decoder[i].decoder.alloc();
     }
 
+    irda_decoder_fill_start_buckets(handler);
     irda_reset_decoder(handler);
     return handler;
 }
@@ -162,6 +269,7 @@ void irda_reset_decoder(IrdaDecoderHandler* handler) {
         if (irda_encoder_decoder[i].decoder.reset)
             irda_encoder_decoder[i].decoder.reset(handler->ctx[i]);
     }
+    handler->alive = 0;
 }
 
 const IrdaMessage* irda_check_decoder_ready(IrdaDecoderHandler* handler) {
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,6 +41,15 @@ typedef struct {
     bool repeat;
 } IrdaMessage;
 
+/**
+ * Callback for every message decoded by \c irda_decode_batch().
+ *
+ * \param[in]   context     - context passed to \c irda_decode_batch().
+ * \param[in]   message     - decoded message, valid only during callback.
+ * \param[in]   index       - index of timing which completed message.
+ */
+typedef void (*IrdaDecodeBatchCallback)(void* context, const IrdaMessage* message, size_t index);
+
 typedef enum {
     IrdaStatusError,
     IrdaStatusOk,
@@ -68,6 +79,25 @@ IrdaDecoderHandler* irda_alloc_decoder(void);
  */
 const IrdaMessage* irda_decode(IrdaDecoderHandler* handler, bool level, uint32_t duration);
 
+/**
+ * Provide to decoder buffer of timings at once.
+ * Same as calling \c irda_decode() for every timing, but without per-timing
+ * call overhead, so it's preferable way for draining big capture buffers.
+ *
+ * \param[in]   handler     - handler to IRDA decoders. Should be acquired with \c irda_alloc_decoder().
+ * \param[in]   timings     - captured timings, levels should alternate.
+ * \param[in]   timings_cnt - amount of timings in buffer.
+ * \param[in]   callback    - called for every decoded message, can be NULL.
+ * \param[in]   context     - context for callback.
+ * \return      amount of decoded messages.
+ */
+size_t irda_decode_batch(
+    IrdaDecoderHandler* handler,
+    const LevelDuration* timings,
+    size_t timings_cnt,
+    IrdaDecodeBatchCallback callback,
+    void* context);
+
 /**
  * Check whether decoder is ready.
  * Functionality is quite similar to irda_decode(), but with no timing providing.
@@ -31,6 +31,7 @@ typedef void (*IrdaFree) (void*);
 typedef void (*IrdaDecoderReset) (void*);
 typedef IrdaMessage* (*IrdaDecode) (void* ctx, bool level, uint32_t duration);
 typedef IrdaMessage* (*IrdaDecoderCheckReady) (void*);
+typedef bool (*IrdaDecoderIsIdle) (void*);
 
 typedef void (*IrdaEncoderReset)(void* encoder, const IrdaMessage* message);
 typedef IrdaStatus (*IrdaEncode)(void* encoder, uint32_t* out, bool* polarity);
@@ -38,6 +38,7 @@
 void* irda_decoder_nec_alloc(void);
 void irda_decoder_nec_reset(void* decoder);
 void irda_decoder_nec_free(void* decoder);
+bool irda_decoder_nec_is_idle(void* decoder);
 IrdaMessage* irda_decoder_nec_decode(void* decoder, bool level, uint32_t duration);
 void* irda_encoder_nec_alloc(void);
 IrdaStatus irda_encoder_nec_encode(void* encoder_ptr, uint32_t* duration, bool* level);
@@ -89,6 +90,7 @@ extern const IrdaCommonProtocolSpec protocol_nec;
 void* irda_decoder_samsung32_alloc(void);
 void irda_decoder_samsung32_reset(void* decoder);
 void irda_decoder_samsung32_free(void* decoder);
+bool irda_decoder_samsung32_is_idle(void* decoder);
 IrdaMessage* irda_decoder_samsung32_decode(void* decoder, bool level, uint32_t duration);
 IrdaStatus irda_encoder_samsung32_encode(void* encoder_ptr, uint32_t* duration, bool* level);
 void irda_encoder_samsung32_reset(void* encoder_ptr, const IrdaMessage* message);
@@ -137,6 +139,7 @@ extern const IrdaCommonProtocolSpec protocol_samsung32;
 void* irda_decoder_rc6_alloc(void);
 void irda_decoder_rc6_reset(void* decoder);
 void irda_decoder_rc6_free(void* decoder);
+bool irda_decoder_rc6_is_idle(void* decoder);
 IrdaMessage* irda_decoder_rc6_decode(void* decoder, bool level, uint32_t duration);
 void* irda_encoder_rc6_alloc(void);
 void irda_encoder_rc6_reset(void* encoder_ptr, const IrdaMessage* message);
@@ -186,6 +189,7 @@ extern const IrdaCommonProtocolSpec protocol_rc6;
 void* irda_decoder_rc5_alloc(void);
 void irda_decoder_rc5_reset(void* decoder);
 void irda_decoder_rc5_free(void* decoder);
+bool irda_decoder_rc5_is_idle(void* decoder);
 IrdaMessage* irda_decoder_rc5_decode(void* decoder, bool level, uint32_t duration);
 void* irda_encoder_rc5_alloc(void);
 void irda_encoder_rc5_reset(void* encoder_ptr, const IrdaMessage* message);
@@ -238,6 +242,7 @@ void irda_decoder_sirc_reset(void* decoder);
 IrdaMessage* irda_decoder_sirc_check_ready(void* decoder);
 uint32_t irda_decoder_sirc_get_timeout(void* decoder);
 void irda_decoder_sirc_free(void* decoder);
+bool irda_decoder_sirc_is_idle(void* decoder);
 IrdaMessage* irda_decoder_sirc_decode(void* decoder, bool level, uint32_t duration);
 void* irda_encoder_sirc_alloc(void);
 void irda_encoder_sirc_reset(void* encoder_ptr, const IrdaMessage* message);
@@ -0,0 +1,276 @@
+#include "irda_raw.h"
+#include <furi.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Stream byte tags: 00iiiiii - dictionary index,
+ * 01hhhhhh llllllll - 14 bit literal, 1hhhhhhh + 3 bytes - 31 bit literal */
+#define IRDA_RAW_TAG_LITERAL14      0x40
+#define IRDA_RAW_TAG_LITERAL31      0x80
+#define IRDA_RAW_LITERAL14_MAX      0x3FFF
+#define IRDA_RAW_LITERAL31_MAX      0x7FFFFFFF
+
+struct IrdaRawSignal {
+    uint32_t stream_size;
+    uint16_t timings_cnt;
+    uint8_t dictionary_cnt;
+    uint8_t reserved;
+    /* followed by stream */
+    uint16_t dictionary[];
+};
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    size_t count;
+} IrdaRawCluster;
+
+static int irda_raw_compare_timings(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* more frequent first, ties by duration to keep encoding stable */
+static int irda_raw_compare_count(const void* a, const void* b) {
+    const IrdaRawCluster* x = a;
+    const IrdaRawCluster* y = b;
+    if(x->count != y->count) return (x->count < y->count) - (x->count > y->count);
+    return (x->min > y->min) - (x->min < y->min);
+}
+
+static int irda_raw_compare_min(const void* a, const void* b) {
+    const IrdaRawCluster* x = a;
+    const IrdaRawCluster* y = b;
+    return (x->min > y->min) - (x->min < y->min);
+}
+
+static uint8_t* irda_raw_signal_stream(const IrdaRawSignal* signal) {
+    return (uint8_t*)&signal->dictionary[signal->dictionary_cnt];
+}
+
+/* Group sorted timings into clusters not wider than 2 * quantization,
+ * keep most frequent repeated ones sorted by duration */
+static size_t irda_raw_build_clusters(
+    const uint32_t* timings,
+    size_t timings_cnt,
+    uint32_t quantization,
+    IrdaRawCluster* clusters) {
+    uint32_t* sorted = furi_alloc(timings_cnt * sizeof(uint32_t));
+    memcpy(sorted, timings, timings_cnt * sizeof(uint32_t));
+    qsort(sorted, timings_cnt, sizeof(uint32_t), irda_raw_compare_timings);
+
+    size_t clusters_cnt = 0;
+    for(size_t i = 0; i < timings_cnt;) {
+        size_t j = i + 1;
+        while((j < timings_cnt) && (sorted[j] - sorted[i] <= 2 * quantization)) ++j;
+        IrdaRawCluster cluster = {.min = sorted[i], .max = sorted[j - 1], .count = j - i};
+        if((cluster.count > 1) && ((cluster.min + cluster.max) / 2 <= UINT16_MAX)) {
+            clusters[clusters_cnt++] = cluster;
+        }
+        i = j;
+    }
+    free(sorted);
+
+    if(clusters_cnt > IRDA_RAW_DICTIONARY_SIZE) {
+        qsort(clusters, clusters_cnt, sizeof(IrdaRawCluster), irda_raw_compare_count);
+        clusters_cnt = IRDA_RAW_DICTIONARY_SIZE;
+        qsort(clusters, clusters_cnt, sizeof(IrdaRawCluster), irda_raw_compare_min);
+    }
+
+    return clusters_cnt;
+}
+
+static int irda_raw_find_cluster(const IrdaRawCluster* clusters, size_t clusters_cnt, uint32_t timing) {
+    size_t low = 0;
+    size_t high = clusters_cnt;
+    while(low < high) {
+        size_t middle = (low + high) / 2;
+        if(clusters[middle].min <= timing) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if(low && (timing <= clusters[low - 1].max)) return low - 1;
+    return -1;
+}
+
+static size_t irda_raw_literal_size(uint32_t timing) {
+    return (timing <= IRDA_RAW_LITERAL14_MAX) ? 2 : 4;
+}
+
+IrdaRawSignal* irda_raw_signal_encode(const uint32_t* timings, size_t timings_cnt, uint32_t quantization) {
+    furi_assert(timings);
+    furi_check(timings_cnt && (timings_cnt <= UINT16_MAX));
+
+    IrdaRawCluster* clusters = furi_alloc(timings_cnt * sizeof(IrdaRawCluster));
+    size_t clusters_cnt = irda_raw_build_clusters(timings, timings_cnt, quantization, clusters);
+
+    size_t stream_size = 0;
+    for(size_t i = 0; i < timings_cnt; ++i) {
+        furi_check(timings[i] && (timings[i] <= IRDA_RAW_LITERAL31_MAX));
+        if(irda_raw_find_cluster(clusters, clusters_cnt, timings[i]) < 0) {
+            stream_size += irda_raw_literal_size(timings[i]);
+        } else {
+            stream_size += 1;
+        }
+    }
+
+    IrdaRawSignal* signal = furi_alloc(sizeof(IrdaRawSignal) + clusters_cnt * sizeof(uint16_t) + stream_size);
+    signal->stream_size = stream_size;
+    signal->timings_cnt = timings_cnt;
+    signal->dictionary_cnt = clusters_cnt;
+    for(size_t i = 0; i < clusters_cnt; ++i) {
+        signal->dictionary[i] = (clusters[i].min + clusters[i].max) / 2;
+    }
+
+    uint8_t* stream = irda_raw_signal_stream(signal);
+    for(size_t i = 0; i < timings_cnt; ++i) {
+        uint32_t timing = timings[i];
+        int index = irda_raw_find_cluster(clusters, clusters_cnt, timing);
+        if(index >= 0) {
+            *stream++ = index;
+        } else if(timing <= IRDA_RAW_LITERAL14_MAX) {
+            *stream++ = IRDA_RAW_TAG_LITERAL14 | (timing >> 8);
+            *stream++ = timing;
+        } else {
+            *stream++ = IRDA_RAW_TAG_LITERAL31 | (timing >> 24);
+            *stream++ = timing >> 16;
+            *stream++ = timing >> 8;
+            *stream++ = timing;
+        }
+    }
+    furi_assert(stream == irda_raw_signal_stream(signal) + stream_size);
+
+    free(clusters);
+    return signal;
+}
+
+IrdaRawSignal* irda_raw_signal_load(
+    const uint16_t* dictionary,
+    size_t dictionary_cnt,
+    const uint8_t* stream,
+    size_t stream_size) {
+    furi_assert(dictionary || !dictionary_cnt);
+    furi_assert(stream);
+
+    if(dictionary_cnt > IRDA_RAW_DICTIONARY_SIZE) return NULL;
+    for(size_t i = 0; i < dictionary_cnt; ++i) {
+        if(!dictionary[i]) return NULL;
+    }
+
+    size_t timings_cnt = 0;
+    for(size_t offset = 0; offset < stream_size; ++timings_cnt) {
+        uint8_t byte = stream[offset];
+        if(byte < IRDA_RAW_TAG_LITERAL14) {
+            if(byte >= dictionary_cnt) return NULL;
+            offset += 1;
+        } else if(byte < IRDA_RAW_TAG_LITERAL31) {
+            offset += 2;
+        } else {
+            offset += 4;
+        }
+        if(offset > stream_size) return NULL;
+    }
+    if(!timings_cnt || (timings_cnt > UINT16_MAX)) return NULL;
+
+    IrdaRawSignal* signal = furi_alloc(sizeof(IrdaRawSignal) + dictionary_cnt * sizeof(uint16_t) + stream_size);
+    signal->stream_size = stream_size;
+    signal->timings_cnt = timings_cnt;
+    signal->dictionary_cnt = dictionary_cnt;
+    memcpy(signal->dictionary, dictionary, dictionary_cnt * sizeof(uint16_t));
+    memcpy(irda_raw_signal_stream(signal), stream, stream_size);
+
+    /* literal of zero is the only malformed timing left */
+    IrdaRawSignalIterator iterator;
+    uint32_t duration;
+    irda_raw_signal_iterator_init(&iterator, signal);
+    while(irda_raw_signal_iterator_next(&iterator, &duration)) {
+        if(!duration) {
+            irda_raw_signal_free(signal);
+            return NULL;
+        }
+    }
+
+    return signal;
+}
+
+IrdaRawSignal* irda_raw_signal_copy(const IrdaRawSignal* signal) {
+    furi_assert(signal);
+    size_t size = irda_raw_signal_get_size(signal);
+    IrdaRawSignal* copy = furi_alloc(size);
+    memcpy(copy, signal, size);
+    return copy;
+}
+
+void irda_raw_signal_free(IrdaRawSignal* signal) {
+    furi_assert(signal);
+    free(signal);
+}
+
+size_t irda_raw_signal_get_timings_count(const IrdaRawSignal* signal) {
+    furi_assert(signal);
+    return signal->timings_cnt;
+}
+
+size_t irda_raw_signal_get_size(const IrdaRawSignal* signal) {
+    furi_assert(signal);
+    return sizeof(IrdaRawSignal) + signal->dictionary_cnt * sizeof(uint16_t) + signal->stream_size;
+}
+
+const uint16_t* irda_raw_signal_get_dictionary(const IrdaRawSignal* signal, size_t* dictionary_cnt) {
+    furi_assert(signal);
+    furi_assert(dictionary_cnt);
+    *dictionary_cnt = signal->dictionary_cnt;
+    return signal->dictionary;
+}
+
+const uint8_t* irda_raw_signal_get_stream(const IrdaRawSignal* signal, size_t* stream_size) {
+    furi_assert(signal);
+    furi_assert(stream_size);
+    *stream_size = signal->stream_size;
+    return irda_raw_signal_stream(signal);
+}
+
+void irda_raw_signal_decode(const IrdaRawSignal* signal, uint32_t* timings) {
+    furi_assert(timings);
+
+    IrdaRawSignalIterator iterator;
+    irda_raw_signal_iterator_init(&iterator, signal);
+    while(irda_raw_signal_iterator_next(&iterator, timings)) ++timings;
+}
+
+void irda_raw_signal_iterator_init(IrdaRawSignalIterator* iterator, const IrdaRawSignal* signal) {
+    furi_assert(iterator);
+    furi_assert(signal);
+
+    iterator->signal = signal;
+    iterator->stream = irda_raw_signal_stream(signal);
+    iterator->index = 0;
+}
+
+bool irda_raw_signal_iterator_next(IrdaRawSignalIterator* iterator, uint32_t* duration) {
+    furi_assert(iterator);
+    furi_assert(duration);
+
+    if(iterator->index >= iterator->signal->timings_cnt) return false;
+
+    const uint8_t* stream = iterator->stream;
+    uint8_t byte = *stream++;
+    if(byte < IRDA_RAW_TAG_LITERAL14) {
+        *duration = iterator->signal->dictionary[byte];
+    } else if(byte < IRDA_RAW_TAG_LITERAL31) {
+        *duration = (uint32_t)(byte & ~IRDA_RAW_TAG_LITERAL14) << 8 | stream[0];
+        stream += 1;
+    } else {
+        *duration = (uint32_t)(byte & ~IRDA_RAW_TAG_LITERAL31) << 24 | (uint32_t)stream[0] << 16 |
+                    (uint32_t)stream[1] << 8 | stream[2];
+        stream += 3;
+    }
+    iterator->stream = stream;
+    ++iterator->index;
+
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Timings closer than this are stored as one dictionary entry. Carrier
+ * period is 26 us, so transmitted signal doesn't change noticeably */
+#define IRDA_RAW_QUANTIZATION_US           10
+/* Max amount of repeated durations stored in dictionary */
+#define IRDA_RAW_DICTIONARY_SIZE           64
+
+/**
+ * Compact raw signal: dictionary of repeated durations and byte stream,
+ * where every timing is either 1 byte dictionary index or 2/4 bytes
+ * literal. Typical learned signal takes ~1 byte per timing instead of 4.
+ */
+typedef struct IrdaRawSignal IrdaRawSignal;
+
+/**
+ * Sequential reader of compact raw signal, cheap enough for TX ISR.
+ */
+typedef struct {
+    const IrdaRawSignal* signal;
+    const uint8_t* stream;
+    size_t index;
+} IrdaRawSignalIterator;
+
+/**
+ * Encode timings into compact raw signal.
+ *
+ * \param[in]   timings     - raw timings, starting from mark.
+ * \param[in]   timings_cnt - amount of timings, 1..UINT16_MAX.
+ * \param[in]   quantization - timings closer than this are merged into
+ *                          one dictionary entry, 0 for lossless encoding.
+ * \return      allocated signal, free with \c irda_raw_signal_free().
+ */
+IrdaRawSignal* irda_raw_signal_encode(const uint32_t* timings, size_t timings_cnt, uint32_t quantization);
+
+/**
+ * Restore compact raw signal from dictionary and stream, as saved in file.
+ *
+ * \param[in]   dictionary  - dictionary entries.
+ * \param[in]   dictionary_cnt - amount of dictionary entries.
+ * \param[in]   stream      - encoded timings.
+ * \param[in]   stream_size - size of stream in bytes.
+ * \return      allocated signal or NULL if stream is malformed.
+ */
+IrdaRawSignal* irda_raw_signal_load(
+    const uint16_t* dictionary,
+    size_t dictionary_cnt,
+    const uint8_t* stream,
+    size_t stream_size);
+
+IrdaRawSignal* irda_raw_signal_copy(const IrdaRawSignal* signal);
+
+void irda_raw_signal_free(IrdaRawSignal* signal);
+
+size_t irda_raw_signal_get_timings_count(const IrdaRawSignal* signal);
+
+/**
+ * \return      heap occupied by signal in bytes.
+ */
+size_t irda_raw_signal_get_size(const IrdaRawSignal* signal);
+
+const uint16_t* irda_raw_signal_get_dictionary(const IrdaRawSignal* signal, size_t* dictionary_cnt);
+
+const uint8_t* irda_raw_signal_get_stream(const IrdaRawSignal* signal, size_t* stream_size);
+
+/**
+ * Decode whole signal.
+ *
+ * \param[in]   signal      - compact raw signal.
+ * \param[out]  timings     - array for \c irda_raw_signal_get_timings_count() timings.
+ */
+void irda_raw_signal_decode(const IrdaRawSignal* signal, uint32_t* timings);
+
+void irda_raw_signal_iterator_init(IrdaRawSignalIterator* iterator, const IrdaRawSignal* signal);
+
+/**
+ * Get next timing.
+ *
+ * \param[in]   iterator    - iterator.
+ * \param[out]  duration    - next timing.
+ * \return      false if there are no more timings.
+ */
+bool irda_raw_signal_iterator_next(IrdaRawSignalIterator* iterator, uint32_t* duration);
+
+#ifdef __cplusplus
+}
+#endif
@@ -31,21 +31,27 @@ bool irda_decoder_nec_interpret(IrdaCommonDecoder* decoder) {
     return result;
 }
 
+static const IrdaTimingBounds irda_nec_repeat_pause = {
+    .min = IRDA_NEC_REPEAT_PAUSE_MIN,
+    .max = IRDA_NEC_REPEAT_PAUSE_MAX,
+};
+static const IrdaTimingBounds irda_nec_repeat_mark =
+    IRDA_TIMING_BOUNDS(IRDA_NEC_REPEAT_MARK, IRDA_NEC_PREAMBLE_TOLERANCE);
+static const IrdaTimingBounds irda_nec_repeat_space =
+    IRDA_TIMING_BOUNDS(IRDA_NEC_REPEAT_SPACE, IRDA_NEC_PREAMBLE_TOLERANCE);
+
 // timings start from Space (delay between message and repeat)
 IrdaStatus irda_decoder_nec_decode_repeat(IrdaCommonDecoder* decoder) {
     furi_assert(decoder);
 
-    float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
-    uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
     IrdaStatus status = IrdaStatusError;
 
     if(decoder->timings_cnt < 4) return IrdaStatusOk;
 
-    if((decoder->timings[0] > IRDA_NEC_REPEAT_PAUSE_MIN) &&
-       (decoder->timings[0] < IRDA_NEC_REPEAT_PAUSE_MAX) &&
-       MATCH_TIMING(decoder->timings[1], IRDA_NEC_REPEAT_MARK, preamble_tolerance) &&
-       MATCH_TIMING(decoder->timings[2], IRDA_NEC_REPEAT_SPACE, preamble_tolerance) &&
-       MATCH_TIMING(decoder->timings[3], decoder->protocol->timings.bit1_mark, bit_tolerance)) {
+    if(irda_timing_match(irda_common_decoder_timing(decoder, 0), irda_nec_repeat_pause) &&
+       irda_timing_match(irda_common_decoder_timing(decoder, 1), irda_nec_repeat_mark) &&
+       irda_timing_match(irda_common_decoder_timing(decoder, 2), irda_nec_repeat_space) &&
+       irda_timing_match(irda_common_decoder_timing(decoder, 3), decoder->bounds.bit1_mark)) {
         status = IrdaStatusReady;
         decoder->timings_cnt = 0;
     } else {
@@ -71,3 +77,7 @@ void irda_decoder_nec_reset(void* decoder) {
     irda_common_decoder_reset(decoder);
 }
 
+bool irda_decoder_nec_is_idle(void* decoder) {
+    return irda_common_decoder_is_idle(decoder);
+}
+
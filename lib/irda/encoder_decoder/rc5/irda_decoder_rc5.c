@@ -77,3 +77,8 @@ void irda_decoder_rc5_reset(void* decoder) {
     irda_common_decoder_reset(decoder_rc5->common_decoder);
 }
 
+bool irda_decoder_rc5_is_idle(void* decoder) {
+    IrdaRc5Decoder* decoder_rc5 = decoder;
+    return irda_common_decoder_is_idle(decoder_rc5->common_decoder);
+}
+
@@ -53,20 +53,18 @@ bool irda_decoder_rc6_interpret(IrdaCommonDecoder* decoder) {
 IrdaStatus irda_decoder_rc6_decode_manchester(IrdaCommonDecoder* decoder) {
     // 4th bit lasts 2x times more
     IrdaStatus status = IrdaStatusError;
-    uint16_t bit = decoder->protocol->timings.bit1_mark;
-    uint16_t tolerance = decoder->protocol->timings.bit_tolerance;
-    uint16_t timing = decoder->timings[0];
+    uint32_t timing = irda_common_decoder_timing(decoder, 0);
 
-    bool single_timing = MATCH_TIMING(timing, bit, tolerance);
-    bool double_timing = MATCH_TIMING(timing, 2*bit, tolerance);
-    bool triple_timing = MATCH_TIMING(timing, 3*bit, tolerance);
+    bool single_timing = irda_timing_match(timing, decoder->bounds.bit1_mark);
+    bool double_timing = irda_timing_match(timing, decoder->bounds.bit1_mark_x2);
+    bool triple_timing = irda_timing_match(timing, decoder->bounds.bit1_mark_x3);
 
     if (decoder->databit_cnt == 4) {
         furi_assert(decoder->timings_cnt == 1);
         furi_assert(decoder->switch_detect == true);
 
         if (single_timing ^ triple_timing) {
-            --decoder->timings_cnt;
+            irda_common_decoder_consume(decoder, 1);
             ++decoder->databit_cnt;
             decoder->data[0] |= (single_timing ? !decoder->level : decoder->level) << 4;
             status = IrdaStatusOk;
@@ -74,11 +72,11 @@ IrdaStatus irda_decoder_rc6_decode_manchester(IrdaCommonDecoder* decoder) {
     } else if (decoder->databit_cnt == 5) {
         if (single_timing || triple_timing) {
             if (triple_timing)
-                decoder->timings[0] = bit;
+                decoder->timings[decoder->timings_head] = decoder->protocol->timings.bit1_mark;
             decoder->switch_detect = false;
             status = irda_common_decode_manchester(decoder);
         } else if (double_timing) {
-            --decoder->timings_cnt;
+            irda_common_decoder_consume(decoder, 1);
             status = IrdaStatusOk;
         }
     } else {
@@ -112,3 +110,8 @@ void irda_decoder_rc6_reset(void* decoder) {
     irda_common_decoder_reset(decoder_rc6->common_decoder);
 }
 
+bool irda_decoder_rc6_is_idle(void* decoder) {
+    IrdaRc6Decoder* decoder_rc6 = decoder;
+    return irda_common_decoder_is_idle(decoder_rc6->common_decoder);
+}
+
@@ -26,24 +26,31 @@ bool irda_decoder_samsung32_interpret(IrdaCommonDecoder* decoder) {
     return result;
 }
 
+static const IrdaTimingBounds irda_samsung_repeat_pause = {
+    .min = IRDA_SAMSUNG_REPEAT_PAUSE_MIN,
+    .max = IRDA_SAMSUNG_REPEAT_PAUSE_MAX,
+};
+static const IrdaTimingBounds irda_samsung_repeat_mark =
+    IRDA_TIMING_BOUNDS(IRDA_SAMSUNG_REPEAT_MARK, IRDA_SAMSUNG_PREAMBLE_TOLERANCE);
+static const IrdaTimingBounds irda_samsung_repeat_space =
+    IRDA_TIMING_BOUNDS(IRDA_SAMSUNG_REPEAT_SPACE, IRDA_SAMSUNG_PREAMBLE_TOLERANCE);
+
 // timings start from Space (delay between message and repeat)
 IrdaStatus irda_decoder_samsung32_decode_repeat(IrdaCommonDecoder* decoder) {
     furi_assert(decoder);
 
-    float preamble_tolerance = decoder->protocol->timings.preamble_tolerance;
-    uint32_t bit_tolerance = decoder->protocol->timings.bit_tolerance;
     IrdaStatus status = IrdaStatusError;
+    const IrdaCommonDecoderBounds* bounds = &decoder->bounds;
 
     if (decoder->timings_cnt < 6)
         return IrdaStatusOk;
 
-    if ((decoder->timings[0] > IRDA_SAMSUNG_REPEAT_PAUSE_MIN)
-        && (decoder->timings[0] < IRDA_SAMSUNG_REPEAT_PAUSE_MAX)
-        && MATCH_TIMING(decoder->timings[1], IRDA_SAMSUNG_REPEAT_MARK, preamble_tolerance)
-        && MATCH_TIMING(decoder->timings[2], IRDA_SAMSUNG_REPEAT_SPACE, preamble_tolerance)
-        && MATCH_TIMING(decoder->timings[3], decoder->protocol->timings.bit1_mark, bit_tolerance)
-        && MATCH_TIMING(decoder->timings[4], decoder->protocol->timings.bit1_space, bit_tolerance)
-        && MATCH_TIMING(decoder->timings[5], decoder->protocol->timings.bit1_mark, bit_tolerance)
+    if (irda_timing_match(irda_common_decoder_timing(decoder, 0), irda_samsung_repeat_pause)
+        && irda_timing_match(irda_common_decoder_timing(decoder, 1), irda_samsung_repeat_mark)
+        && irda_timing_match(irda_common_decoder_timing(decoder, 2), irda_samsung_repeat_space)
+        && irda_timing_match(irda_common_decoder_timing(decoder, 3), bounds->bit1_mark)
+        && irda_timing_match(irda_common_decoder_timing(decoder, 4), bounds->bit1_space)
+        && irda_timing_match(irda_common_decoder_timing(decoder, 5), bounds->bit1_mark)
         ) {
         status = IrdaStatusReady;
         decoder->timings_cnt = 0;
@@ -70,3 +77,7 @@ void irda_decoder_samsung32_reset(void* decoder) {
     irda_common_decoder_reset(decoder);
 }
 
+bool irda_decoder_samsung32_is_idle(void* decoder) {
+    return irda_common_decoder_is_idle(decoder);
+}
+
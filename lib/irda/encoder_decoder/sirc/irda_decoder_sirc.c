@@ -90,3 +90,7 @@ void irda_decoder_sirc_reset(void* decoder) {
     irda_common_decoder_reset(decoder);
 }
 
+bool irda_decoder_sirc_is_idle(void* decoder) {
+    return irda_common_decoder_is_idle(decoder);
+}
+
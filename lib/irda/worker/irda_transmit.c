@@ -1,4 +1,5 @@
 #include "irda.h"
+#include "irda_transmit.h"
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
@@ -54,6 +55,45 @@ void irda_send_raw(const uint32_t timings[], uint32_t timings_cnt, bool start_fr
     irda_send_raw_ext(timings, timings_cnt, start_from_mark, IRDA_COMMON_CARRIER_FREQUENCY, IRDA_COMMON_DUTY_CYCLE);
 }
 
+FuriHalIrdaTxGetDataState irda_get_raw_compact_data_callback (void* context, uint32_t* duration, bool* level) {
+    furi_assert(duration);
+    furi_assert(level);
+    furi_assert(context);
+
+    IrdaRawSignalIterator* iterator = context;
+
+    if (irda_tx_raw_add_silence && (irda_tx_raw_timings_index == 0)) {
+        irda_tx_raw_add_silence = false;
+        *level = false;
+        *duration = IRDA_RAW_TX_TIMING_DELAY_US;
+    } else {
+        *level = irda_tx_raw_start_from_mark ^ (irda_tx_raw_timings_index % 2);
+        bool next = irda_raw_signal_iterator_next(iterator, duration);
+        furi_assert(next);
+        (void)next;
+        ++irda_tx_raw_timings_index;
+    }
+
+    return (irda_tx_raw_timings_number == irda_tx_raw_timings_index) ?
+        FuriHalIrdaTxGetDataStateLastDone : FuriHalIrdaTxGetDataStateOk;
+}
+
+void irda_send_raw_compact(const IrdaRawSignal* signal, bool start_from_mark) {
+    furi_assert(signal);
+
+    IrdaRawSignalIterator iterator;
+    irda_raw_signal_iterator_init(&iterator, signal);
+    irda_tx_raw_start_from_mark = start_from_mark;
+    irda_tx_raw_timings_index = 0;
+    irda_tx_raw_timings_number = irda_raw_signal_get_timings_count(signal);
+    irda_tx_raw_add_silence = start_from_mark;
+    furi_hal_irda_async_tx_set_data_isr_callback(irda_get_raw_compact_data_callback, &iterator);
+    furi_hal_irda_async_tx_start(IRDA_COMMON_CARRIER_FREQUENCY, IRDA_COMMON_DUTY_CYCLE);
+    furi_hal_irda_async_tx_wait_termination();
+
+    furi_assert(!furi_hal_irda_is_busy());
+}
+
 FuriHalIrdaTxGetDataState irda_get_data_callback (void* context, uint32_t* duration, bool* level) {
     FuriHalIrdaTxGetDataState state = FuriHalIrdaTxGetDataStateLastDone;
     IrdaEncoderHandler* handler = context;
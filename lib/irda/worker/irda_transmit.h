@@ -1,5 +1,6 @@
 #include <furi-hal-irda.h>
 #include <irda.h>
+#include <irda_raw.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -36,6 +37,16 @@ void irda_send_raw(const uint32_t timings[], uint32_t timings_cnt, bool start_fr
  */
 void irda_send_raw_ext(const uint32_t timings[], uint32_t timings_cnt, bool start_from_mark, uint32_t frequency, float duty_cycle);
 
+/**
+ * Send compact raw signal through infrared port, timings are decoded
+ * on the fly while TX buffer is filled.
+ *
+ * \param[in]   signal - compact raw signal to send.
+ * \param[in]   start_from_mark - true if timings starts from mark,
+ *              otherwise from space
+ */
+void irda_send_raw_compact(const IrdaRawSignal* signal, bool start_from_mark);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,8 +1,8 @@
 #include "furi/check.h"
 #include "furi/common_defines.h"
-#include "sys/_stdint.h"
 #include "irda_worker.h"
 #include <irda.h>
+#include <irda_raw.h>
 #include <furi-hal-irda.h>
 #include <limits.h>
 #include <stdint.h>
@@ -11,6 +11,12 @@
 #include <stream_buffer.h>
 
 #define IRDA_WORKER_RX_TIMEOUT              IRDA_RAW_RX_TIMING_DELAY_US
+/* size of each of 2 buffers hal captures timings into */
+#define IRDA_WORKER_RX_BUFFER_SIZE          64
+/* signals prepared ahead of transmission by queue producer */
+#define IRDA_WORKER_TX_QUEUE_SIZE           8
+/* how often waiting for queued signal checks for exit request */
+#define IRDA_WORKER_TX_QUEUE_POLL_MS        10
 
 #define IRDA_WORKER_RX_RECEIVED             0x01
 #define IRDA_WORKER_RX_TIMEOUT_RECEIVED     0x02
@@ -42,6 +48,8 @@ typedef enum {
 struct IrdaWorkerSignal{
     bool decoded;
     size_t timings_cnt;
+    /* TX only: raw signal to send instead of timings, owned by worker */
+    IrdaRawSignal* compact;
     union {
         IrdaMessage message;
         /* +1 is for pause we add at the beginning */
@@ -49,9 +57,19 @@ struct IrdaWorkerSignal{
     };
 };
 
+/* raw == NULL for not decoded item marks end of queue */
+typedef struct {
+    bool decoded;
+    union {
+        IrdaMessage message;
+        IrdaRawSignal* raw;
+    };
+} IrdaWorkerTxQueueItem;
+
 struct IrdaWorker {
     FuriThread* thread;
     StreamBufferHandle_t stream;
+    osMessageQueueId_t tx_queue;
     osEventFlagsId_t events;
 
     IrdaWorkerSignal signal;
@@ -70,13 +88,26 @@ struct IrdaWorker {
             uint32_t frequency;
             float duty_cycle;
             uint32_t tx_raw_cnt;
+            IrdaRawSignalIterator tx_raw_iterator;
             bool need_reinitialization;
             bool steady_signal_sent;
+            /* get signal callback returned stop, last signal is in stream */
+            bool finished;
+            /* signals sent, counted by hal ISR, event flag alone would coalesce */
+            volatile uint32_t sent_cnt;
+            uint32_t sent_dispatched_cnt;
         } tx;
         struct {
             IrdaWorkerReceivedSignalCallback received_signal_callback;
             void* received_signal_context;
             bool overrun;
+            /* first timing of buffer which is not a part of decoded message */
+            size_t buffer_raw_start;
+            /* buffers are handed over by hal in turn, next is the one to process */
+            uint8_t next;
+            volatile size_t ready_cnt[2];
+            volatile bool ready_overrun[2];
+            LevelDuration buffer[2 * IRDA_WORKER_RX_BUFFER_SIZE];
         } rx;
     };
 };
@@ -88,6 +119,7 @@ typedef struct {
 } IrdaWorkerTiming;
 
 static int32_t irda_worker_tx_thread(void* context);
+static void irda_worker_tx_queue_flush(IrdaWorker* instance);
 static FuriHalIrdaTxGetDataState irda_worker_furi_hal_data_isr_callback(void* context, uint32_t* duration, bool* level);
 static void irda_worker_furi_hal_message_sent_isr_callback(void* context);
 
@@ -98,20 +130,16 @@ static void irda_worker_rx_timeout_callback(void* context) {
     furi_check(flags_set & IRDA_WORKER_RX_TIMEOUT_RECEIVED);
 }
 
-static void irda_worker_rx_callback(void* context, bool level, uint32_t duration) {
+static void irda_worker_rx_callback(void* context, const LevelDuration* buffer, size_t size, bool overrun) {
     IrdaWorker* instance = context;
+    uint8_t index = (buffer != instance->rx.buffer);
 
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    furi_assert(duration != 0);
-    LevelDuration level_duration = level_duration_make(level, duration);
+    furi_assert(size != 0);
+    instance->rx.ready_overrun[index] = overrun;
+    instance->rx.ready_cnt[index] = size;
 
-    size_t ret =
-        xStreamBufferSendFromISR(instance->stream, &level_duration, sizeof(LevelDuration), &xHigherPriorityTaskWoken);
-    uint32_t events = (ret == sizeof(LevelDuration)) ? IRDA_WORKER_RX_RECEIVED : IRDA_WORKER_OVERRUN;
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-
-    uint32_t flags_set = osEventFlagsSet(instance->events, events);
-    furi_check(flags_set & events);
+    uint32_t flags_set = osEventFlagsSet(instance->events, IRDA_WORKER_RX_RECEIVED);
+    furi_check(flags_set & IRDA_WORKER_RX_RECEIVED);
 }
 
 static void irda_worker_process_timeout(IrdaWorker* instance) {
@@ -130,18 +158,29 @@ static void irda_worker_process_timeout(IrdaWorker* instance) {
         instance->rx.received_signal_callback(instance->rx.received_signal_context, &instance->signal);
 }
 
-static void irda_worker_process_timings(IrdaWorker* instance, uint32_t duration, bool level) {
-    const IrdaMessage* message_decoded = irda_decode(instance->irda_decoder, level, duration);
-    if (message_decoded) {
-        instance->signal.message = *message_decoded;
-        instance->signal.timings_cnt = 0;
-        instance->signal.decoded = true;
-        if (instance->rx.received_signal_callback)
-            instance->rx.received_signal_callback(instance->rx.received_signal_context, &instance->signal);
-    } else {
+static void irda_worker_process_decoded(void* context, const IrdaMessage* message, size_t index) {
+    IrdaWorker* instance = context;
+
+    instance->signal.message = *message;
+    instance->signal.timings_cnt = 0;
+    instance->signal.decoded = true;
+    instance->rx.buffer_raw_start = index + 1;
+    if (instance->rx.received_signal_callback)
+        instance->rx.received_signal_callback(instance->rx.received_signal_context, &instance->signal);
+}
+
+static void irda_worker_process_buffer(IrdaWorker* instance, const LevelDuration* timings, size_t timings_cnt) {
+    instance->rx.buffer_raw_start = 0;
+    irda_decode_batch(instance->irda_decoder, timings, timings_cnt, irda_worker_process_decoded, instance);
+
+    /* timings after last decoded message are stored as raw signal */
+    for (size_t i = instance->rx.buffer_raw_start; i < timings_cnt; ++i) {
+        bool level = level_duration_get_level(timings[i]);
+        uint32_t duration = level_duration_get_duration(timings[i]);
+
         /* Skip first timing if it starts from Space */
         if ((instance->signal.timings_cnt == 0) && !level) {
-            return;
+            continue;
         }
 
         if (instance->signal.timings_cnt < MAX_TIMINGS_AMOUNT) {
@@ -151,6 +190,7 @@ static void irda_worker_process_timings(IrdaWorker* instance, uint32_t duration,
             uint32_t flags_set = osEventFlagsSet(instance->events, IRDA_WORKER_OVERRUN);
             furi_check(flags_set & IRDA_WORKER_OVERRUN);
             instance->rx.overrun = true;
+            break;
         }
     }
 }
@@ -158,7 +198,6 @@ static void irda_worker_process_timings(IrdaWorker* instance, uint32_t duration,
 static int32_t irda_worker_rx_thread(void* thread_context) {
     IrdaWorker* instance = thread_context;
     uint32_t events = 0;
-    LevelDuration level_duration;
     TickType_t last_blink_time = 0;
 
     while(1) {
@@ -172,12 +211,21 @@ static int32_t irda_worker_rx_thread(void* thread_context) {
             }
             if (instance->signal.timings_cnt == 0)
                 notification_message(instance->notification, &sequence_display_on);
-            while (sizeof(LevelDuration) == xStreamBufferReceive(instance->stream, &level_duration, sizeof(LevelDuration), 0)) {
+            size_t received;
+            while ((received = instance->rx.ready_cnt[instance->rx.next])) {
+                const LevelDuration* buffer = &instance->rx.buffer[instance->rx.next * IRDA_WORKER_RX_BUFFER_SIZE];
+                if (instance->rx.ready_overrun[instance->rx.next]) {
+                    /* hal lost timings, what was collected before is garbage */
+                    printf("#");
+                    irda_reset_decoder(instance->irda_decoder);
+                    instance->signal.timings_cnt = 0;
+                }
                 if (!instance->rx.overrun) {
-                    bool level = level_duration_get_level(level_duration);
-                    uint32_t duration = level_duration_get_duration(level_duration);
-                    irda_worker_process_timings(instance, duration, level);
+                    irda_worker_process_buffer(instance, buffer, received);
                 }
+                instance->rx.ready_cnt[instance->rx.next] = 0;
+                instance->rx.next = !instance->rx.next;
+                furi_hal_irda_async_rx_release_buffer(buffer);
             }
         }
         if (events & IRDA_WORKER_OVERRUN) {
@@ -219,8 +267,10 @@ IrdaWorker* irda_worker_alloc() {
     furi_thread_set_stack_size(instance->thread, 2048);
     furi_thread_set_context(instance->thread, instance);
 
-    size_t buffer_size = MAX(sizeof(IrdaWorkerTiming) * (MAX_TIMINGS_AMOUNT + 1), sizeof(LevelDuration) * MAX_TIMINGS_AMOUNT);
+    /* stream is used by TX only, RX timings are captured into rx.buffer by hal */
+    size_t buffer_size = sizeof(IrdaWorkerTiming) * (MAX_TIMINGS_AMOUNT + 1);
     instance->stream = xStreamBufferCreate(buffer_size, sizeof(IrdaWorkerTiming));
+    instance->tx_queue = osMessageQueueNew(IRDA_WORKER_TX_QUEUE_SIZE, sizeof(IrdaWorkerTxQueueItem), NULL);
     instance->irda_decoder = irda_alloc_decoder();
     instance->irda_encoder = irda_alloc_encoder();
     instance->blink_enable = false;
@@ -235,10 +285,15 @@ void irda_worker_free(IrdaWorker* instance) {
     furi_assert(instance);
     furi_assert(instance->state == IrdaWorkerStateIdle);
 
+    if (instance->signal.compact) {
+        irda_raw_signal_free(instance->signal.compact);
+    }
+    irda_worker_tx_queue_flush(instance);
     furi_record_close("notification");
     irda_free_decoder(instance->irda_decoder);
     irda_free_encoder(instance->irda_encoder);
     vStreamBufferDelete(instance->stream);
+    osMessageQueueDelete(instance->tx_queue);
     furi_thread_free(instance->thread);
     osEventFlagsDelete(instance->events);
 
@@ -249,18 +304,20 @@ void irda_worker_rx_start(IrdaWorker* instance) {
     furi_assert(instance);
     furi_assert(instance->state == IrdaWorkerStateIdle);
 
-    xStreamBufferSetTriggerLevel(instance->stream, sizeof(LevelDuration));
-
     osEventFlagsClear(instance->events, IRDA_WORKER_ALL_EVENTS);
     furi_thread_set_callback(instance->thread, irda_worker_rx_thread);
     furi_thread_start(instance->thread);
 
-    furi_hal_irda_async_rx_set_capture_isr_callback(irda_worker_rx_callback, instance);
+    instance->rx.overrun = false;
+    instance->rx.next = 0;
+    instance->rx.ready_cnt[0] = 0;
+    instance->rx.ready_cnt[1] = 0;
+
+    furi_hal_irda_async_rx_set_buffer_isr_callback(instance->rx.buffer, IRDA_WORKER_RX_BUFFER_SIZE, irda_worker_rx_callback, instance);
     furi_hal_irda_async_rx_set_timeout_isr_callback(irda_worker_rx_timeout_callback, instance);
     furi_hal_irda_async_rx_start();
     furi_hal_irda_async_rx_set_timeout(IRDA_WORKER_RX_TIMEOUT);
 
-    instance->rx.overrun = false;
     instance->state = IrdaWorkerStateRunRx;
 }
 
@@ -269,15 +326,13 @@ void irda_worker_rx_stop(IrdaWorker* instance) {
     furi_assert(instance->state == IrdaWorkerStateRunRx);
 
     furi_hal_irda_async_rx_set_timeout_isr_callback(NULL, NULL);
-    furi_hal_irda_async_rx_set_capture_isr_callback(NULL, NULL);
     furi_hal_irda_async_rx_stop();
 
     osEventFlagsSet(instance->events, IRDA_WORKER_EXIT);
     furi_thread_join(instance->thread);
 
-    BaseType_t xReturn = xStreamBufferReset(instance->stream);
-    furi_assert(xReturn == pdPASS);
-    (void)xReturn;
+    /* thread may be releasing buffers until it exits */
+    furi_hal_irda_async_rx_set_buffer_isr_callback(NULL, 0, NULL, NULL);
 
     instance->state = IrdaWorkerStateIdle;
 }
@@ -314,19 +369,24 @@ void irda_worker_tx_start(IrdaWorker* instance) {
     xStreamBufferSetTriggerLevel(instance->stream, sizeof(IrdaWorkerTiming));
 
     osEventFlagsClear(instance->events, IRDA_WORKER_ALL_EVENTS);
-    furi_thread_set_callback(instance->thread, irda_worker_tx_thread);
-    furi_thread_start(instance->thread);
 
     instance->tx.steady_signal_sent = false;
     instance->tx.need_reinitialization = false;
+    instance->tx.finished = false;
+    instance->tx.sent_cnt = 0;
+    instance->tx.sent_dispatched_cnt = 0;
     furi_hal_irda_async_tx_set_data_isr_callback(irda_worker_furi_hal_data_isr_callback, instance);
     furi_hal_irda_async_tx_set_signal_sent_isr_callback(irda_worker_furi_hal_message_sent_isr_callback, instance);
 
+    /* thread starts transmission, so everything is set up before it runs */
     instance->state = IrdaWorkerStateStartTx;
+    furi_thread_set_callback(instance->thread, irda_worker_tx_thread);
+    furi_thread_start(instance->thread);
 }
 
 static void irda_worker_furi_hal_message_sent_isr_callback(void* context) {
     IrdaWorker* instance = context;
+    ++instance->tx.sent_cnt;
     uint32_t flags_set = osEventFlagsSet(instance->events, IRDA_WORKER_TX_MESSAGE_SENT);
     furi_check(flags_set & IRDA_WORKER_TX_MESSAGE_SENT);
 }
@@ -402,7 +462,16 @@ static bool irda_worker_tx_fill_buffer(IrdaWorker* instance) {
         if (instance->signal.decoded) {
             status = irda_encode(instance->irda_encoder, &timing.duration, &timing.level);
         } else {
-            timing.duration = instance->signal.timings[instance->tx.tx_raw_cnt];
+            if (!instance->signal.compact) {
+                timing.duration = instance->signal.timings[instance->tx.tx_raw_cnt];
+            } else if (instance->tx.tx_raw_cnt == 0) {
+                timing.duration = IRDA_RAW_TX_TIMING_DELAY_US;
+                irda_raw_signal_iterator_init(&instance->tx.tx_raw_iterator, instance->signal.compact);
+            } else {
+                bool next = irda_raw_signal_iterator_next(&instance->tx.tx_raw_iterator, &timing.duration);
+                furi_assert(next);
+                (void)next;
+            }
 /* raw always starts from Mark, but we fill it with space delay at start */
             timing.level = (instance->tx.tx_raw_cnt % 2);
             ++instance->tx.tx_raw_cnt;
@@ -438,6 +507,17 @@ static bool irda_worker_tx_fill_buffer(IrdaWorker* instance) {
     return new_data_available;
 }
 
+/* one callback per signal, however many of them were sent since last call */
+static void irda_worker_tx_dispatch_sent(IrdaWorker* instance) {
+    uint32_t sent_cnt = instance->tx.sent_cnt;
+
+    while (instance->tx.sent_dispatched_cnt != sent_cnt) {
+        ++instance->tx.sent_dispatched_cnt;
+        if (instance->tx.message_sent_callback)
+            instance->tx.message_sent_callback(instance->tx.message_sent_context);
+    }
+}
+
 static int32_t irda_worker_tx_thread(void* thread_context) {
     IrdaWorker* instance = thread_context;
     furi_assert(instance->state == IrdaWorkerStateStartTx);
@@ -447,18 +527,23 @@ static int32_t irda_worker_tx_thread(void* thread_context) {
     bool new_data_available = true;
     bool exit = false;
 
+    /* queue may be finished before first signal, nothing to send then */
     exit = !irda_get_new_signal(instance);
-    furi_assert(!exit);
 
     while(!exit) {
         switch (instance->state) {
-        case IrdaWorkerStateStartTx:
+        case IrdaWorkerStateStartTx: {
+            /* filling may already get next signals with other carrier */
+            uint32_t frequency = instance->tx.frequency;
+            float duty_cycle = instance->tx.duty_cycle;
             instance->tx.need_reinitialization = false;
             new_data_available = irda_worker_tx_fill_buffer(instance);
-            furi_hal_irda_async_tx_start(instance->tx.frequency, instance->tx.duty_cycle);
+            furi_hal_irda_async_tx_start(frequency, duty_cycle);
 
             if (!new_data_available) {
-                instance->state = IrdaWorkerStateStopTx;
+                /* queue is over, let hal send what is in stream */
+                instance->tx.finished = true;
+                instance->state = IrdaWorkerStateWaitTxEnd;
             } else if (instance->tx.need_reinitialization) {
                 instance->state = IrdaWorkerStateWaitTxEnd;
             } else {
@@ -466,16 +551,19 @@ static int32_t irda_worker_tx_thread(void* thread_context) {
             }
 
             break;
+        }
         case IrdaWorkerStateStopTx:
             furi_hal_irda_async_tx_stop();
+            irda_worker_tx_dispatch_sent(instance);
             exit = true;
             break;
         case IrdaWorkerStateWaitTxEnd:
             furi_hal_irda_async_tx_wait_termination();
+            irda_worker_tx_dispatch_sent(instance);
             instance->state = IrdaWorkerStateStartTx;
 
             events = osEventFlagsGet(instance->events);
-            if(events & IRDA_WORKER_EXIT) {
+            if((events & IRDA_WORKER_EXIT) || instance->tx.finished) {
                 exit = true;
                 break;
             }
@@ -491,16 +579,16 @@ static int32_t irda_worker_tx_thread(void* thread_context) {
             }
 
             if (events & IRDA_WORKER_TX_FILL_BUFFER) {
-                irda_worker_tx_fill_buffer(instance);
-
-                if (instance->tx.need_reinitialization) {
+                if (!irda_worker_tx_fill_buffer(instance)) {
+                    instance->tx.finished = true;
+                    instance->state = IrdaWorkerStateWaitTxEnd;
+                } else if (instance->tx.need_reinitialization) {
                     instance->state = IrdaWorkerStateWaitTxEnd;
                 }
             }
 
             if (events & IRDA_WORKER_TX_MESSAGE_SENT) {
-                if (instance->tx.message_sent_callback)
-                    instance->tx.message_sent_callback(instance->tx.message_sent_context);
+                irda_worker_tx_dispatch_sent(instance);
             }
             break;
         default:
@@ -534,6 +622,11 @@ void irda_worker_tx_stop(IrdaWorker* instance) {
     furi_hal_irda_async_tx_set_signal_sent_isr_callback(NULL, NULL);
 
     instance->signal.timings_cnt = 0;
+    if (instance->signal.compact) {
+        irda_raw_signal_free(instance->signal.compact);
+        instance->signal.compact = NULL;
+    }
+    irda_worker_tx_queue_flush(instance);
     BaseType_t xReturn = pdFAIL;
     xReturn = xStreamBufferReset(instance->stream);
     furi_assert(xReturn == pdPASS);
@@ -545,6 +638,10 @@ void irda_worker_set_decoded_signal(IrdaWorker* instance, const IrdaMessage* mes
     furi_assert(instance);
     furi_assert(message);
 
+    if (instance->signal.compact) {
+        irda_raw_signal_free(instance->signal.compact);
+        instance->signal.compact = NULL;
+    }
     instance->signal.decoded = true;
     instance->signal.message = *message;
 }
@@ -556,15 +653,101 @@ void irda_worker_set_raw_signal(IrdaWorker* instance, const uint32_t* timings, s
     size_t max_copy_num = COUNT_OF(instance->signal.timings) - 1;
     furi_check(timings_cnt <= max_copy_num);
 
+    if (instance->signal.compact) {
+        irda_raw_signal_free(instance->signal.compact);
+        instance->signal.compact = NULL;
+    }
     instance->signal.timings[0] = IRDA_RAW_TX_TIMING_DELAY_US;
     memcpy(&instance->signal.timings[1], timings, timings_cnt * sizeof(uint32_t));
     instance->signal.decoded = false;
     instance->signal.timings_cnt = timings_cnt + 1;
 }
 
+void irda_worker_set_raw_signal_compact(IrdaWorker* instance, const IrdaRawSignal* signal) {
+    furi_assert(instance);
+    furi_assert(signal);
+
+    if (instance->signal.compact) {
+        irda_raw_signal_free(instance->signal.compact);
+    }
+    /* decoded while filling TX stream, pause is added in front as for timings */
+    instance->signal.compact = irda_raw_signal_copy(signal);
+    instance->signal.decoded = false;
+    instance->signal.timings_cnt = irda_raw_signal_get_timings_count(signal) + 1;
+}
+
 IrdaWorkerGetSignalResponse irda_worker_tx_get_signal_steady_callback(void* context, IrdaWorker* instance) {
     IrdaWorkerGetSignalResponse response = instance->tx.steady_signal_sent ? IrdaWorkerGetSignalResponseSame : IrdaWorkerGetSignalResponseNew;
     instance->tx.steady_signal_sent = true;
     return response;
 }
 
+static void irda_worker_tx_queue_flush(IrdaWorker* instance) {
+    IrdaWorkerTxQueueItem item;
+
+    while (osMessageQueueGet(instance->tx_queue, &item, NULL, 0) == osOK) {
+        if (!item.decoded && item.raw) {
+            irda_raw_signal_free(item.raw);
+        }
+    }
+}
+
+bool irda_worker_tx_queue_decoded_signal(IrdaWorker* instance, const IrdaMessage* message, uint32_t timeout) {
+    furi_assert(instance);
+    furi_assert(message);
+
+    IrdaWorkerTxQueueItem item = {.decoded = true, .message = *message};
+    return osMessageQueuePut(instance->tx_queue, &item, 0, timeout) == osOK;
+}
+
+bool irda_worker_tx_queue_raw_signal(IrdaWorker* instance, const IrdaRawSignal* signal, uint32_t timeout) {
+    furi_assert(instance);
+    furi_assert(signal);
+
+    IrdaWorkerTxQueueItem item = {.decoded = false, .raw = irda_raw_signal_copy(signal)};
+    bool result = osMessageQueuePut(instance->tx_queue, &item, 0, timeout) == osOK;
+    if (!result) {
+        irda_raw_signal_free(item.raw);
+    }
+    return result;
+}
+
+bool irda_worker_tx_queue_finish(IrdaWorker* instance, uint32_t timeout) {
+    furi_assert(instance);
+
+    IrdaWorkerTxQueueItem item = {.decoded = false, .raw = NULL};
+    return osMessageQueuePut(instance->tx_queue, &item, 0, timeout) == osOK;
+}
+
+size_t irda_worker_tx_queue_get_space(IrdaWorker* instance) {
+    furi_assert(instance);
+    return osMessageQueueGetSpace(instance->tx_queue);
+}
+
+IrdaWorkerGetSignalResponse irda_worker_tx_get_signal_queue_callback(void* context, IrdaWorker* instance) {
+    IrdaWorkerTxQueueItem item;
+
+    /* Called when previous signal is fully in stream buffer, so DMA keeps
+     * sending it while we wait for producer to catch up */
+    while (osMessageQueueGet(instance->tx_queue, &item, NULL, IRDA_WORKER_TX_QUEUE_POLL_MS) != osOK) {
+        if (osEventFlagsGet(instance->events) & IRDA_WORKER_EXIT) {
+            return IrdaWorkerGetSignalResponseStop;
+        }
+    }
+
+    if (item.decoded) {
+        irda_worker_set_decoded_signal(instance, &item.message);
+    } else if (item.raw) {
+        /* take ownership instead of copying once more */
+        if (instance->signal.compact) {
+            irda_raw_signal_free(instance->signal.compact);
+        }
+        instance->signal.compact = item.raw;
+        instance->signal.decoded = false;
+        instance->signal.timings_cnt = irda_raw_signal_get_timings_count(item.raw) + 1;
+    } else {
+        return IrdaWorkerGetSignalResponseStop;
+    }
+
+    return IrdaWorkerGetSignalResponseNew;
+}
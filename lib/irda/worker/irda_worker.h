@@ -1,6 +1,7 @@
 #pragma once
 
 #include <irda.h>
+#include <irda_raw.h>
 #include <furi-hal.h>
 
 #ifdef __cplusplus
@@ -121,6 +122,54 @@ void irda_worker_tx_set_signal_sent_callback(IrdaWorker* instance, IrdaWorkerMes
  */
 IrdaWorkerGetSignalResponse irda_worker_tx_get_signal_steady_callback(void* context, IrdaWorker* instance);
 
+/** Callback to pass to irda_worker_tx_set_get_signal_callback() to send
+ * stream of different signals. Signals are taken from TX queue, filled with
+ * irda_worker_tx_queue_*() functions, next one is encoded while previous is
+ * still being sent, so only protocol inter-frame gap is between them.
+ * Carrier change (different protocol frequency) still restarts transmission.
+ * At least one signal must be queued before irda_worker_tx_start().
+ * Transmission ends after irda_worker_tx_queue_finish() item is reached.
+ *
+ * This function should not be implicitly called.
+ *
+ * @param[in]   context - context
+ * @param[out]  instance - IrdaWorker instance
+ */
+IrdaWorkerGetSignalResponse irda_worker_tx_get_signal_queue_callback(void* context, IrdaWorker* instance);
+
+/** Add decoded signal to TX queue
+ *
+ * @param[in]   instance - IrdaWorker instance
+ * @param[in]   message - decoded signal
+ * @param[in]   timeout - how long to wait for free space in queue, ms
+ * @return      true if signal is queued
+ */
+bool irda_worker_tx_queue_decoded_signal(IrdaWorker* instance, const IrdaMessage* message, uint32_t timeout);
+
+/** Add compact raw signal to TX queue. Signal is copied.
+ *
+ * @param[in]   instance - IrdaWorker instance
+ * @param[in]   signal - compact raw signal
+ * @param[in]   timeout - how long to wait for free space in queue, ms
+ * @return      true if signal is queued
+ */
+bool irda_worker_tx_queue_raw_signal(IrdaWorker* instance, const IrdaRawSignal* signal, uint32_t timeout);
+
+/** Mark end of TX queue: transmission stops after last queued signal
+ *
+ * @param[in]   instance - IrdaWorker instance
+ * @param[in]   timeout - how long to wait for free space in queue, ms
+ * @return      true if mark is queued
+ */
+bool irda_worker_tx_queue_finish(IrdaWorker* instance, uint32_t timeout);
+
+/** Get amount of signals TX queue can accept without waiting
+ *
+ * @param[in]   instance - IrdaWorker instance
+ * @return      free space in TX queue
+ */
+size_t irda_worker_tx_queue_get_space(IrdaWorker* instance);
+
 /** Acquire raw signal from interface struct 'IrdaWorkerSignal'.
  * First, you have to ensure that signal is raw.
  *
@@ -153,6 +202,14 @@ void irda_worker_set_decoded_signal(IrdaWorker* instance, const IrdaMessage* mes
  */
 void irda_worker_set_raw_signal(IrdaWorker* instance, const uint32_t* timings, size_t timings_cnt);
 
+/** Set current raw signal for IrdaWorker instance from compact raw signal.
+ * Signal is copied, timings are decoded while filling TX buffer.
+ *
+ * @param[out]  instance - IrdaWorker instance
+ * @param[in]   signal - compact raw signal
+ */
+void irda_worker_set_raw_signal_compact(IrdaWorker* instance, const IrdaRawSignal* signal);
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,9 +20,9 @@
 typedef enum {
     SubGhzProtocolTypeCame,
     SubGhzProtocolTypeKeeloq,
+    SubGhzProtocolTypePrinceton,
     SubGhzProtocolTypeNiceFlo,
     SubGhzProtocolTypeNiceFlorS,
-    SubGhzProtocolTypePrinceton,
     SubGhzProtocolTypeGateTX,
     SubGhzProtocolTypeIDo,
     SubGhzProtocolTypeFaacSLH,
@@ -33,10 +33,136 @@ typedef enum {
     SubGhzProtocolTypeMax,
 } SubGhzProtocolType;
 
+typedef void* (*SubGhzProtocolCommonAlloc)(void);
+typedef void* (*SubGhzProtocolCommonAllocKeystore)(SubGhzKeystore* keystore);
+typedef void (*SubGhzProtocolCommonFree)(void* instance);
+typedef void (*SubGhzProtocolCommonReset)(void* instance);
+typedef void (*SubGhzProtocolCommonParse)(void* instance, bool level, uint32_t duration);
+
+/* First edge idle parser reacts to: level and duration of
+ * te_short * te_short + te_long * te_long, +- te_delta * te_delta */
+typedef struct {
+    bool level;
+    uint8_t te_short;
+    uint8_t te_long;
+    uint8_t te_delta;
+} SubGhzProtocolStart;
+
+typedef struct {
+    SubGhzProtocolCommonAlloc alloc;
+    SubGhzProtocolCommonAllocKeystore alloc_keystore;
+    SubGhzProtocolCommonFree free;
+    SubGhzProtocolCommonReset reset;
+    SubGhzProtocolCommonParse parse;
+    SubGhzProtocolStart start;
+} SubGhzProtocolRegistry;
+
+static const SubGhzProtocolRegistry subghz_protocol_registry[SubGhzProtocolTypeMax] = {
+    [SubGhzProtocolTypeCame] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_protocol_came_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_came_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_came_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_came_parse,
+            .start = {.level = false, .te_short = 51, .te_delta = 51},
+        },
+    [SubGhzProtocolTypeKeeloq] =
+        {
+            .alloc_keystore = (SubGhzProtocolCommonAllocKeystore)subghz_protocol_keeloq_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_keeloq_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_keeloq_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_keeloq_parse,
+            .start = {.level = true, .te_short = 1, .te_delta = 1},
+        },
+    [SubGhzProtocolTypePrinceton] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_decoder_princeton_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_decoder_princeton_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_decoder_princeton_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_decoder_princeton_parse,
+            .start = {.level = false, .te_short = 36, .te_delta = 36},
+        },
+    [SubGhzProtocolTypeNiceFlo] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_protocol_nice_flo_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_nice_flo_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_nice_flo_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_nice_flo_parse,
+            .start = {.level = false, .te_short = 36, .te_delta = 36},
+        },
+    [SubGhzProtocolTypeNiceFlorS] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_protocol_nice_flor_s_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_nice_flor_s_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_nice_flor_s_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_nice_flor_s_parse,
+            .start = {.level = false, .te_short = 38, .te_delta = 38},
+        },
+    [SubGhzProtocolTypeGateTX] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_protocol_gate_tx_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_gate_tx_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_gate_tx_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_gate_tx_parse,
+            .start = {.level = false, .te_short = 47, .te_delta = 47},
+        },
+    [SubGhzProtocolTypeIDo] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_protocol_ido_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_ido_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_ido_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_ido_parse,
+            .start = {.level = true, .te_short = 10, .te_delta = 5},
+        },
+    [SubGhzProtocolTypeFaacSLH] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_protocol_faac_slh_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_faac_slh_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_faac_slh_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_faac_slh_parse,
+            .start = {.level = true, .te_long = 2, .te_delta = 3},
+        },
+    [SubGhzProtocolTypeNeroSketch] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_protocol_nero_sketch_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_nero_sketch_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_nero_sketch_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_nero_sketch_parse,
+            .start = {.level = true, .te_short = 1, .te_delta = 1},
+        },
+    [SubGhzProtocolTypeStarLine] =
+        {
+            .alloc_keystore = (SubGhzProtocolCommonAllocKeystore)subghz_protocol_star_line_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_star_line_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_star_line_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_star_line_parse,
+            .start = {.level = true, .te_long = 2, .te_delta = 2},
+        },
+    [SubGhzProtocolTypeNeroRadio] =
+        {
+            .alloc = (SubGhzProtocolCommonAlloc)subghz_protocol_nero_radio_alloc,
+            .free = (SubGhzProtocolCommonFree)subghz_protocol_nero_radio_free,
+            .reset = (SubGhzProtocolCommonReset)subghz_protocol_nero_radio_reset,
+            .parse = (SubGhzProtocolCommonParse)subghz_protocol_nero_radio_parse,
+            .start = {.level = true, .te_short = 1, .te_delta = 1},
+        },
+};
+
+/* Start windows are bucketed by duration, edge is given only to parsers
+ * which are in the middle of a packet or may start one with this edge. */
+#define SUBGHZ_PROTOCOL_START_SHIFT 9
+#define SUBGHZ_PROTOCOL_START_BUCKETS 64
+
+_Static_assert(SubGhzProtocolTypeMax <= 32, "parser masks are 32 bit");
+
 struct SubGhzProtocol {
     SubGhzKeystore* keystore;
 
     SubGhzProtocolCommon* protocols[SubGhzProtocolTypeMax];
+    /* parsers which are not idle */
+    uint32_t alive;
+    /* [level][bucket] parsers whose start window covers bucket */
+    uint32_t start[2][SUBGHZ_PROTOCOL_START_BUCKETS];
 
     SubGhzProtocolTextCallback text_callback;
     void* text_callback_context;
@@ -44,6 +170,35 @@ struct SubGhzProtocol {
     void* parser_callback_context;
 };
 
+/* Idle parser ignores every edge except the first edge of a packet */
+static inline bool subghz_protocol_is_idle(const SubGhzProtocolCommon* common) {
+    return !common->parser_step && !common->header_count;
+}
+
+static void subghz_protocol_fill_start(SubGhzProtocol* instance, SubGhzProtocolType type) {
+    const SubGhzProtocolStart* start = &subghz_protocol_registry[type].start;
+    const SubGhzProtocolCommon* common = instance->protocols[type];
+
+    uint32_t center = common->te_short * start->te_short + common->te_long * start->te_long;
+    uint32_t delta = common->te_delta * start->te_delta;
+    /* parsers accept DURATION_DIFF(duration, center) < delta */
+    uint32_t min = (center >= delta) ? (center - delta + 1) : 0;
+    uint32_t max = center + delta - 1;
+
+    size_t bucket_min = MIN(min >> SUBGHZ_PROTOCOL_START_SHIFT, SUBGHZ_PROTOCOL_START_BUCKETS - 1);
+    size_t bucket_max = MIN(max >> SUBGHZ_PROTOCOL_START_SHIFT, SUBGHZ_PROTOCOL_START_BUCKETS - 1);
+    for(size_t i = bucket_min; i <= bucket_max; i++) {
+        instance->start[start->level][i] |= (1UL << type);
+    }
+}
+
+static void subghz_protocol_update_alive(SubGhzProtocol* instance) {
+    instance->alive = 0;
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        if(!subghz_protocol_is_idle(instance->protocols[i])) instance->alive |= (1UL << i);
+    }
+}
+
 static void subghz_protocol_text_rx_callback(SubGhzProtocolCommon* parser, void* context) {
     SubGhzProtocol* instance = context;
 
@@ -70,28 +225,16 @@ SubGhzProtocol* subghz_protocol_alloc() {
 
     instance->keystore = subghz_keystore_alloc();
 
-    instance->protocols[SubGhzProtocolTypeCame] =
-        (SubGhzProtocolCommon*)subghz_protocol_came_alloc();
-    instance->protocols[SubGhzProtocolTypeKeeloq] =
-        (SubGhzProtocolCommon*)subghz_protocol_keeloq_alloc(instance->keystore);
-    instance->protocols[SubGhzProtocolTypePrinceton] =
-        (SubGhzProtocolCommon*)subghz_decoder_princeton_alloc();
-    instance->protocols[SubGhzProtocolTypeNiceFlo] =
-        (SubGhzProtocolCommon*)subghz_protocol_nice_flo_alloc();
-    instance->protocols[SubGhzProtocolTypeNiceFlorS] =
-        (SubGhzProtocolCommon*)subghz_protocol_nice_flor_s_alloc();
-    instance->protocols[SubGhzProtocolTypeGateTX] =
-        (SubGhzProtocolCommon*)subghz_protocol_gate_tx_alloc();
-    instance->protocols[SubGhzProtocolTypeIDo] =
-        (SubGhzProtocolCommon*)subghz_protocol_ido_alloc();
-    instance->protocols[SubGhzProtocolTypeFaacSLH] =
-        (SubGhzProtocolCommon*)subghz_protocol_faac_slh_alloc();
-    instance->protocols[SubGhzProtocolTypeNeroSketch] =
-        (SubGhzProtocolCommon*)subghz_protocol_nero_sketch_alloc();
-    instance->protocols[SubGhzProtocolTypeStarLine] =
-        (SubGhzProtocolCommon*)subghz_protocol_star_line_alloc(instance->keystore);
-    instance->protocols[SubGhzProtocolTypeNeroRadio] =
-        (SubGhzProtocolCommon*)subghz_protocol_nero_radio_alloc();
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        const SubGhzProtocolRegistry* registry = &subghz_protocol_registry[i];
+        if(registry->alloc_keystore) {
+            instance->protocols[i] = registry->alloc_keystore(instance->keystore);
+        } else {
+            instance->protocols[i] = registry->alloc();
+        }
+        subghz_protocol_fill_start(instance, i);
+    }
+    subghz_protocol_update_alive(instance);
 
     return instance;
 }
@@ -99,26 +242,9 @@ SubGhzProtocol* subghz_protocol_alloc() {
 void subghz_protocol_free(SubGhzProtocol* instance) {
     furi_assert(instance);
 
-    subghz_protocol_came_free((SubGhzProtocolCame*)instance->protocols[SubGhzProtocolTypeCame]);
-    subghz_protocol_keeloq_free(
-        (SubGhzProtocolKeeloq*)instance->protocols[SubGhzProtocolTypeKeeloq]);
-    subghz_decoder_princeton_free(
-        (SubGhzDecoderPrinceton*)instance->protocols[SubGhzProtocolTypePrinceton]);
-    subghz_protocol_nice_flo_free(
-        (SubGhzProtocolNiceFlo*)instance->protocols[SubGhzProtocolTypeNiceFlo]);
-    subghz_protocol_nice_flor_s_free(
-        (SubGhzProtocolNiceFlorS*)instance->protocols[SubGhzProtocolTypeNiceFlorS]);
-    subghz_protocol_gate_tx_free(
-        (SubGhzProtocolGateTX*)instance->protocols[SubGhzProtocolTypeGateTX]);
-    subghz_protocol_ido_free((SubGhzProtocolIDo*)instance->protocols[SubGhzProtocolTypeIDo]);
-    subghz_protocol_faac_slh_free(
-        (SubGhzProtocolFaacSLH*)instance->protocols[SubGhzProtocolTypeFaacSLH]);
-    subghz_protocol_nero_sketch_free(
-        (SubGhzProtocolNeroSketch*)instance->protocols[SubGhzProtocolTypeNeroSketch]);
-    subghz_protocol_star_line_free(
-        (SubGhzProtocolStarLine*)instance->protocols[SubGhzProtocolTypeStarLine]);
-    subghz_protocol_nero_radio_free(
-        (SubGhzProtocolNeroRadio*)instance->protocols[SubGhzProtocolTypeNeroRadio]);
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        subghz_protocol_registry[i].free(instance->protocols[i]);
+    }
 
     subghz_keystore_free(instance->keystore);
 
@@ -168,9 +294,14 @@ void subghz_protocol_enable_dump(
     instance->parser_callback_context = context;
 }
 
-void subghz_protocol_load_nice_flor_s_file(SubGhzProtocol* instance, const char* file_name) {
+void subghz_protocol_load_nice_flor_s_file(
+    SubGhzProtocol* instance,
+    const char* file_name,
+    bool resident) {
     subghz_protocol_nice_flor_s_name_file(
-        (SubGhzProtocolNiceFlorS*)instance->protocols[SubGhzProtocolTypeNiceFlorS], file_name);
+        (SubGhzProtocolNiceFlorS*)instance->protocols[SubGhzProtocolTypeNiceFlorS],
+        file_name,
+        resident);
 }
 
 void subghz_protocol_load_keeloq_file(SubGhzProtocol* instance, const char* file_name) {
@@ -178,57 +309,34 @@ void subghz_protocol_load_keeloq_file(SubGhzProtocol* instance, const char* file
 }
 
 void subghz_protocol_reset(SubGhzProtocol* instance) {
-    subghz_protocol_came_reset((SubGhzProtocolCame*)instance->protocols[SubGhzProtocolTypeCame]);
-    subghz_protocol_keeloq_reset(
-        (SubGhzProtocolKeeloq*)instance->protocols[SubGhzProtocolTypeKeeloq]);
-    subghz_decoder_princeton_reset(
-        (SubGhzDecoderPrinceton*)instance->protocols[SubGhzProtocolTypePrinceton]);
-    subghz_protocol_nice_flo_reset(
-        (SubGhzProtocolNiceFlo*)instance->protocols[SubGhzProtocolTypeNiceFlo]);
-    subghz_protocol_nice_flor_s_reset(
-        (SubGhzProtocolNiceFlorS*)instance->protocols[SubGhzProtocolTypeNiceFlorS]);
-    subghz_protocol_gate_tx_reset(
-        (SubGhzProtocolGateTX*)instance->protocols[SubGhzProtocolTypeGateTX]);
-    subghz_protocol_ido_reset((SubGhzProtocolIDo*)instance->protocols[SubGhzProtocolTypeIDo]);
-    subghz_protocol_faac_slh_reset(
-        (SubGhzProtocolFaacSLH*)instance->protocols[SubGhzProtocolTypeFaacSLH]);
-    subghz_protocol_nero_sketch_reset(
-        (SubGhzProtocolNeroSketch*)instance->protocols[SubGhzProtocolTypeNeroSketch]);
-    subghz_protocol_star_line_reset(
-        (SubGhzProtocolStarLine*)instance->protocols[SubGhzProtocolTypeStarLine]);
-    subghz_protocol_nero_radio_reset(
-        (SubGhzProtocolNeroRadio*)instance->protocols[SubGhzProtocolTypeNeroRadio]);
+    for(size_t i = 0; i < SubGhzProtocolTypeMax; i++) {
+        subghz_protocol_registry[i].reset(instance->protocols[i]);
+    }
+    subghz_protocol_update_alive(instance);
 }
 
 void subghz_protocol_parse(SubGhzProtocol* instance, bool level, uint32_t duration) {
-    subghz_protocol_came_parse(
-        (SubGhzProtocolCame*)instance->protocols[SubGhzProtocolTypeCame], level, duration);
-    subghz_protocol_keeloq_parse(
-        (SubGhzProtocolKeeloq*)instance->protocols[SubGhzProtocolTypeKeeloq], level, duration);
-    subghz_decoder_princeton_parse(
-        (SubGhzDecoderPrinceton*)instance->protocols[SubGhzProtocolTypePrinceton],
-        level,
-        duration);
-    subghz_protocol_nice_flo_parse(
-        (SubGhzProtocolNiceFlo*)instance->protocols[SubGhzProtocolTypeNiceFlo], level, duration);
-    subghz_protocol_nice_flor_s_parse(
-        (SubGhzProtocolNiceFlorS*)instance->protocols[SubGhzProtocolTypeNiceFlorS],
-        level,
-        duration);
-    subghz_protocol_gate_tx_parse(
-        (SubGhzProtocolGateTX*)instance->protocols[SubGhzProtocolTypeGateTX], level, duration);
-    subghz_protocol_ido_parse(
-        (SubGhzProtocolIDo*)instance->protocols[SubGhzProtocolTypeIDo], level, duration);
-    subghz_protocol_faac_slh_parse(
-        (SubGhzProtocolFaacSLH*)instance->protocols[SubGhzProtocolTypeFaacSLH], level, duration);
-    subghz_protocol_nero_sketch_parse(
-        (SubGhzProtocolNeroSketch*)instance->protocols[SubGhzProtocolTypeNeroSketch],
-        level,
-        duration);
-    subghz_protocol_star_line_parse(
-        (SubGhzProtocolStarLine*)instance->protocols[SubGhzProtocolTypeStarLine], level, duration);
-    subghz_protocol_nero_radio_parse(
-        (SubGhzProtocolNeroRadio*)instance->protocols[SubGhzProtocolTypeNeroRadio],
-        level,
-        duration);
+    size_t bucket = MIN(duration >> SUBGHZ_PROTOCOL_START_SHIFT, SUBGHZ_PROTOCOL_START_BUCKETS - 1);
+    uint32_t parsers = instance->alive | instance->start[level][bucket];
+
+    while(parsers) {
+        size_t i = __builtin_ctz(parsers);
+        parsers &= parsers - 1;
+
+        subghz_protocol_registry[i].parse(instance->protocols[i], level, duration);
+        if(subghz_protocol_is_idle(instance->protocols[i])) {
+            instance->alive &= ~(1UL << i);
+        } else {
+            instance->alive |= (1UL << i);
+        }
+    }
+}
+
+void subghz_protocol_parse_pairs(SubGhzProtocol* instance, const LevelDuration* pairs, size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        subghz_protocol_parse(
+            instance,
+            level_duration_get_level(pairs[i]),
+            level_duration_get_duration(pairs[i]));
+    }
 }
@@ -47,8 +47,13 @@ void subghz_protocol_enable_dump(SubGhzProtocol* instance, SubGhzProtocolCommonC
  * 
  * @param instance - SubGhzProtocol instance
  * @param file_name - "path/file_name"
+ * @param resident - read whole table to RAM, for hosts with heap to spare,
+ *                   otherwise table is read from file through block cache
  */
-void subghz_protocol_load_nice_flor_s_file(SubGhzProtocol* instance, const char* file_name);
+void subghz_protocol_load_nice_flor_s_file(
+    SubGhzProtocol* instance,
+    const char* file_name,
+    bool resident);
 
 /** File upload manufacture keys
  * 
@@ -70,3 +75,11 @@ void subghz_protocol_reset(SubGhzProtocol* instance);
  * @param duration - level duration in microseconds
  */
 void subghz_protocol_parse(SubGhzProtocol* instance, bool level, uint32_t duration);
+
+/** Loading span of durations into all parsers
+ * 
+ * @param instance - SubGhzProtocol instance
+ * @param pairs - level and duration pairs, reset markers are not allowed
+ * @param count - amount of pairs
+ */
+void subghz_protocol_parse_pairs(SubGhzProtocol* instance, const LevelDuration* pairs, size_t count);
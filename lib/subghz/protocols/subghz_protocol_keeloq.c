@@ -56,93 +56,21 @@ uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint16_t end_serial = (uint16_t)(fix & 0x3FF);
     uint8_t btn = (uint8_t)(fix >> 28);
     uint32_t decrypt = 0;
-    uint64_t man_normal_learning;
-
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            switch(manufacture_code->type) {
-            case KEELOQ_LEARNING_SIMPLE:
-                //Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if((decrypt >> 28 == btn) &&
-                   (((((uint16_t)(decrypt >> 16)) & 0x3FF) == end_serial) ||
-                    ((((uint16_t)(decrypt >> 16)) & 0x3FF) == 0))) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    instance->common.cnt = decrypt & 0x0000FFFF;
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_NORMAL:
-                // Normal_Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man_normal_learning =
-                    subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                if((decrypt >> 28 == btn) &&
-                   (((((uint16_t)(decrypt >> 16)) & 0x3FF) == end_serial) ||
-                    ((((uint16_t)(decrypt >> 16)) & 0x3FF) == 0))) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    instance->common.cnt = decrypt & 0x0000FFFF;
-                    return 1;
-                }
-                break;
-            case KEELOQ_LEARNING_UNKNOWN:
-                // Simple Learning
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                if((decrypt >> 28 == btn) &&
-                   (((((uint16_t)(decrypt >> 16)) & 0x3FF) == end_serial) ||
-                    ((((uint16_t)(decrypt >> 16)) & 0x3FF) == 0))) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    instance->common.cnt = decrypt & 0x0000FFFF;
-                    return 1;
-                }
-                // Check for mirrored man
-                uint64_t man_rev = 0;
-                uint64_t man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                if((decrypt >> 28 == btn) &&
-                   (((((uint16_t)(decrypt >> 16)) & 0x3FF) == end_serial) ||
-                    ((((uint16_t)(decrypt >> 16)) & 0x3FF) == 0))) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    instance->common.cnt = decrypt & 0x0000FFFF;
-                    return 1;
-                }
-                //###########################
-                // Normal_Learning
-                // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                man_normal_learning =
-                    subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                if((decrypt >> 28 == btn) &&
-                   (((((uint16_t)(decrypt >> 16)) & 0x3FF) == end_serial) ||
-                    ((((uint16_t)(decrypt >> 16)) & 0x3FF) == 0))) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    instance->common.cnt = decrypt & 0x0000FFFF;
-                    return 1;
-                }
-                // Check for mirrored man
-                man_rev = 0;
-                man_rev_byte = 0;
-                for(uint8_t i = 0; i < 64; i += 8) {
-                    man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                    man_rev = man_rev | man_rev_byte << (56 - i);
-                }
-                man_normal_learning = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                if((decrypt >> 28 == btn) &&
-                   (((((uint16_t)(decrypt >> 16)) & 0x3FF) == end_serial) ||
-                    ((((uint16_t)(decrypt >> 16)) & 0x3FF) == 0))) {
-                    instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                    instance->common.cnt = decrypt & 0x0000FFFF;
-                    return 1;
-                }
-                break;
-            }
-        }
+
+    // decrypt: 0xBSSSCCCC, button must match, serial must match or be 0
+    SubGhzKey* manufacture_code = subghz_keystore_keeloq_find(
+        instance->keystore,
+        fix,
+        hop,
+        0xF3FF0000,
+        (uint32_t)btn << 28 | (uint32_t)end_serial << 16,
+        (uint32_t)btn << 28,
+        &decrypt);
+    if(manufacture_code) {
+        instance->manufacture_name = manufacture_code->name;
+        instance->common.cnt = decrypt & 0x0000FFFF;
+        return 1;
+    }
 
     instance->manufacture_name = "Unknown";
     instance->common.cnt = 0;
@@ -187,18 +115,14 @@ const char* subghz_protocol_keeloq_get_manufacture_name(void* context) {
 
 bool subghz_protocol_keeloq_set_manufacture_name(void* context, const char* manufacture_name) {
     SubGhzProtocolKeeloq* instance = context;
-    instance->manufacture_name = manufacture_name;
-    int res = 0;
-        for
-            M_EACH(
-                manufacture_code,
-                *subghz_keystore_get_data(instance->keystore),
-                SubGhzKeyArray_t) {
-                res = strcmp(string_get_cstr(manufacture_code->name), instance->manufacture_name);
-                if(res == 0) return true;
-            }
-        instance->manufacture_name = "Unknown";
-        return false;
+    SubGhzKey* manufacture_code =
+        subghz_keystore_get_by_name(instance->keystore, manufacture_name);
+    if(manufacture_code) {
+        instance->manufacture_name = manufacture_code->name;
+        return true;
+    }
+    instance->manufacture_name = "Unknown";
+    return false;
 }
 
 uint64_t subghz_protocol_keeloq_gen_key(void* context) {
@@ -208,30 +132,26 @@ uint64_t subghz_protocol_keeloq_gen_key(void* context) {
                        instance->common.cnt;
     uint32_t hop = 0;
     uint64_t man_normal_learning = 0;
-    int res = 0;
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            res = strcmp(string_get_cstr(manufacture_code->name), instance->manufacture_name);
-            if(res == 0) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    //Simple Learning
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    //Simple Learning
-                    man_normal_learning =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    hop = subghz_protocol_keeloq_common_encrypt(decrypt, man_normal_learning);
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    hop = 0; //todo
-                    break;
-                }
-                break;
-            }
+    SubGhzKey* manufacture_code =
+        subghz_keystore_get_by_name(instance->keystore, instance->manufacture_name);
+    if(manufacture_code) {
+        switch(manufacture_code->type) {
+        case KEELOQ_LEARNING_SIMPLE:
+            //Simple Learning
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, manufacture_code->key);
+            break;
+        case KEELOQ_LEARNING_NORMAL:
+            //Simple Learning
+            man_normal_learning =
+                subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+            hop = subghz_protocol_keeloq_common_encrypt(decrypt, man_normal_learning);
+            break;
+        case KEELOQ_LEARNING_UNKNOWN:
+            hop = 0; //todo
+            break;
         }
+    }
     uint64_t yek = (uint64_t)fix << 32 | hop;
     return subghz_protocol_common_reverse_key(yek, instance->common.code_last_count_bit);
 }
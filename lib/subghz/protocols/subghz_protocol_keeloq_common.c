@@ -47,3 +47,67 @@ inline uint64_t subghz_protocol_keeloq_common_normal_learning(uint32_t data, con
 
     return ((uint64_t)k2<<32)| k1; // key - shifrovanoya
 }
+
+inline uint64_t subghz_protocol_keeloq_common_mirror(const uint64_t key) {
+    return __builtin_bswap64(key);
+}
+
+void subghz_protocol_keeloq_common_slice_keys(SubGhzKeeloqKeySlice* slice, const uint64_t* keys, size_t count) {
+    furi_assert(count <= KEELOQ_SLICE_WIDTH);
+    memset(slice, 0, sizeof(SubGhzKeeloqKeySlice));
+    for (size_t j = 0; j < count; j++) {
+        for (size_t i = 0; i < 64; i++) {
+            slice->key[i] |= (uint32_t)bit(keys[j], i) << j;
+        }
+    }
+}
+
+/* KEELOQ_NLF in algebraic normal form, a is the lowest bit of g5() index */
+#define KEELOQ_NLF_SLICE(a,b,c,d,e) \
+    ((a)^(b)^((a)&(b))^((b)&(c))^((a)&(d))^((c)&(d))^ \
+    ((e)&((a)^((a)&(b))^(c)^((a)&(c))^((b)&(d))^((c)&(d)))))
+
+void subghz_protocol_keeloq_common_decrypt_slice(const uint32_t data, const SubGhzKeeloqKeySlice* slice, uint32_t* decrypt) {
+    /* x is shifted by moving its origin: bit n of the state is x[(origin + n) & 31] */
+    uint32_t x[32];
+    uint32_t origin = 0, r;
+    for (r = 0; r < 32; r++)
+        x[r] = bit(data, r) ? 0xFFFFFFFF : 0;
+    for (r = 0; r < 528; r++) {
+        uint32_t nlf = KEELOQ_NLF_SLICE(
+            x[origin & 31], x[(origin + 8) & 31], x[(origin + 19) & 31],
+            x[(origin + 25) & 31], x[(origin + 30) & 31]);
+        uint32_t lsb = x[(origin + 31) & 31] ^ x[(origin + 15) & 31] ^ slice->key[(15 - r) & 63] ^ nlf;
+        origin--;
+        x[origin & 31] = lsb;
+    }
+    for (r = 0; r < 32; r++)
+        decrypt[r] = x[(origin + r) & 31];
+}
+
+void subghz_protocol_keeloq_common_normal_learning_slice(uint32_t data, const SubGhzKeeloqKeySlice* slice, SubGhzKeeloqKeySlice* result) {
+    data&=0x0FFFFFFF;
+    data|=0x20000000;
+    subghz_protocol_keeloq_common_decrypt_slice(data, slice, &result->key[0]);
+
+    data&=0x0FFFFFFF;
+    data|=0x60000000;
+    subghz_protocol_keeloq_common_decrypt_slice(data, slice, &result->key[32]);
+}
+
+uint32_t subghz_protocol_keeloq_common_match_slice(const uint32_t* decrypt, uint32_t mask, uint32_t value) {
+    uint32_t match = 0xFFFFFFFF;
+    while (mask) {
+        uint32_t i = __builtin_ctz(mask);
+        mask &= mask - 1;
+        match &= bit(value, i) ? decrypt[i] : ~decrypt[i];
+    }
+    return match;
+}
+
+uint32_t subghz_protocol_keeloq_common_unslice(const uint32_t* decrypt, size_t index) {
+    uint32_t x = 0;
+    for (size_t i = 0; i < 32; i++)
+        x |= bit(decrypt[i], index) << i;
+    return x;
+}
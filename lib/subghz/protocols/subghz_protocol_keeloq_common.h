@@ -46,3 +46,56 @@ uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64
  * @return manufacture for this serial number (64bit)
  */
 uint64_t subghz_protocol_keeloq_common_normal_learning(uint32_t data, const uint64_t key);
+
+/** Mirrored manufacture key, bytes in reverse order
+ * @param key - manufacture (64bit)
+ * @return mirrored manufacture (64bit)
+ */
+uint64_t subghz_protocol_keeloq_common_mirror(const uint64_t key);
+
+/*
+ * Bitsliced KeeLoq: 32 keys are processed at once, word i holds bit i
+ * of every key (bit j of the word belongs to key j). All keys decrypt
+ * the same data, so a whole slice costs about as much as 2 plain decrypts.
+ */
+#define KEELOQ_SLICE_WIDTH  32
+
+typedef struct {
+    uint32_t key[64];
+} SubGhzKeeloqKeySlice;
+
+/** Transpose manufacture keys into slice
+ * @param slice - destination slice
+ * @param keys - manufacture keys (64bit)
+ * @param count - amount of keys, up to KEELOQ_SLICE_WIDTH, unused keys are zero
+ */
+void subghz_protocol_keeloq_common_slice_keys(SubGhzKeeloqKeySlice* slice, const uint64_t* keys, size_t count);
+
+/** Simple Learning Decrypt for slice of keys
+ * @param data - keelog encrypt data
+ * @param slice - manufacture keys
+ * @param decrypt - 32 words, bitsliced decrypt result of every key
+ */
+void subghz_protocol_keeloq_common_decrypt_slice(const uint32_t data, const SubGhzKeeloqKeySlice* slice, uint32_t* decrypt);
+
+/** Normal Learning for slice of keys
+ * @param data - serial number (28bit)
+ * @param slice - manufacture keys
+ * @param result - manufacture for this serial number, for every key
+ */
+void subghz_protocol_keeloq_common_normal_learning_slice(uint32_t data, const SubGhzKeeloqKeySlice* slice, SubGhzKeeloqKeySlice* result);
+
+/** Compare bitsliced decrypt result
+ * @param decrypt - 32 words, bitsliced decrypt result
+ * @param mask - bits to compare
+ * @param value - expected value of compared bits
+ * @return bit j is set if decrypt result of key j matches
+ */
+uint32_t subghz_protocol_keeloq_common_match_slice(const uint32_t* decrypt, uint32_t mask, uint32_t value);
+
+/** Extract decrypt result of one key
+ * @param decrypt - 32 words, bitsliced decrypt result
+ * @param index - key index in slice
+ * @return decrypt result of key
+ */
+uint32_t subghz_protocol_keeloq_common_unslice(const uint32_t* decrypt, size_t index);
@@ -1,7 +1,8 @@
 #include "subghz_protocol_nice_flor_s.h"
 
+#include "../subghz_rainbow_table.h"
+
 #include <furi.h>
-#include "file-worker.h"
 /*
  * https://phreakerclub.com/1615
  * https://phreakerclub.com/forum/showthread.php?t=2360
@@ -10,12 +11,14 @@
 
 struct SubGhzProtocolNiceFlorS {
     SubGhzProtocolCommon common;
-    const char* rainbow_table_file_name;
+    SubGhzRainbowTable* rainbow_table;
 };
 
 SubGhzProtocolNiceFlorS* subghz_protocol_nice_flor_s_alloc() {
     SubGhzProtocolNiceFlorS* instance = furi_alloc(sizeof(SubGhzProtocolNiceFlorS));
 
+    instance->rainbow_table = subghz_rainbow_table_alloc();
+
     instance->common.name = "Nice FloR-S";
     instance->common.code_min_count_bit_for_found = 52;
     instance->common.te_short = 500;
@@ -31,12 +34,20 @@ SubGhzProtocolNiceFlorS* subghz_protocol_nice_flor_s_alloc() {
 
 void subghz_protocol_nice_flor_s_free(SubGhzProtocolNiceFlorS* instance) {
     furi_assert(instance);
+    subghz_rainbow_table_free(instance->rainbow_table);
     free(instance);
 }
 
-void subghz_protocol_nice_flor_s_name_file(SubGhzProtocolNiceFlorS* instance, const char* name) {
-    instance->rainbow_table_file_name = name;
+void subghz_protocol_nice_flor_s_name_file(
+    SubGhzProtocolNiceFlorS* instance,
+    const char* name,
+    bool resident) {
     printf("Loading Nice FloR S rainbow table %s\r\n", name);
+    if(!subghz_rainbow_table_open(instance->rainbow_table, name, resident)) {
+        printf("Nice FloR S rainbow table is not found: %s\r\n", name);
+    } else if(subghz_rainbow_table_is_resident(instance->rainbow_table)) {
+        printf("Nice FloR S rainbow table is loaded to RAM\r\n");
+    }
 }
 
 /** Send bit 
@@ -93,20 +104,8 @@ void subghz_protocol_nice_flor_s_send_key(
  * @return byte data
  */
 uint8_t subghz_nice_flor_s_get_byte_in_file(SubGhzProtocolNiceFlorS* instance, uint32_t address) {
-    if(!instance->rainbow_table_file_name) 
-        return 0;
-
     uint8_t buffer = 0;
-    FileWorker* file_worker = file_worker_alloc(true);
-    if(file_worker_open(file_worker, instance->rainbow_table_file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
-        file_worker_seek(file_worker, address, true);
-        file_worker_read(file_worker, &buffer, 1);
-        // bool res = file_worker_read(file_worker, &buffer, 1);
-        // furi_assert(res== true);
-    }
-    file_worker_close(file_worker);
-    file_worker_free(file_worker);
-
+    subghz_rainbow_table_get_byte(instance->rainbow_table, address, &buffer);
     return buffer;
 }
 
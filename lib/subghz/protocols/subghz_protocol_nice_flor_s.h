@@ -20,8 +20,12 @@ void subghz_protocol_nice_flor_s_free(SubGhzProtocolNiceFlorS* instance);
  * 
  * @param instance - SubGhzProtocolNiceFlorS instance
  * @param file_name - "path/file_name"
+ * @param resident - read whole table to RAM instead of block cache
  */
-void subghz_protocol_nice_flor_s_name_file(SubGhzProtocolNiceFlorS* instance, const char* name);
+void subghz_protocol_nice_flor_s_name_file(
+    SubGhzProtocolNiceFlorS* instance,
+    const char* name,
+    bool resident);
 
 /** Sends the key on the air
  * 
@@ -103,79 +103,16 @@ uint8_t subghz_protocol_star_line_check_remote_controller_selector(SubGhzProtoco
     uint16_t end_serial = (uint16_t)(fix&0xFF);
     uint8_t btn = (uint8_t)(fix>>24);
     uint32_t decrypt = 0;
-    uint64_t man_normal_learning;
 
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(instance->keystore), SubGhzKeyArray_t) {
-            switch (manufacture_code->type){
-                case KEELOQ_LEARNING_SIMPLE:
-                    //Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if((decrypt>>24 == btn) && ((((uint16_t)(decrypt>>16)) & 0x00FF) == end_serial)){
-                        instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                        instance->common.cnt = decrypt & 0x0000FFFF;
-                        return 1;
-                    }
-                break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal_Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man_normal_learning = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt=subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if( (decrypt>>24 ==btn)&& ((((uint16_t)(decrypt>>16))&0x00FF)==end_serial)){ 
-                        instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                        instance->common.cnt = decrypt & 0x0000FFFF;
-                        return 1;
-                    }
-                break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt=subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if( (decrypt>>24 ==btn) && ((((uint16_t)(decrypt>>16))&0x00FF)==end_serial)){
-                        instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                        instance->common.cnt = decrypt & 0x0000FFFF;
-                        return 1;
-                    }
-                    // Check for mirrored man
-                    uint64_t man_rev=0;
-                    uint64_t man_rev_byte=0;
-                    for(uint8_t i=0; i<64; i+=8){
-                        man_rev_byte=(uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev  | man_rev_byte << (56-i);
-                    }
-                    decrypt=subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if( (decrypt>>24 ==btn) && ((((uint16_t)(decrypt>>16))&0x00FF)==end_serial)){
-                      instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                      instance->common.cnt= decrypt&0x0000FFFF;
-                      return 1;
-                    }
-                    //###########################
-                    // Normal_Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man_normal_learning = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt=subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if( (decrypt>>24 ==btn)&& ((((uint16_t)(decrypt>>16))&0x00FF)==end_serial)){
-                        instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                        instance->common.cnt= decrypt&0x0000FFFF;
-                        return 1;
-                    }
-                    // Check for mirrored man
-                    man_rev=0;
-                    man_rev_byte=0;
-                    for(uint8_t i=0; i<64; i+=8){
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev  | man_rev_byte << (56-i);
-                    }
-                    man_normal_learning = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt=subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if( (decrypt>>24 ==btn) && ((((uint16_t)(decrypt>>16))&0x00FF)==end_serial)){
-                        instance->manufacture_name = string_get_cstr(manufacture_code->name);
-                        instance->common.cnt= decrypt&0x0000FFFF;
-                        return 1;
-                    }
-                break;
-            }
-        }
+    // decrypt: 0xBBSSCCCC, button and serial must match
+    uint32_t value = (uint32_t)btn<<24 | (uint32_t)end_serial<<16;
+    SubGhzKey* manufacture_code = subghz_keystore_keeloq_find(
+        instance->keystore, fix, hop, 0xFFFF0000, value, value, &decrypt);
+    if(manufacture_code) {
+        instance->manufacture_name = manufacture_code->name;
+        instance->common.cnt= decrypt&0x0000FFFF;
+        return 1;
+    }
 
     instance->manufacture_name = "Unknown";
     instance->common.cnt=0;
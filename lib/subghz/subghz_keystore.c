@@ -1,12 +1,39 @@
 #include "subghz_keystore.h"
 
+#include "protocols/subghz_protocol_keeloq_common.h"
+
 #include <furi.h>
 #include <storage/storage.h>
 
-#define FILE_BUFFER_SIZE 64
+#define SUBGHZ_KEYSTORE_READ_CHUNK UINT16_MAX
+
+/* KEELOQ_SLICE_WIDTH keys prepared for bitsliced search,
+ * normal learning keys are derived on demand and kept until serial changes */
+typedef struct {
+    SubGhzKeeloqKeySlice key;
+    SubGhzKeeloqKeySlice key_mirror;
+    SubGhzKeeloqKeySlice normal_key;
+    SubGhzKeeloqKeySlice normal_key_mirror;
+    uint32_t simple;
+    uint32_t normal;
+    uint32_t mirror;
+    uint32_t normal_serial;
+    bool normal_cached;
+} SubGhzKeystoreSlice;
+
+/* Loaded file content, key names point into it. Chained to keep every load alive */
+typedef struct SubGhzKeystoreFile {
+    struct SubGhzKeystoreFile* next;
+    char data[];
+} SubGhzKeystoreFile;
 
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    SubGhzKeystoreFile* files;
+    SubGhzKeystoreSlice* slices;
+    size_t slices_count;
+    uint16_t* names;
+    size_t names_size;
 };
 
 SubGhzKeystore* subghz_keystore_alloc() {
@@ -20,63 +47,296 @@ SubGhzKeystore* subghz_keystore_alloc() {
 void subghz_keystore_free(SubGhzKeystore* instance) {
     furi_assert(instance);
 
-    for
-    M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-        string_clear(manufacture_code->name);
-        manufacture_code->key = 0;
-    }
     SubGhzKeyArray_clear(instance->data);
+    while(instance->files) {
+        SubGhzKeystoreFile* file = instance->files;
+        instance->files = file->next;
+        free(file);
+    }
+    free(instance->slices);
+    free(instance->names);
 
     free(instance);
 }
 
 static void subghz_keystore_add_key(SubGhzKeystore* instance, const char* name, uint64_t key, uint16_t type) {
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    string_init_set_str(manufacture_code->name, name);
+    manufacture_code->name = name;
     manufacture_code->key = key;
     manufacture_code->type = type;
 }
 
-static void subghz_keystore_process_line(SubGhzKeystore* instance, string_t line) {
-    uint64_t key = 0;
-    uint16_t type = 0;
-    char skey[17] = {0};
-    char name[65] = {0};
-    int ret = sscanf(string_get_cstr(line), "%16s:%hu:%64s", skey, &type, name);
-    key = strtoull(skey, NULL, 16);
-    if (ret == 3) {
-        subghz_keystore_add_key(instance, name, key, type);
-    } else {
-        printf("Failed to load line: %s\r\n", string_get_cstr(line));
+/* Text line is KEY:TYPE:NAME, name is terminated in place */
+static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
+    char* end;
+    uint64_t key = strtoull(line, &end, 16);
+    if(end == line || *end != ':') return false;
+    line = end + 1;
+    uint16_t type = strtoul(line, &end, 10);
+    if(end == line || *end != ':') return false;
+    line = end + 1;
+    end = line;
+    while(*end && *end != ' ' && *end != '\t' && *end != '\r') end++;
+    if(end == line) return false;
+    *end = 0;
+    subghz_keystore_add_key(instance, line, key, type);
+    return true;
+}
+
+static void subghz_keystore_load_text(SubGhzKeystore* instance, char* data, size_t size) {
+    size_t lines = 1;
+    for(size_t i = 0; i < size; i++) {
+        if(data[i] == '\n') lines++;
+    }
+    SubGhzKeyArray_reserve(instance->data, SubGhzKeyArray_size(instance->data) + lines);
+
+    char* line = data;
+    while(line < data + size) {
+        char* end = memchr(line, '\n', data + size - line);
+        if(!end) end = data + size;
+        *end = 0;
+        if(*line && !subghz_keystore_process_line(instance, line)) {
+            printf("Failed to load line: %s\r\n", line);
+        }
+        line = end + 1;
+    }
+}
+
+static bool subghz_keystore_load_binary(SubGhzKeystore* instance, char* data, size_t size) {
+    SubGhzKeystoreBinaryHeader header;
+    memcpy(&header, data, sizeof(header));
+    if(header.version != SUBGHZ_KEYSTORE_BINARY_VERSION) return false;
+    if(header.key_count > size / sizeof(SubGhzKeystoreBinaryRecord)) return false;
+
+    size_t records_size = header.key_count * sizeof(SubGhzKeystoreBinaryRecord);
+    if(sizeof(header) + records_size + header.names_size != size) return false;
+    const char* names = data + sizeof(header) + records_size;
+    if(!header.names_size || names[header.names_size - 1]) return false;
+
+    const SubGhzKeystoreBinaryRecord* records =
+        (const SubGhzKeystoreBinaryRecord*)(data + sizeof(header));
+    for(size_t i = 0; i < header.key_count; i++) {
+        if(records[i].name >= header.names_size) return false;
+    }
+
+    SubGhzKeyArray_reserve(instance->data, SubGhzKeyArray_size(instance->data) + header.key_count);
+    for(size_t i = 0; i < header.key_count; i++) {
+        subghz_keystore_add_key(instance, names + records[i].name, records[i].key, records[i].type);
+    }
+    return true;
+}
+
+static uint32_t subghz_keystore_hash(const char* name) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    while(*name) {
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+    return hash;
+}
+
+/* Open addressing table of key index + 1 by name, first key wins for duplicate names.
+ * Names past UINT16_MAX - 1 keys are not indexed */
+static void subghz_keystore_prepare_names(SubGhzKeystore* instance) {
+    size_t keys_count = MIN(SubGhzKeyArray_size(instance->data), UINT16_MAX - 1);
+
+    free(instance->names);
+    instance->names_size = 1;
+    while(instance->names_size < keys_count * 2) instance->names_size <<= 1;
+    instance->names = furi_alloc(sizeof(uint16_t) * instance->names_size);
+
+    for(size_t i = 0; i < keys_count; i++) {
+        const char* name = SubGhzKeyArray_get(instance->data, i)->name;
+        size_t slot = subghz_keystore_hash(name) & (instance->names_size - 1);
+        while(instance->names[slot]) {
+            if(!strcmp(SubGhzKeyArray_get(instance->data, instance->names[slot] - 1)->name, name)) {
+                break;
+            }
+            slot = (slot + 1) & (instance->names_size - 1);
+        }
+        if(!instance->names[slot]) instance->names[slot] = i + 1;
+    }
+}
+
+static void subghz_keystore_prepare_slices(SubGhzKeystore* instance) {
+    size_t keys_count = SubGhzKeyArray_size(instance->data);
+
+    free(instance->slices);
+    instance->slices_count = (keys_count + KEELOQ_SLICE_WIDTH - 1) / KEELOQ_SLICE_WIDTH;
+    instance->slices = furi_alloc(sizeof(SubGhzKeystoreSlice) * instance->slices_count);
+
+    for(size_t i = 0; i < instance->slices_count; i++) {
+        SubGhzKeystoreSlice* slice = &instance->slices[i];
+        uint64_t keys[KEELOQ_SLICE_WIDTH];
+        uint64_t keys_mirror[KEELOQ_SLICE_WIDTH];
+        size_t count = MIN(keys_count - i * KEELOQ_SLICE_WIDTH, KEELOQ_SLICE_WIDTH);
+
+        for(size_t j = 0; j < count; j++) {
+            SubGhzKey* manufacture_code =
+                SubGhzKeyArray_get(instance->data, i * KEELOQ_SLICE_WIDTH + j);
+            keys[j] = manufacture_code->key;
+            keys_mirror[j] = subghz_protocol_keeloq_common_mirror(manufacture_code->key);
+            switch(manufacture_code->type) {
+            case KEELOQ_LEARNING_SIMPLE:
+                slice->simple |= 1u << j;
+                break;
+            case KEELOQ_LEARNING_NORMAL:
+                slice->normal |= 1u << j;
+                break;
+            case KEELOQ_LEARNING_UNKNOWN:
+                slice->simple |= 1u << j;
+                slice->normal |= 1u << j;
+                slice->mirror |= 1u << j;
+                break;
+            }
+        }
+        subghz_protocol_keeloq_common_slice_keys(&slice->key, keys, count);
+        subghz_protocol_keeloq_common_slice_keys(&slice->key_mirror, keys_mirror, count);
     }
 }
 
 void subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
-    File* manufacture_keys_file = storage_file_alloc(furi_record_open("storage"));
-    string_t line;
-    string_init(line);
+    furi_assert(instance);
+    File* manufacture_keys_file = storage_file_alloc(furi_record_open_id(FuriRecordIdStorage));
     if(storage_file_open(manufacture_keys_file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
         printf("Loading manufacture keys file %s\r\n", file_name);
-        char buffer[FILE_BUFFER_SIZE];
-        uint16_t ret;
-        do {
-            ret = storage_file_read(manufacture_keys_file, buffer, FILE_BUFFER_SIZE);
-            for (uint16_t i=0; i < ret; i++) {
-                if (buffer[i] == '\n' && string_size(line) > 0) {
-                    subghz_keystore_process_line(instance, line);
-                    string_clean(line);
-                } else {
-                    string_push_back(line, buffer[i]);
+        size_t size = storage_file_size(manufacture_keys_file);
+        // +1 for terminator of the last text line
+        SubGhzKeystoreFile* file = malloc(sizeof(SubGhzKeystoreFile) + size + 1);
+        size_t offset = 0;
+        if(file) {
+            while(offset < size) {
+                uint16_t bytes_to_read = MIN(size - offset, SUBGHZ_KEYSTORE_READ_CHUNK);
+                uint16_t ret =
+                    storage_file_read(manufacture_keys_file, &file->data[offset], bytes_to_read);
+                offset += ret;
+                if(ret != bytes_to_read) break;
+            }
+        }
+
+        if(!file) {
+            printf("Not enough memory for manufacture keys file\r\n");
+        } else if(offset != size) {
+            printf("Failed to read manufacture keys file\r\n");
+            free(file);
+        } else {
+            file->data[size] = 0;
+            file->next = instance->files;
+            instance->files = file;
+
+            uint32_t magic = 0;
+            if(size >= sizeof(SubGhzKeystoreBinaryHeader)) memcpy(&magic, file->data, sizeof(magic));
+            if(magic == SUBGHZ_KEYSTORE_BINARY_MAGIC) {
+                if(!subghz_keystore_load_binary(instance, file->data, size)) {
+                    printf("Manufacture keys file is corrupted\r\n");
                 }
+            } else {
+                subghz_keystore_load_text(instance, file->data, size);
             }
-        } while(ret > 0);
+        }
     } else {
         printf("Manufacture keys file is not found: %s\r\n", file_name);
     }
-    string_clear(line);
+    subghz_keystore_prepare_slices(instance);
+    subghz_keystore_prepare_names(instance);
     storage_file_close(manufacture_keys_file);
     storage_file_free(manufacture_keys_file);
-    furi_record_close("storage");
+    furi_record_close_id(FuriRecordIdStorage);
+}
+
+SubGhzKey* subghz_keystore_get_by_name(SubGhzKeystore* instance, const char* name) {
+    furi_assert(instance);
+    furi_assert(name);
+    if(!instance->names) return NULL;
+
+    size_t slot = subghz_keystore_hash(name) & (instance->names_size - 1);
+    while(instance->names[slot]) {
+        SubGhzKey* manufacture_code = SubGhzKeyArray_get(instance->data, instance->names[slot] - 1);
+        if(!strcmp(manufacture_code->name, name)) return manufacture_code;
+        slot = (slot + 1) & (instance->names_size - 1);
+    }
+    return NULL;
+}
+
+static uint32_t subghz_keystore_keeloq_match(
+    const SubGhzKeeloqKeySlice* keys,
+    uint32_t hop,
+    uint32_t mask,
+    uint32_t value,
+    uint32_t value_alt) {
+    uint32_t decrypt[KEELOQ_SLICE_WIDTH];
+    subghz_protocol_keeloq_common_decrypt_slice(hop, keys, decrypt);
+    return subghz_protocol_keeloq_common_match_slice(decrypt, mask, value) |
+           subghz_protocol_keeloq_common_match_slice(decrypt, mask, value_alt);
+}
+
+SubGhzKey* subghz_keystore_keeloq_find(
+    SubGhzKeystore* instance,
+    uint32_t fix,
+    uint32_t hop,
+    uint32_t mask,
+    uint32_t value,
+    uint32_t value_alt,
+    uint32_t* decrypt) {
+    furi_assert(instance);
+    furi_assert(decrypt);
+    uint32_t serial = fix & 0x0FFFFFFF;
+
+    for(size_t i = 0; i < instance->slices_count; i++) {
+        SubGhzKeystoreSlice* slice = &instance->slices[i];
+        uint32_t simple = 0, simple_mirror = 0, normal = 0, normal_mirror = 0;
+
+        if(slice->simple) {
+            simple = slice->simple & subghz_keystore_keeloq_match(
+                                         &slice->key, hop, mask, value, value_alt);
+        }
+        if(slice->mirror) {
+            simple_mirror = slice->mirror & subghz_keystore_keeloq_match(
+                                                &slice->key_mirror, hop, mask, value, value_alt);
+        }
+        if(slice->normal) {
+            if(!slice->normal_cached || slice->normal_serial != serial) {
+                subghz_protocol_keeloq_common_normal_learning_slice(
+                    serial, &slice->key, &slice->normal_key);
+                if(slice->mirror) {
+                    subghz_protocol_keeloq_common_normal_learning_slice(
+                        serial, &slice->key_mirror, &slice->normal_key_mirror);
+                }
+                slice->normal_serial = serial;
+                slice->normal_cached = true;
+            }
+            normal = slice->normal & subghz_keystore_keeloq_match(
+                                         &slice->normal_key, hop, mask, value, value_alt);
+            if(slice->mirror) {
+                normal_mirror = slice->mirror &
+                                subghz_keystore_keeloq_match(
+                                    &slice->normal_key_mirror, hop, mask, value, value_alt);
+            }
+        }
+
+        uint32_t found = simple | simple_mirror | normal | normal_mirror;
+        if(found) {
+            // First key in file order wins, its decrypt is redone for this key only
+            size_t j = __builtin_ctz(found);
+            SubGhzKey* manufacture_code =
+                SubGhzKeyArray_get(instance->data, i * KEELOQ_SLICE_WIDTH + j);
+            uint64_t key = manufacture_code->key;
+            if(!bit_read(simple, j)) {
+                if(bit_read(simple_mirror, j)) {
+                    key = subghz_protocol_keeloq_common_mirror(key);
+                } else if(bit_read(normal, j)) {
+                    key = subghz_protocol_keeloq_common_normal_learning(fix, key);
+                } else {
+                    key = subghz_protocol_keeloq_common_normal_learning(
+                        fix, subghz_protocol_keeloq_common_mirror(key));
+                }
+            }
+            *decrypt = subghz_protocol_keeloq_common_decrypt(hop, key);
+            return manufacture_code;
+        }
+    }
+
+    return NULL;
 }
 
 SubGhzKeyArray_t* subghz_keystore_get_data(SubGhzKeystore* instance) {
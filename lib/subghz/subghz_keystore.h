@@ -5,7 +5,7 @@
 #include <stdint.h>
 
 typedef struct {
-    string_t name;
+    const char* name;
     uint64_t key;
     uint16_t type;
 } SubGhzKey;
@@ -16,6 +16,27 @@ ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
 
 typedef struct SubGhzKeystore SubGhzKeystore;
 
+/* Compiled keystore, little endian: header, key_count records,
+ * names_size bytes of zero terminated names. Record name is offset of its
+ * name, equal names are stored once. Made by scripts/subghz_keystore.py */
+#define SUBGHZ_KEYSTORE_BINARY_MAGIC 0x4B5A4753 // "SGZK"
+#define SUBGHZ_KEYSTORE_BINARY_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t key_count;
+    uint32_t names_size;
+} SubGhzKeystoreBinaryHeader;
+
+typedef struct {
+    uint64_t key;
+    uint16_t type;
+    uint16_t reserved;
+    uint32_t name;
+} SubGhzKeystoreBinaryRecord;
+
 /** Allocate SubGhzKeystore
  * 
  * @return SubGhzKeystore* 
@@ -29,12 +50,46 @@ SubGhzKeystore* subghz_keystore_alloc();
 void subghz_keystore_free(SubGhzKeystore* instance);
 
 /** Loading manufacture key from file
+ * Text (KEY:TYPE:NAME lines) and compiled keystores are detected by content,
+ * file is read at once and names are kept in it.
  * 
  * @param instance - SubGhzKeystore instance
  * @param filename - const char* full path to the file
  */
 void subghz_keystore_load(SubGhzKeystore* instance, const char* filename);
 
+/** Find manufacture key for KeeLoq parcel
+ * Keys are tried in file order, learning types in order: simple,
+ * mirrored simple, normal, mirrored normal. Mirrored keys are tried for
+ * KEELOQ_LEARNING_UNKNOWN keys only. Decrypted hop matches when
+ * (decrypt & mask) equals value or value_alt.
+ * 
+ * @param instance - SubGhzKeystore instance
+ * @param fix - fix part of the parcel, serial number for normal learning
+ * @param hop - hop encrypted part of the parcel
+ * @param mask - decrypted bits to compare
+ * @param value - expected value of compared bits
+ * @param value_alt - alternative expected value of compared bits
+ * @param decrypt - decrypted hop, valid if key is found
+ * @return SubGhzKey* found key or NULL
+ */
+SubGhzKey* subghz_keystore_keeloq_find(
+    SubGhzKeystore* instance,
+    uint32_t fix,
+    uint32_t hop,
+    uint32_t mask,
+    uint32_t value,
+    uint32_t value_alt,
+    uint32_t* decrypt);
+
+/** Find manufacture key by name
+ * 
+ * @param instance - SubGhzKeystore instance
+ * @param name - manufacture name
+ * @return SubGhzKey* first key with this name or NULL
+ */
+SubGhzKey* subghz_keystore_get_by_name(SubGhzKeystore* instance, const char* name);
+
 /** Get array of keys and names manufacture
  * 
  * @param instance - SubGhzKeystore instance
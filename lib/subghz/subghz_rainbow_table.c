@@ -0,0 +1,154 @@
+#include "subghz_rainbow_table.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#define SUBGHZ_RAINBOW_TABLE_BLOCK_SIZE 256
+#define SUBGHZ_RAINBOW_TABLE_BLOCK_COUNT 4
+
+typedef struct {
+    uint32_t address;
+    uint32_t used;
+    uint8_t data[SUBGHZ_RAINBOW_TABLE_BLOCK_SIZE];
+} SubGhzRainbowTableBlock;
+
+struct SubGhzRainbowTable {
+    Storage* storage;
+    File* file;
+    uint32_t size;
+    uint8_t* resident;
+    uint32_t tick;
+    SubGhzRainbowTableBlock* blocks;
+};
+
+SubGhzRainbowTable* subghz_rainbow_table_alloc() {
+    SubGhzRainbowTable* instance = furi_alloc(sizeof(SubGhzRainbowTable));
+    return instance;
+}
+
+void subghz_rainbow_table_free(SubGhzRainbowTable* instance) {
+    furi_assert(instance);
+    subghz_rainbow_table_close(instance);
+    free(instance);
+}
+
+static bool subghz_rainbow_table_load_resident(SubGhzRainbowTable* instance) {
+    if(memmgr_get_free_heap() < instance->size + SUBGHZ_RAINBOW_TABLE_HEAP_RESERVE) {
+        return false;
+    }
+
+    instance->resident = malloc(instance->size);
+    if(!instance->resident) return false;
+
+    uint32_t offset = 0;
+    while(offset < instance->size) {
+        uint16_t bytes_to_read = MIN(instance->size - offset, UINT16_MAX);
+        uint16_t ret = storage_file_read(instance->file, &instance->resident[offset], bytes_to_read);
+        if(ret != bytes_to_read) break;
+        offset += ret;
+    }
+
+    if(offset != instance->size) {
+        free(instance->resident);
+        instance->resident = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool subghz_rainbow_table_open(SubGhzRainbowTable* instance, const char* file_name, bool resident) {
+    furi_assert(instance);
+    furi_assert(file_name);
+
+    subghz_rainbow_table_close(instance);
+
+    instance->storage = furi_record_open("storage");
+    instance->file = storage_file_alloc(instance->storage);
+    if(!storage_file_open(instance->file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        subghz_rainbow_table_close(instance);
+        return false;
+    }
+    instance->size = storage_file_size(instance->file);
+
+    if(resident && subghz_rainbow_table_load_resident(instance)) {
+        // Everything is in RAM, file is not needed anymore
+        storage_file_close(instance->file);
+        storage_file_free(instance->file);
+        instance->file = NULL;
+    } else {
+        instance->blocks =
+            furi_alloc(sizeof(SubGhzRainbowTableBlock) * SUBGHZ_RAINBOW_TABLE_BLOCK_COUNT);
+    }
+
+    return true;
+}
+
+void subghz_rainbow_table_close(SubGhzRainbowTable* instance) {
+    furi_assert(instance);
+
+    if(instance->file) {
+        storage_file_close(instance->file);
+        storage_file_free(instance->file);
+        instance->file = NULL;
+    }
+    if(instance->storage) {
+        furi_record_close("storage");
+        instance->storage = NULL;
+    }
+    free(instance->resident);
+    instance->resident = NULL;
+    free(instance->blocks);
+    instance->blocks = NULL;
+    instance->size = 0;
+    instance->tick = 0;
+}
+
+bool subghz_rainbow_table_is_resident(SubGhzRainbowTable* instance) {
+    furi_assert(instance);
+    return instance->resident != NULL;
+}
+
+/* Least recently used block is replaced, block with used == 0 is empty */
+static SubGhzRainbowTableBlock*
+    subghz_rainbow_table_get_block(SubGhzRainbowTable* instance, uint32_t address) {
+    uint32_t block_address = address - address % SUBGHZ_RAINBOW_TABLE_BLOCK_SIZE;
+    SubGhzRainbowTableBlock* victim = &instance->blocks[0];
+
+    instance->tick++;
+    for(size_t i = 0; i < SUBGHZ_RAINBOW_TABLE_BLOCK_COUNT; i++) {
+        SubGhzRainbowTableBlock* block = &instance->blocks[i];
+        if(block->used && block->address == block_address) {
+            block->used = instance->tick;
+            return block;
+        }
+        if(block->used < victim->used) victim = block;
+    }
+
+    victim->used = 0;
+    if(!storage_file_seek(instance->file, block_address, true)) return NULL;
+    uint16_t bytes_to_read = MIN(instance->size - block_address, SUBGHZ_RAINBOW_TABLE_BLOCK_SIZE);
+    if(storage_file_read(instance->file, victim->data, bytes_to_read) != bytes_to_read) {
+        return NULL;
+    }
+    victim->address = block_address;
+    victim->used = instance->tick;
+    return victim;
+}
+
+bool subghz_rainbow_table_get_byte(SubGhzRainbowTable* instance, uint32_t address, uint8_t* data) {
+    furi_assert(instance);
+    furi_assert(data);
+
+    if(address >= instance->size) return false;
+
+    if(instance->resident) {
+        *data = instance->resident[address];
+        return true;
+    }
+
+    if(!instance->file) return false;
+    SubGhzRainbowTableBlock* block = subghz_rainbow_table_get_block(instance, address);
+    if(!block) return false;
+    *data = block->data[address - block->address];
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Free heap left to the rest of application when table is resident */
+#ifndef SUBGHZ_RAINBOW_TABLE_HEAP_RESERVE
+#define SUBGHZ_RAINBOW_TABLE_HEAP_RESERVE (32 * 1024)
+#endif
+
+typedef struct SubGhzRainbowTable SubGhzRainbowTable;
+
+/** Allocate SubGhzRainbowTable
+ * 
+ * @return SubGhzRainbowTable* 
+ */
+SubGhzRainbowTable* subghz_rainbow_table_alloc();
+
+/** Free SubGhzRainbowTable, table is closed
+ * 
+ * @param instance 
+ */
+void subghz_rainbow_table_free(SubGhzRainbowTable* instance);
+
+/** Open rainbow table file, file is kept open until closed
+ * File is read by blocks through a small cache. Resident table is read into
+ * RAM at once instead, it is opt-in: table takes tens of KiB. When heap
+ * would be left with less than SUBGHZ_RAINBOW_TABLE_HEAP_RESERVE, block
+ * cache is used anyway.
+ * 
+ * @param instance - SubGhzRainbowTable instance
+ * @param file_name - const char* full path to the file
+ * @param resident - try to keep whole table in RAM
+ * @return true on success
+ */
+bool subghz_rainbow_table_open(SubGhzRainbowTable* instance, const char* file_name, bool resident);
+
+/** Close rainbow table file, drop cached data
+ * 
+ * @param instance - SubGhzRainbowTable instance
+ */
+void subghz_rainbow_table_close(SubGhzRainbowTable* instance);
+
+/** Check if table is held in RAM
+ * 
+ * @param instance - SubGhzRainbowTable instance
+ * @return bool
+ */
+bool subghz_rainbow_table_is_resident(SubGhzRainbowTable* instance);
+
+/** Read byte from rainbow table
+ * 
+ * @param instance - SubGhzRainbowTable instance
+ * @param address - byte address
+ * @param data - read byte
+ * @return true on success, false if table is not open or address is out of table
+ */
+bool subghz_rainbow_table_get_byte(SubGhzRainbowTable* instance, uint32_t address, uint8_t* data);
@@ -3,16 +3,23 @@
 #include <stream_buffer.h>
 #include <furi.h>
 
+#define SUBGHZ_WORKER_STREAM_SIZE 1024
+#define SUBGHZ_WORKER_PAIRS_SIZE 64
+
 struct SubGhzWorker {
     FuriThread* thread;
     StreamBufferHandle_t stream;
 
     volatile bool running;
     volatile bool overrun;
+    volatile SubGhzWorkerStats stats;
 
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerPairsCallback pairs_callback;
     void* context;
+
+    LevelDuration pairs[SUBGHZ_WORKER_PAIRS_SIZE];
 };
 
 /** Rx callback timer
@@ -26,16 +33,41 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     LevelDuration level_duration = level_duration_make(level, duration);
+    instance->stats.edges_received++;
     if(instance->overrun) {
-        instance->overrun = false;
+        // Edge after the gap is replaced with reset marker
         level_duration = level_duration_reset();
     }
     size_t ret =
         xStreamBufferSendFromISR(instance->stream, &level_duration, sizeof(LevelDuration), &xHigherPriorityTaskWoken);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    if(sizeof(LevelDuration) != ret) {
+        if(!instance->overrun) instance->stats.overrun_count++;
+        instance->overrun = true;
+        instance->stats.edges_dropped++;
+    } else {
+        if(instance->overrun) {
+            instance->overrun = false;
+            instance->stats.edges_dropped++;
+        }
+        uint32_t fill = xStreamBufferBytesAvailable(instance->stream) / sizeof(LevelDuration);
+        if(fill > instance->stats.stream_fill_max) instance->stats.stream_fill_max = fill;
+    }
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
+static void subghz_worker_process_pairs(SubGhzWorker* instance, const LevelDuration* pairs, size_t count) {
+    if(instance->pairs_callback) {
+        instance->pairs_callback(instance->context, pairs, count);
+    } else if(instance->pair_callback) {
+        for(size_t i = 0; i < count; i++) {
+            instance->pair_callback(
+                instance->context,
+                level_duration_get_level(pairs[i]),
+                level_duration_get_duration(pairs[i]));
+        }
+    }
+}
+
 /** Worker callback thread
  * 
  * @param context 
@@ -44,19 +76,21 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
     while(instance->running) {
-        int ret = xStreamBufferReceive(instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
-            if(level_duration_is_reset(level_duration)) {
-                printf(".");
+        size_t count = xStreamBufferReceive(instance->stream, instance->pairs, sizeof(instance->pairs), 10) /
+            sizeof(LevelDuration);
+        // Span is split by reset markers
+        size_t start = 0;
+        for(size_t i = 0; i < count; i++) {
+            if(level_duration_is_reset(instance->pairs[i])) {
+                subghz_worker_process_pairs(instance, &instance->pairs[start], i - start);
                 if (instance->overrun_callback) instance->overrun_callback(instance->context);
-            } else {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-                if (instance->pair_callback) instance->pair_callback(instance->context, level, duration);
+                start = i + 1;
             }
         }
+        if(start < count) {
+            subghz_worker_process_pairs(instance, &instance->pairs[start], count - start);
+        }
     }
 
     return 0;
@@ -71,7 +105,7 @@ SubGhzWorker* subghz_worker_alloc() {
     furi_thread_set_context(instance->thread, instance);
     furi_thread_set_callback(instance->thread, subghz_worker_thread_callback);
     
-    instance->stream = xStreamBufferCreate(sizeof(LevelDuration) * 1024, sizeof(LevelDuration));
+    instance->stream = xStreamBufferCreate(sizeof(LevelDuration) * SUBGHZ_WORKER_STREAM_SIZE, sizeof(LevelDuration));
 
     return instance;
 }
@@ -95,6 +129,11 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_pairs_callback(SubGhzWorker* instance, SubGhzWorkerPairsCallback callback) {
+    furi_assert(instance);
+    instance->pairs_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_assert(instance);
     instance->context = context;
@@ -104,6 +143,7 @@ void subghz_worker_start(SubGhzWorker* instance) {
     furi_assert(instance);
     furi_assert(!instance->running);
 
+    memset((void*)&instance->stats, 0, sizeof(SubGhzWorkerStats));
     instance->running = true;
 
     furi_thread_start(instance->thread);
@@ -122,3 +162,18 @@ bool subghz_worker_is_running(SubGhzWorker* instance) {
     furi_assert(instance);
     return instance->running;
 }
+
+void subghz_worker_get_stats(SubGhzWorker* instance, SubGhzWorkerStats* stats) {
+    furi_assert(instance);
+    furi_assert(stats);
+    // Counters are updated from ISR one by one, each of them is read atomically
+    stats->edges_received = instance->stats.edges_received;
+    stats->edges_dropped = instance->stats.edges_dropped;
+    stats->stream_fill_max = instance->stats.stream_fill_max;
+    stats->overrun_count = instance->stats.overrun_count;
+}
+
+size_t subghz_worker_get_stream_size(SubGhzWorker* instance) {
+    furi_assert(instance);
+    return SUBGHZ_WORKER_STREAM_SIZE;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <furi-hal.h>
+#include <toolbox/level_duration.h>
 
 typedef struct SubGhzWorker SubGhzWorker;
 
@@ -8,6 +9,16 @@ typedef void (*SubGhzWorkerOverrunCallback)(void* context);
 
 typedef void (*SubGhzWorkerPairCallback)(void* context, bool level, uint32_t duration);
 
+typedef void (*SubGhzWorkerPairsCallback)(void* context, const LevelDuration* pairs, size_t count);
+
+/** SubGhzWorker statistics, counted from start */
+typedef struct {
+    uint32_t edges_received;    /**< edges captured by rx callback */
+    uint32_t edges_dropped;     /**< edges lost because stream was full */
+    uint32_t stream_fill_max;   /**< max amount of edges waiting in stream */
+    uint32_t overrun_count;     /**< overrun episodes, overrun callback is called after each */
+} SubGhzWorkerStats;
+
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context);
 
 /** Allocate SubGhzWorker
@@ -36,6 +47,15 @@ void subghz_worker_set_overrun_callback(SubGhzWorker* instance, SubGhzWorkerOver
  */
 void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCallback callback);
 
+/** Pairs callback SubGhzWorker
+ * Receives every span of edges available in stream at once, pair callback
+ * is not called when it is set
+ * 
+ * @param instance SubGhzWorker instance
+ * @param callback SubGhzWorkerPairsCallback callback
+ */
+void subghz_worker_set_pairs_callback(SubGhzWorker* instance, SubGhzWorkerPairsCallback callback);
+
 /** Context callback SubGhzWorker
  * 
  * @param instance SubGhzWorker instance
@@ -60,3 +80,15 @@ void subghz_worker_stop(SubGhzWorker* instance);
  * @return bool - true if running
  */
 bool subghz_worker_is_running(SubGhzWorker* instance);
+
+/** Get statistics, can be called while worker is running
+ * @param instance SubGhzWorker instance
+ * @param stats SubGhzWorkerStats to fill
+ */
+void subghz_worker_get_stats(SubGhzWorker* instance, SubGhzWorkerStats* stats);
+
+/** Get stream size
+ * @param instance SubGhzWorker instance
+ * @return size_t - stream size in edges
+ */
+size_t subghz_worker_get_stream_size(SubGhzWorker* instance);
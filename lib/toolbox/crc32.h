@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief CRC-32 (IEEE 802.3, same as zlib crc32()) of data.
+ * Table is 16 entries, so it is slower than byte table but takes 64 bytes of flash.
+ * 
+ * @param crc CRC of previous data, 0 for first call
+ * @param data pointer to data
+ * @param size data size
+ * @return uint32_t CRC of previous data and this data
+ */
+uint32_t crc32_calc_buffer(uint32_t crc, const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,62 @@
+#include "level_duration_pingpong.h"
+#include <furi/check.h>
+
+void level_duration_pingpong_init(
+    LevelDurationPingPong* pingpong,
+    LevelDuration* buffer,
+    size_t size,
+    LevelDurationPingPongCallback callback,
+    void* context) {
+    furi_assert(pingpong);
+    furi_assert(buffer);
+    furi_assert(size);
+
+    pingpong->buffer = buffer;
+    pingpong->size = size;
+    pingpong->fill_cnt = 0;
+    pingpong->fill = 0;
+    pingpong->overrun = false;
+    pingpong->busy[0] = false;
+    pingpong->busy[1] = false;
+    pingpong->callback = callback;
+    pingpong->context = context;
+}
+
+void level_duration_pingpong_flush(LevelDurationPingPong* pingpong) {
+    if(!pingpong->fill_cnt) return;
+
+    uint8_t fill = pingpong->fill;
+    size_t fill_cnt = pingpong->fill_cnt;
+    bool overrun = pingpong->overrun;
+
+    pingpong->busy[fill] = true;
+    pingpong->fill = !fill;
+    pingpong->fill_cnt = 0;
+    pingpong->overrun = false;
+
+    if(pingpong->callback) {
+        pingpong->callback(
+            pingpong->context, &pingpong->buffer[fill * pingpong->size], fill_cnt, overrun);
+    }
+}
+
+bool level_duration_pingpong_put(LevelDurationPingPong* pingpong, LevelDuration level_duration) {
+    if(pingpong->busy[pingpong->fill]) {
+        pingpong->overrun = true;
+        return false;
+    }
+
+    pingpong->buffer[pingpong->fill * pingpong->size + pingpong->fill_cnt] = level_duration;
+    if(++pingpong->fill_cnt == pingpong->size) {
+        level_duration_pingpong_flush(pingpong);
+    }
+    return true;
+}
+
+void level_duration_pingpong_release(LevelDurationPingPong* pingpong, const LevelDuration* buffer) {
+    furi_assert(pingpong);
+    furi_assert(
+        (buffer == pingpong->buffer) || (buffer == &pingpong->buffer[pingpong->size]));
+
+    pingpong->busy[buffer != pingpong->buffer] = false;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "level_duration.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Callback for a filled buffer, called from producer context
+ *
+ * @param context callback context
+ * @param buffer filled buffer, belongs to consumer until released
+ * @param size amount of timings in buffer
+ * @param overrun timings were dropped right before this buffer
+ */
+typedef void (*LevelDurationPingPongCallback)(
+    void* context,
+    const LevelDuration* buffer,
+    size_t size,
+    bool overrun);
+
+/**
+ * Pair of LevelDuration buffers filled in turn by producer (usually ISR).
+ * Filled buffer is handed over to consumer as is, so consumer reads
+ * timings in place and producer never waits: when both buffers are
+ * still owned by consumer, timings are dropped and overrun is reported
+ * with the next handed over buffer.
+ */
+typedef struct {
+    LevelDuration* buffer;
+    size_t size;
+    size_t fill_cnt;
+    uint8_t fill;
+    bool overrun;
+    volatile bool busy[2];
+    LevelDurationPingPongCallback callback;
+    void* context;
+} LevelDurationPingPong;
+
+/**
+ * @brief Init ping-pong over external memory
+ *
+ * @param pingpong instance
+ * @param buffer memory for both buffers, 2 * size timings
+ * @param size size of one buffer in timings
+ * @param callback filled buffer callback
+ * @param context callback context
+ */
+void level_duration_pingpong_init(
+    LevelDurationPingPong* pingpong,
+    LevelDuration* buffer,
+    size_t size,
+    LevelDurationPingPongCallback callback,
+    void* context);
+
+/**
+ * @brief Store timing, hand buffer over to consumer if it is full. Producer side.
+ *
+ * @param pingpong instance
+ * @param level_duration timing
+ * @return false - timing is dropped, no free buffer
+ */
+bool level_duration_pingpong_put(LevelDurationPingPong* pingpong, LevelDuration level_duration);
+
+/**
+ * @brief Hand partially filled buffer over to consumer. Producer side.
+ *
+ * @param pingpong instance
+ */
+void level_duration_pingpong_flush(LevelDurationPingPong* pingpong);
+
+/**
+ * @brief Give buffer back to producer. Consumer side.
+ *
+ * @param pingpong instance
+ * @param buffer buffer received in callback
+ */
+void level_duration_pingpong_release(LevelDurationPingPong* pingpong, const LevelDuration* buffer);
+
+#ifdef __cplusplus
+}
+#endif
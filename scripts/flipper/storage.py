@@ -3,6 +3,8 @@ import serial
 import time
 import hashlib
 import math
+import struct
+import zlib
 
 
 def timing(func):
@@ -47,10 +49,28 @@ class BufferedRead:
             data = self.stream.read(i)
             self.buffer.extend(data)
 
+    def exact(self, size):
+        """Read exactly size bytes, None on timeout"""
+        while len(self.buffer) < size:
+            i = max(size - len(self.buffer), self.stream.in_waiting)
+            data = self.stream.read(i)
+            if not data:
+                return None
+            self.buffer.extend(data)
+        read = self.buffer[:size]
+        self.buffer = self.buffer[size:]
+        return read
+
 
 class FlipperStorage:
     CLI_PROMPT = ">: "
     CLI_EOL = "\r\n"
+    # storage read_stream/write_stream packets, see storage-cli.c
+    STREAM_MAGIC = 0xA5
+    STREAM_ACK = 0x06
+    STREAM_NAK = 0x15
+    STREAM_HEADER = struct.Struct("<BBH")
+    STREAM_CRC = struct.Struct("<I")
 
     def __init__(self, portname: str):
         self.port = serial.Serial()
@@ -85,7 +105,7 @@ class FlipperStorage:
 
     def has_error(self, data):
         """Is data has error"""
-        if data.find(b"Storage error") != -1:
+        if data.find(b"Storage error") != -1 or data.find(b"Stream error") != -1:
             return True
         else:
             return False
@@ -184,49 +204,72 @@ class FlipperStorage:
         for new_path in walk_dirs:
             yield from self.walk(new_path)
 
+    def stream_packet(self, seq, data):
+        header = self.STREAM_HEADER.pack(self.STREAM_MAGIC, seq & 0xFF, len(data))
+        packet = header + data
+        return packet + self.STREAM_CRC.pack(zlib.crc32(packet))
+
+    def stream_answer(self, seq):
+        """Wait for answer to packet, True if it is ACK"""
+        answer = self.read.exact(2)
+        return (
+            answer is not None
+            and answer[0] == self.STREAM_ACK
+            and answer[1] == seq & 0xFF
+        )
+
+    def stream_progress(self, done, size, packet_size):
+        percent = str(math.ceil(done / size * 100)) if size else "100"
+        total_chunks = str(math.ceil(size / packet_size))
+        current_chunk = str(math.ceil(done / packet_size))
+        print(percent + "%, chunk " + current_chunk + " of " + total_chunks, end="\r")
+
     def send_file(self, filename_from, filename_to):
         """Send file from local device to Flipper"""
-        self.remove(filename_to)
-
         file = open(filename_from, "rb")
         filesize = os.fstat(file.fileno()).st_size
 
-        buffer_size = 512
-        while True:
-            filedata = file.read(buffer_size)
-            size = len(filedata)
-            if size == 0:
-                break
-
-            self.send_and_wait_eol(
-                'storage write_chunk "' + filename_to + '" ' + str(size) + "\r"
-            )
-            answer = self.read.until(self.CLI_EOL)
-            if self.has_error(answer):
-                self.last_error = self.get_error(answer)
-                self.read.until(self.CLI_PROMPT)
-                file.close()
-                return False
-
-            self.port.write(filedata)
+        self.send_and_wait_eol('storage write_stream "' + filename_to + '"\r')
+        answer = self.read.until(self.CLI_EOL)
+        if self.has_error(answer):
+            self.last_error = self.get_error(answer)
             self.read.until(self.CLI_PROMPT)
-
-            percent = str(math.ceil(file.tell() / filesize * 100))
-            total_chunks = str(math.ceil(filesize / buffer_size))
-            current_chunk = str(math.ceil(file.tell() / buffer_size))
-            print(
-                percent + "%, chunk " + current_chunk + " of " + total_chunks, end="\r"
-            )
+            file.close()
+            return False
+        packet_size, window = map(int, answer.split(b": ")[1].split(b" "))
+
+        # keep up to window packets on the way, empty packet ends stream
+        seq = 0
+        answered = 0
+        result = True
+        while result:
+            filedata = file.read(packet_size)
+            self.port.write(self.stream_packet(seq, filedata))
+            seq += 1
+
+            while result and (
+                seq - answered == window or (not filedata and answered < seq)
+            ):
+                result = self.stream_answer(answered)
+                answered += 1
+
+            if not filedata:
+                break
+            self.stream_progress(file.tell(), filesize, packet_size)
         file.close()
         print()
-        return True
+
+        data = self.read.until(self.CLI_PROMPT)
+        if not result:
+            self.last_error = "stream aborted"
+            for line in data.split(b"\r\n"):
+                if self.has_error(line):
+                    self.last_error = self.get_error(line)
+        return result
 
     def read_file(self, filename):
         """Receive file from Flipper, and get filedata (bytes)"""
-        buffer_size = 512
-        self.send_and_wait_eol(
-            'storage read_chunks "' + filename + '" ' + str(buffer_size) + "\r"
-        )
+        self.send_and_wait_eol('storage read_stream "' + filename + '"\r')
         answer = self.read.until(self.CLI_EOL)
         filedata = bytearray()
         if self.has_error(answer):
@@ -234,23 +277,43 @@ class FlipperStorage:
             self.read.until(self.CLI_PROMPT)
             return filedata
         size = int(answer.split(b": ")[1])
-        readed_size = 0
-
-        while readed_size < size:
-            self.read.until("Ready?" + self.CLI_EOL)
-            self.send("y")
-            read_size = min(size - readed_size, buffer_size)
-            filedata.extend(self.port.read(read_size))
-            readed_size = readed_size + read_size
-
-            percent = str(math.ceil(readed_size / size * 100))
-            total_chunks = str(math.ceil(size / buffer_size))
-            current_chunk = str(math.ceil(readed_size / buffer_size))
-            print(
-                percent + "%, chunk " + current_chunk + " of " + total_chunks, end="\r"
-            )
+        packet_size = 512
+
+        seq = 0
+        while True:
+            header = self.read.exact(self.STREAM_HEADER.size)
+            if header is None:
+                self.last_error = "stream timeout"
+                break
+            magic, packet_seq, length = self.STREAM_HEADER.unpack(header)
+            data = None
+            if magic == self.STREAM_MAGIC and length <= packet_size:
+                data = self.read.exact(length + self.STREAM_CRC.size)
+            if (
+                data is None
+                or packet_seq != seq & 0xFF
+                or self.STREAM_CRC.unpack(data[length:])[0]
+                != zlib.crc32(header + data[:length])
+            ):
+                self.port.write(bytes([self.STREAM_NAK, seq & 0xFF]))
+                self.last_error = "broken packet"
+                break
+            self.port.write(bytes([self.STREAM_ACK, seq & 0xFF]))
+            seq += 1
+
+            if length == 0:
+                break
+            filedata.extend(data[:length])
+            self.stream_progress(len(filedata), size, packet_size)
         print()
-        self.read.until(self.CLI_PROMPT)
+
+        data = self.read.until(self.CLI_PROMPT)
+        for line in data.split(b"\r\n"):
+            if self.has_error(line):
+                self.last_error = self.get_error(line)
+                return bytearray()
+        if len(filedata) != size:
+            return bytearray()
         return filedata
 
     def receive_file(self, filename_from, filename_to):
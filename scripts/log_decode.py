@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+
+import logging
+import argparse
+import sys
+import re
+import struct
+
+FRAME_START = 0x1E
+# start, length, timestamp and format address, checksum
+FRAME_MIN = 2 + 8 + 1
+
+ELF_MAGIC = b"\x7fELF"
+ELF_SECTION = "<" "IIIIIIIIII"
+ELF_SHF_ALLOC = 0x2
+ELF_SHT_NOBITS = 8
+
+# same conversions as furi_log_encode() in core/furi/log.c
+FORMAT_SPEC = re.compile(
+    r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|ll|[hlzjtL])?([diouxXcsfeEgGaApn%])"
+)
+
+
+class Elf:
+    def __init__(self, filename):
+        with open(filename, "rb") as file:
+            self.data = file.read()
+        if self.data[:4] != ELF_MAGIC or self.data[4] != 1:
+            raise ValueError(f"{filename} is not 32 bit ELF")
+        shoff = struct.unpack_from("<I", self.data, 0x20)[0]
+        shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            section = struct.unpack_from(ELF_SECTION, self.data, shoff + i * shentsize)
+            _, sh_type, flags, addr, offset, size = section[:6]
+            if flags & ELF_SHF_ALLOC and sh_type != ELF_SHT_NOBITS and size:
+                self.sections.append((addr, offset, size))
+
+    def string(self, address):
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.find(b"\0", start, offset + size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode("utf-8", "replace")
+        return None
+
+
+class Main:
+    def __init__(self):
+        # command args
+        self.parser = argparse.ArgumentParser(
+            description="Decode binary log frames of 'log binary' CLI command"
+        )
+        self.parser.add_argument("-d", "--debug", action="store_true", help="Debug")
+        self.parser.add_argument("elf", help="Firmware elf, same build as device runs")
+        self.parser.add_argument(
+            "input", nargs="?", default="-", help="Captured CLI output, - for stdin"
+        )
+        self.parser.add_argument("-p", "--port", help="Read from CDC Port instead")
+        # logging
+        self.logger = logging.getLogger()
+
+    def __call__(self):
+        self.args = self.parser.parse_args()
+        # configure log output
+        self.log_level = logging.DEBUG if self.args.debug else logging.INFO
+        self.logger.setLevel(self.log_level)
+        self.handler = logging.StreamHandler(sys.stderr)
+        self.handler.setLevel(self.log_level)
+        self.formatter = logging.Formatter("%(asctime)s [%(levelname)s] %(message)s")
+        self.handler.setFormatter(self.formatter)
+        self.logger.addHandler(self.handler)
+        # execute
+        self.elf = Elf(self.args.elf)
+        self.buffer = bytearray()
+        for data in self._read():
+            self.buffer.extend(data)
+            self._decode()
+        self._decode(final=True)
+
+    def _read(self):
+        if self.args.port:
+            import serial
+
+            port = serial.Serial(self.args.port, 230400, timeout=0.1)
+            port.write(b"log binary\r")
+            try:
+                while True:
+                    yield port.read(max(1, port.in_waiting))
+            except KeyboardInterrupt:
+                port.write(b" ")
+                return
+        if self.args.input == "-":
+            stream = sys.stdin.buffer
+        else:
+            stream = open(self.args.input, "rb")
+        with stream:
+            while True:
+                data = stream.read1(4096)
+                if not data:
+                    return
+                yield data
+
+    def _output(self, text):
+        sys.stdout.write(text)
+        sys.stdout.flush()
+
+    def _decode(self, final=False):
+        buffer = self.buffer
+        text_start = 0
+        i = 0
+        while i < len(buffer):
+            if buffer[i] != FRAME_START:
+                i += 1
+                continue
+            length = buffer[i + 1] if i + 1 < len(buffer) else 0
+            if len(buffer) - i < max(FRAME_MIN, 3 + length):
+                if final:
+                    i += 1
+                    continue
+                # frame may be incomplete, wait for more data
+                break
+            line = self._frame(buffer[i + 2 : i + 2 + length], buffer[i + 2 + length])
+            if line is None:
+                i += 1
+                continue
+            self._output(buffer[text_start:i].decode("utf-8", "replace") + line)
+            i += 3 + length
+            text_start = i
+        self._output(buffer[text_start:i].decode("utf-8", "replace"))
+        del buffer[:i]
+
+    def _frame(self, payload, checksum):
+        if len(payload) < 8 or sum(payload) & 0xFF != checksum:
+            return None
+        timestamp, address = struct.unpack_from("<II", payload)
+        format = self.elf.string(address)
+        if format is None:
+            self.logger.debug(f"No format string at 0x{address:08x}")
+            return None
+        try:
+            return f"{timestamp} " + self._format(format, payload[8:])
+        except (struct.error, ValueError, TypeError) as e:
+            self.logger.debug(f"Broken frame for {format!r}: {e}")
+            return None
+
+    def _format(self, format, args):
+        offset = 0
+
+        def take(fmt):
+            nonlocal offset
+            value = struct.unpack_from(fmt, args, offset)[0]
+            offset += struct.calcsize(fmt)
+            return value
+
+        def spec(match):
+            nonlocal offset
+            flags, width, precision, length, conversion = match.groups()
+            if conversion == "%":
+                return "%"
+            if width == "*":
+                width = str(take("<i"))
+            if precision == "*":
+                precision = str(take("<i"))
+            python = "%" + flags + (width or "")
+            if precision is not None:
+                python += "." + precision
+            if conversion in "diouxXc":
+                signed = conversion in "di"
+                if length in ("ll", "j"):
+                    value = take("<q" if signed else "<Q")
+                else:
+                    value = take("<i" if signed else "<I")
+                    if length in ("h", "hh"):
+                        bits = 16 if length == "h" else 8
+                        value &= (1 << bits) - 1
+                        if signed and value >= 1 << (bits - 1):
+                            value -= 1 << bits
+                conversion = "d" if conversion == "u" else conversion
+                return (python + conversion) % value
+            if conversion in "feEgGaA":
+                value = take("<d")
+                if conversion in "aA":
+                    return value.hex()
+                return (python + conversion) % value
+            if conversion == "s":
+                end = args.index(b"\0", offset)
+                value = args[offset:end].decode("utf-8", "replace")
+                offset = end + 1
+                return (python + "s") % value
+            if conversion == "p":
+                return "0x%x" % take("<I")
+            return ""
+
+        return FORMAT_SPEC.sub(spec, format)
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+
+import logging
+import argparse
+import sys
+import struct
+
+KEYSTORE_MAGIC = 0x4B5A4753
+KEYSTORE_VERSION = 0x01
+KEYSTORE_RESERVED = 0x00
+KEYSTORE_HEADER = "<" "IHHII"
+KEYSTORE_RECORD = "<" "QHHI"
+
+
+class Main:
+    def __init__(self):
+        # command args
+        self.parser = argparse.ArgumentParser()
+        self.parser.add_argument("-d", "--debug", action="store_true", help="Debug")
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+        # Compile
+        self.parser_compile = self.subparsers.add_parser(
+            "compile", help="Compile text keystore to binary"
+        )
+        self.parser_compile.add_argument("input", help="Text keystore, KEY:TYPE:NAME")
+        self.parser_compile.add_argument("output", help="Binary keystore")
+        self.parser_compile.set_defaults(func=self.compile)
+        # Decompile
+        self.parser_decompile = self.subparsers.add_parser(
+            "decompile", help="Convert binary keystore back to text"
+        )
+        self.parser_decompile.add_argument("input", help="Binary keystore")
+        self.parser_decompile.add_argument("output", help="Text keystore")
+        self.parser_decompile.set_defaults(func=self.decompile)
+        # logging
+        self.logger = logging.getLogger()
+
+    def __call__(self):
+        self.args = self.parser.parse_args()
+        if "func" not in self.args:
+            self.parser.error("Choose something to do")
+        # configure log output
+        self.log_level = logging.DEBUG if self.args.debug else logging.INFO
+        self.logger.setLevel(self.log_level)
+        self.handler = logging.StreamHandler(sys.stdout)
+        self.handler.setLevel(self.log_level)
+        self.formatter = logging.Formatter("%(asctime)s [%(levelname)s] %(message)s")
+        self.handler.setFormatter(self.formatter)
+        self.logger.addHandler(self.handler)
+        # execute requested function
+        self.args.func()
+
+    def _read_text(self, filename):
+        keys = []
+        with open(filename, "r") as file:
+            for number, line in enumerate(file, 1):
+                line = line.strip()
+                if not line:
+                    continue
+                try:
+                    key, key_type, name = line.split(":", 2)
+                    keys.append((int(key, 16), int(key_type), name.split()[0]))
+                except (ValueError, IndexError):
+                    self.logger.warning(f"Skipping line {number}: {line}")
+        return keys
+
+    def compile(self):
+        # Records keep text order: first matching key wins, and decompiled
+        # keystore must be the same text. Bitsliced search masks learning
+        # types per key, so slices don't need keys of one type.
+        keys = self._read_text(self.args.input)
+
+        names = bytearray()
+        offsets = {}
+        records = bytearray()
+        for key, key_type, name in keys:
+            if name not in offsets:
+                offsets[name] = len(names)
+                names += name.encode("ascii") + b"\0"
+            records += struct.pack(
+                KEYSTORE_RECORD, key, key_type, KEYSTORE_RESERVED, offsets[name]
+            )
+
+        header = struct.pack(
+            KEYSTORE_HEADER,
+            KEYSTORE_MAGIC,
+            KEYSTORE_VERSION,
+            KEYSTORE_RESERVED,
+            len(keys),
+            len(names),
+        )
+        with open(self.args.output, "wb") as file:
+            file.write(header + records + names)
+        self.logger.info(
+            f"Compiled {len(keys)} keys, {len(offsets)} names, "
+            f"{len(header) + len(records) + len(names)} bytes"
+        )
+
+    def decompile(self):
+        data = open(self.args.input, "rb").read()
+        header_size = struct.calcsize(KEYSTORE_HEADER)
+        record_size = struct.calcsize(KEYSTORE_RECORD)
+        magic, version, _, key_count, names_size = struct.unpack_from(
+            KEYSTORE_HEADER, data
+        )
+        if magic != KEYSTORE_MAGIC or version != KEYSTORE_VERSION:
+            self.logger.error("Not a compiled keystore")
+            return
+        names = data[header_size + key_count * record_size :]
+        if len(names) != names_size:
+            self.logger.error("Keystore is truncated")
+            return
+        with open(self.args.output, "w") as file:
+            for i in range(key_count):
+                key, key_type, _, name = struct.unpack_from(
+                    KEYSTORE_RECORD, data, header_size + i * record_size
+                )
+                name = names[name : names.index(b"\0", name)].decode("ascii")
+                file.write(f"{key:016X}:{key_type}:{name}\n")
+        self.logger.info(f"Decompiled {key_count} keys")
+
+
+if __name__ == "__main__":
+    Main()()